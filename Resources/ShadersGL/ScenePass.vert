@@ -1,10 +1,10 @@
 #version 330 core
 
 layout(location = 0) in vec3 inPosition;
-layout(location = 1) in vec3 inNormal;
+layout(location = 1) in vec2 inNormal;         // octahedral encoding
 layout(location = 2) in vec2 inTexCoord;
-layout(location = 3) in vec3 inTangent;
-layout(location = 4) in vec3 inBitangent;
+layout(location = 3) in vec2 inTangent;        // octahedral encoding
+layout(location = 4) in float inBitangentSign; // 0 when the mesh has no tangents
 
 uniform mat4 model;
 uniform mat3 normalMatrix;
@@ -24,14 +24,36 @@ out vec2 fragTexCoord;
 out vec3 fragTangent;
 out vec3 fragBitangent;
 
+vec3 decodeOctahedral(vec2 encoded) {
+    encoded = clamp(encoded, -1.0, 1.0);
+    vec3 direction = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+    if (direction.z < 0.0) {
+        direction.xy = (1.0 - abs(encoded.yx)) * vec2(encoded.x < 0.0 ? -1.0 : 1.0, encoded.y < 0.0 ? -1.0 : 1.0);
+    }
+    return normalize(direction);
+}
+
 void main() {
     vec4 worldPosition = model * vec4(inPosition, 1.0);
 
     fragPosition = worldPosition.xyz;
 
-    fragNormal = normalize(normalMatrix * inNormal);
-    fragTangent = normalize(normalMatrix * inTangent);
-    fragBitangent = normalize(normalMatrix * inBitangent);
+    vec3 normal = decodeOctahedral(inNormal);
+    vec3 tangent;
+    vec3 bitangent;
+    if (inBitangentSign == 0.0) {
+        // The mesh has no tangents, any frame around the normal does without a normal map.
+        vec3 axis = abs(normal.x) < 0.9 ? vec3(1.0, 0.0, 0.0) : vec3(0.0, 1.0, 0.0);
+        tangent = normalize(cross(cross(normal, axis), normal));
+        bitangent = cross(normal, tangent);
+    } else {
+        tangent = decodeOctahedral(inTangent);
+        bitangent = inBitangentSign * cross(normal, tangent);
+    }
+
+    fragNormal = normalize(normalMatrix * normal);
+    fragTangent = normalize(normalMatrix * tangent);
+    fragBitangent = normalize(normalMatrix * bitangent);
     
     fragTexCoord = inTexCoord;
     
@@ -0,0 +1,194 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Core/ImageTypes.hpp"
+#include "Surface/Texture.hpp"
+#include "Surface/TextureFiltering.hpp"
+#include "Surface/TextureStorage.hpp"
+#include "Surface/TextureWrapping.hpp"
+
+namespace {
+
+constexpr std::size_t SAMPLE_COUNT = 65536; // lookups per iteration, enough to leave the L1 cache on large textures
+constexpr double      UV_MIN       = -0.5;  // coordinates span [-0.5, 1.5] so that every wrapping mode does work
+constexpr double      UV_RANGE     = 2.0;
+constexpr unsigned    SEED         = 42U;
+
+enum class AccessPattern : std::uint8_t {
+  COHERENT, ///< Scanline order, one texel apart, as a camera ray sweep over a flat surface.
+  RANDOM    ///< Uniformly scattered, as secondary bounces hitting the texture anywhere.
+};
+
+const char* filteringName(TextureSampling::TextureFiltering filtering) {
+  switch(filtering) {
+  case TextureSampling::TextureFiltering::NEAREST:
+    return "nearest";
+  case TextureSampling::TextureFiltering::BILINEAR:
+    return "bilinear";
+  case TextureSampling::TextureFiltering::TRILINEAR:
+    return "trilinear";
+  }
+  return "unknown";
+}
+
+const char* wrappingName(TextureSampling::TextureWrapping wrapping) {
+  switch(wrapping) {
+  case TextureSampling::TextureWrapping::REPEAT:
+    return "repeat";
+  case TextureSampling::TextureWrapping::MIRRORED_REPEAT:
+    return "mirrored_repeat";
+  case TextureSampling::TextureWrapping::CLAMP_TO_EDGE:
+    return "clamp_to_edge";
+  case TextureSampling::TextureWrapping::CLAMP_TO_BORDER:
+    return "clamp_to_border";
+  }
+  return "unknown";
+}
+
+const char* patternName(AccessPattern pattern) { return pattern == AccessPattern::COHERENT ? "coherent" : "random"; }
+
+const char* colorSpaceName(ColorSpace color_space) { return color_space == ColorSpace::S_RGB ? "srgb" : "linear"; }
+
+const char* formatName(TexelFormat format) {
+  switch(format) {
+  case TexelFormat::UNORM8:
+    return "unorm8";
+  case TexelFormat::HALF:
+    return "half";
+  case TexelFormat::FLOAT32:
+    return "float32";
+  case TexelFormat::FLOAT64:
+    return "float64";
+  }
+  return "unknown";
+}
+
+struct TextureCase {
+  TextureSampling::TextureFiltering filtering   = TextureSampling::TextureFiltering::BILINEAR;
+  TextureSampling::TextureWrapping  wrapping    = TextureSampling::TextureWrapping::REPEAT;
+  AccessPattern                     pattern     = AccessPattern::COHERENT;
+  ColorSpace                        color_space = ColorSpace::LINEAR;
+  TexelFormat                       format      = TexelFormat::FLOAT64;
+  int                               size        = 512;
+  int                               channels    = 3;
+
+  std::string label() const {
+    return std::string(filteringName(filtering)) + "/" + wrappingName(wrapping) + "/" + patternName(pattern) + "/" +
+           colorSpaceName(color_space) + "/" + formatName(format) + "/" + std::to_string(size) + "px/" +
+           std::to_string(channels) + "ch";
+  }
+};
+
+void setupTexture(Texture& texture, const TextureCase& texture_case) {
+  const ImageProperties properties{texture_case.size, texture_case.size, texture_case.channels};
+
+  std::mt19937                           generator(SEED);
+  std::uniform_real_distribution<double> distribution(0.0, 1.0);
+  std::vector<double>                    image_data(properties.bufferSize());
+  for(double& value : image_data) {
+    value = distribution(generator);
+  }
+
+  texture.generateTexture(properties, image_data);
+  texture.setStorageFormat(texture_case.format);
+  texture.setColorSpace(texture_case.color_space);
+  texture.setFilteringMode(texture_case.filtering);
+  texture.setWrappingMode(texture_case.wrapping);
+}
+
+std::vector<TextureUV> generateCoordinates(AccessPattern pattern, int size) {
+  std::vector<TextureUV> coordinates(SAMPLE_COUNT);
+  if(pattern == AccessPattern::COHERENT) {
+    const double      texel_step = 1.0 / size;
+    const std::size_t row_length = static_cast<std::size_t>(UV_RANGE * size);
+    for(std::size_t i = 0; i < SAMPLE_COUNT; ++i) {
+      coordinates[i] = {UV_MIN + static_cast<double>(i % row_length) * texel_step,
+                        UV_MIN + static_cast<double>(i / row_length) * texel_step};
+    }
+    return coordinates;
+  }
+
+  std::mt19937                           generator(SEED);
+  std::uniform_real_distribution<double> distribution(UV_MIN, UV_MIN + UV_RANGE);
+  for(TextureUV& uv : coordinates) {
+    uv = {distribution(generator), distribution(generator)};
+  }
+  return coordinates;
+}
+
+template <typename Sampler>
+void runSampling(benchmark::State& state, const TextureCase& texture_case, Sampler sample) {
+  Texture texture;
+  setupTexture(texture, texture_case);
+  const std::vector<TextureUV> coordinates = generateCoordinates(texture_case.pattern, texture_case.size);
+
+  for(auto _ : state) {
+    for(const TextureUV& uv : coordinates) {
+      benchmark::DoNotOptimize(sample(texture, uv));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(coordinates.size()));
+  state.SetLabel(texture_case.label());
+}
+
+// Args: filtering, wrapping, access pattern. Isolates the addressing cost on a fixed 512px RGB texture.
+void BM_TextureSample3d_Addressing(benchmark::State& state) {
+  TextureCase texture_case;
+  texture_case.filtering = static_cast<TextureSampling::TextureFiltering>(state.range(0));
+  texture_case.wrapping  = static_cast<TextureSampling::TextureWrapping>(state.range(1));
+  texture_case.pattern   = static_cast<AccessPattern>(state.range(2));
+  runSampling(state, texture_case, [](const Texture& texture, TextureUV uv) { return texture.getValue3d(uv); });
+}
+
+// Args: filtering, channels, storage format, color space, size. Measures the fetch and decode cost of the stored
+// texels; UNORM8 textures sampled in LINEAR color space decode their sRGB texels through the lookup table.
+void BM_TextureSample3d_Format(benchmark::State& state) {
+  TextureCase texture_case;
+  texture_case.filtering   = static_cast<TextureSampling::TextureFiltering>(state.range(0));
+  texture_case.channels    = static_cast<int>(state.range(1));
+  texture_case.format      = static_cast<TexelFormat>(state.range(2));
+  texture_case.color_space = static_cast<ColorSpace>(state.range(3));
+  texture_case.size        = static_cast<int>(state.range(4));
+  runSampling(state, texture_case, [](const Texture& texture, TextureUV uv) { return texture.getValue3d(uv); });
+}
+
+// Args: filtering, access pattern, size. Single channel textures, as roughness and metalness maps.
+void BM_TextureSample1d(benchmark::State& state) {
+  TextureCase texture_case;
+  texture_case.filtering = static_cast<TextureSampling::TextureFiltering>(state.range(0));
+  texture_case.pattern   = static_cast<AccessPattern>(state.range(1));
+  texture_case.size      = static_cast<int>(state.range(2));
+  texture_case.channels  = 1;
+  runSampling(state, texture_case, [](const Texture& texture, TextureUV uv) { return texture.getValue1d(uv); });
+}
+
+template <typename Enum> constexpr std::int64_t toArg(Enum value) { return static_cast<std::int64_t>(value); }
+
+const std::vector<std::int64_t> FILTERINGS   = {toArg(TextureSampling::TextureFiltering::NEAREST),
+                                                toArg(TextureSampling::TextureFiltering::BILINEAR)};
+const std::vector<std::int64_t> WRAPPINGS    = {toArg(TextureSampling::TextureWrapping::REPEAT),
+                                                toArg(TextureSampling::TextureWrapping::MIRRORED_REPEAT),
+                                                toArg(TextureSampling::TextureWrapping::CLAMP_TO_EDGE),
+                                                toArg(TextureSampling::TextureWrapping::CLAMP_TO_BORDER)};
+const std::vector<std::int64_t> PATTERNS     = {toArg(AccessPattern::COHERENT), toArg(AccessPattern::RANDOM)};
+const std::vector<std::int64_t> FORMATS      = {toArg(TexelFormat::UNORM8), toArg(TexelFormat::HALF),
+                                                toArg(TexelFormat::FLOAT32), toArg(TexelFormat::FLOAT64)};
+const std::vector<std::int64_t> COLOR_SPACES = {toArg(ColorSpace::LINEAR), toArg(ColorSpace::S_RGB)};
+const std::vector<std::int64_t> SIZES        = {64, 512, 2048};
+
+} // namespace
+
+BENCHMARK(BM_TextureSample3d_Addressing)
+    ->ArgNames({"filter", "wrap", "pattern"})
+    ->ArgsProduct({FILTERINGS, WRAPPINGS, PATTERNS});
+
+BENCHMARK(BM_TextureSample3d_Format)
+    ->ArgNames({"filter", "channels", "format", "color_space", "size"})
+    ->ArgsProduct({FILTERINGS, {1, 3, 4}, FORMATS, COLOR_SPACES, SIZES});
+
+BENCHMARK(BM_TextureSample1d)->ArgNames({"filter", "pattern", "size"})->ArgsProduct({FILTERINGS, PATTERNS, SIZES});
@@ -79,6 +79,13 @@ public:
    */
   int getLeafIndex() const { return m_leaf_index; }
 
+  /**
+   * @brief Sets the leaf index of the BVH node, keeping its bounds as they are.
+   *
+   * @param leaf_index The index of the object of the leaf.
+   */
+  void setLeafIndex(int leaf_index) { m_leaf_index = leaf_index; }
+
   /**
    * @brief Gets the left child of the BVH node.
    *
@@ -0,0 +1,46 @@
+/**
+ * @file FlatBVH.hpp
+ * @brief Header file for the flat, pointer free representation of a BVH used to store it on disk.
+ */
+#ifndef BVH_FLATBVH_HPP
+#define BVH_FLATBVH_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "BVH/BVHNode.hpp"
+
+/**
+ * @struct FlatBVHNode
+ * @brief Node of a BVH stored in an array in depth-first order.
+ *
+ * The left child of an inner node directly follows it in the array, the right child is referenced by its index.
+ */
+struct FlatBVHNode {
+  std::array<double, 3> min_bound   = {0.0, 0.0, 0.0};
+  std::array<double, 3> max_bound   = {0.0, 0.0, 0.0};
+  std::int32_t          leaf_index  = -1; ///< Index of the object of a leaf, -1 for inner nodes.
+  std::uint32_t         right_child = 0;  ///< Index of the right child of an inner node.
+};
+
+namespace BVH {
+/**
+ * @brief Flattens a BVH into an array of nodes.
+ * @param root The root of the BVH, may be nullptr.
+ * @return The nodes in depth-first order, empty if the root is nullptr.
+ */
+std::vector<FlatBVHNode> flatten(const BVHNode* root);
+
+/**
+ * @brief Rebuilds a BVH from its flattened nodes, keeping the bounds of every node bit for bit.
+ * @param nodes The nodes in depth-first order, as returned by flatten.
+ * @param node_count The number of nodes.
+ * @return The root of the BVH, nullptr if there is no node or if the nodes do not describe a tree.
+ */
+std::shared_ptr<BVHNode> unflatten(const FlatBVHNode* nodes, std::size_t node_count);
+} // namespace BVH
+
+#endif // BVH_FLATBVH_HPP
@@ -56,6 +56,32 @@ static constexpr double DEFAULT_PLANE_LENGTH = 10.0;   // in meters
 static constexpr double MIN_PLANE_LENGTH     = 0.1;    // in meters
 static constexpr double MAX_PLANE_LENGTH     = 1000.0; // in meters
 
+//<-------- OBJ LOADER --------->
+static constexpr std::size_t  OBJ_PARSE_CHUNK_SIZE    = 4U << 20U; // in bytes, part of a file parsed by one job
+static constexpr unsigned int MAX_CONCURRENT_IMPORTS  = 4;         // files imported at once, the others wait their turn
+static constexpr int          IMPORT_POLL_INTERVAL    = 50;        // in ms, hand imported meshes over to the GUI thread
+static constexpr int          IMPORT_MESSAGE_DURATION = 3000;      // in ms, status bar message of a finished import
+
+//<-------- TANGENTS --------->
+static constexpr std::size_t TANGENT_JOB_SIZE         = 1U << 15U; // faces or vertices processed by one job
+static constexpr double      DEGENERATE_UV_DETERMINANT = 1e-20;    // below, a face has no usable uv gradient
+
+//<-------- LEVELS OF DETAIL --------->
+static constexpr std::size_t LOD_MAX_LEVELS      = 5;    // simplified levels built below the full mesh
+static constexpr std::size_t LOD_MIN_FACES       = 256;  // meshes and levels with fewer faces are not simplified
+static constexpr double      LOD_REDUCTION_RATIO = 0.25; // faces kept from one level to the next
+static constexpr double      LOD_MAX_KEPT_RATIO  = 0.75; // a level keeping more faces than this share is dropped
+static constexpr double      LOD_PIXELS_PER_FACE = 4.0;  // screen area per face aimed at by the viewport, in pixels
+static constexpr double      LOD_MAX_ERROR       = 0.01; // level 1 error over the bounds diagonal, doubled per level
+static constexpr double      LOD_WELD_TOLERANCE  = 1e-6; // closer positions, over the bounds diagonal, are welded
+
+//<-------- SUBDIVISION SURFACES --------->
+static constexpr int         SUBDIVISION_MAX_LEVEL      = 6;         // Loop steps, each one splits a face in four
+static constexpr std::size_t SUBDIVISION_MAX_FACES      = 1U << 22U; // faces of a tessellated surface, at most
+static constexpr double      SUBDIVISION_EDGE_PIXELS    = 4.0;       // projected length aimed at for the edges
+static constexpr std::size_t SUBDIVISION_JOB_SIZE       = 1U << 14U; // faces or edges processed by one job
+static constexpr double      SUBDIVISION_WELD_TOLERANCE = 1e-6;      // welding distance, over the bounds diagonal
+
 //<-------- RENDER SETTINGS --------->
 static constexpr int DEFAULT_WIDTH   = 800; // in pixels
 static constexpr int MIN_WIDTH       = 1;
@@ -75,6 +101,36 @@ static constexpr int MAX_SAMPLES_PER_PIXEL     = 20000;
 
 static constexpr int FRAMEBUFFER_CHANNEL_COUNT = 3; // RGB
 
+static constexpr int DEFAULT_MAX_PATH_DEPTH = 64; // in bounces
+static constexpr int MIN_MAX_PATH_DEPTH     = 1;
+static constexpr int MAX_MAX_PATH_DEPTH     = 1024;
+
+static constexpr int DEFAULT_MAX_BOUNCES = 32; // per bounce type
+static constexpr int MIN_MAX_BOUNCES     = 0;
+static constexpr int MAX_MAX_BOUNCES     = 1024;
+
+static constexpr int DEFAULT_ROULETTE_START_DEPTH = 3; // in bounces
+static constexpr int MIN_ROULETTE_START_DEPTH     = 0;
+static constexpr int MAX_ROULETTE_START_DEPTH     = 1024;
+
+static constexpr double DEFAULT_INDIRECT_CLAMP = 0.0; // 0 disables the clamp
+static constexpr double MIN_INDIRECT_CLAMP     = 0.0;
+static constexpr double MAX_INDIRECT_CLAMP     = 1000.0;
+
+static constexpr double DEFAULT_REGULARIZATION_ROUGHNESS   = 0.3;
+static constexpr double MIN_REGULARIZATION_ROUGHNESS       = 0.0;
+static constexpr double MAX_REGULARIZATION_ROUGHNESS       = 1.0;
+static constexpr double REGULARIZATION_ROUGHNESS_THRESHOLD = 0.1; // vertices at least this rough start regularizing
+
+static constexpr double DEFAULT_LOD_DISTANCE = 0.0; // 0 keeps the full meshes for every ray
+static constexpr double MIN_LOD_DISTANCE     = 0.0;
+static constexpr double MAX_LOD_DISTANCE     = 1e6;
+
+static constexpr int MAX_NESTED_DIELECTRICS = 8; // dielectric media a path can be inside at once
+
+static constexpr int GGX_LUT_RESOLUTION   = 32;   // entries per axis of the GGX albedo table (cos_theta, roughness)
+static constexpr int GGX_LUT_SAMPLE_COUNT = 1024; // half vectors integrated per entry of the table
+
 //<-------- RENDER EXPORTER --------->
 static constexpr std::string_view DEFAULT_FILE_PATH    = "RenderImages/";
 static constexpr std::string_view DEFAULT_FILE_NAME    = "output";
@@ -95,6 +151,12 @@ static constexpr double DEFAULT_TEXTURE_UNDEFINED_R = 1.0;
 static constexpr double DEFAULT_TEXTURE_UNDEFINED_G = 0.0;
 static constexpr double DEFAULT_TEXTURE_UNDEFINED_B = 1.0;
 static constexpr int    MAX_PREVIEW_TEXTURE_SIZE    = 256;
+static constexpr double MIN_RAY_CONE_COSINE         = 0.01; // caps the footprint growth at grazing angles
+
+static constexpr int    TEXTURE_FILE_TILE_SIZE     = 64; // side of the tiles of .ltex files, in texels
+static constexpr int    TEXTURE_CACHE_SHARD_COUNT  = 16; // independent locks of the tile cache
+static constexpr size_t DEFAULT_TEXTURE_CACHE_SIZE = size_t{512} << 20; // 512 MiB of resident tiles
+static constexpr int    TEXTURE_LOAD_POLL_INTERVAL = 50; // in ms, hand decoded textures over to the GUI thread
 
 //<-------- MATERIAL --------->
 static constexpr double MAX_EMISSIVE_STRENGTH   = 1000.0;
@@ -166,17 +228,11 @@ static constexpr unsigned int FULL_STENCIL_MASK            = 0xFF;
 static constexpr unsigned int NO_STENCIL_MASK              = 0x00;
 
 //<-------- VERTEX --------->
-static constexpr size_t POSITION_LOCATION  = 0;
-static constexpr size_t NORMAL_LOCATION    = 1;
-static constexpr size_t UV_LOCATION        = 2;
-static constexpr size_t TANGENT_LOCATION   = 3;
-static constexpr size_t BITANGENT_LOCATION = 4;
-static constexpr size_t POSITION_OFFSET    = 0;
-static constexpr size_t NORMAL_OFFSET      = 3 * sizeof(float);
-static constexpr size_t UV_OFFSET          = 6 * sizeof(float);
-static constexpr size_t TANGENT_OFFSET     = 8 * sizeof(float);
-static constexpr size_t BITANGENT_OFFSET   = 11 * sizeof(float);
-static constexpr size_t VERTEX_SIZE        = 14 * sizeof(float);
+static constexpr size_t POSITION_LOCATION       = 0;
+static constexpr size_t NORMAL_LOCATION         = 1;
+static constexpr size_t UV_LOCATION             = 2;
+static constexpr size_t TANGENT_LOCATION        = 3;
+static constexpr size_t BITANGENT_SIGN_LOCATION = 4;
 
 //<-------- SHADOW MAP --------->
 static constexpr int DEFAULT_SHADOW_MAP_SIZE = 2048; // in pixels
@@ -0,0 +1,62 @@
+/**
+ * @file MappedFile.hpp
+ * @brief Header file for the MappedFile class, a read-only memory mapping of a whole file.
+ */
+#ifndef CORE_MAPPEDFILE_HPP
+#define CORE_MAPPEDFILE_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/**
+ * @class MappedFile
+ * @brief Maps a file read-only in the address space of the process, unmapped on destruction.
+ *
+ * The pages are loaded by the system on first access, so that large files are read without an intermediate copy and
+ * can be scanned from several threads at once.
+ */
+class MappedFile {
+private:
+  const char* m_data = nullptr;
+  std::size_t m_size = 0;
+  bool        m_open = false;
+
+#ifdef _WIN32
+  void* m_file    = nullptr;
+  void* m_mapping = nullptr;
+#endif
+
+  void close();
+
+public:
+  /**
+   * @brief Maps the file.
+   * @param path The path of the file to map.
+   */
+  explicit MappedFile(const std::string& path);
+
+  MappedFile(const MappedFile&)            = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  MappedFile(MappedFile&&)                 = delete;
+  MappedFile& operator=(MappedFile&&)      = delete;
+
+  /**
+   * @brief Checks whether the file could be opened. An empty file is open but has no content.
+   * @return True if the file was opened.
+   */
+  bool isOpen() const { return m_open; }
+
+  /**
+   * @brief Gets the content of the file.
+   * @return A view of the mapped bytes, valid while this object lives.
+   */
+  std::string_view getContent() const { return {m_data, m_size}; }
+
+  /**
+   * @brief Unmaps the file.
+   */
+  ~MappedFile();
+};
+
+#endif // CORE_MAPPEDFILE_HPP
@@ -7,6 +7,22 @@
 
 #include <linalg/Vec3.hpp>
 
+/**
+ * @struct RayCone
+ * @brief Footprint of a ray, approximated by a cone, used to select the mip level of the textures it hits.
+ */
+struct RayCone {
+  double width        = 0.0; ///< Width of the cone at the ray origin.
+  double spread_angle = 0.0; ///< Widening of the cone per unit of distance, in radians.
+
+  /**
+   * @brief Gets the width of the cone at a given distance from the ray origin.
+   * @param distance The distance along the ray.
+   * @return The width of the cone.
+   */
+  double getWidth(double distance) const { return width + (spread_angle * distance); }
+};
+
 /**
  * @struct Ray
  * @brief A structure representing a ray in 3D space.
@@ -17,6 +33,7 @@
 struct Ray {
   linalg::Vec3d origin    = {0, 0, 0};
   linalg::Vec3d direction = {0, 0, -1};
+  RayCone       cone;     ///< Footprint of the ray, zero width and spread for an infinitely thin ray.
 
   /**
    * @brief Constructs a Ray from two points.
@@ -42,4 +59,19 @@ private:
   Ray(const linalg::Vec3d& o, const linalg::Vec3d& d) : origin(o), direction(d) {}
 };
 
+/**
+ * @struct RayF
+ * @brief Single precision copy of a Ray, used by the float intersection kernels.
+ */
+struct RayF {
+  linalg::Vec3f origin    = {0.0F, 0.0F, 0.0F};
+  linalg::Vec3f direction = {0.0F, 0.0F, -1.0F};
+
+  /**
+   * @brief Constructs a single precision ray from a double precision one.
+   * @param ray The double precision ray.
+   */
+  explicit RayF(const Ray& ray) : origin(ray.origin), direction(ray.direction) {}
+};
+
 #endif // CORE_RAY_HPP
@@ -0,0 +1,82 @@
+/**
+ * @file ThreadPool.hpp
+ * @brief Header file for the ThreadPool class, running jobs on a fixed set of worker threads.
+ */
+#ifndef CORE_THREADPOOL_HPP
+#define CORE_THREADPOOL_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @class ThreadPool
+ * @brief Fixed set of worker threads consuming a shared queue of jobs.
+ *
+ * Jobs are run in submission order by the first idle worker. Their result (or exception) is handed back through a
+ * std::future. Destroying the pool runs the jobs still queued before joining the workers, so that no future is left
+ * without a value.
+ */
+class ThreadPool {
+private:
+  std::vector<std::thread>          m_workers;
+  std::deque<std::function<void()>> m_jobs;
+  std::mutex                        m_mutex;
+  std::condition_variable           m_job_available;
+  bool                              m_stopping = false;
+
+  void workerLoop();
+
+public:
+  /**
+   * @brief Starts the worker threads.
+   * @param thread_count The number of workers, one per hardware thread by default (at least one).
+   */
+  explicit ThreadPool(unsigned int thread_count = std::thread::hardware_concurrency());
+
+  ThreadPool(const ThreadPool&)            = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ThreadPool(ThreadPool&&)                 = delete;
+  ThreadPool& operator=(ThreadPool&&)      = delete;
+
+  /**
+   * @brief Queues a job.
+   * @param function The job, callable without arguments.
+   * @return The future receiving the result of the job.
+   */
+  template <typename Function> std::future<std::invoke_result_t<Function>> submit(Function function);
+
+  /**
+   * @brief Gets the number of worker threads.
+   * @return The number of workers.
+   */
+  unsigned int getThreadCount() const { return static_cast<unsigned int>(m_workers.size()); }
+
+  /**
+   * @brief Runs the queued jobs and joins the worker threads.
+   */
+  ~ThreadPool();
+};
+
+template <typename Function> std::future<std::invoke_result_t<Function>> ThreadPool::submit(Function function) {
+  using Result = std::invoke_result_t<Function>;
+
+  // std::function needs a copyable callable, the move-only task is shared with the queued job.
+  auto                task   = std::make_shared<std::packaged_task<Result()>>(std::move(function));
+  std::future<Result> result = task->get_future();
+  {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    m_jobs.emplace_back([task]() { (*task)(); });
+  }
+  m_job_available.notify_one();
+  return result;
+}
+
+#endif // CORE_THREADPOOL_HPP
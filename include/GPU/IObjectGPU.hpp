@@ -9,6 +9,7 @@
 #include <linalg/Mat3.hpp>
 #include <linalg/Mat4.hpp>
 
+#include "Geometry/Mesh.hpp"
 #include "SceneObjects/Object3D.hpp"
 
 /**
@@ -17,27 +18,42 @@
  *
  * This interface provides methods to upload object data to the GPU and release resources.
  * It is designed to be implemented by specific GPU object classes, such as OpenGL, Vulkan or CUDA.
+ * The vertex streams and faces of the mesh are read in place by the implementations, without a staging copy.
  */
 class IObjectGPU {
 private:
   Object3D* m_object = nullptr;
 
-  std::vector<float>        m_vertices;
-  std::vector<unsigned int> m_indices;
-
   linalg::Mat4f m_model_matrix  = linalg::Mat4f::Identity();
   linalg::Mat3f m_normal_matrix = linalg::Mat3f::Identity();
 
-  size_t       m_data_size     = 0;
-  unsigned int m_indices_count = 0;
-  size_t       m_indices_size  = 0;
+  std::size_t m_lod_level = 0;
 
 protected:
-  size_t                    dataSize() const { return m_data_size; }
-  const std::vector<float>& vertices() const { return m_vertices; }
+  /**
+   * @brief Gets the vertex streams of a level of detail of the mesh, uploaded as they are stored.
+   * @param level The level of detail, 0 being the full mesh.
+   * @return A const reference to the vertex streams of the level.
+   */
+  const VertexStreams& vertexStreams(std::size_t level = 0) const {
+    return m_object->getMesh().getLOD(level).getStreams();
+  }
+
+  /**
+   * @brief Tells whether the tangent streams of a level of detail can be uploaded.
+   * @param level The level of detail, 0 being the full mesh.
+   * @return True once the tangents of the level are built, empty tangent streams are uploaded until then.
+   */
+  bool hasTangents(std::size_t level = 0) const { return m_object->getMesh().getLOD(level).hasTangents(); }
+
+  /**
+   * @brief Gets the faces of a level of detail of the mesh, uploaded as an array of unsigned indices.
+   * @param level The level of detail, 0 being the full mesh.
+   * @return A const reference to the faces of the level.
+   */
+  const std::vector<Face>& faces(std::size_t level = 0) const { return m_object->getMesh().getLOD(level).getFaces(); }
 
-  size_t                           indicesSize() const { return m_indices_size; }
-  const std::vector<unsigned int>& indices() const { return m_indices; }
+  size_t indicesSize(std::size_t level = 0) const { return faces(level).size() * 3 * sizeof(unsigned int); }
 
 public:
   /**
@@ -58,10 +74,30 @@ public:
   Object3D* getSource() const { return m_object; }
 
   /**
-   * @brief Gets the number of indices in the index buffer.
+   * @brief Gets the number of indices in the index buffer of the selected level of detail.
    * @return The number of indices.
    */
-  unsigned int getIndexCount() const { return m_indices_count; }
+  unsigned int getIndexCount() const { return static_cast<unsigned int>(faces(m_lod_level).size() * 3); }
+
+  /**
+   * @brief Gets the number of levels of detail of the mesh, the full mesh included.
+   * @return The number of levels of detail.
+   */
+  std::size_t getLevelCount() const { return m_object->getMesh().getLODCount(); }
+
+  /**
+   * @brief Gets the level of detail drawn.
+   * @return The level of detail, 0 being the full mesh.
+   */
+  std::size_t getLevelOfDetail() const { return m_lod_level; }
+
+  /**
+   * @brief Selects the level of detail drawn from the size of the object on screen.
+   * @param screen_radius The radius of the projection of the bounds of the object, in pixels.
+   */
+  void selectLevelOfDetail(double screen_radius) {
+    m_lod_level = m_object->getMesh().selectLODForScreenRadius(screen_radius);
+  }
 
   /**
    * @brief Gets the model matrix of the object.
@@ -56,6 +56,8 @@ private:
   int m_viewport_width;
   int m_viewport_height;
 
+  double m_pixels_per_unit = 1.0; ///< Size in pixels of a unit length seen at a unit distance.
+
   void updateAxisVectors();
 
 public:
@@ -126,6 +128,14 @@ public:
   void rotate(float delta_yaw, float delta_pitch);
 
   Ray getRayFromMousePosition(int mouse_x, int mouse_y) const;
+
+  /**
+   * @brief Estimates the size on screen of a sphere.
+   * @param center The center of the sphere, in world space.
+   * @param radius The radius of the sphere.
+   * @return The radius of the projection of the sphere, in pixels.
+   */
+  double getScreenRadius(const linalg::Vec3d& center, double radius) const;
 };
 
 // GCOVR_EXCL_STOP
@@ -76,6 +76,7 @@ private:
   void configureShadersAndUniforms();
   void blitSceneToResolveFramebuffer();
 
+  void selectLevelsOfDetail();
   void renderScenePass();
   void drawOutline();
   void drawSkybox();
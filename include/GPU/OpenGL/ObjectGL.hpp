@@ -8,7 +8,10 @@
 
 // GCOVR_EXCL_START
 
+#include <algorithm>
+#include <cstddef>
 #include <qopenglfunctions_3_3_core.h>
+#include <vector>
 
 #include "GPU/IObjectGPU.hpp"
 #include "GPU/OpenGL/MaterialGL.hpp"
@@ -19,20 +22,28 @@
  * @brief Represents a 3D object in OpenGL, encapsulating its vertex data and material.
  *
  * This class manages the OpenGL Vertex Array Object (VAO), Vertex Buffer Object (VBO),
- * and Element Buffer Object (EBO) for rendering a 3D object. It also handles the binding
- * of the material textures to the appropriate texture units.
+ * and Element Buffer Object (EBO) for rendering a 3D object, one set per level of detail of its mesh.
+ * It also handles the binding of the material textures to the appropriate texture units.
  */
 class ObjectGL : public IObjectGPU, protected QOpenGLFunctions_3_3_Core {
 private:
-  unsigned int m_vao = 0;
-  unsigned int m_vbo = 0;
-  unsigned int m_ebo = 0;
+  /**
+   * @struct LevelBuffers
+   * @brief OpenGL buffers of one level of detail.
+   */
+  struct LevelBuffers {
+    unsigned int vao = 0;
+    unsigned int vbo = 0;
+    unsigned int ebo = 0;
+  };
+
+  std::vector<LevelBuffers> m_levels;
 
   MaterialGL* m_material;
 
-  void uploadVertices();
-  void uploadIndices();
-  void setupVertexAttributes();
+  void uploadVertices(std::size_t level, bool with_tangents);
+  void uploadIndices(std::size_t level);
+  void setupVertexAttributes(std::size_t level, bool with_tangents);
 
   bool m_is_selected = false;
 
@@ -61,10 +72,20 @@ public:
   void uploadToGPU() override;
 
   /**
-   * @brief Gets the Vertex Array Object ID.
-   * @return The Vertex Array Object ID.
+   * @brief Builds and uploads the tangents of the mesh when the material of the object starts using a normal map.
+   *
+   * Meshes are uploaded without tangents as long as no normal map needs them, the shader then builds a frame around
+   * the normal.
+   */
+  void updateTangents();
+
+  /**
+   * @brief Gets the Vertex Array Object ID of the selected level of detail.
+   * @return The Vertex Array Object ID, 0 before the upload.
    */
-  unsigned int getVAO() const { return m_vao; }
+  unsigned int getVAO() const {
+    return m_levels.empty() ? 0U : m_levels[std::min(getLevelOfDetail(), m_levels.size() - 1)].vao;
+  }
 
   /**
    * @brief Sets the selection state of the object.
@@ -79,7 +100,7 @@ public:
   bool isSelected() const { return m_is_selected; }
 
   /**
-   * @brief Binds the Vertex Array Object for rendering.
+   * @brief Binds the Vertex Array Object of the selected level of detail for rendering.
    */
   void bindVAO();
 
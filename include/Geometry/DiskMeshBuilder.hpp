@@ -0,0 +1,45 @@
+/**
+ * @file DiskMeshBuilder.hpp
+ * @brief Header file for the DiskMeshBuilder class.
+ */
+#ifndef GEOMETRY_DISKMESHBUILDER_HPP
+#define GEOMETRY_DISKMESHBUILDER_HPP
+
+#include "Geometry/MeshBuilder.hpp"
+
+class Mesh;
+
+/**
+ * @class DiskMeshBuilder
+ * @brief A class for building a disk mesh.
+ *
+ * This class is responsible for creating a disk mesh in the XZ plane, facing +Y, with the specified radius and number
+ * of segments. The disk is a fan of triangles around its center.
+ */
+class DiskMeshBuilder : public MeshBuilder {
+private:
+  double m_radius;
+  int    m_segments;
+
+public:
+  /**
+   * @brief Constructs a DiskMeshBuilder with the specified radius and segments.
+   * @param radius The radius of the disk.
+   * @param segments The number of segments around the disk, at least 3.
+   */
+  explicit DiskMeshBuilder(double radius, int segments);
+
+  /**
+   * @brief Builds a disk mesh with the specified parameters.
+   * @return A Mesh object representing the disk.
+   */
+  Mesh build() const override;
+
+  /**
+   * @brief Gets the analytic disk tessellated by the built mesh.
+   * @return The disk primitive with the radius of the disk.
+   */
+  Primitive getPrimitive() const override { return Primitive::Disk(m_radius); }
+};
+
+#endif // GEOMETRY_DISKMESHBUILDER_HPP
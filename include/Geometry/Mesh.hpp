@@ -1,23 +1,30 @@
 /**
  * @file Mesh.hpp
- * @brief Header file for the Mesh class, the Vertex and Face structures.
+ * @brief Header file for the Mesh class, the Vertex, VertexStreams and Face structures.
  */
 #ifndef GEOMETRY_MESH_HPP
 #define GEOMETRY_MESH_HPP
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <linalg/Vec3.hpp>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include "Core/ImageTypes.hpp"
+#include "Geometry/VertexEncoding.hpp"
 
 class BVHNode;
 
 /**
  * @struct Vertex
- * @brief Structure representing a vertex in a 3D mesh.
+ * @brief Structure representing a vertex in a 3D mesh, in double precision.
+ *
+ * Used to build meshes and to read their vertices back. A Mesh stores its vertices encoded in VertexStreams.
  */
 struct Vertex {
   linalg::Vec3d position  = {0.0, 0.0, 0.0}; ///< Position of the vertex in 3D space.
@@ -63,28 +70,137 @@ struct Face {
   }
 };
 
+/**
+ * @struct VertexStreams
+ * @brief Vertex attributes of a mesh, one array per attribute in their compact encoding.
+ *
+ * Each stream is tightly packed, so that the intersection kernels only touch the positions and the streams can be
+ * uploaded to the GPU as they are. The bitangent is not stored: it is the cross product of the normal and the tangent,
+ * oriented by its sign. The tangents and bitangent signs are empty until Mesh::buildTangents() is called, and are only
+ * read once Mesh::hasTangents() tells they are built: another thread may be building them.
+ */
+struct VertexStreams {
+  std::vector<linalg::Vec3f>   positions;
+  std::vector<PackedDirection> normals;
+  std::vector<PackedDirection> tangents;
+  std::vector<PackedUV>        uvs;
+  std::vector<std::int8_t>     bitangent_signs; ///< 1 or -1.
+
+  /**
+   * @brief Gets the number of vertices.
+   * @return The number of vertices.
+   */
+  std::size_t size() const { return positions.size(); }
+
+  /**
+   * @brief Reserves the memory of the streams filled by pushBack().
+   * @param vertex_count The number of vertices.
+   */
+  void reserve(std::size_t vertex_count);
+
+  /**
+   * @brief Encodes the position, normal and texture coordinates of a vertex at the end of the streams.
+   * @param vertex The vertex, whose tangent and bitangent are ignored.
+   */
+  void pushBack(const Vertex& vertex);
+};
+
 /**
  * @class Mesh
  * @brief Class representing a 3D mesh, containing vertices and faces.
+ *
+ * The geometry does not change once the mesh is built. The BVH, tangents and levels of detail are computed on demand
+ * by const methods synchronized internally, so that a mesh shared between threads is only ever used as const.
  */
 class Mesh {
 private:
-  std::vector<Vertex> m_vertices;
-  std::vector<Face>   m_faces;
+  /**
+   * @struct BuildState
+   * @brief Serializes the builds of the data computed on demand, and publishes each one once it is complete.
+   *
+   * A flag is set, with release semantics, after the data it guards is written: a thread reading it set reads the data
+   * without locking. A copy gets the flags of its source and a mutex of its own.
+   */
+  struct BuildState {
+    std::mutex        mutex;
+    std::atomic<bool> bvh_built{false};
+    std::atomic<bool> tangents_built{false};
+    std::atomic<bool> lods_built{false};
+
+    BuildState() = default;
+    BuildState(const BuildState& other) noexcept
+        : bvh_built(other.bvh_built.load()), tangents_built(other.tangents_built.load()),
+          lods_built(other.lods_built.load()) {}
+    BuildState& operator=(const BuildState& other) noexcept {
+      bvh_built.store(other.bvh_built.load());
+      tangents_built.store(other.tangents_built.load());
+      lods_built.store(other.lods_built.load());
+      return *this;
+    }
+    ~BuildState() = default;
+  };
+
+  mutable VertexStreams m_streams; ///< Only its tangent streams are written after construction, by buildTangents().
+  std::vector<Face>     m_faces;
 
-  std::shared_ptr<BVHNode> m_bvh_root;
+  linalg::Vec3d m_min_bound = {0.0, 0.0, 0.0};
+  linalg::Vec3d m_max_bound = {0.0, 0.0, 0.0};
 
-  void computeTangentsAndBitangents();
+  mutable std::shared_ptr<BVHNode>           m_bvh_root;
+  mutable std::vector<std::shared_ptr<Mesh>> m_lods;
+
+  mutable BuildState m_build_state;
+
+  void computeBounds();
+
+  /**
+   * @brief Builds the BVH over the faces of the mesh.
+   * @return The root node of the BVH.
+   */
+  std::shared_ptr<BVHNode> buildBVHRoot() const;
+
+  /**
+   * @brief Retrieves the levels of detail once they are published.
+   * @return The simplified levels, empty until buildLODs() completes.
+   */
+  const std::vector<std::shared_ptr<Mesh>>& publishedLODs() const {
+    static const std::vector<std::shared_ptr<Mesh>> none;
+    return m_build_state.lods_built.load(std::memory_order_acquire) ? m_lods : none;
+  }
 
 public:
   Mesh() = default; ///< Default constructor.
 
   /**
    * @brief Constructor to initialize a Mesh with a set of vertices and faces.
+   *
+   * The vertices are encoded in streams, without tangents: see buildTangents().
+   * Both vectors are taken by value: pass them with std::move to build the mesh without copying them.
    * @param vertices A vector containing the vertices of the mesh.
-   * @param faces A vector containing the faces of the mesh.
+   * @param faces A vector containing the faces of the mesh, faces indexing missing vertices are dropped.
    */
-  Mesh(const std::vector<Vertex>& vertices, const std::vector<Face>& faces);
+  Mesh(std::vector<Vertex> vertices, std::vector<Face> faces);
+
+  /**
+   * @brief Creates a mesh from data computed beforehand, such as a mesh cache file.
+   *
+   * The faces are not validated and the streams and BVH are taken as they are instead of being computed.
+   * @param streams The encoded vertices of the mesh, with or without their tangents.
+   * @param faces The faces of the mesh, indexing existing vertices.
+   * @param bvh_root The BVH over the faces, nullptr if the mesh is too small to have one.
+   * @return The mesh.
+   */
+  static Mesh FromPrecomputed(VertexStreams streams, std::vector<Face> faces, std::shared_ptr<BVHNode> bvh_root);
+
+  /**
+   * @brief Creates a mesh from encoded vertices, such as a simplified mesh.
+   *
+   * The faces are not validated, the BVH is built on demand as for any mesh.
+   * @param streams The encoded vertices of the mesh, with or without their tangents.
+   * @param faces The faces of the mesh, indexing existing vertices.
+   * @return The mesh.
+   */
+  static Mesh FromStreams(VertexStreams streams, std::vector<Face> faces);
 
   Mesh(const Mesh&)            = default; ///< Default copy constructor.
   Mesh& operator=(const Mesh&) = default; ///< Default copy assignment operator.
@@ -92,17 +208,73 @@ public:
   Mesh& operator=(Mesh&&)      = default; ///< Default move assignment operator.
 
   /**
-   * @brief Retrieves the list of vertices in the mesh.
-   * @return A const reference to the list of vertices.
+   * @brief Retrieves the number of vertices in the mesh.
+   * @return The number of vertices.
    */
-  const std::vector<Vertex>& getVertices() const { return m_vertices; }
+  std::size_t getVertexCount() const { return m_streams.size(); }
 
   /**
-   * @brief Retrieves a specific vertex by index.
+   * @brief Retrieves the encoded vertex attributes, as used for rendering and GPU upload.
+   * @return A const reference to the vertex streams.
+   */
+  const VertexStreams& getStreams() const { return m_streams; }
+
+  /**
+   * @brief Decodes every vertex of the mesh.
+   * @return A copy of the vertices in double precision.
+   */
+  std::vector<Vertex> getVertices() const;
+
+  /**
+   * @brief Decodes a specific vertex by index.
+   *
+   * Until the tangents are built, the tangent is any direction orthogonal to the normal.
    * @param index The index of the vertex.
-   * @return A const reference to the vertex at the given index.
+   * @return The vertex at the given index, in double precision.
    */
-  const Vertex& getVertex(int index) const { return m_vertices[index]; }
+  Vertex getVertex(int index) const;
+
+  /**
+   * @brief Retrieves the single precision position of a vertex, as used for ray intersection.
+   * @param index The index of the vertex.
+   * @return A const reference to the position of the vertex at the given index.
+   */
+  const linalg::Vec3f& getVertexPosition(int index) const { return m_streams.positions[index]; }
+
+  /**
+   * @brief Decodes the normal of a vertex.
+   * @param index The index of the vertex.
+   * @return The normalized normal of the vertex.
+   */
+  linalg::Vec3d getVertexNormal(int index) const { return VertexEncoding::decodeDirection(m_streams.normals[index]); }
+
+  /**
+   * @brief Decodes the tangent of a vertex, once the tangents are built.
+   * @param index The index of the vertex.
+   * @return The normalized tangent of the vertex.
+   */
+  linalg::Vec3d getVertexTangent(int index) const {
+    return VertexEncoding::decodeDirection(m_streams.tangents[index]);
+  }
+
+  /**
+   * @brief Retrieves the texture coordinates of a vertex.
+   * @param index The index of the vertex.
+   * @return The texture coordinates of the vertex.
+   */
+  TextureUV getVertexUV(int index) const { return {m_streams.uvs[index].u, m_streams.uvs[index].v}; }
+
+  /**
+   * @brief Retrieves the minimum corner of the bounding box of the vertices, in object space.
+   * @return The minimum corner, zero for an empty mesh.
+   */
+  const linalg::Vec3d& getMinBound() const { return m_min_bound; }
+
+  /**
+   * @brief Retrieves the maximum corner of the bounding box of the vertices, in object space.
+   * @return The maximum corner, zero for an empty mesh.
+   */
+  const linalg::Vec3d& getMaxBound() const { return m_max_bound; }
 
   /**
    * @brief Retrieves the list of faces in the mesh.
@@ -111,22 +283,86 @@ public:
   const std::vector<Face>& getFaces() const { return m_faces; }
 
   /**
-   * @brief Equality operator for comparing two meshes.
+   * @brief Equality operator for comparing two meshes, on the positions, normals and texture coordinates.
    * @param other The mesh to compare with.
    * @return True if the meshes are equal, false otherwise.
    */
-  bool operator==(const Mesh& other) const { return m_vertices == other.m_vertices && m_faces == other.m_faces; }
+  bool operator==(const Mesh& other) const {
+    return m_streams.positions == other.m_streams.positions && m_streams.normals == other.m_streams.normals &&
+           m_streams.uvs == other.m_streams.uvs && m_faces == other.m_faces;
+  }
+
+  /**
+   * @brief Builds the bounding volume hierarchy (BVH) for the mesh, once: the geometry does not change afterwards.
+   *
+   * Threads building it at the same time wait for the first one, the BVH is published once complete.
+   */
+  void buildBVH() const;
+
+  /**
+   * @brief Tells whether the tangents of the vertices are built.
+   * @return True once the tangent and bitangent sign streams are filled, and can be read from any thread.
+   */
+  bool hasTangents() const { return m_build_state.tangents_built.load(std::memory_order_acquire); }
 
   /**
-   * @brief Builds the bounding volume hierarchy (BVH) for the mesh.
+   * @brief Builds the tangents from the texture coordinates, once.
+   *
+   * Only normal mapping needs them, so they are built on demand rather than with the mesh. Threads building them at the
+   * same time wait for the first one, the tangents are published once complete.
    */
-  void buildBVH();
+  void buildTangents() const;
+
+  /**
+   * @brief Builds the simplified levels of detail of the mesh, once, with MeshSimplifier::buildLevels().
+   *
+   * The levels get their BVH and tangents whenever the mesh gets its own. They are published together once complete,
+   * the mesh has a single level until then.
+   */
+  void buildLODs() const;
+
+  /**
+   * @brief Retrieves the number of levels of detail, the mesh itself included.
+   * @return 1 until buildLODs() is called, or for meshes too small to simplify.
+   */
+  std::size_t getLODCount() const { return publishedLODs().size() + 1; }
+
+  /**
+   * @brief Retrieves a level of detail.
+   * @param level The level, 0 being the mesh itself; levels past the coarsest give the coarsest.
+   * @return A const reference to the mesh of the level.
+   */
+  const Mesh& getLOD(std::size_t level) const {
+    const std::vector<std::shared_ptr<Mesh>>& lods = publishedLODs();
+    return level == 0 || lods.empty() ? *this : *lods[std::min(level, lods.size()) - 1];
+  }
+
+  /**
+   * @brief Selects the level of detail for a mesh drawn over a disk of a given radius on screen.
+   *
+   * The finest level is chosen whose faces cover at least LOD_PIXELS_PER_FACE pixels on average.
+   * @param screen_radius The radius of the projection of the mesh, in pixels.
+   * @return The level of detail.
+   */
+  std::size_t selectLODForScreenRadius(double screen_radius) const;
+
+  /**
+   * @brief Selects the level of detail for a mesh seen from a distance.
+   *
+   * The full mesh is kept up to the LOD distance, and every doubling of the distance goes one level coarser.
+   * @param distance The distance to the mesh.
+   * @param lod_distance The distance at which the first simplified level starts, 0 to always keep the full mesh.
+   * @return The level of detail.
+   */
+  std::size_t selectLODForDistance(double distance, double lod_distance) const;
 
   /**
    * @brief Retrieves the bounding volume hierarchy (BVH) root node of the mesh.
-   * @return A shared pointer to the BVH root node.
+   * @return A pointer to the BVH root node, nullptr until the BVH is built or for meshes too small to have one.
    */
-  const BVHNode* getBVHRoot() const { return m_bvh_root.get(); }
+  const BVHNode* getBVHRoot() const {
+    return m_build_state.bvh_built.load(std::memory_order_acquire) ? m_bvh_root.get() : nullptr;
+  }
 
   ~Mesh() = default; ///< Default destructor.
 };
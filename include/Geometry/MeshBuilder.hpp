@@ -5,6 +5,8 @@
 #ifndef GEOMETRY_MESHBUILDER_HPP
 #define GEOMETRY_MESHBUILDER_HPP
 
+#include "Geometry/Primitive.hpp"
+
 class Mesh;
 
 /**
@@ -30,6 +32,12 @@ public:
    */
   virtual Mesh build() const = 0;
 
+  /**
+   * @brief Gets the analytic shape tessellated by the built mesh, which the ray tracer can intersect in closed form.
+   * @return The primitive, of type MESH when the shape is not analytic.
+   */
+  virtual Primitive getPrimitive() const { return {}; }
+
   virtual ~MeshBuilder() = default; ///< Default destructor.
 };
 
@@ -0,0 +1,58 @@
+/**
+ * @file MeshCache.hpp
+ * @brief Header file for the MeshCache namespace, reading and writing the binary .lmesh mesh cache format.
+ */
+#ifndef GEOMETRY_MESHCACHE_HPP
+#define GEOMETRY_MESHCACHE_HPP
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "Geometry/Mesh.hpp"
+
+/**
+ * @namespace MeshCache
+ * @brief Namespace for the .lmesh files caching the result of a mesh import.
+ *
+ * An .lmesh file holds a small header followed by the vertex streams (with the tangents once built), the faces and
+ * the flattened BVH of a mesh, each section being a raw copy of the arrays in memory. Loading it is a memory mapping
+ * and a few copies, with no parsing and no BVH construction. The header records the hash of the source
+ * file the mesh was imported from, the cache is ignored once the source changes. Values are written in the byte order
+ * and layout of the host: a cache written by another build is rejected through its version and element sizes.
+ */
+namespace MeshCache {
+/**
+ * @brief Gets the path of the cache of a source file, next to it.
+ * @param source_path The path of the imported file.
+ * @return The path with its extension replaced by .lmesh.
+ */
+std::string getCachePath(const std::string& source_path);
+
+/**
+ * @brief Hashes the content of a source file, to detect when its cache is stale.
+ * @param content The content of the source file.
+ * @return The 64-bit hash of the content.
+ */
+std::uint64_t hashSource(std::string_view content);
+
+/**
+ * @brief Writes a mesh and its BVH, built if needed, to a cache file.
+ * @param path The path of the .lmesh file to write.
+ * @param mesh The mesh to store.
+ * @param source_hash The hash of the source file the mesh was imported from.
+ * @return True if the file was written.
+ */
+bool write(const std::string& path, Mesh& mesh, std::uint64_t source_hash);
+
+/**
+ * @brief Reads a mesh from a cache file.
+ * @param path The path of the .lmesh file to read.
+ * @param source_hash The hash of the current source file.
+ * @return The mesh with its BVH, or nothing if the file is missing, invalid or was written for another source.
+ */
+std::optional<Mesh> read(const std::string& path, std::uint64_t source_hash);
+} // namespace MeshCache
+
+#endif // GEOMETRY_MESHCACHE_HPP
@@ -0,0 +1,52 @@
+/**
+ * @file MeshSimplifier.hpp
+ * @brief Header file for the MeshSimplifier namespace, decimating meshes into levels of detail.
+ */
+#ifndef GEOMETRY_MESHSIMPLIFIER_HPP
+#define GEOMETRY_MESHSIMPLIFIER_HPP
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <vector>
+
+class Mesh;
+
+/**
+ * @namespace MeshSimplifier
+ * @brief Namespace for the simplification of meshes with quadric error metrics (Garland and Heckbert, "Surface
+ * Simplification Using Quadric Error Metrics").
+ *
+ * Edges are collapsed onto one of their vertices in the order of the squared distance of that vertex to the planes of
+ * the faces merged into it. Collapsing onto an existing vertex keeps its attributes as they are: a simplified mesh is
+ * a subset of the vertices of the input, with fewer and larger faces. Vertices on texture seams and open borders only
+ * slide along them and vertices on non-manifold edges stay in place, so that the simplified mesh has neither holes
+ * nor cracks.
+ */
+namespace MeshSimplifier {
+/**
+ * @brief Simplifies a mesh down to a number of faces.
+ *
+ * Collapses that would flip a face, make the surface non-manifold or move it further than the error bound are
+ * skipped, the result can therefore keep more faces than requested. Degenerate faces are dropped.
+ * @param mesh The mesh to simplify.
+ * @param target_face_count The number of faces to reach.
+ * @param max_error The largest distance of a kept vertex to the planes of the faces merged into it, in object space.
+ * @return The simplified mesh, with the tangents of the input mesh when they are built.
+ */
+Mesh simplify(const Mesh& mesh, std::size_t target_face_count,
+              double max_error = std::numeric_limits<double>::infinity());
+
+/**
+ * @brief Builds the chain of levels of detail of a mesh.
+ *
+ * Each level keeps LOD_REDUCTION_RATIO of the faces of the previous one, within an error bound of LOD_MAX_ERROR times
+ * the bounds diagonal for the first level, doubled at each level. Levels are built until LOD_MAX_LEVELS levels exist,
+ * a level has at most LOD_MIN_FACES faces, or the simplification stops making progress.
+ * @param mesh The full resolution mesh.
+ * @return The levels from the finest to the coarsest, without the mesh itself. Empty for small meshes.
+ */
+std::vector<std::shared_ptr<Mesh>> buildLevels(const Mesh& mesh);
+} // namespace MeshSimplifier
+
+#endif // GEOMETRY_MESHSIMPLIFIER_HPP
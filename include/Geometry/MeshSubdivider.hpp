@@ -0,0 +1,45 @@
+/**
+ * @file MeshSubdivider.hpp
+ * @brief Header file for the MeshSubdivider namespace, tessellating subdivision surfaces from their control cage.
+ */
+#ifndef GEOMETRY_MESHSUBDIVIDER_HPP
+#define GEOMETRY_MESHSUBDIVIDER_HPP
+
+class Mesh;
+
+/**
+ * @namespace MeshSubdivider
+ * @brief Namespace for the Loop subdivision of triangle meshes (Loop, "Smooth Subdivision Surfaces Based on
+ * Triangles").
+ *
+ * Each step splits every face in four and moves the vertices towards the smooth limit surface. The connectivity is
+ * the one of the vertices welded by position, so that texture seams stay closed: the vertices of a seam move together
+ * and keep their own texture coordinates, which are interpolated linearly. Open borders are subdivided as cubic
+ * B-spline curves, and the vertices of corners and non-manifold edges stay in place.
+ *
+ * The subdivided vertices are averages of the vertices of the cage: the surface stays within its bounding box.
+ */
+namespace MeshSubdivider {
+/**
+ * @brief Subdivides a mesh.
+ *
+ * The steps are parallelized over the faces and edges. Faces degenerate once welded are dropped.
+ * @param mesh The control cage.
+ * @param level The number of subdivision steps.
+ * @return The subdivided mesh, with the normals of the subdivided surface. A copy of the cage for level 0.
+ */
+Mesh subdivide(const Mesh& mesh, int level);
+
+/**
+ * @brief Selects the subdivision level bringing the projected length of the edges of a cage down to
+ * SUBDIVISION_EDGE_PIXELS pixels.
+ *
+ * Each step halves the length of the edges and multiplies the number of faces by four.
+ * @param mesh The control cage.
+ * @param pixels_per_unit The length in pixels of one object space unit of the cage, as seen by the camera.
+ * @return The level, at most SUBDIVISION_MAX_LEVEL and without exceeding SUBDIVISION_MAX_FACES faces.
+ */
+int selectLevel(const Mesh& mesh, double pixels_per_unit);
+} // namespace MeshSubdivider
+
+#endif // GEOMETRY_MESHSUBDIVIDER_HPP
@@ -5,21 +5,79 @@
 #ifndef GEOMETRY_OBJLOADER_HPP
 #define GEOMETRY_OBJLOADER_HPP
 
+#include <atomic>
+#include <cstddef>
 #include <string>
+#include <string_view>
+
+#include "Core/Config.hpp"
 
 class Mesh;
 
 /**
  * @namespace OBJLoader
  * @brief Namespace for loading 3D meshes from OBJ files.
+ *
+ * Positions, texture coordinates, normals and faces are read. Faces with more than three corners are triangulated
+ * as fans and negative (relative) indices are resolved. The content is split at line boundaries and the chunks are
+ * parsed in parallel, then merged in file order so that the result does not depend on how the content was split.
  */
 namespace OBJLoader {
+/**
+ * @struct LoadControl
+ * @brief State shared with a load running on another thread: how far it got, and whether it should stop.
+ *
+ * The work of a load is the bytes of the content parsed, then merged into the mesh: the progress reaches 1 once
+ * both are done. A cancelled load stops at the next line it parses or chunk it merges and returns an empty mesh.
+ */
+struct LoadControl {
+  std::atomic<std::size_t> done_work{0};
+  std::atomic<std::size_t> total_work{0};
+  std::atomic<bool>        cancelled{false};
+  unsigned int             thread_count = 0; ///< Threads parsing the chunks, 0 for one per hardware thread.
+
+  /**
+   * @brief Gets the fraction of the load done so far.
+   * @return The progress, between 0 and 1.
+   */
+  double getProgress() const {
+    const std::size_t total = total_work.load(std::memory_order_relaxed);
+    return total == 0 ? 0.0 : static_cast<double>(done_work.load(std::memory_order_relaxed)) / total;
+  }
+
+  /**
+   * @brief Asks the load to stop, from any thread.
+   */
+  void cancel() { cancelled.store(true, std::memory_order_relaxed); }
+
+  /**
+   * @brief Tells whether the load was asked to stop.
+   * @return True once cancel() was called.
+   */
+  bool isCancelled() const { return cancelled.load(std::memory_order_relaxed); }
+};
+
 /**
  * @brief Loads a 3D mesh from an OBJ file.
+ *
+ * With the cache enabled, the mesh is read from the .lmesh file next to the OBJ file when it was written for the
+ * current content of the OBJ file. Otherwise the OBJ file is parsed, and the mesh and its BVH are written to the cache.
  * @param filename The name of the OBJ file to load.
- * @return A Mesh object containing the loaded geometry.
+ * @param use_cache Whether to read and write the .lmesh cache of the file.
+ * @param control The progress and cancellation of the load, nullptr if nobody follows it. A cancelled load does not
+ * write the cache.
+ * @return A Mesh object containing the loaded geometry, empty if the load failed or was cancelled.
+ */
+Mesh load(const std::string& filename, bool use_cache = true, LoadControl* control = nullptr);
+
+/**
+ * @brief Builds a 3D mesh from the content of an OBJ file.
+ * @param content The text of the OBJ file.
+ * @param chunk_size The approximate size in bytes of the parts parsed by each job.
+ * @param control The progress and cancellation of the parse, nullptr if nobody follows it.
+ * @return A Mesh object containing the parsed geometry, empty if the parse was cancelled.
  */
-Mesh load(const std::string& filename);
+Mesh parse(std::string_view content, std::size_t chunk_size = OBJ_PARSE_CHUNK_SIZE, LoadControl* control = nullptr);
 } // namespace OBJLoader
 
-#endif // GEOMETRY_OBJLOADER_HPP
\ No newline at end of file
+#endif // GEOMETRY_OBJLOADER_HPP
@@ -35,6 +35,12 @@ public:
    * @return A Mesh object representing the plane.
    */
   Mesh build() const override;
+
+  /**
+   * @brief Gets the analytic plane tessellated by the built mesh.
+   * @return The quad primitive with the dimensions of the plane.
+   */
+  Primitive getPrimitive() const override { return Primitive::Quad(m_width, m_length); }
 };
 
 #endif // GEOMETRY_PLANEMESHBUILDER_HPP
\ No newline at end of file
@@ -0,0 +1,110 @@
+/**
+ * @file Primitive.hpp
+ * @brief Header file for the Primitive structure, the analytic shapes the ray tracer intersects in closed form.
+ */
+#ifndef GEOMETRY_PRIMITIVE_HPP
+#define GEOMETRY_PRIMITIVE_HPP
+
+#include <cstdint>
+#include <linalg/Vec3.hpp>
+
+#include "Core/MathConstants.hpp"
+
+/**
+ * @enum PrimitiveType
+ * @brief Shape intersected by the ray tracer for an object.
+ */
+enum class PrimitiveType : std::uint8_t {
+  MESH,   ///< The triangles of the mesh.
+  SPHERE, ///< Sphere centered at the origin.
+  QUAD,   ///< Rectangle centered at the origin in the XZ plane, facing +Y.
+  DISK    ///< Disk centered at the origin in the XZ plane, facing +Y.
+};
+
+/**
+ * @struct Primitive
+ * @brief Analytic shape of an object in object space, with the parameterization of the mesh builder of the same
+ * shape, so that the texture coordinates match the tessellated mesh drawn by the viewport.
+ *
+ * - Sphere: u = phi / 2pi and v = theta / pi, with y = radius * cos(theta), x and z along phi = 0 and phi = pi / 2.
+ * - Quad: u = x + width / 2 and v = z + length / 2.
+ * - Disk: u = x + radius and v = z + radius.
+ */
+struct Primitive {
+  PrimitiveType type   = PrimitiveType::MESH;
+  double        radius = 0.0; ///< Radius of the sphere or the disk.
+  double        width  = 0.0; ///< Extent of the quad along X.
+  double        length = 0.0; ///< Extent of the quad along Z.
+
+  /**
+   * @brief Creates a sphere.
+   * @param radius The radius of the sphere.
+   * @return The primitive.
+   */
+  static Primitive Sphere(double radius) { return {PrimitiveType::SPHERE, radius, 0.0, 0.0}; }
+
+  /**
+   * @brief Creates a quad.
+   * @param width The extent of the quad along X.
+   * @param length The extent of the quad along Z.
+   * @return The primitive.
+   */
+  static Primitive Quad(double width, double length) { return {PrimitiveType::QUAD, 0.0, width, length}; }
+
+  /**
+   * @brief Creates a disk.
+   * @param radius The radius of the disk.
+   * @return The primitive.
+   */
+  static Primitive Disk(double radius) { return {PrimitiveType::DISK, radius, 0.0, 0.0}; }
+
+  /**
+   * @brief Tells whether the shape is intersected in closed form rather than through the mesh.
+   * @return True for a sphere, a quad or a disk.
+   */
+  bool isAnalytic() const { return type != PrimitiveType::MESH; }
+
+  /**
+   * @brief Gets the minimum corner of the bounding box of the shape, in object space.
+   * @return The minimum corner, zero for a mesh.
+   */
+  linalg::Vec3d getMinBound() const { return -getMaxBound(); }
+
+  /**
+   * @brief Gets the maximum corner of the bounding box of the shape, in object space.
+   * @return The maximum corner, zero for a mesh.
+   */
+  linalg::Vec3d getMaxBound() const {
+    switch(type) {
+    case PrimitiveType::SPHERE:
+      return {radius, radius, radius};
+    case PrimitiveType::QUAD:
+      return {width * HALF, 0.0, length * HALF};
+    case PrimitiveType::DISK:
+      return {radius, 0.0, radius};
+    default:
+      return {0.0, 0.0, 0.0};
+    }
+  }
+
+  /**
+   * @brief Gets the area covered by the shape in texture space.
+   * @return The texture space area, zero for a mesh.
+   */
+  double getUVArea() const {
+    switch(type) {
+    case PrimitiveType::SPHERE:
+      return 1.0;
+    case PrimitiveType::QUAD:
+      return width * length;
+    case PrimitiveType::DISK:
+      return PI * radius * radius;
+    default:
+      return 0.0;
+    }
+  }
+
+  bool operator==(const Primitive& other) const = default;
+};
+
+#endif // GEOMETRY_PRIMITIVE_HPP
@@ -38,6 +38,12 @@ public:
    * @return A Mesh object representing the sphere.
    */
   Mesh build() const override;
+
+  /**
+   * @brief Gets the analytic sphere tessellated by the built mesh.
+   * @return The sphere primitive with the dimensions of the sphere.
+   */
+  Primitive getPrimitive() const override { return Primitive::Sphere(m_radius); }
 };
 
 #endif // GEOMETRY_SPHEREMESHBUILDER_HPP
@@ -0,0 +1,43 @@
+/**
+ * @file TangentGenerator.hpp
+ * @brief Header file for the TangentGenerator namespace, computing the tangent frames of a mesh.
+ */
+#ifndef GEOMETRY_TANGENTGENERATOR_HPP
+#define GEOMETRY_TANGENTGENERATOR_HPP
+
+#include <linalg/Vec3.hpp>
+#include <vector>
+
+struct Face;
+struct VertexStreams;
+
+/**
+ * @namespace TangentGenerator
+ * @brief Namespace for the generation of per-vertex tangents from the texture coordinates of a mesh.
+ *
+ * The output follows the MikkTSpace convention: a unit tangent orthogonal to the normal and the sign of the bitangent,
+ * which is rebuilt as sign * cross(normal, tangent). The face tangents are computed in parallel, then each vertex
+ * sums the tangents of its faces in face order, so that no two jobs write the same value and the result does not
+ * depend on the number of threads.
+ */
+namespace TangentGenerator {
+/**
+ * @brief Computes the tangents and bitangent signs of a mesh.
+ *
+ * Faces whose texture coordinates are degenerate do not contribute. A vertex left without a tangent gets any
+ * direction orthogonal to its normal.
+ * @param streams The vertex streams, whose tangents and bitangent signs are replaced.
+ * @param faces The faces of the mesh, indexing existing vertices.
+ */
+void generate(VertexStreams& streams, const std::vector<Face>& faces);
+
+/**
+ * @brief Makes a tangent orthogonal to a normal, falling back to any orthogonal direction when it is degenerate.
+ * @param tangent The tangent, zero when there is none.
+ * @param normal The normalized normal.
+ * @return The normalized tangent.
+ */
+linalg::Vec3d orthogonalize(const linalg::Vec3d& tangent, const linalg::Vec3d& normal);
+} // namespace TangentGenerator
+
+#endif // GEOMETRY_TANGENTGENERATOR_HPP
@@ -22,6 +22,7 @@ struct RayEmitterParameters {
   double        focus_distance         = 0.0;
   double        lens_radius            = 0.0;
   double        image_aspect_ratio     = 0.0;
+  double        pixel_width            = 0.0; ///< Width of a pixel in normalized coordinates, 0 for thin rays.
 };
 
 /**
@@ -38,6 +39,7 @@ private:
   linalg::Vec3d m_viewport_top_left_corner;
   linalg::Vec3d m_horizontal_vector;
   linalg::Vec3d m_vertical_vector;
+  double        m_pixel_spread_angle = 0.0;
 
   linalg::Vec3d generateCorner(double x, double y) const;
   linalg::Vec3d getRayOrigin() const;
@@ -59,12 +61,21 @@ public:
 
   /**
    * @brief Generate a ray from the camera based on normalized screen coordinates.
+   *
+   * The ray carries a cone spreading by the angle covered by one pixel, used to filter the textures it hits.
+   *
    * @param u Normalized horizontal coordinate (0 to 1).
    * @param v Normalized vertical coordinate (0 to 1).
    * @return The generated ray.
    */
   Ray generateRay(double u, double v) const;
 
+  /**
+   * @brief Gets the angle covered by one pixel, which is the spread angle of the generated ray cones.
+   * @return The spread angle in radians.
+   */
+  double getPixelSpreadAngle() const { return m_pixel_spread_angle; }
+
   ~CameraRayEmitter() = default; ///< Default destructor.
 };
 
@@ -41,6 +41,22 @@ private:
   void generateChunks(int width, int height);
   void threadWorker(int thread_id, double sample_weight, double cell_size);
 
+protected:
+  /**
+   * @brief Gets the number of threads used for rendering.
+   * @return The number of threads.
+   */
+  unsigned int threadCount() const { return m_thread_count; }
+
+  /**
+   * @brief Renders one sample for every pixel of a chunk.
+   * @param thread_id The index of the worker thread rendering the chunk.
+   * @param chunk The chunk to render.
+   * @param sample_weight The weight of the sample.
+   * @param cell_size The size of the cell in the subpixel grid.
+   */
+  virtual void renderChunk(int thread_id, const Chunk& chunk, double sample_weight, double cell_size);
+
 public:
   /**
    * @brief Default constructor for MultiThreadedCPU.
@@ -35,12 +35,13 @@ inline linalg::Vec3d sampleHalfVectorGgx(double roughness, const linalg::Mat3d&
   const double u1    = randomUniform01();
   const double u2    = randomUniform01();
 
-  const double theta = std::atan(alpha * std::sqrt(u1 / (1.0 - u1)));
-  const double phi   = 2.0 * M_PI * u2;
+  // cos^2(theta) derived from tan(theta) = alpha * sqrt(u1 / (1 - u1)), which avoids the atan/sin/cos round trip.
+  const double cos2_theta = (1.0 - u1) / (1.0 + (alpha * alpha - 1.0) * u1);
+  const double cos_theta  = std::sqrt(cos2_theta);
+  const double sin_theta  = std::sqrt(std::max(0.0, 1.0 - cos2_theta));
+  const double phi        = 2.0 * M_PI * u2;
 
-  const double sin_theta = std::sin(theta);
-
-  const linalg::Vec3d half_vector = {sin_theta * std::cos(phi), sin_theta * std::sin(phi), std::cos(theta)};
+  const linalg::Vec3d half_vector = {sin_theta * std::cos(phi), sin_theta * std::sin(phi), cos_theta};
   return tbn_matrix * half_vector;
 }
 
@@ -59,7 +60,7 @@ inline double pdfLightSample(int num_light, const RayHitInfo& hit, const linalg:
   if(hit.material == nullptr) {
     return 0.0;
   }
-  if(hit.material->getEmissive(hit.bary_coords) * hit.material->getEmissiveIntensity() == ColorRGB(0.0)) {
+  if(hit.material->getRecord().getEmission(hit.bary_coords, 0.0) == ColorRGB(0.0)) {
     return 0.0;
   }
 
@@ -81,6 +82,44 @@ inline std::vector<double> pdfListBrdf(double reflection_probability, double rou
   return pdf_list;
 }
 
+/**
+ * @brief Computes the densities of the lobes of the full BSDF for a direction, weighted by their probabilities.
+ *
+ * The opaque lobes only cover the upper hemisphere, the dielectric lobe both sides of the surface.
+ */
+inline std::vector<double> pdfListBsdf(const PBR::BRDFInput& input, const linalg::Vec3d& outgoing_direction) {
+  if(input.transmission <= 0.0) {
+    return pdfListBrdf(input.specular_ratio, input.roughness, input.incoming_dir, input.normal, outgoing_direction);
+  }
+
+  std::vector<double> pdf_list;
+  if(linalg::dot(input.normal, outgoing_direction) > 0.0) {
+    pdf_list = pdfListBrdf(input.specular_ratio, input.roughness, input.incoming_dir, input.normal, outgoing_direction);
+    for(double& pdf : pdf_list) {
+      pdf *= 1.0 - input.transmission;
+    }
+  }
+  pdf_list.push_back(input.transmission * PBR::pdfDielectric(input, outgoing_direction));
+  return pdf_list;
+}
+
+/**
+ * @brief Computes the sum of the densities of pdfListBsdf, without building the list.
+ */
+inline double pdfSumBsdf(const PBR::BRDFInput& input, const linalg::Vec3d& outgoing_direction) {
+  double opaque_sum = 0.0;
+  if(input.transmission <= 0.0 || linalg::dot(input.normal, outgoing_direction) > 0.0) {
+    const linalg::Vec3d half_vector = (input.incoming_dir + outgoing_direction).normalized();
+    opaque_sum = pdfCosineHemisphere(1 - input.specular_ratio, input.normal, outgoing_direction) +
+                 pdfHalfVectorGgx(input.specular_ratio, input.roughness, input.incoming_dir, input.normal, half_vector);
+  }
+  if(input.transmission <= 0.0) {
+    return opaque_sum;
+  }
+  return (opaque_sum * (1.0 - input.transmission)) +
+         (input.transmission * PBR::pdfDielectric(input, outgoing_direction));
+}
+
 inline double balanceHeuristic(double pdf_chosen, const std::vector<double>& pdf_list) {
   double sum = 0.0;
   for(const double p : pdf_list) {
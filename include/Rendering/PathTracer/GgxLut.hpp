@@ -0,0 +1,37 @@
+/**
+ * @file GgxLut.hpp
+ * @brief Header file for the precomputed directional albedo table of the GGX specular lobe.
+ */
+#ifndef RENDERING_PATHTRACER_GGXLUT_HPP
+#define RENDERING_PATHTRACER_GGXLUT_HPP
+
+namespace PBR {
+
+/**
+ * @struct SpecularAlbedo
+ * @brief Directional albedo of the GGX specular lobe, split on the base reflectance F0 of the Schlick Fresnel.
+ *
+ * The fraction of light reflected by the lobe towards the whole hemisphere is F0 * scale + bias.
+ */
+struct SpecularAlbedo {
+  double scale = 1.0;
+  double bias  = 0.0;
+
+  /**
+   * @brief Gets the albedo of the lobe without Fresnel (F0 = 1), the energy kept by single scattering.
+   * @return The energy of the lobe, in [0, 1].
+   */
+  double energy() const { return scale + bias; }
+};
+
+/**
+ * @brief Reads the directional albedo of the GGX lobe, bilinearly interpolated from a table built on first use.
+ * @param cos_theta The cosine between the normal and the view direction.
+ * @param roughness The perceptual roughness of the surface.
+ * @return The albedo of the lobe for this view direction.
+ */
+SpecularAlbedo lookupSpecularAlbedo(double cos_theta, double roughness);
+
+} // namespace PBR
+
+#endif // RENDERING_PATHTRACER_GGXLUT_HPP
@@ -6,6 +6,7 @@
 #define RENDERING_PATHTRACER_PBR_HPP
 
 #include <algorithm>
+#include <cmath>
 #include <linalg/Mat3.hpp>
 #include <linalg/Vec3.hpp>
 #include <linalg/linalg.hpp>
@@ -14,6 +15,7 @@
 #include "Core/MathConstants.hpp"
 #include "Core/Random.hpp"
 #include "Core/Ray.hpp"
+#include "Rendering/PathTracer/GgxLut.hpp"
 #include "Scene/LightSample.hpp"
 #include "Surface/Material.hpp"
 #include "Surface/Texture.hpp"
@@ -21,6 +23,7 @@
 namespace PBR {
 
 static constexpr double DIELECTRIC_REFLECTANCE = 0.04; ///< Base reflectance value for non-metallic surfaces.
+static constexpr double MIN_SPECULAR_ENERGY    = 1e-3; ///< Lower bound of the lobe energy in the compensation.
 
 inline ColorRGB getLambertianDiffuse(const ColorRGB& diffuse_color) { return diffuse_color * INV_PI; }
 
@@ -28,11 +31,20 @@ inline ColorRGB getBaseReflectance(const ColorRGB& albedo, double metalness) {
   return ColorRGB(DIELECTRIC_REFLECTANCE) * (1.0 - metalness) + albedo * metalness;
 }
 
+/**
+ * @brief Computes (1 - cos_theta)^5 with multiplications only, avoiding std::pow in the Schlick approximation.
+ */
+inline double getSchlickWeight(double cos_theta) {
+  const double m  = 1.0 - cos_theta;
+  const double m2 = m * m;
+  return m2 * m2 * m;
+}
+
 // NOLINTBEGIN(readability-identifier-naming)
 inline ColorRGB getFresnelSchlick(const linalg::Vec3d& half_vector, const linalg::Vec3d& view_direction,
                                   const ColorRGB& F0) {
   const double cos_theta = std::max(0.0, linalg::dot(view_direction, half_vector));
-  return F0 + (ColorRGB(1.0) - F0) * std::pow(1.0 - cos_theta, 5); // NOLINT
+  return F0 + (ColorRGB(1.0) - F0) * getSchlickWeight(cos_theta);
 }
 
 inline double getDistributionGgx(const linalg::Vec3d& normal, const linalg::Vec3d& half_vector, double roughness) {
@@ -58,6 +70,55 @@ inline double getGeometrySmith(const linalg::Vec3d& normal, const linalg::Vec3d&
   return ggx_v * ggx_l;
 }
 
+/**
+ * @brief Computes the Smith masking term of one direction, with the approximation of getGeometrySmith.
+ * @param cos_theta The cosine between the normal and the direction, on either side of the surface.
+ * @param roughness The perceptual roughness.
+ */
+inline double getSmithMasking(double cos_theta, double roughness) {
+  const double alpha2  = roughness * roughness * roughness * roughness;
+  const double abs_cos = std::abs(cos_theta);
+  const double denom   = abs_cos * (1.0 - alpha2) + alpha2;
+  return denom > 0.0 ? abs_cos / denom : 0.0;
+}
+
+/**
+ * @brief Computes the unpolarized Fresnel reflectance of an interface between two dielectrics.
+ * @param cos_theta_i The cosine of the incident angle, on the side of the incident medium.
+ * @param eta The relative index of refraction, transmitted over incident.
+ * @return The reflectance, 1 under total internal reflection.
+ */
+inline double getFresnelDielectric(double cos_theta_i, double eta) {
+  cos_theta_i         = std::clamp(cos_theta_i, 0.0, 1.0);
+  const double sin2_t = (1.0 - cos_theta_i * cos_theta_i) / (eta * eta);
+  if(sin2_t >= 1.0) {
+    return 1.0;
+  }
+  const double cos_theta_t     = std::sqrt(1.0 - sin2_t);
+  const double r_parallel      = (eta * cos_theta_i - cos_theta_t) / (eta * cos_theta_i + cos_theta_t);
+  const double r_perpendicular = (cos_theta_i - eta * cos_theta_t) / (cos_theta_i + eta * cos_theta_t);
+  return 0.5 * (r_parallel * r_parallel + r_perpendicular * r_perpendicular);
+}
+
+/**
+ * @brief Refracts a direction through a (micro)surface.
+ * @param view The direction towards the viewer, on the side the normal points to.
+ * @param normal The normal of the surface.
+ * @param eta The relative index of refraction, transmitted over incident.
+ * @param refracted Output refracted direction, leaving the surface on the other side.
+ * @return False under total internal reflection.
+ */
+inline bool refract(const linalg::Vec3d& view, const linalg::Vec3d& normal, double eta, linalg::Vec3d& refracted) {
+  const double cos_theta_i = linalg::dot(view, normal);
+  const double sin2_t      = std::max(0.0, 1.0 - cos_theta_i * cos_theta_i) / (eta * eta);
+  if(sin2_t >= 1.0) {
+    return false;
+  }
+  const double cos_theta_t = std::sqrt(1.0 - sin2_t);
+  refracted                = view * (-1.0 / eta) + normal * (cos_theta_i / eta - cos_theta_t);
+  return true;
+}
+
 inline double getCookTorranceSpecular(const linalg::Vec3d& incoming_dir, const linalg::Vec3d& outgoing_direction,
                                       const linalg::Vec3d& normal, double roughness) {
   const linalg::Vec3d half_vector = (incoming_dir + outgoing_direction).normalized();
@@ -88,16 +149,41 @@ struct BRDFInput {
   double   roughness{};
   double   metalness{};
 
-  double specular_ratio{};
+  double   specular_ratio{};
+  ColorRGB specular_compensation{1.0}; ///< Scale of the specular lobe restoring the energy lost to multiple scattering.
+
+  double transmission{}; ///< Weight of the dielectric lobe, the rest of the light goes to the opaque lobes.
+  double eta{1.0};       ///< Relative index of refraction of the interface, transmitted over incident.
 
   BRDFInput(const linalg::Vec3d& incoming_dir, const linalg::Vec3d& normal, const ColorRGB& base_color,
             double roughness, double metalness)
       : incoming_dir(incoming_dir), normal(normal), base_color(base_color), roughness(roughness), metalness(metalness) {
+    updateSpecularTerms();
+  }
 
-    const ColorRGB F0 = getBaseReflectance(base_color, metalness);
-    const ColorRGB F  = getFresnelSchlick(normal, incoming_dir, F0);
+  /**
+   * @brief Changes the roughness and the terms derived from it.
+   * @param value The new roughness.
+   */
+  void setRoughness(double value) {
+    roughness = value;
+    updateSpecularTerms();
+  }
 
-    specular_ratio = metalness + (1.0 - metalness) * F.luminance();
+  /**
+   * @brief Derives the specular sampling ratio and the energy compensation from the GGX albedo table.
+   *
+   * The ratio uses the Fresnel averaged over the lobe, which reduces to Schlick at n.v for a mirror. The compensation
+   * scales the single scattering lobe by 1 + F0 * (1 - E) / E, so that a white rough metal reflects all the light.
+   */
+  void updateSpecularTerms() {
+    const SpecularAlbedo albedo = lookupSpecularAlbedo(std::max(0.0, linalg::dot(normal, incoming_dir)), roughness);
+    const double         energy = std::max(albedo.energy(), MIN_SPECULAR_ENERGY);
+    const ColorRGB       F0     = getBaseReflectance(base_color, metalness);
+    const ColorRGB       F      = (F0 * albedo.scale + ColorRGB(albedo.bias)) / energy;
+
+    specular_ratio        = metalness + (1.0 - metalness) * F.luminance();
+    specular_compensation = ColorRGB(1.0) + F0 * ((1.0 - energy) / energy);
   }
 };
 
@@ -113,7 +199,100 @@ inline ColorRGB evaluateBrdf(const BRDFInput& input, const linalg::Vec3d& outgoi
   const double   specular = getCookTorranceSpecular(incoming_dir, outgoing_direction, input.normal, input.roughness);
   const ColorRGB diffuse  = getLambertianDiffuse(input.base_color);
 
-  return k_d * diffuse + k_s * specular;
+  return k_d * diffuse + k_s * input.specular_compensation * specular;
+}
+
+/**
+ * @brief Computes the microfacet normal of a pair of directions through the dielectric lobe, facing the normal.
+ * @return False when the directions cannot be connected by a microfacet.
+ */
+inline bool getDielectricHalfVector(const BRDFInput& input, const linalg::Vec3d& outgoing_direction,
+                                    linalg::Vec3d& half_vector) {
+  const bool reflection = linalg::dot(input.normal, outgoing_direction) > 0.0;
+  half_vector     = reflection ? input.incoming_dir + outgoing_direction
+                               : input.incoming_dir + outgoing_direction * input.eta;
+  if(linalg::dot(half_vector, half_vector) <= 0.0) {
+    return false;
+  }
+  half_vector = half_vector.normalized();
+  if(linalg::dot(half_vector, input.normal) < 0.0) {
+    half_vector = -half_vector;
+  }
+  // Back-facing microfacets cannot be seen from either direction.
+  return linalg::dot(half_vector, input.incoming_dir) > 0.0 &&
+         linalg::dot(half_vector, outgoing_direction) * linalg::dot(input.normal, outgoing_direction) > 0.0;
+}
+
+/**
+ * @brief Evaluates the GGX dielectric lobe (rough glass): reflection weighted by the exact Fresnel reflectance,
+ * transmission by its complement and tinted by the base color.
+ *
+ * The transmitted radiance is divided by eta^2 since paths are traced from the camera.
+ */
+inline ColorRGB evaluateDielectric(const BRDFInput& input, const linalg::Vec3d& outgoing_direction) {
+  const double  cos_v = linalg::dot(input.normal, input.incoming_dir);
+  const double  cos_l = linalg::dot(input.normal, outgoing_direction);
+  linalg::Vec3d half_vector;
+  if(cos_v <= 0.0 || cos_l == 0.0 || !getDielectricHalfVector(input, outgoing_direction, half_vector)) {
+    return ColorRGB(0.0);
+  }
+
+  const double v_dot_h = linalg::dot(input.incoming_dir, half_vector);
+  const double l_dot_h = linalg::dot(outgoing_direction, half_vector);
+  const double F       = getFresnelDielectric(v_dot_h, input.eta);
+  const double D       = getDistributionGgx(input.normal, half_vector, input.roughness);
+  const double G       = getSmithMasking(cos_v, input.roughness) * getSmithMasking(cos_l, input.roughness);
+
+  if(cos_l > 0.0) {
+    return ColorRGB(F * D * G / (4.0 * cos_v * cos_l)); // NOLINT
+  }
+  const double denom = l_dot_h + v_dot_h / input.eta;
+  const double btdf  = (1.0 - F) * D * G * std::abs(l_dot_h * v_dot_h) / (cos_v * std::abs(cos_l) * denom * denom);
+  return input.base_color * (btdf / (input.eta * input.eta));
+}
+
+/**
+ * @brief Computes the density of the directions sampled by the dielectric lobe: a GGX microfacet normal, then
+ * reflection with probability F or refraction otherwise.
+ */
+inline double pdfDielectric(const BRDFInput& input, const linalg::Vec3d& outgoing_direction) {
+  linalg::Vec3d half_vector;
+  if(!getDielectricHalfVector(input, outgoing_direction, half_vector)) {
+    return 0.0;
+  }
+
+  const double v_dot_h  = linalg::dot(input.incoming_dir, half_vector);
+  const double F        = getFresnelDielectric(v_dot_h, input.eta);
+  const double pdf_half = getDistributionGgx(input.normal, half_vector, input.roughness) *
+                          std::max(0.0, linalg::dot(input.normal, half_vector));
+  if(linalg::dot(input.normal, outgoing_direction) > 0.0) {
+    return F * pdf_half / (4.0 * v_dot_h); // NOLINT
+  }
+  const double l_dot_h = linalg::dot(outgoing_direction, half_vector);
+  const double denom   = l_dot_h + v_dot_h / input.eta;
+  return (1.0 - F) * pdf_half * std::abs(l_dot_h) / (denom * denom);
+}
+
+/**
+ * @brief Evaluates the full BSDF: the opaque BRDF above the surface, blended with the dielectric lobe.
+ */
+inline ColorRGB evaluateBsdf(const BRDFInput& input, const linalg::Vec3d& outgoing_direction) {
+  if(input.transmission <= 0.0) {
+    return evaluateBrdf(input, outgoing_direction);
+  }
+  const ColorRGB dielectric = evaluateDielectric(input, outgoing_direction) * input.transmission;
+  if(linalg::dot(input.normal, outgoing_direction) <= 0.0) {
+    return dielectric;
+  }
+  return evaluateBrdf(input, outgoing_direction) * (1.0 - input.transmission) + dielectric;
+}
+
+/**
+ * @brief Gets the cosine factor of the rendering equation, on both sides of the surface for transmissive inputs.
+ */
+inline double getCosineFactor(const BRDFInput& input, const linalg::Vec3d& outgoing_direction) {
+  const double cos_theta = linalg::dot(input.normal, outgoing_direction);
+  return input.transmission > 0.0 ? std::abs(cos_theta) : std::max(0.0, cos_theta);
 }
 // NOLINTEND(readability-identifier-naming)
 
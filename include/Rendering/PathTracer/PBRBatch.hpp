@@ -0,0 +1,127 @@
+/**
+ * @file PBRBatch.hpp
+ * @brief Header file for the batched (SoA, single precision) PBR shading kernel.
+ */
+#ifndef RENDERING_PATHTRACER_PBRBATCH_HPP
+#define RENDERING_PATHTRACER_PBRBATCH_HPP
+
+#include <array>
+#include <linalg/Vec3.hpp>
+
+#include "Core/Color.hpp"
+#include "Core/Config.hpp"
+#include "Rendering/PathTracer/PBR.hpp"
+
+namespace PBRBatch {
+
+static constexpr int BATCH_SIZE = 8; ///< Number of shading points evaluated together (one AVX2 register of floats).
+
+using Lanes = std::array<float, BATCH_SIZE>; ///< One float value per shading point of a batch.
+
+/**
+ * @struct Vec3Batch
+ * @brief Structure of arrays holding one 3D vector per lane.
+ */
+struct Vec3Batch {
+  alignas(ALIGN32) Lanes x{};
+  alignas(ALIGN32) Lanes y{};
+  alignas(ALIGN32) Lanes z{};
+
+  /**
+   * @brief Stores a vector in the given lane.
+   * @param lane The lane index.
+   * @param value The vector to store.
+   */
+  void set(int lane, const linalg::Vec3d& value);
+
+  /**
+   * @brief Reads back the vector of the given lane.
+   * @param lane The lane index.
+   * @return The vector stored in the lane.
+   */
+  linalg::Vec3d get(int lane) const;
+};
+
+/**
+ * @struct ColorBatch
+ * @brief Structure of arrays holding one RGB color per lane.
+ */
+struct ColorBatch {
+  alignas(ALIGN32) Lanes r{};
+  alignas(ALIGN32) Lanes g{};
+  alignas(ALIGN32) Lanes b{};
+
+  /**
+   * @brief Stores a color in the given lane.
+   * @param lane The lane index.
+   * @param value The color to store.
+   */
+  void set(int lane, const ColorRGB& value);
+
+  /**
+   * @brief Reads back the color of the given lane.
+   * @param lane The lane index.
+   * @return The color stored in the lane.
+   */
+  ColorRGB get(int lane) const;
+};
+
+/**
+ * @struct BRDFBatchInput
+ * @brief SoA counterpart of PBR::BRDFInput for BATCH_SIZE shading points.
+ */
+struct BRDFBatchInput {
+  Vec3Batch  incoming_dir;
+  Vec3Batch  normal;
+  ColorBatch base_color;
+
+  alignas(ALIGN32) Lanes roughness{};
+  alignas(ALIGN32) Lanes metalness{};
+
+  ColorBatch specular_compensation;
+
+  /**
+   * @brief Copies a scalar BRDF input into the given lane.
+   * @param lane The lane index.
+   * @param input The scalar BRDF input.
+   */
+  void set(int lane, const PBR::BRDFInput& input);
+};
+
+/**
+ * @brief Polynomial approximation of sine and cosine, without any call to the standard library.
+ * @param angle The angle in radians, expected in [0, 2 * PI].
+ * @param sin_value Output sine of the angle.
+ * @param cos_value Output cosine of the angle.
+ *
+ * The absolute error is below 1e-5 on the whole range, which is enough for direction sampling in float.
+ */
+void fastSinCos(float angle, float& sin_value, float& cos_value);
+
+/**
+ * @brief Evaluates the Cook-Torrance / Lambert BRDF of PBR::evaluateBrdf for every lane of a batch.
+ * @param input The shading points.
+ * @param outgoing_dir The outgoing direction of each lane.
+ * @param result Output BRDF value of each lane.
+ *
+ * Uses AVX2 when the library is compiled with it, a scalar lane loop otherwise. Both paths use a pow-free
+ * Schlick term and produce the same results up to float rounding.
+ */
+void evaluateBrdf(const BRDFBatchInput& input, const Vec3Batch& outgoing_dir, ColorBatch& result);
+
+/**
+ * @brief Samples one GGX half vector per lane, without inverse trigonometric functions.
+ * @param roughness The roughness of each lane.
+ * @param u1 First uniform random number of each lane.
+ * @param u2 Second uniform random number of each lane.
+ * @param tangent Tangent of each lane.
+ * @param bitangent Bitangent of each lane.
+ * @param normal Normal of each lane.
+ * @param half_vector Output world space half vector of each lane.
+ */
+void sampleHalfVectorGgx(const Lanes& roughness, const Lanes& u1, const Lanes& u2, const Vec3Batch& tangent,
+                         const Vec3Batch& bitangent, const Vec3Batch& normal, Vec3Batch& half_vector);
+
+} // namespace PBRBatch
+
+#endif // RENDERING_PATHTRACER_PBRBATCH_HPP
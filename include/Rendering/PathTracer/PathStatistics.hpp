@@ -0,0 +1,99 @@
+/**
+ * @file PathStatistics.hpp
+ * @brief Header file for the PathStatistics class.
+ */
+#ifndef RENDERING_PATHTRACER_PATHSTATISTICS_HPP
+#define RENDERING_PATHTRACER_PATHSTATISTICS_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "Core/Color.hpp"
+
+/**
+ * @class PathStatistics
+ * @brief Per-depth counters of a render: rays traced, paths terminated and average path throughput.
+ *
+ * The counters are not synchronized: each thread fills its own instance and merges it into the renderer's once its
+ * work is done.
+ */
+class PathStatistics {
+private:
+  struct DepthCounters {
+    std::uint64_t rays_traced      = 0;
+    std::uint64_t paths_terminated = 0;
+    double        throughput_sum   = 0.0;
+  };
+
+  std::vector<DepthCounters> m_depths;
+
+  DepthCounters& countersAt(int depth);
+
+public:
+  PathStatistics() = default; ///< Default constructor.
+
+  PathStatistics(const PathStatistics&)            = default;
+  PathStatistics& operator=(const PathStatistics&) = default;
+  PathStatistics(PathStatistics&&)                 = default;
+  PathStatistics& operator=(PathStatistics&&)      = default;
+
+  /**
+   * @brief Records a ray traced at a given depth.
+   * @param depth The number of bounces of the path before this ray.
+   * @param throughput The throughput of the path when the ray is traced.
+   */
+  void recordRay(int depth, const ColorRGB& throughput);
+
+  /**
+   * @brief Records the termination of a path at a given depth (miss, Russian roulette or bounce limit).
+   * @param depth The depth of the last ray of the path.
+   */
+  void recordTermination(int depth);
+
+  /**
+   * @brief Adds the counters of another instance to this one.
+   * @param other The statistics to add.
+   */
+  void merge(const PathStatistics& other);
+
+  /**
+   * @brief Resets every counter.
+   */
+  void clear() { m_depths.clear(); }
+
+  /**
+   * @brief Gets the number of depths that have at least one recorded ray.
+   * @return The deepest recorded depth plus one.
+   */
+  int getDepthCount() const { return static_cast<int>(m_depths.size()); }
+
+  /**
+   * @brief Gets the number of rays traced at a given depth.
+   * @param depth The depth.
+   * @return The number of rays.
+   */
+  std::uint64_t getRaysTraced(int depth) const;
+
+  /**
+   * @brief Gets the number of paths that ended at a given depth.
+   * @param depth The depth.
+   * @return The number of terminated paths.
+   */
+  std::uint64_t getPathsTerminated(int depth) const;
+
+  /**
+   * @brief Gets the average throughput (largest component) of the rays traced at a given depth.
+   * @param depth The depth.
+   * @return The average throughput, 0 if no ray was traced at this depth.
+   */
+  double getAverageThroughput(int depth) const;
+
+  /**
+   * @brief Prints the counters of every depth.
+   */
+  void print() const;
+
+  ~PathStatistics() = default; ///< Default destructor.
+};
+
+#endif // RENDERING_PATHTRACER_PATHSTATISTICS_HPP
@@ -1,29 +1,51 @@
 #ifndef RENDERING_PATHTRACER_PATHTRACER_HPP
 #define RENDERING_PATHTRACER_PATHTRACER_HPP
 
+#include <array>
 #include <linalg/linalg.hpp>
 
+#include "Core/Config.hpp"
 #include "Rendering/PathTracer/DirectionSampler.hpp"
 #include "Rendering/PathTracer/PBR.hpp"
+#include "Rendering/PathTracer/PathStatistics.hpp"
+#include "Rendering/RenderSettings.hpp"
 
+class Material;
 class Scene;
 
+/**
+ * @struct PathState
+ * @brief Per-path bookkeeping for the bounce limits, path regularization and nested dielectrics.
+ */
+struct PathState {
+  std::array<int, BOUNCE_TYPE_COUNT> bounce_counts{};           ///< Number of bounces of each BounceType so far.
+  bool                               after_rough_bounce = false; ///< Whether the path bounced off a rough surface.
+
+  std::array<const Material*, MAX_NESTED_DIELECTRICS> media{};     ///< Dielectrics the path is inside, in entry order.
+  int                                                 media_count = 0;
+};
+
 class PathTracer {
 private:
-  Scene* m_scene;
+  Scene*                m_scene;
+  RenderSettings        m_default_render_settings; ///< Read until render settings are set.
+  const RenderSettings* m_render_settings = &m_default_render_settings;
 
   bool isValidHit(double distance) const;
 
-  static PBR::BRDFInput CreateBrdfInput(const RayHitInfo& hit_info, const linalg::Vec3d& incoming_dir);
-
   static linalg::Vec3d Reflect(const linalg::Vec3d& incident, const linalg::Vec3d& normal) {
     return incident - 2 * linalg::dot(incident, normal) * normal;
   }
 
-  static linalg::Vec3d SampleOutgoingDirection(const PBR::BRDFInput& input, const linalg::Mat3d& tbn, double& pdf);
+  double getLODDistance() const { return m_render_settings->getLODDistance(); }
+
+  template <typename HalfVectorSampler>
+  static linalg::Vec3d SampleLobe(const PBR::BRDFInput& input, const linalg::Mat3d& tbn,
+                                  const HalfVectorSampler& sample_half_vector, double& pdf, BounceType& bounce_type);
 
-  ColorRGB        computeDirectLighting(const PBR::BRDFInput& input, const linalg::Vec3d& hit_position) const;
+  ColorRGB        computeDirectLighting(const PBR::BRDFInput& input, const RayHitInfo& hit) const;
   static ColorRGB ComputeBrdfContribution(const PBR::BRDFInput& input, const linalg::Vec3d& outgoing_dir, double pdf);
+  ColorRGB        clampIndirect(const ColorRGB& radiance, int bounce_count) const;
 
 public:
   PathTracer() = default;
@@ -35,7 +57,137 @@ public:
 
   void setScene(Scene* scene) { m_scene = scene; }
 
-  ColorRGB traceRay(const Ray& ray_in) const;
+  /**
+   * @brief Sets the render settings providing the path depth, clamping and regularization parameters.
+   * @param render_settings The render settings, nullptr for the default ones.
+   */
+  void setRenderSettings(const RenderSettings* render_settings) {
+    m_render_settings = render_settings != nullptr ? render_settings : &m_default_render_settings;
+  }
+
+  /**
+   * @brief Builds the BRDF input of a hit point by sampling its material.
+   * @param hit_info The hit information.
+   * @param incoming_dir The direction towards the previous vertex of the path.
+   * @return The BRDF input.
+   */
+  static PBR::BRDFInput CreateBrdfInput(const RayHitInfo& hit_info, const linalg::Vec3d& incoming_dir);
+
+  /**
+   * @brief Samples an outgoing direction, choosing the dielectric lobe from the transmission, then between GGX and
+   * cosine sampling from the specular ratio.
+   * @param input The BRDF input.
+   * @param tbn The tangent space matrix of the hit point.
+   * @param pdf Output pdf of the sampled direction.
+   * @param bounce_type Output type of the sampled lobe.
+   * @return The sampled outgoing direction.
+   */
+  static linalg::Vec3d SampleOutgoingDirection(const PBR::BRDFInput& input, const linalg::Mat3d& tbn, double& pdf,
+                                               BounceType& bounce_type);
+
+  /**
+   * @brief Samples an outgoing direction like SampleOutgoingDirection, from a GGX half vector sampled beforehand, e.g.
+   * for a whole batch by PBRBatch::sampleHalfVectorGgx. The half vector is only read by the GGX and dielectric lobes.
+   * @param input The BRDF input.
+   * @param tbn The tangent space matrix of the hit point.
+   * @param half_dir The GGX half vector, sampled around the normal of the input.
+   * @param pdf Output pdf of the sampled direction.
+   * @param bounce_type Output type of the sampled lobe.
+   * @return The sampled outgoing direction.
+   */
+  static linalg::Vec3d SampleOutgoingDirection(const PBR::BRDFInput& input, const linalg::Mat3d& tbn,
+                                               const linalg::Vec3d& half_dir, double& pdf, BounceType& bounce_type);
+
+  /**
+   * @brief Checks whether a path arrives on the front side of a surface.
+   * @param hit_info The hit information.
+   * @param incoming_dir The direction towards the previous vertex of the path.
+   * @return True if the path enters the object, false if it leaves it.
+   */
+  static bool IsEntering(const RayHitInfo& hit_info, const linalg::Vec3d& incoming_dir) {
+    return linalg::dot(hit_info.geometric_normal, incoming_dir) > 0.0;
+  }
+
+  /**
+   * @brief Gets the medium the path currently travels through: the dielectric of highest priority it is inside.
+   * @param state The state of the path.
+   * @param excluded A medium to ignore, e.g. the one the path is about to leave.
+   * @return The medium, nullptr for the air.
+   */
+  static const Material* EnclosingMedium(const PathState& state, const Material* excluded = nullptr);
+
+  /**
+   * @brief Checks whether a dielectric surface is overlapped by a medium of higher priority and must be ignored.
+   * @param state The state of the path.
+   * @param material The material of the surface.
+   * @param entering Whether the path enters the object.
+   * @return True for a false hit, crossed without any interaction.
+   */
+  static bool IsFalseHit(const PathState& state, const Material* material, bool entering);
+
+  /**
+   * @brief Records a path entering or leaving a dielectric medium.
+   * @param state The state of the path.
+   * @param material The material of the crossed surface.
+   * @param entering Whether the path enters the object.
+   */
+  static void CrossInterface(PathState& state, const Material* material, bool entering);
+
+  /**
+   * @brief Sets the relative index of refraction of a transmissive vertex from the media around the surface.
+   * @param input The BRDF input of the vertex.
+   * @param hit_info The hit information.
+   * @param state The state of the path.
+   */
+  static void ApplyMedia(PBR::BRDFInput& input, const RayHitInfo& hit_info, const PathState& state);
+
+  /**
+   * @brief Finds the next surface along a ray, crossing the false hits of nested dielectrics.
+   * @param ray The ray.
+   * @param scene The scene.
+   * @param state The state of the path, updated with the media crossed.
+   * @param lod_distance The distance at which simplified meshes start to be used, 0 to always use the full meshes.
+   * @return The hit information of the first real hit, its distance measured from the origin of the ray.
+   */
+  static RayHitInfo IntersectThroughMedia(const Ray& ray, const Scene* scene, PathState& state,
+                                          double lod_distance = 0.0);
+
+  /**
+   * @brief Counts a bounce of a path, checking it against the per-type limits of the render settings.
+   * @param state The state of the path, updated with the bounce.
+   * @param bounce_type The type of the bounce.
+   * @param render_settings The render settings holding the bounce limits.
+   * @return True if the path may continue, false if it already reached the limit for this type.
+   */
+  static bool RegisterBounce(PathState& state, BounceType bounce_type, const RenderSettings& render_settings);
+
+  /**
+   * @brief Scales a radiance sample down so that its largest component does not exceed a limit, keeping its hue.
+   * @param radiance The radiance sample.
+   * @param max_value The limit, 0 disables the clamp.
+   * @return The clamped radiance.
+   */
+  static ColorRGB ClampRadiance(const ColorRGB& radiance, double max_value);
+
+  /**
+   * @brief Raises the roughness of a vertex once its path has bounced off a glossy or diffuse surface.
+   *
+   * Blurring the lobes following a rough bounce removes the caustic paths (e.g. diffuse, then mirror, then small
+   * light) that are responsible for most fireflies, at the cost of slightly blurrier indirect reflections.
+   *
+   * @param input The BRDF input of the vertex, its roughness may be raised.
+   * @param min_roughness The roughness applied after the first rough bounce.
+   * @param after_rough_bounce Whether the path already bounced off a rough surface, updated with this vertex.
+   */
+  static void RegularizeRoughness(PBR::BRDFInput& input, double min_roughness, bool& after_rough_bounce);
+
+  /**
+   * @brief Traces a path from a camera ray and returns the radiance it carries.
+   * @param ray_in The camera ray.
+   * @param statistics Optional per-depth counters to update.
+   * @return The radiance along the ray.
+   */
+  ColorRGB traceRay(const Ray& ray_in, PathStatistics* statistics = nullptr) const;
   ColorRGB traceRayRecursion(const Ray& ray, const ColorRGB& throughput = ColorRGB(1.0), int depth = 0,
                              double prev_brdf_pdf = 1.0, std::vector<double> prev_brdf_pdf_list = {1.0}) const;
 
@@ -5,14 +5,21 @@
 #ifndef RENDERING_PATHTRACER_RAYINTERSECTION_HPP
 #define RENDERING_PATHTRACER_RAYINTERSECTION_HPP
 
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <limits>
 #include <linalg/Vec3.hpp>
 #include <linalg/linalg.hpp>
 #include <vector>
 
+#include "Core/Config.hpp"
 #include "Core/ImageTypes.hpp"
 #include "Core/Ray.hpp"
 #include "Geometry/Mesh.hpp"
+#include "Geometry/Primitive.hpp"
 #include "Scene/Scene.hpp"
 #include "SceneObjects/Object3D.hpp"
 #include "Surface/Material.hpp"
@@ -26,13 +33,17 @@ class BVHNode;
 struct RayHitInfo {
   ColorRGB        emitted_light = ColorRGB(0.0);
   linalg::Vec3d   normal;
+  linalg::Vec3d   geometric_normal;
   linalg::Vec3d   tangent;
   linalg::Vec3d   bitangent;
   linalg::Vec3d   position;
   TextureUV       bary_coords;
-  double          distance = std::numeric_limits<double>::max();
-  double          area     = 0.0;
-  const Material* material = nullptr;
+  double          distance     = std::numeric_limits<double>::max();
+  double          area         = 0.0;
+  double          uv_area      = 0.0; ///< Area of the hit triangle in texture space.
+  RayCone         cone;               ///< Footprint of the incoming ray, with its width at the hit point.
+  double          uv_footprint = 0.0; ///< Width of the ray footprint in texture space, selecting the mip level.
+  const Material* material     = nullptr;
 };
 
 /**
@@ -51,12 +62,19 @@ struct RayBVHHitInfo {
   double distance;
 };
 
-constexpr double RAY_OFFSET_FACTOR      = 1e-9;
-constexpr double INTERSECTION_TOLERANCE = 1e-6;
+constexpr float RAY_OFFSET_ORIGIN      = 1.0F / 32.0F;    ///< Below this magnitude, offsets are applied in float space.
+constexpr float RAY_OFFSET_FLOAT_SCALE = 1.0F / 65536.0F; ///< Offset scale near the origin.
+constexpr float RAY_OFFSET_INT_SCALE   = 256.0F;          ///< Offset in units in the last place elsewhere.
 
 /**
- * @brief Checks for intersection between a ray and a triangle defined by three points.
- * @param ray The ray to check for intersection.
+ * @brief Checks for intersection between a ray and a triangle, for any floating point precision.
+ *
+ * Möller-Trumbore test without epsilon: hits exactly on an edge or a vertex are accepted and only hits strictly in
+ * front of the origin are reported. Self-intersections are avoided by offsetting spawned rays (see spawnRay) instead
+ * of tolerances.
+ *
+ * @param origin The origin of the ray.
+ * @param direction The direction of the ray.
  * @param p0 The first vertex of the triangle.
  * @param p1 The second vertex of the triangle.
  * @param p2 The third vertex of the triangle.
@@ -64,42 +82,98 @@ constexpr double INTERSECTION_TOLERANCE = 1e-6;
  * @param bary_coords The barycentric coordinates of the intersection point, if any.
  * @return True if the ray intersects the triangle, false otherwise.
  */
-inline bool getTriangleIntersection(const Ray& ray, const linalg::Vec3d& p0, const linalg::Vec3d& p1,
-                                    const linalg::Vec3d& p2, double& hit_distance, linalg::Vec3d& bary_coords) {
-  const linalg::Vec3d edge1 = p1 - p0;
-  const linalg::Vec3d edge2 = p2 - p0;
-  const linalg::Vec3d h     = ray.direction.cross(edge2);
-  const double        a     = linalg::dot(edge1, h);
-
-  if(a > -INTERSECTION_TOLERANCE && a < INTERSECTION_TOLERANCE) {
+template <typename Vec3T, typename Scalar>
+inline bool getTriangleIntersection(const Vec3T& origin, const Vec3T& direction, const Vec3T& p0, const Vec3T& p1,
+                                    const Vec3T& p2, Scalar& hit_distance, Vec3T& bary_coords) {
+  const Vec3T  edge1 = p1 - p0;
+  const Vec3T  edge2 = p2 - p0;
+  const Vec3T  h     = direction.cross(edge2);
+  const Scalar a     = linalg::dot(edge1, h);
+
+  if(a == Scalar(0)) {
     return false;
   }
 
-  const double        f = 1.0 / a;
-  const linalg::Vec3d s = ray.origin - p0;
-  const double        u = f * linalg::dot(s, h);
+  const Scalar f = Scalar(1) / a;
+  const Vec3T  s = origin - p0;
+  const Scalar u = f * linalg::dot(s, h);
 
-  if(u < -INTERSECTION_TOLERANCE || u > 1.0 + INTERSECTION_TOLERANCE) {
+  if(u < Scalar(0) || u > Scalar(1)) {
     return false;
   }
 
-  const linalg::Vec3d q = s.cross(edge1);
-  const double        v = f * linalg::dot(ray.direction, q);
+  const Vec3T  q = s.cross(edge1);
+  const Scalar v = f * linalg::dot(direction, q);
 
-  if(v < -INTERSECTION_TOLERANCE || u + v > 1.0 + INTERSECTION_TOLERANCE) {
+  if(v < Scalar(0) || u + v > Scalar(1)) {
     return false;
   }
 
   hit_distance = f * linalg::dot(edge2, q);
 
-  if(hit_distance > INTERSECTION_TOLERANCE) {
-    bary_coords = {1.0 - u - v, u, v};
+  if(hit_distance > Scalar(0)) {
+    bary_coords = {Scalar(1) - u - v, u, v};
     return true;
   }
 
   return false;
 }
 
+/**
+ * @brief Checks for intersection between a ray and a triangle defined by three points.
+ * @param ray The ray to check for intersection.
+ * @param p0 The first vertex of the triangle.
+ * @param p1 The second vertex of the triangle.
+ * @param p2 The third vertex of the triangle.
+ * @param hit_distance The distance to the intersection point, if any.
+ * @param bary_coords The barycentric coordinates of the intersection point, if any.
+ * @return True if the ray intersects the triangle, false otherwise.
+ */
+inline bool getTriangleIntersection(const Ray& ray, const linalg::Vec3d& p0, const linalg::Vec3d& p1,
+                                    const linalg::Vec3d& p2, double& hit_distance, linalg::Vec3d& bary_coords) {
+  return getTriangleIntersection(ray.origin, ray.direction, p0, p1, p2, hit_distance, bary_coords);
+}
+
+/**
+ * @brief Checks for intersection between a single precision ray and a triangle.
+ * @param ray The ray to check for intersection.
+ * @param p0 The first vertex of the triangle.
+ * @param p1 The second vertex of the triangle.
+ * @param p2 The third vertex of the triangle.
+ * @param hit_distance The distance to the intersection point, if any.
+ * @param bary_coords The barycentric coordinates of the intersection point, if any.
+ * @return True if the ray intersects the triangle, false otherwise.
+ */
+inline bool getTriangleIntersection(const RayF& ray, const linalg::Vec3f& p0, const linalg::Vec3f& p1,
+                                    const linalg::Vec3f& p2, float& hit_distance, linalg::Vec3f& bary_coords) {
+  return getTriangleIntersection(ray.origin, ray.direction, p0, p1, p2, hit_distance, bary_coords);
+}
+
+/**
+ * @brief Offsets a point away from a surface by a few units in the last place of its float representation.
+ *
+ * Scale-independent replacement for fixed epsilons (Wächter and Binder, "A Fast and Robust Method for Avoiding
+ * Self-Intersection"): the offset grows with the magnitude of the coordinates, so it works for tiny and huge scenes.
+ *
+ * @param position The point on the surface.
+ * @param normal The geometric normal, oriented towards the side the new ray leaves from.
+ * @return The offset point.
+ */
+inline linalg::Vec3d offsetRayOrigin(const linalg::Vec3d& position, const linalg::Vec3d& normal) {
+  const auto offset_component = [](double p, double n) {
+    const auto p_f      = static_cast<float>(p);
+    const auto n_f      = static_cast<float>(n);
+    const auto offset_i = static_cast<std::int32_t>(RAY_OFFSET_INT_SCALE * n_f);
+
+    const auto  p_bits   = std::bit_cast<std::int32_t>(p_f);
+    const float p_offset = std::bit_cast<float>(p_bits + (p_f < 0.0F ? -offset_i : offset_i));
+
+    return static_cast<double>(std::abs(p_f) < RAY_OFFSET_ORIGIN ? p_f + RAY_OFFSET_FLOAT_SCALE * n_f : p_offset);
+  };
+  return {offset_component(position.x, normal.x), offset_component(position.y, normal.y),
+          offset_component(position.z, normal.z)};
+}
+
 /**
  * @brief Processes the intersection of a ray with a mesh using a BVH.
  * @param ray The ray to check for intersection.
@@ -124,37 +198,59 @@ RayHitInfo getMeshIntersectionWithoutBVH(const Ray& ray, const Mesh& mesh);
  */
 RayHitInfo getMeshIntersection(const Ray& ray, const Mesh& mesh);
 
+/**
+ * @brief Processes the intersection of a ray with an analytic primitive, in closed form.
+ *
+ * The texture coordinates and the tangent frame follow the parameterization of the primitive (see Primitive), the
+ * tangent and bitangent being the derivatives of the position along u and v. The area and texture space area are the
+ * ones of a surface element covering an equal share of the texture space, the triangles of the mesh tessellating the
+ * primitive, so that the light sampling density, which picks these triangles, and the texture footprint stay
+ * consistent with the mesh.
+ * @param ray The ray to check for intersection, with a normalized direction.
+ * @param primitive The primitive, in the space of the ray.
+ * @param element_count The number of triangles tessellating the primitive.
+ * @return RayHitInfo containing the intersection information if an intersection occurs, otherwise an empty RayHitInfo.
+ */
+RayHitInfo getPrimitiveIntersection(const Ray& ray, const Primitive& primitive, std::size_t element_count = 1);
+
 /**
  * @brief Gets the intersection information of a ray with an object in the scene.
+ *
+ * Analytic primitives are intersected in closed form, other objects through the triangles of their mesh, or of one of
+ * its levels of detail selected by the distance of the ray origin to the bounds of the object.
  * @param ray The ray to check for intersection.
  * @param object The object to check for intersection.
+ * @param lod_distance The distance at which simplified meshes start to be used, 0 to always use the full meshes.
  * @return RayHitInfo containing the intersection information if an intersection occurs, otherwise an empty RayHitInfo.
  */
-RayHitInfo getObjectIntersection(const Ray& ray, const Object3D* object);
+RayHitInfo getObjectIntersection(const Ray& ray, const Object3D* object, double lod_distance = 0.0);
 
 /**
  * @brief Gets the intersection information of a ray with the scene, using BVH.
  * @param ray The ray to check for intersection.
  * @param scene The scene containing the objects.
+ * @param lod_distance The distance at which simplified meshes start to be used, 0 to always use the full meshes.
  * @return RayHitInfo containing the intersection information if an intersection occurs, otherwise an empty RayHitInfo.
  */
-RayHitInfo getSceneIntersectionWithBVH(const Ray& ray, const Scene* scene);
+RayHitInfo getSceneIntersectionWithBVH(const Ray& ray, const Scene* scene, double lod_distance = 0.0);
 
 /**
  * @brief Gets the intersection information of a ray with the scene, without using BVH.
  * @param ray The ray to check for intersection.
  * @param scene The scene containing the objects.
+ * @param lod_distance The distance at which simplified meshes start to be used, 0 to always use the full meshes.
  * @return RayHitInfo containing the intersection information if an intersection occurs, otherwise an empty RayHitInfo.
  */
-RayHitInfo getSceneIntersectionWithoutBVH(const Ray& ray, const Scene* scene);
+RayHitInfo getSceneIntersectionWithoutBVH(const Ray& ray, const Scene* scene, double lod_distance = 0.0);
 
 /**
  * @brief Gets the intersection information of a ray with the scene.
  * @param ray The ray to check for intersection.
  * @param scene The scene containing the objects.
+ * @param lod_distance The distance at which simplified meshes start to be used, 0 to always use the full meshes.
  * @return RayHitInfo containing the intersection information if an intersection occurs, otherwise an empty RayHitInfo.
  */
-RayHitInfo getSceneIntersection(const Ray& ray, const Scene* scene);
+RayHitInfo getSceneIntersection(const Ray& ray, const Scene* scene, double lod_distance = 0.0);
 
 /**
  * @brief Checks if a ray intersects with an axis-aligned bounding box (AABB).
@@ -208,6 +304,15 @@ std::string getObjectNameFromHit(const Ray& ray, const Scene* scene);
  */
 void processFaceIntersection(const Ray& ray, const Mesh& mesh, const Face& face, RayHitInfo& closest_hit);
 
+/**
+ * @brief Processes the intersection of a single precision ray with a face in a mesh.
+ * @param ray The ray to check for intersection, in single precision.
+ * @param mesh The mesh containing the face.
+ * @param face The face to check for intersection.
+ * @param closest_hit The RayHitInfo to update with the intersection information if an intersection occurs.
+ */
+void processFaceIntersection(const RayF& ray, const Mesh& mesh, const Face& face, RayHitInfo& closest_hit);
+
 /**
  * @brief Updates the RayHitInfo with barycentric coordinates and vertex information.
  * @param hit_info The RayHitInfo to update.
@@ -220,14 +325,25 @@ void processFaceIntersection(const Ray& ray, const Mesh& mesh, const Face& face,
 inline void updateHitInfoFromBarycentric(RayHitInfo& hit_info, double distance, const linalg::Vec3d& bary,
                                          const Vertex& v0, const Vertex& v1, const Vertex& v2) {
   hit_info.distance      = distance;
+  hit_info.position      = bary.x * v0.position + bary.y * v1.position + bary.z * v2.position;
   hit_info.bary_coords.u = bary.x * v0.uv_coord.u + bary.y * v1.uv_coord.u + bary.z * v2.uv_coord.u;
   hit_info.bary_coords.v = bary.x * v0.uv_coord.v + bary.y * v1.uv_coord.v + bary.z * v2.uv_coord.v;
 
   hit_info.normal    = (bary.x * v0.normal + bary.y * v1.normal + bary.z * v2.normal).normalized();
   hit_info.tangent   = (bary.x * v0.tangent + bary.y * v1.tangent + bary.z * v2.tangent).normalized();
   hit_info.bitangent = (bary.x * v0.bitangent + bary.y * v1.bitangent + bary.z * v2.bitangent).normalized();
-  hit_info.area      = (v1.position - v0.position).cross(v2.position - v0.position).length() * HALF;
+
+  const linalg::Vec3d face_normal = (v1.position - v0.position).cross(v2.position - v0.position);
+  hit_info.area                   = face_normal.length() * HALF;
+  hit_info.geometric_normal       = face_normal.normalized();
+
+  const double du0 = v1.uv_coord.u - v0.uv_coord.u;
+  const double dv0 = v1.uv_coord.v - v0.uv_coord.v;
+  const double du1 = v2.uv_coord.u - v0.uv_coord.u;
+  const double dv1 = v2.uv_coord.v - v0.uv_coord.v;
+  hit_info.uv_area = std::abs((du0 * dv1) - (du1 * dv0)) * HALF;
 }
+
 /**
  * @brief Transforms a ray from world space to object space.
  * @param ray The ray to transform.
@@ -245,24 +361,22 @@ inline Ray transformRayToObjectSpace(const Ray& ray, const Object3D* object) {
 
 /**
  * @brief Transforms the hit information from object space to world space.
+ *
+ * The position is the one found on the surface in object space: rebuilding it from the single precision distance along
+ * the ray would put it off the surface by an error growing with the distance, beyond what offsetRayOrigin covers.
+ *
  * @param hit_info The RayHitInfo to transform.
- * @param local_ray The ray in object space.
  * @param original_ray The original ray in world space.
  * @param object The object to which the hit information belongs.
  */
-inline void transformHitInfoToWorldSpace(RayHitInfo& hit_info, const Ray& local_ray, const Ray& original_ray,
-                                         const Object3D* object) {
-  const linalg::Vec3d local_position = local_ray.origin + hit_info.distance * local_ray.direction;
+inline void transformHitInfoToWorldSpace(RayHitInfo& hit_info, const Ray& original_ray, const Object3D* object) {
   const linalg::Vec3d world_position =
-      linalg::toVec3((object->getTransformationMatrix() * linalg::toVec4(local_position)));
+      linalg::toVec3((object->getTransformationMatrix() * linalg::toVec4(hit_info.position)));
 
   hit_info.distance = (world_position - original_ray.origin).length();
   hit_info.position = world_position;
   hit_info.material = object->getMaterial();
 
-  hit_info.emitted_light =
-      hit_info.material->getEmissive(hit_info.bary_coords) * hit_info.material->getEmissiveIntensity();
-
   const linalg::Mat3d rotation_scale_matrix = object->getTransformationMatrix().topLeft3x3();
   const linalg::Vec3d tangent_world         = rotation_scale_matrix * hit_info.tangent;
   const linalg::Vec3d bitangent_world       = rotation_scale_matrix * hit_info.bitangent;
@@ -271,8 +385,36 @@ inline void transformHitInfoToWorldSpace(RayHitInfo& hit_info, const Ray& local_
 
   const linalg::Mat3d normal_matrix = object->getNormalMatrix();
   hit_info.normal                   = (normal_matrix * hit_info.normal).normalized();
+  hit_info.geometric_normal         = (normal_matrix * hit_info.geometric_normal).normalized();
   hit_info.tangent                  = (normal_matrix * hit_info.tangent).normalized();
   hit_info.bitangent                = (normal_matrix * hit_info.bitangent).normalized();
+
+  hit_info.cone = {original_ray.cone.getWidth(hit_info.distance), original_ray.cone.spread_angle};
+  if(hit_info.area > 0.0) {
+    const double cos_theta = std::abs(linalg::dot(hit_info.geometric_normal, original_ray.direction));
+    hit_info.uv_footprint  = hit_info.cone.width * std::sqrt(hit_info.uv_area / hit_info.area) /
+                            std::max(cos_theta, MIN_RAY_CONE_COSINE);
+  }
+
+  hit_info.emitted_light = hit_info.material->getRecord().getEmission(hit_info.bary_coords, hit_info.uv_footprint);
+}
+
+/**
+ * @brief Creates a ray leaving a surface, with its origin offset to avoid intersecting the surface again.
+ *
+ * The new ray continues the cone of the incoming ray, starting with its width at the hit point.
+ *
+ * @param hit_info The hit information of the surface point.
+ * @param direction The direction of the new ray.
+ * @return The spawned ray.
+ */
+inline Ray spawnRay(const RayHitInfo& hit_info, const linalg::Vec3d& direction) {
+  const linalg::Vec3d& normal        = hit_info.geometric_normal;
+  const linalg::Vec3d  offset_normal = linalg::dot(normal, direction) >= 0.0 ? normal : -normal;
+  Ray                  ray           = Ray::FromDirection(offsetRayOrigin(hit_info.position, offset_normal), direction);
+
+  ray.cone = hit_info.cone;
+  return ray;
 }
 
 /**
@@ -0,0 +1,183 @@
+/**
+ * @file WavefrontPathTracer.hpp
+ * @brief Header file for the WavefrontPathTracer class.
+ */
+#ifndef RENDERING_PATHTRACER_WAVEFRONTPATHTRACER_HPP
+#define RENDERING_PATHTRACER_WAVEFRONTPATHTRACER_HPP
+
+#include <cstddef>
+#include <linalg/Vec3.hpp>
+#include <vector>
+
+#include "Core/Color.hpp"
+#include "Core/ImageTypes.hpp"
+#include "Core/Ray.hpp"
+#include "Rendering/PathTracer/PathStatistics.hpp"
+#include "Rendering/PathTracer/PathTracer.hpp"
+#include "Rendering/PathTracer/RayIntersection.hpp"
+#include "Rendering/RenderSettings.hpp"
+
+class CameraRayEmitter;
+class Framebuffer;
+class Scene;
+
+/**
+ * @struct PathQueue
+ * @brief Structure of arrays holding the state of the paths waiting for their next intersection.
+ */
+struct PathQueue {
+  std::vector<linalg::Vec3d> origin;
+  std::vector<linalg::Vec3d> direction;
+  std::vector<ColorRGB>      throughput;
+  std::vector<double>        brdf_pdf;     ///< Pdf of the BRDF sample that generated the ray.
+  std::vector<double>        brdf_pdf_sum; ///< Sum of the BRDF strategy pdfs, used by the balance heuristic.
+  std::vector<int>           pixel_index;  ///< Index of the pixel in the tile being rendered.
+  std::vector<RayCone>       cone;         ///< Footprint of the ray, used to filter the textures it hits.
+  std::vector<PathState>     state;        ///< Bounce counts and regularization state of the path.
+
+  /**
+   * @brief Appends a path to the queue.
+   */
+  void push(const Ray& ray, const ColorRGB& path_throughput, double pdf, double pdf_sum, int pixel,
+            const PathState& path_state = PathState());
+
+  /**
+   * @brief Removes every path from the queue, keeping the allocated memory.
+   */
+  void clear();
+
+  /**
+   * @brief Gets the number of paths in the queue.
+   * @return The number of paths.
+   */
+  std::size_t size() const { return pixel_index.size(); }
+};
+
+/**
+ * @struct ShadowQueue
+ * @brief Structure of arrays holding the light sampling rays produced by the shading stage.
+ */
+struct ShadowQueue {
+  std::vector<linalg::Vec3d> origin;
+  std::vector<linalg::Vec3d> direction;
+  std::vector<ColorRGB>      contribution; ///< Throughput * BRDF * cosine, before light pdf and MIS weighting.
+  std::vector<double>        brdf_pdf_sum; ///< Sum of the BRDF strategy pdfs for the light direction.
+  std::vector<int>           pixel_index;  ///< Index of the pixel in the tile being rendered.
+
+  /**
+   * @brief Appends a shadow ray to the queue.
+   */
+  void push(const linalg::Vec3d& ray_origin, const linalg::Vec3d& ray_direction, const ColorRGB& ray_contribution,
+            double pdf_sum, int pixel);
+
+  /**
+   * @brief Removes every shadow ray from the queue, keeping the allocated memory.
+   */
+  void clear();
+
+  /**
+   * @brief Gets the number of shadow rays in the queue.
+   * @return The number of shadow rays.
+   */
+  std::size_t size() const { return pixel_index.size(); }
+};
+
+/**
+ * @class WavefrontPathTracer
+ * @brief Queue-based path tracer processing a whole tile of paths stage by stage.
+ *
+ * Instead of following each path to completion, every stage (generate, intersect, shade, shadow, accumulate) is run
+ * over all the live paths before moving to the next one. Paths are sorted by material before shading and extension
+ * rays are sorted by direction before intersection so that each stage works on coherent data. Shading uses the
+ * batched BRDF kernel of PBRBatch. The estimator is the same as PathTracer::traceRay.
+ */
+class WavefrontPathTracer {
+private:
+  struct ShadingItem {
+    const Material* material;
+    int             octant;
+    int             path;
+  };
+
+  RenderSettings          m_default_render_settings; ///< Read until render settings are set.
+  const Scene*            m_scene           = nullptr;
+  const RenderSettings*   m_render_settings = &m_default_render_settings;
+  const CameraRayEmitter* m_ray_emitter     = nullptr;
+  double                  m_dx              = 1.0;
+  double                  m_dy              = 1.0;
+
+  PathQueue                m_paths;
+  PathQueue                m_extension_paths;
+  ShadowQueue              m_shadow_rays;
+  std::vector<RayHitInfo>  m_hits;
+  std::vector<ShadingItem> m_shading_items;
+  std::vector<ColorRGB>    m_radiance;
+  PathStatistics           m_statistics;
+
+  bool     isValidHit(double distance) const;
+  ColorRGB clampIndirect(const ColorRGB& radiance, int bounce_count) const;
+
+  static int DirectionOctant(const linalg::Vec3d& direction);
+
+  void generate(const PixelCoord& pixel_start, const PixelCoord& pixel_end, const PixelCoord& subpixel_grid_pos,
+                double cell_size);
+  void intersect(int depth);
+  void sortByMaterial();
+  void shade(int depth);
+  void traceShadowRays(int depth);
+  void sortExtensionRaysByDirection();
+  void accumulate(Framebuffer* framebuffer, const PixelCoord& pixel_start, const PixelCoord& pixel_end,
+                  double sample_weight) const;
+
+public:
+  WavefrontPathTracer() = default; ///< Default constructor.
+
+  WavefrontPathTracer(const WavefrontPathTracer&)            = delete;
+  WavefrontPathTracer& operator=(const WavefrontPathTracer&) = delete;
+  WavefrontPathTracer(WavefrontPathTracer&&)                 = delete;
+  WavefrontPathTracer& operator=(WavefrontPathTracer&&)      = delete;
+
+  /**
+   * @brief Sets the scene to trace paths in.
+   * @param scene The scene.
+   */
+  void setScene(const Scene* scene) { m_scene = scene; }
+
+  /**
+   * @brief Sets the render settings providing the path depth, clamping and regularization parameters.
+   * @param render_settings The render settings, nullptr for the default ones.
+   */
+  void setRenderSettings(const RenderSettings* render_settings) {
+    m_render_settings = render_settings != nullptr ? render_settings : &m_default_render_settings;
+  }
+
+  /**
+   * @brief Sets the camera used to generate the primary rays.
+   * @param ray_emitter The camera ray emitter, already initialized for the frame.
+   * @param dx The horizontal step size between pixels in normalized coordinates.
+   * @param dy The vertical step size between pixels in normalized coordinates.
+   */
+  void setCamera(const CameraRayEmitter* ray_emitter, double dx, double dy);
+
+  /**
+   * @brief Renders one sample for every pixel of a tile and accumulates it into the framebuffer.
+   * @param framebuffer The framebuffer receiving the radiance (current thread buffer).
+   * @param pixel_start The first pixel of the tile.
+   * @param pixel_end The pixel past the last one of the tile.
+   * @param sample_weight The weight of the sample.
+   * @param subpixel_grid_pos The subpixel grid position within the pixels.
+   * @param cell_size The size of the cell in the subpixel grid.
+   */
+  void renderTile(Framebuffer* framebuffer, const PixelCoord& pixel_start, const PixelCoord& pixel_end,
+                  double sample_weight, const PixelCoord& subpixel_grid_pos, double cell_size);
+
+  /**
+   * @brief Gets the per-depth counters of the tiles rendered so far.
+   * @return The path statistics.
+   */
+  const PathStatistics& getStatistics() const { return m_statistics; }
+
+  ~WavefrontPathTracer() = default; ///< Default destructor.
+};
+
+#endif // RENDERING_PATHTRACER_WAVEFRONTPATHTRACER_HPP
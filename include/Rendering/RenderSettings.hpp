@@ -6,6 +6,7 @@
 #define RENDERING_RENDERSETTINGS_HPP
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstdint>
 #include <memory>
@@ -15,7 +16,11 @@
 #include "Core/Config.hpp"
 #include "Core/ImageTypes.hpp"
 
-enum class RenderMode : std::uint8_t { SINGLE_THREADED, MULTI_THREADED_CPU, GPU_CUDA };
+enum class RenderMode : std::uint8_t { SINGLE_THREADED, MULTI_THREADED_CPU, WAVEFRONT_CPU, GPU_CUDA };
+
+enum class BounceType : std::uint8_t { DIFFUSE, GLOSSY, TRANSMISSION };
+
+static constexpr int BOUNCE_TYPE_COUNT = 3;
 
 /**
  * @class RenderSettings
@@ -32,6 +37,16 @@ private:
 
   int m_samples_per_pixels = DEFAULT_SAMPLES_PER_PIXEL;
 
+  int                                m_max_path_depth       = DEFAULT_MAX_PATH_DEPTH;
+  std::array<int, BOUNCE_TYPE_COUNT> m_max_bounces          = {DEFAULT_MAX_BOUNCES, DEFAULT_MAX_BOUNCES,
+                                                                DEFAULT_MAX_BOUNCES};
+  int                                m_roulette_start_depth = DEFAULT_ROULETTE_START_DEPTH;
+
+  double m_indirect_clamp           = DEFAULT_INDIRECT_CLAMP;
+  bool   m_path_regularization      = false;
+  double m_regularization_roughness = DEFAULT_REGULARIZATION_ROUGHNESS;
+  double m_lod_distance             = DEFAULT_LOD_DISTANCE;
+
   RenderMode m_render_mode = RenderMode::SINGLE_THREADED;
 
   int          m_chunk_size   = DEFAULT_CHUNK_SIZE;
@@ -108,6 +123,109 @@ public:
    */
   void setSamplesPerPixel(int samples_per_pixels);
 
+  /**
+   * @brief Get the maximum number of bounces of a path.
+   * @return The maximum path depth.
+   */
+  int getMaxPathDepth() const { return m_max_path_depth; }
+
+  /**
+   * @brief Set the maximum number of bounces of a path, on top of Russian roulette.
+   * The depth will be clamped to a valid range between MIN_MAX_PATH_DEPTH and MAX_MAX_PATH_DEPTH.
+   * @param max_path_depth The maximum path depth.
+   */
+  void setMaxPathDepth(int max_path_depth) {
+    m_max_path_depth = std::clamp(max_path_depth, MIN_MAX_PATH_DEPTH, MAX_MAX_PATH_DEPTH);
+  }
+
+  /**
+   * @brief Get the maximum number of bounces of a given type along a path.
+   * @param type The bounce type.
+   * @return The maximum number of bounces of this type.
+   */
+  int getMaxBounces(BounceType type) const { return m_max_bounces[static_cast<int>(type)]; }
+
+  /**
+   * @brief Set the maximum number of bounces of a given type along a path.
+   * The count will be clamped to a valid range between MIN_MAX_BOUNCES and MAX_MAX_BOUNCES.
+   * @param type The bounce type.
+   * @param max_bounces The maximum number of bounces of this type.
+   */
+  void setMaxBounces(BounceType type, int max_bounces) {
+    m_max_bounces[static_cast<int>(type)] = std::clamp(max_bounces, MIN_MAX_BOUNCES, MAX_MAX_BOUNCES);
+  }
+
+  /**
+   * @brief Get the number of bounces every path goes through before Russian roulette may terminate it.
+   * @return The depth at which Russian roulette starts.
+   */
+  int getRouletteStartDepth() const { return m_roulette_start_depth; }
+
+  /**
+   * @brief Set the number of bounces every path goes through before Russian roulette may terminate it.
+   * The depth will be clamped to a valid range between MIN_ROULETTE_START_DEPTH and MAX_ROULETTE_START_DEPTH.
+   * @param depth The depth at which Russian roulette starts.
+   */
+  void setRouletteStartDepth(int depth) {
+    m_roulette_start_depth = std::clamp(depth, MIN_ROULETTE_START_DEPTH, MAX_ROULETTE_START_DEPTH);
+  }
+
+  /**
+   * @brief Get the maximum value of a single indirect radiance sample.
+   * @return The clamp value, 0 when clamping is disabled.
+   */
+  double getIndirectClamp() const { return m_indirect_clamp; }
+
+  /**
+   * @brief Set the maximum value of a single indirect radiance sample.
+   * Samples brighter than this value are scaled down, trading a small bias for far fewer fireflies.
+   * @param indirect_clamp The clamp value, 0 disables clamping.
+   */
+  void setIndirectClamp(double indirect_clamp) {
+    m_indirect_clamp = std::clamp(indirect_clamp, MIN_INDIRECT_CLAMP, MAX_INDIRECT_CLAMP);
+  }
+
+  /**
+   * @brief Check whether path regularization is enabled.
+   * @return True if the roughness is raised after the first glossy bounce.
+   */
+  bool isPathRegularizationEnabled() const { return m_path_regularization; }
+
+  /**
+   * @brief Enable or disable path regularization.
+   * @param enabled True to raise the roughness of the vertices following the first glossy bounce of a path.
+   */
+  void setPathRegularization(bool enabled) { m_path_regularization = enabled; }
+
+  /**
+   * @brief Get the minimum roughness used by path regularization.
+   * @return The minimum roughness.
+   */
+  double getRegularizationRoughness() const { return m_regularization_roughness; }
+
+  /**
+   * @brief Set the minimum roughness used by path regularization.
+   * The roughness will be clamped to a valid range between MIN_REGULARIZATION_ROUGHNESS and
+   * MAX_REGULARIZATION_ROUGHNESS.
+   * @param roughness The minimum roughness.
+   */
+  void setRegularizationRoughness(double roughness) {
+    m_regularization_roughness = std::clamp(roughness, MIN_REGULARIZATION_ROUGHNESS, MAX_REGULARIZATION_ROUGHNESS);
+  }
+
+  /**
+   * @brief Get the distance beyond which secondary rays intersect the simplified levels of detail of the meshes.
+   * @return The distance, 0 when every ray intersects the full meshes.
+   */
+  double getLODDistance() const { return m_lod_distance; }
+
+  /**
+   * @brief Set the distance beyond which secondary rays intersect the simplified levels of detail of the meshes.
+   * The distance will be clamped to a valid range between MIN_LOD_DISTANCE and MAX_LOD_DISTANCE.
+   * @param distance The distance, 0 to intersect the full meshes with every ray.
+   */
+  void setLODDistance(double distance) { m_lod_distance = std::clamp(distance, MIN_LOD_DISTANCE, MAX_LOD_DISTANCE); }
+
   /**
    * @brief Get the mode for rendering.
    * @return The current render mode.
@@ -6,12 +6,14 @@
 #define RENDERING_RENDERER_HPP
 
 #include <memory>
+#include <mutex>
 
 #include "Core/Color.hpp"
 #include "Core/Framebuffer.hpp"
 #include "Core/ImageTypes.hpp"
 #include "Core/Observer.hpp"
 #include "Rendering/CameraRayEmitter.hpp"
+#include "Rendering/PathTracer/PathStatistics.hpp"
 #include "Rendering/PathTracer/PathTracer.hpp"
 #include "Rendering/PathTracer/RayIntersection.hpp"
 #include "Rendering/RenderSettings.hpp"
@@ -40,6 +42,9 @@ private:
   PathTracer       m_path_tracer;
   RenderTime       m_render_time;
 
+  PathStatistics m_path_statistics;
+  std::mutex     m_path_statistics_mutex;
+
   std::atomic<bool> m_stop_requested = false;
 
   Observer<double> m_render_progress_observer;
@@ -72,6 +77,18 @@ public:
    */
   RenderTime* getRenderTime() { return &m_render_time; }
 
+  /**
+   * @brief Gets the per-depth path statistics of the last rendered frame.
+   * @return A constant reference to the path statistics.
+   */
+  const PathStatistics& getPathStatistics() const { return m_path_statistics; }
+
+  /**
+   * @brief Adds the path statistics gathered by a rendering thread to the frame statistics. Thread-safe.
+   * @param statistics The statistics to add.
+   */
+  void mergePathStatistics(const PathStatistics& statistics);
+
   /**
    * @brief Sets the scene to be rendered.
    * @param scene The new scene to render.
@@ -90,6 +107,12 @@ public:
    */
   const Scene& getScene() const { return *m_scene; }
 
+  /**
+   * @brief Gets the ray emitter generating the camera rays of the current frame.
+   * @return A constant reference to the camera ray emitter.
+   */
+  const CameraRayEmitter& getCameraRayEmitter() const { return m_camera_ray_emitter; }
+
   /**
    * @brief Gets the framebuffer used for storing the rendered image.
    * @return A pointer to the framebuffer.
@@ -141,10 +164,11 @@ public:
    * @param dy The vertical offset for the subpixel grid.
    * @param subpixel_grid_pos The subpixel grid position within the pixel.
    * @param cell_size The size of the cell in the subpixel grid.
+   * @param statistics Optional per-depth counters to update.
    * @return The color of the pixel as a ColorRGB object.
    */
   ColorRGB getPixelColor(const PixelCoord& pixel, double dx, double dy, const PixelCoord& subpixel_grid_pos,
-                         double cell_size) const;
+                         double cell_size, PathStatistics* statistics = nullptr) const;
 
   /**
    * @brief Renders a sample at a specific grid position.
@@ -160,10 +184,19 @@ public:
   void renderSample(const PixelCoord& pixel_start, const PixelCoord& pixel_end, double sample_weight,
                     const PixelCoord& subpixel_grid_pos, double cell_size);
 
+  /**
+   * @brief Prepares the scene for the next frame, on the thread owning the scene.
+   *
+   * Tessellates the subdivision surfaces for the camera. The viewport reads their meshes, so they are not replaced
+   * while renderFrame() runs on a thread of its own. Does nothing without a camera.
+   */
+  void prepareFrame();
+
   /**
    * @brief Renders a frame of the scene.
    *
-   * This method renders a full frame based on the current settings, scene, and camera setup.
+   * This method renders a full frame based on the current settings, scene, and camera setup. The subdivision surfaces
+   * are rendered as tessellated by the last call to prepareFrame().
    */
   bool renderFrame();
 
@@ -0,0 +1,44 @@
+/**
+ * @file WavefrontCPU.hpp
+ * @brief Header file for the WavefrontCPU class.
+ */
+#ifndef RENDERING_WAVEFRONTCPU_HPP
+#define RENDERING_WAVEFRONTCPU_HPP
+
+#include <memory>
+#include <vector>
+
+#include "Rendering/MultiThreadedCPU.hpp"
+#include "Rendering/PathTracer/WavefrontPathTracer.hpp"
+
+/**
+ * @class WavefrontCPU
+ * @brief A rendering strategy that renders chunks with the queue-based WavefrontPathTracer.
+ *
+ * Chunks are distributed to the worker threads like in MultiThreadedCPU, but each thread traces all the paths of its
+ * chunk stage by stage instead of one path at a time. Every thread owns its own queues, which are reused from one
+ * chunk to the next.
+ */
+class WavefrontCPU : public MultiThreadedCPU {
+private:
+  std::vector<std::unique_ptr<WavefrontPathTracer>> m_path_tracers;
+
+protected:
+  void renderChunk(int thread_id, const Chunk& chunk, double sample_weight, double cell_size) override;
+
+public:
+  /**
+   * @brief Constructor for WavefrontCPU.
+   * @param chunk_size The size of each chunk in pixels.
+   * @param thread_count The number of threads to use for rendering.
+   */
+  explicit WavefrontCPU(int chunk_size, unsigned int thread_count);
+
+  /**
+   * @brief Renders the scene with one wavefront path tracer per thread.
+   * @return True if rendering was successful, false otherwise.
+   */
+  bool render() override;
+};
+
+#endif // RENDERING_WAVEFRONTCPU_HPP
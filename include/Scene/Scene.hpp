@@ -204,10 +204,21 @@ public:
    */
   Skybox* getSkybox() const { return m_skybox.get(); }
 
+  /**
+   * @brief Tessellates the subdivision surfaces for a point of view, before their BVH is built.
+   *
+   * The level of each surface brings the edges of its cage, seen from the nearest point of its bounds, down to about
+   * SUBDIVISION_EDGE_PIXELS pixels: see MeshSubdivider::selectLevel().
+   * @param eye The position of the camera.
+   * @param pixel_angle The angle covered by a pixel, in radians: the size of a pixel seen at a distance of 1.
+   */
+  void tessellateSubdivisionSurfaces(const linalg::Vec3d& eye, double pixel_angle);
+
   /**
    * @brief Builds the bounding volume hierarchy (BVH) for the objects in the scene.
+   * @param with_lods True to also build the levels of detail of the meshes, intersected by distant secondary rays.
    */
-  void buildBVH();
+  void buildBVH(bool with_lods = false);
 
   /**
    * @brief Gets the bounding volume hierarchy (BVH) root node.
@@ -0,0 +1,147 @@
+/**
+ * @file SceneImporter.hpp
+ * @brief Header file for the SceneImporter class, importing mesh files into a scene in the background.
+ */
+#ifndef SCENE_SCENEIMPORTER_HPP
+#define SCENE_SCENEIMPORTER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Core/Observer.hpp"
+#include "Geometry/OBJLoader.hpp"
+
+class Mesh;
+class Scene;
+class ThreadPool;
+
+/**
+ * @enum ImportStatus
+ * @brief Outcome of an import, given to the observers once it is over.
+ */
+enum class ImportStatus : std::uint8_t {
+  COMPLETED, ///< The object was added to the scene.
+  FAILED,    ///< The file could not be read or holds no face.
+  CANCELLED  ///< The import was cancelled before the object was added to the scene.
+};
+
+/**
+ * @class SceneImporter
+ * @brief Imports OBJ files into a scene without blocking the calling thread.
+ *
+ * Up to MAX_CONCURRENT_IMPORTS files are loaded at once on worker threads, the others wait in the queue. The hardware
+ * threads are shared among the running imports to parse the chunks of their files, so that a single large file still
+ * uses them all. The loaded meshes are added to the scene by processImports, on the thread owning the importer, since
+ * the scene observers (GPU upload, widgets) expect to be notified there.
+ */
+class SceneImporter {
+public:
+  using ImportID = std::size_t;
+
+private:
+  struct PendingImport {
+    ImportID                                 id;
+    std::string                              base_name;
+    std::shared_ptr<OBJLoader::LoadControl>  control; ///< Shared with the worker thread.
+    std::future<std::shared_ptr<const Mesh>> loaded;
+    double                                   reported_progress = -1.0;
+  };
+
+  Scene* m_scene;
+
+  std::unique_ptr<ThreadPool> m_import_pool; ///< Created on the first import.
+  std::vector<PendingImport>  m_pending_imports;
+  ImportID                    m_next_id = 0;
+  std::atomic<unsigned int>   m_running_imports{0};
+
+  Observer<ImportID, double>                    m_import_progress_observer;
+  Observer<ImportID, ImportStatus, std::string> m_import_finished_observer;
+
+public:
+  /**
+   * @brief Constructor for the SceneImporter class.
+   * @param scene The scene receiving the imported objects, which must outlive the importer.
+   */
+  explicit SceneImporter(Scene* scene);
+
+  SceneImporter(const SceneImporter&)            = delete;
+  SceneImporter& operator=(const SceneImporter&) = delete;
+  SceneImporter(SceneImporter&&)                 = delete;
+  SceneImporter& operator=(SceneImporter&&)      = delete;
+
+  /**
+   * @brief Notified by processImports with the progress, between 0 and 1, of the imports still running.
+   * @return The observer of the import progress.
+   */
+  Observer<ImportID, double>& getImportProgressObserver() { return m_import_progress_observer; }
+
+  /**
+   * @brief Notified by processImports once an import is over, with the name of the object added to the scene
+   * (empty unless the import completed).
+   * @return The observer of the finished imports.
+   */
+  Observer<ImportID, ImportStatus, std::string>& getImportFinishedObserver() { return m_import_finished_observer; }
+
+  /**
+   * @brief Queues the import of an OBJ file, read through its mesh cache.
+   * @param path The path of the OBJ file.
+   * @param base_name The base name of the object, made unique when it is added to the scene.
+   * @return The identifier of the import, given to the observers.
+   */
+  ImportID importOBJ(const std::string& path, const std::string& base_name);
+
+  /**
+   * @brief Cancels an import. Its file stops being parsed and its observers are notified by the next processImports
+   * once the worker thread has let it go.
+   * @param id The identifier of the import.
+   * @return True if the import was pending, false if it is unknown or already over.
+   */
+  bool cancelImport(ImportID id);
+
+  /**
+   * @brief Cancels every pending import.
+   */
+  void cancelAllImports();
+
+  /**
+   * @brief Adds the objects loaded so far to the scene and notifies the observers of the finished imports and of the
+   * progress of the others.
+   * @return The number of imports that are over.
+   */
+  int processImports();
+
+  /**
+   * @brief Waits for every pending import to be loaded and processes them.
+   */
+  void waitForImports();
+
+  /**
+   * @brief Checks whether imports are still waiting to be processed.
+   * @return True if processImports still has work to do.
+   */
+  bool hasPendingImports() const { return !m_pending_imports.empty(); }
+
+  /**
+   * @brief Gets the number of imports still waiting to be processed.
+   * @return The number of pending imports.
+   */
+  std::size_t getPendingImportCount() const { return m_pending_imports.size(); }
+
+  /**
+   * @brief Gets the progress of the pending imports taken together.
+   * @return The mean progress of the pending imports, between 0 and 1; 1 if there is none.
+   */
+  double getProgress() const;
+
+  /**
+   * @brief Cancels the pending imports and waits for the worker threads to let them go.
+   */
+  ~SceneImporter();
+};
+
+#endif // SCENE_SCENEIMPORTER_HPP
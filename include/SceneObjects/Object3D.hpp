@@ -7,10 +7,13 @@
 #define SCENEOBJECTS_OBJECT3D_HPP
 
 #include <linalg/Vec3.hpp>
+#include <memory>
+#include <utility>
 
 #include "Core/Observer.hpp"
 #include "Core/Transform.hpp"
 #include "Geometry/Mesh.hpp"
+#include "Geometry/Primitive.hpp"
 
 class Material;
 
@@ -20,23 +23,67 @@ class Material;
  *
  * This class inherits from Transform and encapsulates a Mesh. It provides
  * functionality for setting, getting, and cloning the 3D object.
+ * The mesh is shared and immutable: objects built from the same mesh pointer use a single copy of the geometry, and
+ * only build its BVH, tangents and levels of detail through the internally synchronized const methods of Mesh.
+ * An object can also be an analytic primitive: the ray tracer then intersects the shape in closed form, while the
+ * viewport keeps drawing the mesh tessellating it. Emitters are still intersected as their mesh, see
+ * isIntersectedAnalytically().
+ * An object can also be a subdivision surface: the mesh is then its control cage, drawn by the viewport, and the ray
+ * tracer intersects the tessellation of the surface built by setSubdivisionLevel().
  */
 class Object3D : public Transform {
 private:
-  Mesh      m_mesh;
-  Material* m_material;
+  std::shared_ptr<const Mesh> m_mesh;
+  Material*                   m_material;
+  Primitive                   m_primitive;
+
+  bool                        m_subdivision_surface = false;
+  int                         m_subdivision_level   = 0;
+  std::shared_ptr<const Mesh> m_subdivided_mesh; ///< Tessellation of the subdivision surface, null at level 0.
+
+  linalg::Vec3d m_min_bound = {0.0, 0.0, 0.0};
+  linalg::Vec3d m_max_bound = {0.0, 0.0, 0.0};
 
   Observer<const Object3D*> m_material_changed_observer;
   Observer<const Object3D*> m_object_deleted_observer;
 
+  /**
+   * @brief Transforms the bounding box of the mesh into world space.
+   *
+   * Called when the shape or the transformation changes, so that getting the bounds does not scan the vertices.
+   * The result encloses the transformed box of the mesh, or of the primitive when it is analytic. It can be larger
+   * than the box of the transformed shape.
+   */
+  void updateBounds();
+
 public:
   Object3D(); ///< Default constructor.
 
   /**
    * @brief Constructs an Object3D with a specified mesh.
-   * @param mesh The mesh to associate with the Object3D.
+   * @param mesh The mesh to associate with the Object3D, moved in when passed as an rvalue.
    */
-  explicit Object3D(const Mesh& mesh);
+  explicit Object3D(Mesh mesh);
+
+  /**
+   * @brief Constructs an Object3D sharing a mesh with other objects.
+   * @param mesh The mesh to associate with the Object3D, an empty mesh if null.
+   */
+  explicit Object3D(std::shared_ptr<const Mesh> mesh);
+
+  /**
+   * @brief Constructs an Object3D that the ray tracer intersects as an analytic primitive.
+   * @param mesh The mesh tessellating the primitive, drawn by the viewport, moved in when passed as an rvalue.
+   * @param primitive The primitive intersected by the ray tracer.
+   */
+  Object3D(Mesh mesh, const Primitive& primitive);
+
+  /**
+   * @brief Constructs an Object3D that the ray tracer intersects as an analytic primitive, sharing its mesh.
+   * @param mesh The mesh tessellating the primitive, drawn by the viewport, an empty mesh if null.
+   * @param primitive The primitive intersected by the ray tracer.
+   */
+  Object3D(std::shared_ptr<const Mesh> mesh, const Primitive& primitive);
 
   Object3D(const Object3D&)            = delete;
   Object3D& operator=(const Object3D&) = delete;
@@ -57,9 +104,68 @@ public:
 
   /**
    * @brief Sets the mesh for this 3D object.
-   * @param mesh The mesh to set.
+   * @param mesh The mesh to set, moved in when passed as an rvalue.
+   */
+  void setMesh(Mesh mesh) { setMesh(std::make_shared<const Mesh>(std::move(mesh))); }
+
+  /**
+   * @brief Sets a mesh shared with other objects.
+   *
+   * The object is no longer an analytic primitive: the new mesh may not tessellate it. A subdivision surface takes
+   * the mesh as its new cage, back at level 0.
+   * @param mesh The mesh to set, an empty mesh if null.
+   */
+  void setMesh(std::shared_ptr<const Mesh> mesh);
+
+  /**
+   * @brief Sets the analytic shape intersected by the ray tracer instead of the mesh.
+   *
+   * The mesh is still drawn by the viewport, it should tessellate the primitive: see MeshBuilder::getPrimitive().
+   * @param primitive The primitive, of type MESH to intersect the mesh again.
+   */
+  void setPrimitive(const Primitive& primitive);
+
+  /**
+   * @brief Gets the analytic shape intersected by the ray tracer.
+   * @return The primitive, of type MESH when the ray tracer intersects the mesh.
+   */
+  const Primitive& getPrimitive() const { return m_primitive; }
+
+  /**
+   * @brief Tells whether the ray tracer intersects the primitive rather than the mesh.
+   *
+   * The light sampling picks the triangles of the emitters: they are hit as their mesh too, so that the densities of
+   * light and BSDF sampling weighed by MIS are taken over the same surface.
+   * @return True for an analytic primitive whose material does not emit light.
+   */
+  bool isIntersectedAnalytically() const;
+
+  /**
+   * @brief Tags the mesh as the control cage of a Loop subdivision surface, or as a plain mesh again.
+   * @param subdivision_surface Whether the object is a subdivision surface.
+   */
+  void setSubdivisionSurface(bool subdivision_surface);
+
+  /**
+   * @brief Tells whether the mesh is the control cage of a subdivision surface.
+   * @return True for a subdivision surface.
+   */
+  bool isSubdivisionSurface() const { return m_subdivision_surface; }
+
+  /**
+   * @brief Tessellates the subdivision surface, when the level changes.
+   *
+   * The tessellation stays within the bounding box of the cage, the bounds of the object do not change.
+   * @param level The number of subdivision steps, 0 to intersect the cage. Ignored unless the object is a subdivision
+   * surface.
+   */
+  void setSubdivisionLevel(int level);
+
+  /**
+   * @brief Gets the number of subdivision steps of the tessellation intersected by the ray tracer.
+   * @return The level, 0 for the cage or a plain mesh.
    */
-  void setMesh(const Mesh& mesh) { this->m_mesh = mesh; }
+  int getSubdivisionLevel() const { return m_subdivision_level; }
 
   /**
    * @brief Sets the material for this 3D object.
@@ -69,41 +175,56 @@ public:
 
   /**
    * @brief Gets the mesh associated with this 3D object.
-   * @return The mesh of the 3D object.
+   * @return The mesh of the 3D object, the cage of a subdivision surface.
    */
-  const Mesh& getMesh() const { return m_mesh; }
+  const Mesh& getMesh() const { return *m_mesh; }
 
   /**
-   * @brief Gets a modifiable reference to the mesh of this 3D object.
-   * @return A reference to the mesh of the 3D object.
+   * @brief Gets the mesh intersected by the ray tracer.
+   * @return The tessellation of a subdivision surface, the mesh of the object otherwise.
    */
-  Mesh& getMesh() { return m_mesh; }
+  const Mesh& getRenderMesh() const { return m_subdivided_mesh != nullptr ? *m_subdivided_mesh : *m_mesh; }
 
   /**
-   * @brief Gets the material associated with this 3D object.
-   * @return The material of the 3D object.
+   * @brief Builds the BVH of the render mesh, shared with the other objects using the mesh.
+   *
+   * Objects intersected analytically do not use the mesh, they have no BVH to build.
    */
-  Material* getMaterial() const;
+  void buildMeshBVH() {
+    if(!isIntersectedAnalytically()) {
+      getRenderMesh().buildBVH();
+    }
+  }
+
+  /**
+   * @brief Builds the levels of detail of the render mesh, shared with the other objects using the mesh.
+   *
+   * The viewport draws getMesh() instead, and builds its levels and tangents on it.
+   */
+  void buildMeshLODs() { getRenderMesh().buildLODs(); }
 
   /**
-   * @brief Computes the bounding box of the object.
-   * @param comparator A function to compare two Vec3d objects.
-   * @return The bounding box as a Vec3d.
+   * @brief Builds the tangents of the render mesh if the material of the object uses a normal map.
    */
-  linalg::Vec3d
-  computeBound(const std::function<linalg::Vec3d(const linalg::Vec3d&, const linalg::Vec3d&)>& comparator) const;
+  void buildMeshTangentsIfNeeded();
+
+  /**
+   * @brief Gets the material associated with this 3D object.
+   * @return The material of the 3D object.
+   */
+  Material* getMaterial() const;
 
   /**
    * @brief Gets the minimum bounding box corner of the object.
-   * @return The minimum bounding box corner as a Vec3d.
+   * @return The minimum bounding box corner in world space.
    */
-  linalg::Vec3d getMinBound() const;
+  const linalg::Vec3d& getMinBound() const { return m_min_bound; }
 
   /**
    * @brief Gets the maximum bounding box corner of the object.
-   * @return The maximum bounding box corner as a Vec3d.
+   * @return The maximum bounding box corner in world space.
    */
-  linalg::Vec3d getMaxBound() const;
+  const linalg::Vec3d& getMaxBound() const { return m_max_bound; }
 
   ~Object3D(); ///< Default destructor.
 };
@@ -10,6 +10,7 @@
 #include "Core/Color.hpp"
 #include "Core/ImageTypes.hpp"
 #include "Core/Observer.hpp"
+#include "Surface/MaterialRecord.hpp"
 #include "Surface/TextureManager.hpp"
 
 class Texture;
@@ -41,11 +42,16 @@ private:
   bool     m_use_texture_transmission = false;
 
   double m_index_of_refraction = 1.0;
+  int    m_dielectric_priority = 0;
+
+  MaterialRecord m_record;
 
   Observer<const Material*> m_material_changed_observer;
 
+  void notifyChanged();
+
 public:
-  Material() = default; ///< Default constructor.
+  Material(); ///< Default constructor.
 
   Material(const Material&)            = delete;
   Material(Material&&)                 = delete;
@@ -76,6 +82,14 @@ public:
    */
   Texture* getNormalTexture() const { return m_normal_texture; }
 
+  /**
+   * @brief Tells whether this material perturbs the normals with a texture, and so needs tangents.
+   * @return True if the normal texture is set and is not the default flat one.
+   */
+  bool hasNormalMap() const {
+    return m_normal_texture != nullptr && m_normal_texture != TextureManager::DefaultNormalTexture();
+  }
+
   /**
    * @brief Sets the normal texture for this material.
    * @param texture The texture to set as the normal texture.
@@ -196,34 +210,44 @@ public:
    */
   void setIndexOfRefraction(double ior);
 
+  /**
+   * @brief Sets the priority of this material among overlapping dielectrics.
+   *
+   * Inside a medium of higher priority, the surfaces of this material are ignored: a liquid slightly overlapping its
+   * glass only refracts at the glass boundary.
+   *
+   * @param priority The priority, higher wins.
+   */
+  void setDielectricPriority(int priority);
+
   /**
    * @brief Gets the albedo texture of this material.
    * @return The albedo texture.
    */
-  ColorRGB getDiffuse(TextureUV uv_coord) const;
+  ColorRGB getDiffuse(TextureUV uv_coord, double uv_footprint = 0.0) const;
   /**
    * @brief Gets the normal texture of this material.
    * @return The normal texture.
    */
-  ColorRGB getNormal(TextureUV uv_coord) const;
+  ColorRGB getNormal(TextureUV uv_coord, double uv_footprint = 0.0) const;
 
   /**
    * @brief Gets the roughness texture of this material.
    * @return The roughness texture.
    */
-  double getRoughness(TextureUV uv_coord) const;
+  double getRoughness(TextureUV uv_coord, double uv_footprint = 0.0) const;
 
   /**
    * @brief Gets the metallic texture of this material.
    * @return The metallic texture.
    */
-  double getMetalness(TextureUV uv_coord) const;
+  double getMetalness(TextureUV uv_coord, double uv_footprint = 0.0) const;
 
   /**
    * @brief Gets the emissive texture of this material.
    * @return The emissive texture.
    */
-  ColorRGB getEmissive(TextureUV uv_coord) const;
+  ColorRGB getEmissive(TextureUV uv_coord, double uv_footprint = 0.0) const;
 
   /**
    * @brief Gets the emissive intensity of this material.
@@ -235,7 +259,7 @@ public:
    * @brief Gets the transmission texture of this material.
    * @return The transmission texture.
    */
-  double getTransmission(TextureUV uv_coord) const;
+  double getTransmission(TextureUV uv_coord, double uv_footprint = 0.0) const;
 
   /**
    * @brief Gets the index of refraction of this material.
@@ -243,6 +267,25 @@ public:
    */
   double getIndexOfRefraction() const;
 
+  /**
+   * @brief Gets the priority of this material among overlapping dielectrics.
+   * @return The dielectric priority.
+   */
+  int getDielectricPriority() const { return m_dielectric_priority; }
+
+  /**
+   * @brief Rebuilds the record used while rendering, e.g. after the values of the textures changed.
+   *
+   * Called by every setter and by the scene before rendering.
+   */
+  void compile();
+
+  /**
+   * @brief Gets the flattened inputs of the material, as compiled by the last call to compile.
+   * @return The material record.
+   */
+  const MaterialRecord& getRecord() const { return m_record; }
+
   ~Material() = default; ///< Default destructor.
 };
 
@@ -0,0 +1,89 @@
+/**
+ * @file MaterialRecord.hpp
+ * @brief Header file for the MaterialRecord structure, the flattened form of a material used while rendering.
+ */
+#ifndef SURFACE_MATERIALRECORD_HPP
+#define SURFACE_MATERIALRECORD_HPP
+
+#include "Core/Color.hpp"
+#include "Core/ImageTypes.hpp"
+#include "Surface/Texture.hpp"
+
+/**
+ * @struct MaterialChannel1d
+ * @brief Scalar input of a material: a texture, or a constant when the value does not vary over the surface.
+ */
+struct MaterialChannel1d {
+  const Texture* texture = nullptr; ///< Sampled texture, nullptr when the value is constant.
+  double         value   = 0.0;
+
+  /**
+   * @brief Evaluates the channel.
+   * @param uv_coord The texture coordinates.
+   * @param uv_footprint The width of the sampled area in texture space.
+   * @return The value of the channel.
+   */
+  double sample(TextureUV uv_coord, double uv_footprint) const {
+    return texture == nullptr ? value : texture->getValue1d(uv_coord, uv_footprint);
+  }
+};
+
+/**
+ * @struct MaterialChannel3d
+ * @brief Color input of a material: a texture, or a constant when the color does not vary over the surface.
+ */
+struct MaterialChannel3d {
+  const Texture* texture = nullptr; ///< Sampled texture, nullptr when the color is constant.
+  ColorRGB       value   = ColorRGB(0.0);
+
+  /**
+   * @brief Evaluates the channel.
+   * @param uv_coord The texture coordinates.
+   * @param uv_footprint The width of the sampled area in texture space.
+   * @return The color of the channel.
+   */
+  ColorRGB sample(TextureUV uv_coord, double uv_footprint) const {
+    return texture == nullptr ? value : texture->getValue3d(uv_coord, uv_footprint);
+  }
+};
+
+/**
+ * @struct MaterialRecord
+ * @brief Flat copy of the inputs of a Material, compiled by Material::compile before rendering.
+ *
+ * Constant values (roughness and metalness sliders, colors set with Texture::setValue) are stored inline, so that
+ * evaluating them costs a branch instead of the wrapping, filtering and color space code of a 1x1 texture. Only the
+ * channels backed by an actual image keep a texture to sample.
+ */
+struct MaterialRecord {
+  MaterialChannel3d diffuse;
+  MaterialChannel3d normal;
+  MaterialChannel1d roughness;
+  MaterialChannel1d metalness;
+  MaterialChannel3d emissive;
+  MaterialChannel1d transmission;
+  double            emissive_intensity  = 0.0;
+  double            index_of_refraction = 1.0;
+  int               dielectric_priority = 0;
+
+  /**
+   * @brief Checks whether light can go through the surface, i.e. whether the material bounds a dielectric medium.
+   * @return True if the transmission is textured or not zero.
+   */
+  bool isTransmissive() const { return transmission.texture != nullptr || transmission.value > 0.0; }
+
+  /**
+   * @brief Evaluates the light emitted by the surface, skipping the emissive channel when the intensity is zero.
+   * @param uv_coord The texture coordinates.
+   * @param uv_footprint The width of the sampled area in texture space.
+   * @return The emitted radiance.
+   */
+  ColorRGB getEmission(TextureUV uv_coord, double uv_footprint) const {
+    if(emissive_intensity <= 0.0) {
+      return ColorRGB(0.0);
+    }
+    return emissive.sample(uv_coord, uv_footprint) * emissive_intensity;
+  }
+};
+
+#endif // SURFACE_MATERIALRECORD_HPP
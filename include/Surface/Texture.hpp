@@ -6,12 +6,14 @@
 #define SURFACE_TEXTURE_HPP
 
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 #include "Core/Color.hpp"
 #include "Core/ImageTypes.hpp"
 #include "Core/Observer.hpp"
 #include "Surface/TextureFiltering.hpp"
+#include "Surface/TextureStorage.hpp"
 #include "Surface/TextureWrapping.hpp"
 
 /**
@@ -33,6 +35,8 @@ enum class ColorSpace : std::uint8_t { LINEAR, S_RGB };
  */
 enum class TextureType : std::uint8_t { IMAGE_TEXTURE, COLOR_TEXTURE };
 
+class TiledTextureFile;
+
 /**
  * @class Texture
  * @brief Class representing a texture for 3D rendering.
@@ -44,8 +48,18 @@ enum class TextureType : std::uint8_t { IMAGE_TEXTURE, COLOR_TEXTURE };
  */
 class Texture {
 private:
-  std::vector<double>        m_image_data;
-  std::vector<unsigned char> m_texture_preview;
+  struct StreamedTile {
+    std::shared_ptr<const TextureStorage> texels;
+    int                                   tile_x = -1;
+    int                                   tile_y = -1;
+  };
+
+  TextureStorage              m_image_data;
+  TextureStorage              m_linear_image_data; ///< Linear copy of non 8-bit data, sampled in LINEAR color space.
+  std::vector<TextureStorage> m_mip_levels;        ///< Levels 1 to n of the mip pyramid, built for TRILINEAR filtering.
+  std::vector<unsigned char>  m_texture_preview;
+
+  std::shared_ptr<const TiledTextureFile> m_tiled_file; ///< Source of the tiles of streamed textures, null otherwise.
 
   TextureType m_texture_type = TextureType::IMAGE_TEXTURE;
 
@@ -60,15 +74,28 @@ private:
   TextureSampling::TextureWrapping  m_wrapping_mode  = TextureSampling::TextureWrapping::MIRRORED_REPEAT;
 
   ColorRGB m_border_color;
+  ColorRGB m_linear_border_color;
 
   Observer<> m_texture_data_observer;
   Observer<> m_texture_parameters_observer;
 
-  void      readPixelChannels(int x, int y, double* out) const;
-  ColorRGBA samplePixelColor(TextureUV uv) const;
+  template <typename Texel, typename Decoder>
+  void readPixelChannels(const Texel* data, const TextureLayout& layout, int x, int y, double* out,
+                         Decoder decode) const;
+  template <typename TexelReader>
+  ColorRGBA filterLevel(const TextureLayout& layout, TextureUV uv, TexelReader read) const;
+  void      readStreamedTexel(int level, int x, int y, StreamedTile& tile, bool to_linear, double* out) const;
+  const TextureStorage& getLevelStorage(int level) const;
+  ColorRGBA             sampleLevel(int level, TextureUV uv) const;
+  ColorRGBA             sampleStreamedLevel(int level, TextureUV uv) const;
+  ColorRGBA             samplePixelColor(TextureUV uv, double uv_footprint) const;
+
+  void updateLinearData();
+  void updateMipLevels();
 
   std::pair<int, int> computePreviewSize() const;
-  void                appendPixelFromSource(int src_x, int src_y, int channels, int original_width);
+  int                 computePreviewLevel(int preview_width, int preview_height) const;
+  void                appendPixelFromSource(int level, int src_x, int src_y, StreamedTile& tile);
   void                generateRescaledImage(int new_width, int new_height);
 
   void flipVertically();
@@ -122,16 +149,64 @@ public:
 
   /**
    * @brief Loads texture data from a file.
+   *
+   * Tiled texture files (.ltex, see TiledTextureFile) are not loaded into memory: the texture is streamed, its tiles
+   * being read on demand through TextureManager::TileCache() when it is sampled.
+   *
    * @param filename The path to the texture file to load.
    */
   void loadFromFile(const char* filename);
 
+  /**
+   * @brief Replaces the image with the one loaded by another texture, e.g. a staging texture filled on a worker thread.
+   *
+   * The image, its path and its preview are moved out of the source. The color space, filtering and wrapping modes of
+   * this texture are kept. Its linear data and mip levels are moved out of the source as well when the source shares
+   * its color space and filtering mode, and rebuilt otherwise.
+   *
+   * @param source The texture holding the loaded image, left empty.
+   */
+  void takeImageFrom(Texture& source);
+
+  /**
+   * @brief Checks if sampling the texture returns the same value everywhere, e.g. for colors set with setValue.
+   * @return True for single texel textures, unless their wrapping mode shows the border color.
+   */
+  bool isConstant() const;
+
+  /**
+   * @brief Checks if the texels are streamed from a tiled texture file instead of being held in memory.
+   * @return True if the texture is streamed.
+   */
+  bool isStreamed() const { return m_tiled_file != nullptr; }
+
   /**
    * @brief Gets the path of the texture file.
    * @return The path of the texture file.
    */
   const std::string& getTexturePath() const { return m_texture_path; }
 
+  /**
+   * @brief Converts the texels to another storage format, e.g. HALF to halve the memory of an HDR image.
+   *
+   * Streamed textures keep the format of their file.
+   *
+   * @param format The new texel format.
+   */
+  void setStorageFormat(TexelFormat format);
+
+  /**
+   * @brief Gets the format the texels are stored in.
+   * @return The texel format.
+   */
+  TexelFormat getStorageFormat() const;
+
+  /**
+   * @brief Gets the texel storage of the texture.
+   * @return A constant reference to the texel storage, empty for streamed textures.
+   */
+  const TextureStorage& getStorage() const { return m_image_data; }
+
   /**
    * @brief Sets the value of the texture.
    * @param value The new value for the texture.
@@ -152,6 +227,10 @@ public:
 
   /**
    * @brief Sets the color space of the texture.
+   *
+   * In the LINEAR color space, 8-bit texels are decoded through a lookup table while other formats are converted once
+   * into a cached linear copy, so that sampling never calls std::pow.
+   *
    * @param color_space The new color space for the texture.
    */
   void setColorSpace(ColorSpace color_space);
@@ -237,32 +316,45 @@ public:
   /**
    * @brief Gets the value of the texture.
    * @param uv_coord The texture coordinates (u, v).
-   *
+   * @param uv_footprint The width of the sampled area in texture space, selecting the mip level with TRILINEAR
+   * filtering.
    * @return The value of the texture.
    */
-  double getValue1d(TextureUV uv_coord) const;
+  double getValue1d(TextureUV uv_coord, double uv_footprint = 0.0) const;
 
   /**
    * @brief Gets the color of the texture.
    * @param uv_coord The texture coordinates (u, v).
-   *
+   * @param uv_footprint The width of the sampled area in texture space, selecting the mip level with TRILINEAR
+   * filtering.
    * @return The color RGB of the texture.
    */
-  ColorRGB getValue3d(TextureUV uv_coord) const;
+  ColorRGB getValue3d(TextureUV uv_coord, double uv_footprint = 0.0) const;
 
   /**
    * @brief Gets the color of the texture with alpha.
    * @param uv_coord The texture coordinates (u, v).
-   *
+   * @param uv_footprint The width of the sampled area in texture space, selecting the mip level with TRILINEAR
+   * filtering.
    * @return The color RGBA of the texture.
    */
-  ColorRGBA getValue4d(TextureUV uv_coord) const;
+  ColorRGBA getValue4d(TextureUV uv_coord, double uv_footprint = 0.0) const;
 
   /**
-   * @brief Gets the image data of the texture.
-   * @return A pointer to the image data of the texture.
+   * @brief Gets the number of levels of the mip pyramid, 1 unless the filtering mode is TRILINEAR or the texture is
+   * streamed.
+   * @return The number of mip levels, including the base level.
+   */
+  int getMipLevelCount() const;
+
+  /**
+   * @brief Gets the image data of the texture, for textures stored in double precision.
+   *
+   * Images spanning several tiles in both directions are stored in tiles, see TextureLayout.
+   *
+   * @return A pointer to the image data of the texture, nullptr if it is stored in another format.
    */
-  const double* getImageData() const { return m_image_data.data(); }
+  const double* getImageData() const { return m_image_data.data<double>(); }
 
   /**
    * @brief Gets the preview data of the texture.
@@ -19,8 +19,9 @@ namespace TextureSampling {
  * @brief Enumeration for texture filtering modes.
  *
  * This enum defines the filtering modes for textures, including NEAREST and LINEAR.
+ * TRILINEAR blends bilinear lookups of the two mip levels closest to the footprint of the ray.
  */
-enum class TextureFiltering : std::uint8_t { NEAREST, BILINEAR };
+enum class TextureFiltering : std::uint8_t { NEAREST, BILINEAR, TRILINEAR };
 
 /**
  * @struct BilinearSampleInfo
@@ -59,6 +60,26 @@ PixelCoord sampleNearest(TextureUV uv_coord, Resolution resolution);
  */
 BilinearSampleInfo sampleBilinear(TextureUV uv_coord, Resolution resolution);
 
+/**
+ * @brief Computes the mip level matching a footprint in texture space.
+ *
+ * The level is the base 2 logarithm of the number of texels covered by the footprint along one axis, so that one
+ * texel of the selected level roughly covers the footprint.
+ *
+ * @param uv_footprint The width of the sampled area in texture space (1 being the whole texture).
+ * @param resolution The resolution of the base level.
+ * @return The fractional mip level, 0 for footprints smaller than a texel.
+ */
+double computeMipLevel(double uv_footprint, Resolution resolution);
+
+/**
+ * @brief Computes the resolution of a mip level, halving the base resolution once per level.
+ * @param resolution The resolution of the base level.
+ * @param level The mip level.
+ * @return The resolution of the level, at least 1x1.
+ */
+Resolution getMipResolution(Resolution resolution, int level);
+
 } // namespace TextureSampling
 
 #endif // SURFACE_TEXTUREFILTERING_HPP
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "Core/ImageTypes.hpp"
+#include "Surface/TextureStorage.hpp"
 
 /**
  * @namespace TextureLoader
@@ -23,6 +24,17 @@ namespace TextureLoader {
  * @param texture_properties A reference to an ImageProperties object to store the texture properties.
  */
 void load(const char* filename, std::vector<double>& image_data, ImageProperties& texture_properties);
+
+/**
+ * @brief Loads a texture from a file, keeping the texels in their decoded format.
+ *
+ * 8-bit images are stored as UNORM8 and HDR images as FLOAT32, without widening to double.
+ *
+ * @param filename The name of the file to load the texture from.
+ * @param storage The storage receiving the texels.
+ * @param texture_properties A reference to an ImageProperties object to store the texture properties.
+ */
+void load(const char* filename, TextureStorage& storage, ImageProperties& texture_properties);
 } // namespace TextureLoader
 
 #endif // SURFACE_TEXTURELOADER_HPP
\ No newline at end of file
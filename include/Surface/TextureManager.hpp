@@ -5,24 +5,41 @@
 #ifndef SURFACE_TEXTUREMANAGER_HPP
 #define SURFACE_TEXTUREMANAGER_HPP
 
+#include <future>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "Core/Observer.hpp"
 
 class Texture;
+class TextureTileCache;
+class ThreadPool;
 
 /**
  * @class TextureManager
  * @brief Manages textures in the application.
  *
  * The TextureManager class is responsible for loading, retrieving, and managing textures.
+ *
+ * Image files can be decoded in parallel on a pool of worker threads with loadTextureAsync. The decoded images are
+ * handed to their texture by processLoadedTextures, on the thread owning the manager, since the texture observers
+ * (GPU upload, widgets) expect to be notified there.
  */
 class TextureManager {
 private:
+  struct PendingTexture {
+    Texture*                              target;
+    std::future<std::unique_ptr<Texture>> decoded; ///< Staging texture filled by a worker thread.
+    std::promise<Texture*>                loaded;
+  };
+
   std::unordered_map<std::string, std::unique_ptr<Texture>> m_texture_map;
 
+  std::unique_ptr<ThreadPool> m_decode_pool; ///< Created on the first asynchronous load.
+  std::vector<PendingTexture> m_pending_textures;
+
   static std::unique_ptr<Texture> s_default_skybox_texture;
   static std::unique_ptr<Texture> s_default_diffuse_texture;
   static std::unique_ptr<Texture> s_default_normal_texture;
@@ -38,7 +55,7 @@ public:
   /**
    * @brief Default constructor for the TextureManager class.
    */
-  TextureManager() = default;
+  TextureManager();
 
   TextureManager(const TextureManager&)            = delete;
   TextureManager& operator=(const TextureManager&) = delete;
@@ -55,6 +72,38 @@ public:
    */
   void addTexture(const std::string& texture_name);
 
+  /**
+   * @brief Loads an image file into a texture without blocking the calling thread.
+   *
+   * The texture is added right away (showing its previous image, or the default one for a new texture) so that it can
+   * be assigned to materials. The file is decoded and its preview built on a worker thread; the texture receives the
+   * image when processLoadedTextures is next called. Its color space, filtering and wrapping modes are kept; the worker
+   * also builds the linear data and mip levels for the color space and filtering mode set before this call.
+   *
+   * @param texture_name The name of the texture, added if it does not exist.
+   * @param path The path of the image file.
+   * @return The future receiving the texture once it holds the image, nullptr if it was removed in the meantime.
+   * Waiting on it from the thread owning the manager requires calling waitForLoadedTextures instead.
+   */
+  std::future<Texture*> loadTextureAsync(const std::string& texture_name, const std::string& path);
+
+  /**
+   * @brief Hands the images decoded so far to their textures, notifying their observers.
+   * @return The number of textures updated.
+   */
+  int processLoadedTextures();
+
+  /**
+   * @brief Waits for every asynchronous load to be decoded and hands the images to their textures.
+   */
+  void waitForLoadedTextures();
+
+  /**
+   * @brief Checks whether asynchronous loads are still waiting to be handed to their textures.
+   * @return True if processLoadedTextures still has work to do.
+   */
+  bool hasPendingTextures() const { return !m_pending_textures.empty(); }
+
   /**
    * @brief Gets a unique name for a texture, ensuring it is not already in use.
    * @param name The base name for the texture.
@@ -132,7 +181,17 @@ public:
    */
   static Texture* DefaultBlackTexture();
 
-  ~TextureManager() = default; ///< Default destructor for the TextureManager class.
+  /**
+   * @brief Gets the cache shared by the textures streamed from tiled (.ltex) files.
+   *
+   * Streamed textures only keep their header in memory; their tiles are loaded on demand by the render workers and
+   * evicted once the memory budget of the cache is reached.
+   *
+   * @return A reference to the tile cache.
+   */
+  static TextureTileCache& TileCache();
+
+  ~TextureManager(); ///< Default destructor for the TextureManager class.
 };
 
 #endif // SURFACE_TEXTUREMANAGER_HPP
\ No newline at end of file
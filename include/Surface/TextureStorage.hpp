@@ -0,0 +1,305 @@
+/**
+ * @file TextureStorage.hpp
+ * @brief Header file for the TextureStorage class, holding texel data in a compact format.
+ */
+#ifndef SURFACE_TEXTURESTORAGE_HPP
+#define SURFACE_TEXTURESTORAGE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Core/Color.hpp"
+#include "Core/ImageTypes.hpp"
+
+/**
+ * @enum TexelFormat
+ * @brief Enumeration for the formats a texture can store its channels in.
+ *
+ * UNORM8 keeps 8-bit images as they are decoded (LDR files), HALF and FLOAT32 are used for high dynamic range data and
+ * FLOAT64 for values generated by the application (constant colors, procedural data).
+ */
+enum class TexelFormat : std::uint8_t { UNORM8, HALF, FLOAT32, FLOAT64 };
+
+/**
+ * @struct Half
+ * @brief IEEE 754 half precision float, stored as its raw bits.
+ */
+struct Half {
+  std::uint16_t bits = 0;
+
+  /**
+   * @brief Converts a single precision float to half precision, rounding to nearest even.
+   * @param value The value to convert.
+   * @return The half precision value.
+   */
+  static Half FromFloat(float value);
+
+  /**
+   * @brief Converts the half precision value to single precision.
+   * @return The value as a float.
+   */
+  float toFloat() const;
+};
+
+/**
+ * @brief Decodes an 8-bit normalized texel.
+ * @param texel The texel value.
+ * @return The value in [0, 1].
+ */
+inline double decodeTexel(std::uint8_t texel) { return static_cast<double>(texel) * COLOR8_TO_NORMALIZED; }
+
+static constexpr int SRGB_LUT_SIZE = COLOR8_MAX_VALUE + 1; ///< One entry per 8-bit value.
+
+/**
+ * @brief Table converting every 8-bit sRGB encoded value to linear space, filled once at startup.
+ */
+extern const std::array<double, SRGB_LUT_SIZE> SRGB_TO_LINEAR_LUT;
+
+/**
+ * @brief Decodes an 8-bit sRGB encoded texel to linear space with a table lookup instead of std::pow.
+ * @param texel The texel value.
+ * @return The linear value in [0, 1].
+ */
+inline double decodeSRGBTexel(std::uint8_t texel) { return SRGB_TO_LINEAR_LUT[texel]; }
+
+/**
+ * @brief Decodes a half precision texel.
+ * @param texel The texel value.
+ * @return The value as a double.
+ */
+inline double decodeTexel(Half texel) { return static_cast<double>(texel.toFloat()); }
+
+/**
+ * @brief Decodes a single precision texel.
+ * @param texel The texel value.
+ * @return The value as a double.
+ */
+inline double decodeTexel(float texel) { return static_cast<double>(texel); }
+
+/**
+ * @brief Decodes a double precision texel.
+ * @param texel The texel value.
+ * @return The value.
+ */
+inline double decodeTexel(double texel) { return texel; }
+
+static constexpr int TEXTURE_TILE_SHIFT = 3;                       ///< Log2 of the tile side.
+static constexpr int TEXTURE_TILE_SIZE  = 1 << TEXTURE_TILE_SHIFT; ///< Side of the square tiles, in texels.
+static constexpr int TEXTURE_TILE_MASK  = TEXTURE_TILE_SIZE - 1;
+
+/**
+ * @struct TextureLayout
+ * @brief Describes how the texels of an image are ordered in a TextureStorage.
+ *
+ * Scanline images store the rows one after the other. Tiled images store square blocks of TEXTURE_TILE_SIZE texels
+ * one after the other, each block being in scanline order, so that the texels of a bilinear footprint share one or
+ * two cache lines instead of touching rows that are the full image width apart. The last row and column of tiles are
+ * padded.
+ */
+struct TextureLayout {
+  Resolution resolution;
+  int        channels = 1;
+  bool       tiled    = false;
+
+  /**
+   * @brief Gets the index of the first channel of a texel.
+   * @param x The column of the texel.
+   * @param y The row of the texel.
+   * @return The index of the value holding the first channel.
+   */
+  std::size_t getTexelIndex(int x, int y) const {
+    if(!tiled) {
+      return ((static_cast<std::size_t>(y) * resolution.width) + x) * channels;
+    }
+    const std::size_t tile_count_x = (resolution.width + TEXTURE_TILE_MASK) >> TEXTURE_TILE_SHIFT;
+    const std::size_t tile         = ((y >> TEXTURE_TILE_SHIFT) * tile_count_x) + (x >> TEXTURE_TILE_SHIFT);
+    const std::size_t texel =
+        (tile << (2 * TEXTURE_TILE_SHIFT)) + ((y & TEXTURE_TILE_MASK) << TEXTURE_TILE_SHIFT) + (x & TEXTURE_TILE_MASK);
+    return texel * channels;
+  }
+
+  /**
+   * @brief Gets the number of values needed to store the image, padding included.
+   * @return The number of values.
+   */
+  std::size_t getValueCount() const;
+};
+
+/**
+ * @class TextureStorage
+ * @brief Texel buffer of a texture, stored in a single TexelFormat.
+ *
+ * The channels of every texel are interleaved, scanline after scanline. Only the vector matching the current format
+ * holds data. Samplers read the typed buffer through data<Texel>() and decodeTexel so that the format dispatch happens
+ * once per lookup instead of once per channel.
+ */
+class TextureStorage {
+private:
+  TexelFormat   m_format = TexelFormat::FLOAT64;
+  TextureLayout m_layout;
+
+  std::vector<std::uint8_t> m_unorm8;
+  std::vector<Half>         m_half;
+  std::vector<float>        m_float32;
+  std::vector<double>       m_float64;
+
+  void releaseAll();
+  void reorder(const TextureLayout& layout);
+
+public:
+  TextureStorage() = default; ///< Default constructor.
+
+  TextureStorage(const TextureStorage&)            = default;
+  TextureStorage& operator=(const TextureStorage&) = default;
+  TextureStorage(TextureStorage&&)                 = default;
+  TextureStorage& operator=(TextureStorage&&)      = default;
+
+  /**
+   * @brief Gets the format of the stored texels.
+   * @return The texel format.
+   */
+  TexelFormat getFormat() const { return m_format; }
+
+  /**
+   * @brief Gets the number of stored values (texels times channels).
+   * @return The number of values.
+   */
+  std::size_t size() const;
+
+  /**
+   * @brief Gets the memory used by the texel data.
+   * @return The size in bytes.
+   */
+  std::size_t getMemorySize() const;
+
+  /**
+   * @brief Gets the order of the texels in the storage.
+   * @return The texel layout.
+   */
+  const TextureLayout& getLayout() const { return m_layout; }
+
+  /**
+   * @brief Gets the index of the first channel of a texel, whatever the layout.
+   * @param x The column of the texel.
+   * @param y The row of the texel.
+   * @return The index of the value holding the first channel.
+   */
+  std::size_t getTexelIndex(int x, int y) const { return m_layout.getTexelIndex(x, y); }
+
+  /**
+   * @brief Describes the image held by the data and reorders it into tiles when it spans several tiles.
+   *
+   * Must be called after each of the set functions, which expect scanline data. Images smaller than a tile in either
+   * direction stay in scanline order to avoid padding them.
+   *
+   * @param resolution The resolution of the image.
+   * @param channels The number of channels per texel.
+   */
+  void setImageLayout(Resolution resolution, int channels);
+
+  /**
+   * @brief Builds a copy of the data in scanline order, e.g. to upload it to the GPU.
+   * @return The storage in scanline order.
+   */
+  TextureStorage toScanlineLayout() const;
+
+  /**
+   * @brief Replaces the data with 8-bit normalized values.
+   * @param data The values, 255 mapping to 1.
+   */
+  void setUnorm8(std::vector<std::uint8_t> data);
+
+  /**
+   * @brief Replaces the data with half precision values.
+   * @param data The values.
+   */
+  void setHalf(std::vector<Half> data);
+
+  /**
+   * @brief Replaces the data with single precision values.
+   * @param data The values.
+   */
+  void setFloat32(std::vector<float> data);
+
+  /**
+   * @brief Replaces the data with double precision values.
+   * @param data The values.
+   */
+  void setFloat64(std::vector<double> data);
+
+  /**
+   * @brief Converts the stored data to another format.
+   *
+   * Converting to UNORM8 clamps the values to [0, 1]; converting to HALF keeps the dynamic range of HDR images at
+   * half the memory of FLOAT32.
+   *
+   * @param format The new format.
+   */
+  void convertTo(TexelFormat format);
+
+  /**
+   * @brief Builds a copy of the data with the color channels converted from sRGB to linear space.
+   *
+   * The alpha channel of 4 channel images is copied as is. UNORM8 data is promoted to HALF, 8 bits not being enough
+   * to hold linear values without banding in the dark tones.
+   *
+   * @param channels The number of channels per texel.
+   * @return The converted storage.
+   */
+  TextureStorage toLinearSpace(int channels) const;
+
+  /**
+   * @brief Builds the next level of a mip pyramid with a 2x2 box filter.
+   *
+   * Odd dimensions repeat the last row or column. sRGB encoded 8-bit data is averaged in linear space and encoded
+   * back, so that the levels do not darken.
+   *
+   * @param srgb_encoded Whether the color channels are sRGB encoded (only used for UNORM8 data).
+   * @return The downsampled image, in the same format and with its own layout.
+   */
+  TextureStorage downsample(bool srgb_encoded) const;
+
+  /**
+   * @brief Reads a single value, whatever the format.
+   * @param index The index of the value.
+   * @return The decoded value.
+   */
+  double load(std::size_t index) const;
+
+  /**
+   * @brief Gets the typed texel buffer.
+   * @tparam Texel The texel type: std::uint8_t, Half, float or double.
+   * @return A pointer to the data, nullptr if the storage is in another format.
+   */
+  template <typename Texel> const Texel* data() const;
+
+  /**
+   * @brief Swaps the rows of the image upside down.
+   * @param width The width of the image.
+   * @param height The height of the image.
+   * @param channels The number of channels per texel.
+   */
+  void flipRows(int width, int height, int channels);
+
+  ~TextureStorage() = default; ///< Default destructor.
+};
+
+template <> inline const std::uint8_t* TextureStorage::data<std::uint8_t>() const {
+  return m_format == TexelFormat::UNORM8 ? m_unorm8.data() : nullptr;
+}
+
+template <> inline const Half* TextureStorage::data<Half>() const {
+  return m_format == TexelFormat::HALF ? m_half.data() : nullptr;
+}
+
+template <> inline const float* TextureStorage::data<float>() const {
+  return m_format == TexelFormat::FLOAT32 ? m_float32.data() : nullptr;
+}
+
+template <> inline const double* TextureStorage::data<double>() const {
+  return m_format == TexelFormat::FLOAT64 ? m_float64.data() : nullptr;
+}
+
+#endif // SURFACE_TEXTURESTORAGE_HPP
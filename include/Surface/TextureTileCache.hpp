@@ -0,0 +1,147 @@
+/**
+ * @file TextureTileCache.hpp
+ * @brief Header file for the TextureTileCache class, keeping the recently used tiles of tiled textures in memory.
+ */
+#ifndef SURFACE_TEXTURETILECACHE_HPP
+#define SURFACE_TEXTURETILECACHE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "Core/Config.hpp"
+#include "Surface/TextureStorage.hpp"
+
+class TiledTextureFile;
+
+/**
+ * @struct TextureTileKey
+ * @brief Identifies a tile of a mip level of a tiled texture file.
+ */
+struct TextureTileKey {
+  std::uint32_t file_id = 0;
+  int           level   = 0;
+  int           tile_x  = 0;
+  int           tile_y  = 0;
+
+  bool operator==(const TextureTileKey& other) const = default;
+};
+
+/**
+ * @struct TextureTileKeyHash
+ * @brief Hash function of the tile keys.
+ */
+struct TextureTileKeyHash {
+  std::size_t operator()(const TextureTileKey& key) const;
+};
+
+/**
+ * @class TextureTileCache
+ * @brief Thread-safe cache of texture tiles with a fixed memory budget and least recently used eviction.
+ *
+ * The tiles are spread over independent shards, each with its own lock, LRU list and share of the budget, so that
+ * render workers sampling different tiles rarely wait on each other. Tiles are read from the disk outside of the
+ * locks. They are handed out as shared pointers: a tile evicted while a worker is still filtering it stays alive until
+ * the worker releases it.
+ */
+class TextureTileCache {
+private:
+  using TilePtr = std::shared_ptr<const TextureStorage>;
+
+  struct Entry {
+    TilePtr                             tile;
+    std::list<TextureTileKey>::iterator lru_position;
+  };
+
+  struct Shard {
+    std::mutex                                                    mutex;
+    std::list<TextureTileKey>                                     lru; ///< Most recently used tile first.
+    std::unordered_map<TextureTileKey, Entry, TextureTileKeyHash> entries;
+    std::size_t                                                   memory = 0;
+  };
+
+  std::vector<std::unique_ptr<Shard>> m_shards;
+  std::atomic<std::size_t>            m_memory_budget;
+  std::atomic<std::uint64_t>          m_hit_count{0};
+  std::atomic<std::uint64_t>          m_miss_count{0};
+
+  Shard& getShard(const TextureTileKey& key) const;
+  void   evict(Shard& shard) const;
+
+public:
+  /**
+   * @brief Constructs a cache.
+   * @param memory_budget The maximum memory used by the cached tiles, in bytes.
+   * @param shard_count The number of independently locked shards the budget is split between.
+   */
+  explicit TextureTileCache(std::size_t memory_budget = DEFAULT_TEXTURE_CACHE_SIZE,
+                            int         shard_count   = TEXTURE_CACHE_SHARD_COUNT);
+
+  TextureTileCache(const TextureTileCache&)            = delete;
+  TextureTileCache& operator=(const TextureTileCache&) = delete;
+  TextureTileCache(TextureTileCache&&)                 = delete;
+  TextureTileCache& operator=(TextureTileCache&&)      = delete;
+
+  /**
+   * @brief Gets a tile, reading it from the file if it is not cached.
+   * @param file The tiled texture file.
+   * @param level The mip level of the tile.
+   * @param tile_x The column of the tile in the level.
+   * @param tile_y The row of the tile in the level.
+   * @return The texels of the tile.
+   */
+  std::shared_ptr<const TextureStorage> getTile(const TiledTextureFile& file, int level, int tile_x, int tile_y);
+
+  /**
+   * @brief Sets the maximum memory used by the cached tiles, evicting tiles if needed.
+   *
+   * Each shard keeps at least its most recently used tile, even if it does not fit in its share of the budget.
+   *
+   * @param memory_budget The memory budget, in bytes.
+   */
+  void setMemoryBudget(std::size_t memory_budget);
+
+  /**
+   * @brief Gets the maximum memory used by the cached tiles.
+   * @return The memory budget, in bytes.
+   */
+  std::size_t getMemoryBudget() const { return m_memory_budget; }
+
+  /**
+   * @brief Gets the memory currently used by the cached tiles.
+   * @return The memory usage, in bytes.
+   */
+  std::size_t getMemoryUsage() const;
+
+  /**
+   * @brief Gets the number of tiles currently cached.
+   * @return The number of tiles.
+   */
+  std::size_t getTileCount() const;
+
+  /**
+   * @brief Gets the number of requests served from memory.
+   * @return The number of cache hits.
+   */
+  std::uint64_t getHitCount() const { return m_hit_count; }
+
+  /**
+   * @brief Gets the number of requests that read a tile from the disk.
+   * @return The number of cache misses.
+   */
+  std::uint64_t getMissCount() const { return m_miss_count; }
+
+  /**
+   * @brief Removes every tile from the cache.
+   */
+  void clear();
+
+  ~TextureTileCache() = default; ///< Default destructor.
+};
+
+#endif // SURFACE_TEXTURETILECACHE_HPP
@@ -0,0 +1,147 @@
+/**
+ * @file TiledTextureFile.hpp
+ * @brief Header file for the TiledTextureFile class, reading and writing the tiled .ltex texture format.
+ */
+#ifndef SURFACE_TILEDTEXTUREFILE_HPP
+#define SURFACE_TILEDTEXTUREFILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Core/Config.hpp"
+#include "Core/ImageTypes.hpp"
+#include "Surface/TextureStorage.hpp"
+
+/**
+ * @class TiledTextureFile
+ * @brief Texture stored on disk as a mip pyramid of square tiles, read one tile at a time.
+ *
+ * An .ltex file holds a small header followed by every level of the mip pyramid, from the base level down to 1x1.
+ * Each level is cut into tiles of the same size, stored one after the other in scanline order of tiles, each tile
+ * holding its texels in scanline order in the texel format of the source image. Tiles crossing the right or bottom
+ * edge are padded by repeating the last column or row, so that every tile has the same size and its offset is
+ * computed instead of stored. Values are written in the byte order of the host.
+ *
+ * Tiles are meant to be read through TextureTileCache, which keeps only the recently used ones in memory.
+ */
+class TiledTextureFile {
+private:
+  std::string   m_path;
+  std::uint32_t m_id          = 0;
+  TexelFormat   m_format      = TexelFormat::UNORM8;
+  int           m_level_count = 1;
+  int           m_tile_size   = TEXTURE_FILE_TILE_SIZE;
+  std::size_t   m_tile_bytes  = 0;
+
+  ImageProperties            m_properties;
+  std::vector<std::uint64_t> m_level_offsets; ///< Byte offset of the first tile of each level.
+
+  mutable std::mutex    m_stream_mutex;
+  mutable std::ifstream m_stream;
+
+  TiledTextureFile() = default;
+
+public:
+  TiledTextureFile(const TiledTextureFile&)            = delete;
+  TiledTextureFile& operator=(const TiledTextureFile&) = delete;
+  TiledTextureFile(TiledTextureFile&&)                 = delete;
+  TiledTextureFile& operator=(TiledTextureFile&&)      = delete;
+
+  /**
+   * @brief Checks whether a path has the extension of tiled texture files.
+   * @param path The path to check.
+   * @return True if the path ends with .ltex, whatever the case.
+   */
+  static bool HasTiledExtension(const std::string& path);
+
+  /**
+   * @brief Opens a tiled texture file and reads its header.
+   * @param path The path of the .ltex file.
+   * @return The opened file, nullptr if it could not be read.
+   */
+  static std::shared_ptr<const TiledTextureFile> Open(const std::string& path);
+
+  /**
+   * @brief Writes an image and its mip pyramid as a tiled texture file.
+   * @param path The path of the .ltex file to write.
+   * @param image The base level, with its layout set.
+   * @param srgb_encoded Whether the color channels are sRGB encoded, to build the 8-bit levels in linear space.
+   * @param tile_size The side of the tiles, in texels.
+   * @return True if the file was written.
+   */
+  static bool Write(const std::string& path, const TextureStorage& image, bool srgb_encoded,
+                    int tile_size = TEXTURE_FILE_TILE_SIZE);
+
+  /**
+   * @brief Converts an image file (PNG, JPEG, HDR...) to a tiled texture file.
+   * @param image_path The path of the image to convert.
+   * @param output_path The path of the .ltex file to write.
+   * @param srgb_encoded Whether the color channels are sRGB encoded, to build the 8-bit levels in linear space.
+   * @return True if the file was written.
+   */
+  static bool Convert(const std::string& image_path, const std::string& output_path, bool srgb_encoded = true);
+
+  /**
+   * @brief Gets the identifier of the opened file, unique for the lifetime of the application.
+   * @return The file identifier.
+   */
+  std::uint32_t getId() const { return m_id; }
+
+  /**
+   * @brief Gets the path of the file.
+   * @return The path of the file.
+   */
+  const std::string& getPath() const { return m_path; }
+
+  /**
+   * @brief Gets the format the texels are stored in.
+   * @return The texel format.
+   */
+  TexelFormat getFormat() const { return m_format; }
+
+  /**
+   * @brief Gets the resolution and channels of the base level.
+   * @return The image properties.
+   */
+  const ImageProperties& getProperties() const { return m_properties; }
+
+  /**
+   * @brief Gets the number of levels of the mip pyramid, including the base level.
+   * @return The number of levels.
+   */
+  int getLevelCount() const { return m_level_count; }
+
+  /**
+   * @brief Gets the side of the tiles.
+   * @return The tile size, in texels.
+   */
+  int getTileSize() const { return m_tile_size; }
+
+  /**
+   * @brief Gets the resolution of a level of the mip pyramid.
+   * @param level The level, 0 being the base level.
+   * @return The resolution of the level.
+   */
+  Resolution getLevelResolution(int level) const;
+
+  /**
+   * @brief Reads a tile from the disk.
+   *
+   * The file can be read from several threads, the reads being serialized on the file stream.
+   *
+   * @param level The mip level of the tile.
+   * @param tile_x The column of the tile in the level.
+   * @param tile_y The row of the tile in the level.
+   * @return The texels of the tile, with their layout set. Zero filled if the file could not be read.
+   */
+  TextureStorage readTile(int level, int tile_x, int tile_y) const;
+
+  ~TiledTextureFile() = default; ///< Default destructor.
+};
+
+#endif // SURFACE_TILEDTEXTUREFILE_HPP
@@ -0,0 +1,75 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <linalg/Vec3.hpp>
+#include <memory>
+#include <vector>
+
+#include "BVH/BVHNode.hpp"
+#include "BVH/FlatBVH.hpp"
+
+namespace {
+
+constexpr std::size_t INVALID_TREE = std::numeric_limits<std::size_t>::max();
+
+std::array<double, 3> toArray(const linalg::Vec3d& vector) { return {vector.x, vector.y, vector.z}; }
+
+linalg::Vec3d toVector(const std::array<double, 3>& array) { return {array[0], array[1], array[2]}; }
+
+void flattenNode(const BVHNode* node, std::vector<FlatBVHNode>& nodes) {
+  const std::size_t index = nodes.size();
+  nodes.push_back({toArray(node->getMinBound()), toArray(node->getMaxBound()), node->getLeafIndex(), 0});
+  if(node->getLeafIndex() >= 0) {
+    return;
+  }
+  flattenNode(node->getLeftChild().get(), nodes);
+  nodes[index].right_child = static_cast<std::uint32_t>(nodes.size());
+  flattenNode(node->getRightChild().get(), nodes);
+}
+
+// Returns the index following the subtree, or INVALID_TREE when the nodes are inconsistent.
+std::size_t unflattenNode(const FlatBVHNode* nodes, std::size_t node_count, std::size_t index,
+                          std::shared_ptr<BVHNode>& node) {
+  const FlatBVHNode& flat_node = nodes[index];
+  // The two bounds constructor keeps the stored bounds, which already include the padding of the leaves.
+  node = std::make_shared<BVHNode>(toVector(flat_node.min_bound), toVector(flat_node.max_bound));
+  if(flat_node.leaf_index >= 0) {
+    node->setLeafIndex(flat_node.leaf_index);
+    return index + 1;
+  }
+
+  if(index + 1 >= node_count || flat_node.right_child <= index + 1 || flat_node.right_child >= node_count) {
+    return INVALID_TREE;
+  }
+  const std::size_t left_end = unflattenNode(nodes, node_count, index + 1, node->getLeftChild());
+  if(left_end != flat_node.right_child) {
+    return INVALID_TREE;
+  }
+  return unflattenNode(nodes, node_count, flat_node.right_child, node->getRightChild());
+}
+
+} // namespace
+
+namespace BVH {
+
+std::vector<FlatBVHNode> flatten(const BVHNode* root) {
+  std::vector<FlatBVHNode> nodes;
+  if(root != nullptr) {
+    flattenNode(root, nodes);
+  }
+  return nodes;
+}
+
+std::shared_ptr<BVHNode> unflatten(const FlatBVHNode* nodes, std::size_t node_count) {
+  if(node_count == 0) {
+    return nullptr;
+  }
+  std::shared_ptr<BVHNode> root;
+  if(unflattenNode(nodes, node_count, 0, root) != node_count) {
+    return nullptr;
+  }
+  return root;
+}
+
+} // namespace BVH
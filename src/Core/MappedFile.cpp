@@ -0,0 +1,98 @@
+#include <cstddef>
+#include <string>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "Core/MappedFile.hpp"
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string& path) {
+  m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                       FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if(m_file == INVALID_HANDLE_VALUE) {
+    m_file = nullptr;
+    return;
+  }
+  m_open = true;
+
+  LARGE_INTEGER size;
+  if(GetFileSizeEx(m_file, &size) == 0 || size.QuadPart == 0) {
+    return;
+  }
+  m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if(m_mapping == nullptr) {
+    m_open = false;
+    return;
+  }
+  m_data = static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+  if(m_data == nullptr) {
+    m_open = false;
+    return;
+  }
+  m_size = static_cast<std::size_t>(size.QuadPart);
+}
+
+void MappedFile::close() {
+  if(m_data != nullptr) {
+    UnmapViewOfFile(m_data);
+  }
+  if(m_mapping != nullptr) {
+    CloseHandle(m_mapping);
+  }
+  if(m_file != nullptr) {
+    CloseHandle(m_file);
+  }
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& path) {
+  const int descriptor = ::open(path.c_str(), O_RDONLY);
+  if(descriptor < 0) {
+    return;
+  }
+
+  struct stat status {};
+  if(::fstat(descriptor, &status) != 0 || !S_ISREG(status.st_mode)) {
+    ::close(descriptor);
+    return;
+  }
+  m_open = true;
+
+  // mmap rejects empty ranges, an empty file is simply left without content.
+  if(status.st_size > 0) {
+    const auto size    = static_cast<std::size_t>(status.st_size);
+    void*      mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    if(mapping == MAP_FAILED) {
+      m_open = false;
+    } else {
+      ::madvise(mapping, size, MADV_SEQUENTIAL);
+      m_data = static_cast<const char*>(mapping);
+      m_size = size;
+    }
+  }
+  // The mapping keeps its own reference to the file.
+  ::close(descriptor);
+}
+
+void MappedFile::close() {
+  if(m_data != nullptr) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    ::munmap(const_cast<char*>(m_data), m_size);
+  }
+}
+
+#endif
+
+MappedFile::~MappedFile() { close(); }
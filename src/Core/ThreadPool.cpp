@@ -0,0 +1,42 @@
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "Core/ThreadPool.hpp"
+
+ThreadPool::ThreadPool(unsigned int thread_count) {
+  thread_count = std::max(thread_count, 1U);
+  m_workers.reserve(thread_count);
+  for(unsigned int i = 0; i < thread_count; ++i) {
+    m_workers.emplace_back(&ThreadPool::workerLoop, this);
+  }
+}
+
+void ThreadPool::workerLoop() {
+  while(true) {
+    std::function<void()> job;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_job_available.wait(lock, [this]() { return m_stopping || !m_jobs.empty(); });
+      if(m_jobs.empty()) {
+        return;
+      }
+      job = std::move(m_jobs.front());
+      m_jobs.pop_front();
+    }
+    job();
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopping = true;
+  }
+  m_job_available.notify_all();
+  for(auto& worker : m_workers) {
+    worker.join();
+  }
+}
@@ -1,4 +1,5 @@
 // GCOVR_EXCL_START
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
 #include <linalg/Mat4.hpp>
@@ -137,6 +138,7 @@ void CameraGL::updateProjectionMatrix() {
 
   m_camera_ubo.projection_transposed =
       linalg::Mat4f::Perspective(fov_y, static_cast<float>(aspect_ratio), near_plane, far_plane).transposed();
+  m_pixels_per_unit = static_cast<double>(m_viewport_height) * HALF / std::tan(static_cast<double>(fov_y) * HALF);
 
   m_gl_camera_ubo.updateData(&m_camera_ubo.projection_transposed, sizeof(linalg::Mat4f),
                              offsetof(CameraUBO, projection_transposed));
@@ -162,4 +164,10 @@ Ray CameraGL::getRayFromMousePosition(int mouse_x, int mouse_y) const {
   return Ray::FromDirection(linalg::Vec3d(m_camera_ubo.position), linalg::Vec3d(ray_direction));
 }
 
+double CameraGL::getScreenRadius(const linalg::Vec3d& center, double radius) const {
+  // A camera inside the sphere sees it cover the whole screen.
+  const double distance = (center - linalg::Vec3d(m_camera_ubo.position)).length();
+  return radius * m_pixels_per_unit / std::max(distance, radius);
+}
+
 // GCOVR_EXCL_STOP
\ No newline at end of file
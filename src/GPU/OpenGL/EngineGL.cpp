@@ -3,11 +3,13 @@
 #include <GL/glext.h>
 #include <algorithm>
 #include <array>
+#include <linalg/Vec3.hpp>
 #include <memory>
 #include <string>
 
 #include "Core/Config.hpp"
 #include "Core/MathConstants.hpp"
+#include "GPU/OpenGL/CameraGL.hpp"
 #include "GPU/OpenGL/EngineGL.hpp"
 #include "GPU/OpenGL/FramebufferGL.hpp"
 #include "GPU/OpenGL/Lights/PointGL.hpp"
@@ -17,6 +19,7 @@
 #include "GPU/OpenGL/ShadersGL.hpp"
 #include "PostProcessing/ToneMapping/ToneMapping.hpp"
 #include "Scene/Scene.hpp"
+#include "SceneObjects/Object3D.hpp"
 
 EngineGL::EngineGL(int width, int height) : m_viewport_width(width), m_viewport_height(height) {}
 
@@ -300,6 +303,16 @@ void EngineGL::configureShadersAndUniforms() {
   m_scene_pass_program.bindUniformBlock("Camera", CAMERA_UBO_BINDING_POINT);
 }
 
+void EngineGL::selectLevelsOfDetail() {
+  const CameraGL* camera = m_resource_manager->getCamera();
+  for(const auto& data_buffer : m_resource_manager->getObjectList()) {
+    const Object3D*     object = data_buffer->getSource();
+    const linalg::Vec3d center = (object->getMinBound() + object->getMaxBound()) * HALF;
+    const double        radius = (object->getMaxBound() - object->getMinBound()).length() * HALF;
+    data_buffer->selectLevelOfDetail(camera->getScreenRadius(center, radius));
+  }
+}
+
 void EngineGL::renderScenePass() {
   glEnable(GL_DEPTH_TEST);
   glClearStencil(0);
@@ -426,6 +439,8 @@ void EngineGL::setupRendering() {
 }
 
 void EngineGL::renderFrame(unsigned int default_ramebuffer) {
+  selectLevelsOfDetail();
+
   if(m_dynamic_lighting) {
     uploadLightsData();
   }
@@ -1,75 +1,157 @@
 // GCOVR_EXCL_START
 #include <GL/gl.h>
 #include <GL/glext.h>
+#include <cstddef>
+#include <cstdint>
+#include <linalg/Vec3.hpp>
 
 #include "Core/Config.hpp"
 #include "GPU/IObjectGPU.hpp"
 #include "GPU/OpenGL/MaterialGL.hpp"
 #include "GPU/OpenGL/ObjectGL.hpp"
+#include "Geometry/Mesh.hpp"
+#include "Geometry/VertexEncoding.hpp"
 #include "SceneObjects/Object3D.hpp"
+#include "Surface/Material.hpp"
 
 ObjectGL::ObjectGL(Object3D* object, MaterialGL* material) : IObjectGPU(object), m_material(material) {
   initializeOpenGLFunctions();
-
-  glGenVertexArrays(1, &m_vao);
-  glGenBuffers(1, &m_vbo);
-  glGenBuffers(1, &m_ebo);
 }
 
 void ObjectGL::setMaterial(MaterialGL* material) {
   if(m_material != material) {
     m_material = material;
+    updateTangents();
   }
 }
 
-void ObjectGL::uploadVertices() {
-  glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-  glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(dataSize()), vertices().data(), GL_STATIC_DRAW);
+void ObjectGL::updateTangents() {
+  if(!getSource()->getMesh().hasTangents() && getSource()->getMaterial()->hasNormalMap()) {
+    uploadToGPU();
+  }
 }
 
-void ObjectGL::uploadIndices() {
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
-  glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(indicesSize()), indices().data(), GL_STATIC_DRAW);
+namespace {
+static_assert(sizeof(linalg::Vec3f) == 3 * sizeof(float), "positions must be tightly packed");
+
+/**
+ * @struct StreamOffsets
+ * @brief Byte offsets of the vertex streams, stored one after the other in a single buffer.
+ *
+ * The tangent streams are left out until the mesh has built its tangents, which another thread may be doing.
+ */
+struct StreamOffsets {
+  std::size_t positions       = 0;
+  std::size_t normals         = 0;
+  std::size_t tangents        = 0;
+  std::size_t uvs             = 0;
+  std::size_t bitangent_signs = 0;
+  std::size_t end             = 0;
+
+  StreamOffsets(const VertexStreams& streams, bool with_tangents) {
+    const std::size_t tangent_count = with_tangents ? streams.size() : 0;
+    normals                         = positions + streams.positions.size() * sizeof(linalg::Vec3f);
+    tangents                        = normals + streams.normals.size() * sizeof(PackedDirection);
+    uvs                             = tangents + tangent_count * sizeof(PackedDirection);
+    bitangent_signs                 = uvs + streams.uvs.size() * sizeof(PackedUV);
+    end                             = bitangent_signs + tangent_count * sizeof(std::int8_t);
+  }
+};
+} // namespace
+
+void ObjectGL::uploadVertices(std::size_t level, bool with_tangents) {
+  const VertexStreams& streams = vertexStreams(level);
+  const StreamOffsets  offsets(streams, with_tangents);
+
+  glBindBuffer(GL_ARRAY_BUFFER, m_levels[level].vbo);
+  glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(offsets.end), nullptr, GL_STATIC_DRAW);
+  glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(offsets.positions),
+                  static_cast<GLsizeiptr>(offsets.normals - offsets.positions), streams.positions.data());
+  glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(offsets.normals),
+                  static_cast<GLsizeiptr>(offsets.tangents - offsets.normals), streams.normals.data());
+  glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(offsets.tangents),
+                  static_cast<GLsizeiptr>(offsets.uvs - offsets.tangents),
+                  with_tangents ? streams.tangents.data() : nullptr);
+  glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(offsets.uvs),
+                  static_cast<GLsizeiptr>(offsets.bitangent_signs - offsets.uvs), streams.uvs.data());
+  glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(offsets.bitangent_signs),
+                  static_cast<GLsizeiptr>(offsets.end - offsets.bitangent_signs),
+                  with_tangents ? streams.bitangent_signs.data() : nullptr);
+}
+
+void ObjectGL::uploadIndices(std::size_t level) {
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_levels[level].ebo);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(indicesSize(level)), faces(level).data(),
+               GL_STATIC_DRAW);
 }
 
 // NOLINTBEGIN(cppcoreguidelines-pro-type-cstyle-cast, google-readability-casting, performance-no-int-to-ptr)
-void ObjectGL::setupVertexAttributes() {
+void ObjectGL::setupVertexAttributes(std::size_t level, bool with_tangents) {
+  const StreamOffsets offsets(vertexStreams(level), with_tangents);
 
   // position (x,y,z)
-  glVertexAttribPointer(POSITION_LOCATION, 3, GL_FLOAT, GL_FALSE, VERTEX_SIZE, (void*)(POSITION_OFFSET));
+  glVertexAttribPointer(POSITION_LOCATION, 3, GL_FLOAT, GL_FALSE, 0, (void*)(offsets.positions));
   glEnableVertexAttribArray(POSITION_LOCATION);
 
-  // normal (x,y,z)
-  glVertexAttribPointer(NORMAL_LOCATION, 3, GL_FLOAT, GL_FALSE, VERTEX_SIZE, (void*)(NORMAL_OFFSET));
+  // normal, octahedral (x,y) in [-1, 1]
+  glVertexAttribPointer(NORMAL_LOCATION, 2, GL_SHORT, GL_TRUE, 0, (void*)(offsets.normals));
   glEnableVertexAttribArray(NORMAL_LOCATION);
 
   // uv (u,v)
-  glVertexAttribPointer(UV_LOCATION, 2, GL_FLOAT, GL_FALSE, VERTEX_SIZE, (void*)(UV_OFFSET));
+  glVertexAttribPointer(UV_LOCATION, 2, GL_FLOAT, GL_FALSE, 0, (void*)(offsets.uvs));
   glEnableVertexAttribArray(UV_LOCATION);
 
-  // tangent (x,y,z)
-  glVertexAttribPointer(TANGENT_LOCATION, 3, GL_FLOAT, GL_FALSE, VERTEX_SIZE, (void*)(TANGENT_OFFSET));
+  if(!with_tangents) {
+    // A bitangent sign of zero tells the shader to build its own frame around the normal.
+    glDisableVertexAttribArray(TANGENT_LOCATION);
+    glDisableVertexAttribArray(BITANGENT_SIGN_LOCATION);
+    glVertexAttrib2f(TANGENT_LOCATION, 0.0F, 0.0F);
+    glVertexAttrib1f(BITANGENT_SIGN_LOCATION, 0.0F);
+    return;
+  }
+
+  // tangent, octahedral (x,y) in [-1, 1]
+  glVertexAttribPointer(TANGENT_LOCATION, 2, GL_SHORT, GL_TRUE, 0, (void*)(offsets.tangents));
   glEnableVertexAttribArray(TANGENT_LOCATION);
 
-  // bitangent (x,y,z)
-  glVertexAttribPointer(BITANGENT_LOCATION, 3, GL_FLOAT, GL_FALSE, VERTEX_SIZE, (void*)(BITANGENT_OFFSET));
-  glEnableVertexAttribArray(BITANGENT_LOCATION);
+  // bitangent sign, -1 or 1
+  glVertexAttribPointer(BITANGENT_SIGN_LOCATION, 1, GL_BYTE, GL_FALSE, 0, (void*)(offsets.bitangent_signs));
+  glEnableVertexAttribArray(BITANGENT_SIGN_LOCATION);
 }
 // NOLINTEND(cppcoreguidelines-pro-type-cstyle-cast, google-readability-casting, performance-no-int-to-ptr)
 
 void ObjectGL::uploadToGPU() {
-  glBindVertexArray(m_vao);
+  // The viewport draws the mesh of the object, the cage of a subdivision surface, not the render mesh the
+  // Object3D builders act on. Levels first, so that the tangents are built for every level at once.
+  const Mesh& mesh = getSource()->getMesh();
+  mesh.buildLODs();
+  if(getSource()->getMaterial()->hasNormalMap()) {
+    mesh.buildTangents();
+  }
+
+  while(m_levels.size() < getLevelCount()) {
+    LevelBuffers buffers;
+    glGenVertexArrays(1, &buffers.vao);
+    glGenBuffers(1, &buffers.vbo);
+    glGenBuffers(1, &buffers.ebo);
+    m_levels.push_back(buffers);
+  }
 
-  uploadVertices();
-  uploadIndices();
-  setupVertexAttributes();
+  for(std::size_t level = 0; level < m_levels.size(); ++level) {
+    // Read once: another thread may publish the tangents between the upload and the attribute setup.
+    const bool with_tangents = hasTangents(level);
+    glBindVertexArray(m_levels[level].vao);
+    uploadVertices(level, with_tangents);
+    uploadIndices(level);
+    setupVertexAttributes(level, with_tangents);
+  }
 
   glBindVertexArray(0);
   glBindBuffer(GL_ARRAY_BUFFER, 0);
   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
 
-void ObjectGL::bindVAO() { glBindVertexArray(m_vao); }
+void ObjectGL::bindVAO() { glBindVertexArray(getVAO()); }
 
 void ObjectGL::bindMaterial() { m_material->bind(); }
 
@@ -83,18 +165,12 @@ void ObjectGL::release() {
   glBindBuffer(GL_ARRAY_BUFFER, 0);
   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
-  if(m_vao != 0U) {
-    glDeleteVertexArrays(1, &m_vao);
-    m_vao = 0;
-  }
-  if(m_vbo != 0U) {
-    glDeleteBuffers(1, &m_vbo);
-    m_vbo = 0;
-  }
-  if(m_ebo != 0U) {
-    glDeleteBuffers(1, &m_ebo);
-    m_ebo = 0;
+  for(LevelBuffers& buffers : m_levels) {
+    glDeleteVertexArrays(1, &buffers.vao);
+    glDeleteBuffers(1, &buffers.vbo);
+    glDeleteBuffers(1, &buffers.ebo);
   }
+  m_levels.clear();
 }
 
 ObjectGL::~ObjectGL() { ObjectGL::release(); }
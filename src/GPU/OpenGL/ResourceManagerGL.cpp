@@ -209,6 +209,11 @@ void ResourceManagerGL::onMaterialTextureChanged(const Material* material) {
       gl_material->setNormalTexture(normal_texture);
     }
   }
+  for(auto& object_gl : m_object_list) {
+    if(object_gl->getSource()->getMaterial() == material) {
+      object_gl->updateTangents();
+    }
+  }
 }
 
 void ResourceManagerGL::clearAllRessources() {
@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <array>
 #include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <utility>
 #include <vector>
@@ -15,6 +16,7 @@
 #include "GPU/OpenGL/TextureGL.hpp"
 #include "Surface/Texture.hpp"
 #include "Surface/TextureFiltering.hpp"
+#include "Surface/TextureStorage.hpp"
 #include "Surface/TextureWrapping.hpp"
 
 TextureGL::TextureGL(Texture* texture) : ITextureGPU(texture) {
@@ -61,7 +63,7 @@ void TextureGL::applyFilteringMode(TextureSampling::TextureFiltering filtering_m
   }
 
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, gl_mode);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, gl_mode);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, gl_mode == GL_LINEAR_MIPMAP_LINEAR ? GL_LINEAR : gl_mode);
 }
 
 GLint TextureGL::GetGlWrappingMode(TextureSampling::TextureWrapping wrapping_mode) {
@@ -86,6 +88,8 @@ GLint TextureGL::GetGlFilteringMode(TextureSampling::TextureFiltering filtering_
     return GL_NEAREST;
   case TextureSampling::TextureFiltering::BILINEAR:
     return GL_LINEAR;
+  case TextureSampling::TextureFiltering::TRILINEAR:
+    return GL_LINEAR_MIPMAP_LINEAR;
   default:
     std::cerr << "Error: Unsupported texture filtering mode." << '\n';
     return -1;
@@ -113,32 +117,46 @@ void TextureGL::uploadToGPU() {
   const Texture* texture = getSource();
   configureParameters(texture);
 
-  if(const double* image_data = texture->getImageData()) {
-    const auto format = GetGlFormat(texture->getProperties().channels);
+  // Streamed textures are never fully in memory, the viewport shows their preview instead.
+  const ImageProperties& properties =
+      texture->isStreamed() ? texture->getPreviewProperties() : texture->getProperties();
+  TextureStorage storage;
+  if(texture->isStreamed()) {
+    const unsigned char* preview = texture->getPreviewData();
+    storage.setUnorm8(std::vector<std::uint8_t>(preview, preview + properties.bufferSize()));
+  } else {
+    storage = texture->getStorage().toScanlineLayout();
+  }
+
+  if(storage.size() > 0) {
+    const auto format = GetGlFormat(properties.channels);
     if(format == 0) {
       return;
     }
 
-    const auto [width, height] = std::make_pair(texture->getProperties().width, texture->getProperties().height);
-    const int data_size        = width * height * texture->getProperties().channels;
+    const auto [width, height] = std::make_pair(properties.width, properties.height);
+    const int data_size        = width * height * properties.channels;
 
     if(texture->getColorSpace() == ColorSpace::LINEAR) {
       std::vector<float> linear_data(data_size);
       for(size_t i = 0; i < static_cast<size_t>(data_size); ++i) {
-        linear_data[i] = static_cast<float>(image_data[i]);
+        linear_data[i] = static_cast<float>(storage.load(i));
         convertToLinearSpace(linear_data[i]);
       }
 
       glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_FLOAT, linear_data.data());
+    } else if(const std::uint8_t* unorm8_data = storage.data<std::uint8_t>()) {
+      glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, unorm8_data);
     } else {
       std::vector<unsigned char> converted_data(data_size);
       for(size_t i = 0; i < static_cast<size_t>(data_size); ++i) {
         converted_data[i] = static_cast<unsigned char>(
-            std::clamp(image_data[i] * NORMALIZED_TO_COLOR8, 0.0, static_cast<double>(COLOR8_MAX_VALUE)));
+            std::clamp(storage.load(i) * NORMALIZED_TO_COLOR8, 0.0, static_cast<double>(COLOR8_MAX_VALUE)));
       }
 
       glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, converted_data.data());
     }
+    glGenerateMipmap(GL_TEXTURE_2D);
   } else {
     std::cerr << "Error: Texture data is null." << '\n';
   }
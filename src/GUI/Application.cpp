@@ -9,6 +9,7 @@
 #include "Core/Color.hpp"
 #include "GUI/Application.hpp"
 #include "Geometry/CubeMeshBuilder.hpp"
+#include "Geometry/Mesh.hpp"
 #include "Geometry/PlaneMeshBuilder.hpp"
 #include "Geometry/SphereMeshBuilder.hpp"
 #include "Lighting/DirectionalLight.hpp"
@@ -42,7 +43,7 @@ Application::Application(int& argc, char** argv)
 void Application::createDefaultScene() {
   const CubeMeshBuilder cube_mesh_builder(1.0);
   auto                  cube        = cube_mesh_builder.build();
-  auto                  cube_object = std::make_unique<Object3D>(cube);
+  auto                  cube_object = std::make_unique<Object3D>(std::move(cube));
   m_scene->addObject("Default Cube", std::move(cube_object));
 
   auto directional_light = std::make_unique<DirectionalLight>();
@@ -86,32 +87,32 @@ void Application::createCornellBoxScene() {
   m_material_manager->getMaterial("Light")->setEmissiveIntensity(15.0);
 
   const PlaneMeshBuilder plane_builder(555.0, 555.0);
-  auto                   plane_mesh = plane_builder.build();
+  auto                   plane_mesh = std::make_shared<Mesh>(plane_builder.build());
 
-  auto floor_object = std::make_unique<Object3D>(plane_mesh);
+  auto floor_object = std::make_unique<Object3D>(plane_mesh, plane_builder.getPrimitive());
   floor_object->setPosition({0, 0.0, 277.5});
   floor_object->setMaterial(m_material_manager->getMaterial("White"));
   m_scene->addObject("Floor", std::move(floor_object));
 
-  auto ceiling_object = std::make_unique<Object3D>(plane_mesh);
+  auto ceiling_object = std::make_unique<Object3D>(plane_mesh, plane_builder.getPrimitive());
   ceiling_object->setPosition({0, 555.0, 277.5});
   ceiling_object->setRotationDeg({180.0, 0.0, 0.0});
   ceiling_object->setMaterial(m_material_manager->getMaterial("White"));
   m_scene->addObject("Ceiling", std::move(ceiling_object));
 
-  auto right_wall_object = std::make_unique<Object3D>(plane_mesh);
+  auto right_wall_object = std::make_unique<Object3D>(plane_mesh, plane_builder.getPrimitive());
   right_wall_object->setPosition({-277.5, 277.5, 277.5});
   right_wall_object->setRotationDeg({0.0, 0.0, -90.0});
   right_wall_object->setMaterial(m_material_manager->getMaterial("Red"));
   m_scene->addObject("Right Wall", std::move(right_wall_object));
 
-  auto left_wall_object = std::make_unique<Object3D>(plane_mesh);
+  auto left_wall_object = std::make_unique<Object3D>(plane_mesh, plane_builder.getPrimitive());
   left_wall_object->setPosition({277.5, 277.5, 277.5});
   left_wall_object->setRotationDeg({0.0, 0.0, 90.0});
   left_wall_object->setMaterial(m_material_manager->getMaterial("Green"));
   m_scene->addObject("Left Wall", std::move(left_wall_object));
 
-  auto back_wall_object = std::make_unique<Object3D>(plane_mesh);
+  auto back_wall_object = std::make_unique<Object3D>(plane_mesh, plane_builder.getPrimitive());
   back_wall_object->setPosition({0.0, 277.5, 555.5});
   back_wall_object->setRotationDeg({-90.0, 0.0, 0.0});
   back_wall_object->setMaterial(m_material_manager->getMaterial("White"));
@@ -120,7 +121,7 @@ void Application::createCornellBoxScene() {
   const PlaneMeshBuilder light_plane_builder(130.0, 105.0);
   auto                   light_plane_mesh = light_plane_builder.build();
 
-  auto light_object = std::make_unique<Object3D>(light_plane_mesh);
+  auto light_object = std::make_unique<Object3D>(std::move(light_plane_mesh), light_plane_builder.getPrimitive());
   light_object->setPosition({0, 554.0, 277.5});
   light_object->setRotationDeg({180.0, 0.0, 0.0});
   light_object->setMaterial(m_material_manager->getMaterial("Light"));
@@ -129,7 +130,7 @@ void Application::createCornellBoxScene() {
   const CubeMeshBuilder cube_mesh_builder(165.0);
   auto                  cube_mesh = cube_mesh_builder.build();
 
-  auto right_cube_object = std::make_unique<Object3D>(cube_mesh);
+  auto right_cube_object = std::make_unique<Object3D>(std::move(cube_mesh));
   right_cube_object->setPosition({-92.5, 165, 327.5});
   right_cube_object->setRotationDeg({0.0, -18.0, 0.0});
   right_cube_object->setScaleY(2.0);
@@ -139,7 +140,7 @@ void Application::createCornellBoxScene() {
   const SphereMeshBuilder sphere_mesh_builder(82.5, 128, 128);
   auto                    sphere_mesh = sphere_mesh_builder.build();
 
-  auto left_sphere_object = std::make_unique<Object3D>(sphere_mesh);
+  auto left_sphere_object = std::make_unique<Object3D>(std::move(sphere_mesh), sphere_mesh_builder.getPrimitive());
   left_sphere_object->setPosition({92.5, 82.5, 152.5});
   left_sphere_object->setRotationDeg({0.0, 15.0, 0.0});
   left_sphere_object->setMaterial(m_material_manager->getMaterial("White"));
@@ -186,15 +187,15 @@ void Application::createSphereScene() {
   m_material_manager->getMaterial("Light")->setEmissiveIntensity(1.0);
 
   const PlaneMeshBuilder plane_builder(2.5, 2.5);
-  auto                   plane_mesh = plane_builder.build();
+  auto                   plane_mesh = std::make_shared<Mesh>(plane_builder.build());
 
-  auto floor_object = std::make_unique<Object3D>(plane_mesh);
+  auto floor_object = std::make_unique<Object3D>(plane_mesh, plane_builder.getPrimitive());
   floor_object->setPosition({0, 0.0, 0.0});
   floor_object->setScale(4.0);
   floor_object->setMaterial(m_material_manager->getMaterial("White"));
   m_scene->addObject("Floor", std::move(floor_object));
 
-  auto ceiling_light_object = std::make_unique<Object3D>(plane_mesh);
+  auto ceiling_light_object = std::make_unique<Object3D>(plane_mesh, plane_builder.getPrimitive());
   ceiling_light_object->setPosition({0.0, 5.0, 0.0});
   ceiling_light_object->setScale(2.0);
   ceiling_light_object->setRotationDeg({180.0, 0.0, 0.0});
@@ -202,8 +203,8 @@ void Application::createSphereScene() {
   m_scene->addObject("Ceiling Light", std::move(ceiling_light_object));
 
   const SphereMeshBuilder sphere_mesh_builder(1.0, 32, 16);
-  auto                    sphere        = sphere_mesh_builder.build();
-  auto                    sphere_object = std::make_unique<Object3D>(sphere);
+  auto                    sphere = sphere_mesh_builder.build();
+  auto sphere_object = std::make_unique<Object3D>(std::move(sphere), sphere_mesh_builder.getPrimitive());
   sphere_object->setPosition({0.0, 1.0, 0.0});
   sphere_object->setMaterial(m_material_manager->getMaterial("Red"));
   m_scene->addObject("Sphere", std::move(sphere_object));
@@ -276,62 +277,62 @@ void Application::createRoughnessScene() {
   m_material_manager->getMaterial("White100")->setMetallicValue(0.0);
 
   const PlaneMeshBuilder plane_builder(10.0, 10.0);
-  auto                   plane_mesh = plane_builder.build();
+  auto                   plane_mesh = std::make_shared<Mesh>(plane_builder.build());
 
-  auto floor = std::make_unique<Object3D>(plane_mesh);
+  auto floor = std::make_unique<Object3D>(plane_mesh, plane_builder.getPrimitive());
   floor->setPosition({0.0, 0.0, 0.0});
   // floor->setMaterial(m_material_manager->getMaterial("Silver0"));
   // m_scene->addObject("Floor", std::move(floor));
 
   const SphereMeshBuilder sphere_builder(0.5, 16, 8);
-  auto                    sphere_mesh = sphere_builder.build();
+  auto                    sphere_mesh = std::make_shared<Mesh>(sphere_builder.build());
 
-  auto silver0 = std::make_unique<Object3D>(sphere_mesh);
+  auto silver0 = std::make_unique<Object3D>(sphere_mesh, sphere_builder.getPrimitive());
   silver0->setPosition({-2.5, -1.0, 0.0});
   silver0->setMaterial(m_material_manager->getMaterial("Silver0"));
   m_scene->addObject("Sphere0", std::move(silver0));
 
-  auto silver25 = std::make_unique<Object3D>(sphere_mesh);
+  auto silver25 = std::make_unique<Object3D>(sphere_mesh, sphere_builder.getPrimitive());
   silver25->setPosition({-1.25, -1.0, 0.0});
   silver25->setMaterial(m_material_manager->getMaterial("Silver25"));
   m_scene->addObject("Sphere25", std::move(silver25));
 
-  auto silver50 = std::make_unique<Object3D>(sphere_mesh);
+  auto silver50 = std::make_unique<Object3D>(sphere_mesh, sphere_builder.getPrimitive());
   silver50->setPosition({0.0, -1.0, 0.0});
   silver50->setMaterial(m_material_manager->getMaterial("Silver50"));
   m_scene->addObject("Sphere50", std::move(silver50));
 
-  auto silver75 = std::make_unique<Object3D>(sphere_mesh);
+  auto silver75 = std::make_unique<Object3D>(sphere_mesh, sphere_builder.getPrimitive());
   silver75->setPosition({1.25, -1.0, 0.0});
   silver75->setMaterial(m_material_manager->getMaterial("Silver75"));
   m_scene->addObject("Sphere75", std::move(silver75));
 
-  auto silver100 = std::make_unique<Object3D>(sphere_mesh);
+  auto silver100 = std::make_unique<Object3D>(sphere_mesh, sphere_builder.getPrimitive());
   silver100->setPosition({2.5, -1.0, 0.0});
   silver100->setMaterial(m_material_manager->getMaterial("Silver100"));
   m_scene->addObject("Sphere100", std::move(silver100));
 
-  auto white0 = std::make_unique<Object3D>(sphere_mesh);
+  auto white0 = std::make_unique<Object3D>(sphere_mesh, sphere_builder.getPrimitive());
   white0->setPosition({-2.5, 1.0, 0.0});
   white0->setMaterial(m_material_manager->getMaterial("White0"));
   m_scene->addObject("SphereWhite0", std::move(white0));
 
-  auto white25 = std::make_unique<Object3D>(sphere_mesh);
+  auto white25 = std::make_unique<Object3D>(sphere_mesh, sphere_builder.getPrimitive());
   white25->setPosition({-1.25, 1.0, 0.0});
   white25->setMaterial(m_material_manager->getMaterial("White25"));
   m_scene->addObject("SphereWhite25", std::move(white25));
 
-  auto white50 = std::make_unique<Object3D>(sphere_mesh);
+  auto white50 = std::make_unique<Object3D>(sphere_mesh, sphere_builder.getPrimitive());
   white50->setPosition({0.0, 1.0, 0.0});
   white50->setMaterial(m_material_manager->getMaterial("White50"));
   m_scene->addObject("SphereWhite50", std::move(white50));
 
-  auto white75 = std::make_unique<Object3D>(sphere_mesh);
+  auto white75 = std::make_unique<Object3D>(sphere_mesh, sphere_builder.getPrimitive());
   white75->setPosition({1.25, 1.0, 0.0});
   white75->setMaterial(m_material_manager->getMaterial("White75"));
   m_scene->addObject("SphereWhite75", std::move(white75));
 
-  auto white100 = std::make_unique<Object3D>(sphere_mesh);
+  auto white100 = std::make_unique<Object3D>(sphere_mesh, sphere_builder.getPrimitive());
   white100->setPosition({2.5, 1.0, 0.0});
   white100->setMaterial(m_material_manager->getMaterial("White100"));
   m_scene->addObject("SphereWhite100", std::move(white100));
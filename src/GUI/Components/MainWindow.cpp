@@ -1,15 +1,17 @@
 // GCOVR_EXCL_START
 #include "MainWindow.hpp"
 #include "CubeDialog.hpp"
+#include "Core/Config.hpp"
 #include "Geometry/CubeMeshBuilder.hpp"
-#include "Geometry/OBJLoader.hpp"
 #include "Geometry/PlaneMeshBuilder.hpp"
 #include "Geometry/SphereMeshBuilder.hpp"
 #include "Lighting/Light.hpp"
 #include "PlaneDialog.hpp"
 #include "Scene/Scene.hpp"
+#include "Scene/SceneImporter.hpp"
 #include "SphereDialog.hpp"
 #include "Surface/MaterialManager.hpp"
+#include "Surface/Texture.hpp"
 #include "Surface/TextureManager.hpp"
 #include "ui_MainWindow.h"
 
@@ -17,13 +19,18 @@
 
 #include <QFileDialog>
 #include <QMessageBox>
+#include <QStatusBar>
 #include <iostream>
+#include <memory>
+#include <utility>
 
 MainWindow::MainWindow(Scene* scene, TextureManager* texture_manager, MaterialManager* material_manager,
                        QWidget* parent)
     : QMainWindow(parent), ui(new Ui::MainWindow), m_scene(scene), m_texture_manager(texture_manager),
       m_material_manager(material_manager), m_textures_list_model(new TexturesListModel(m_texture_manager, this)),
-      m_materials_list_model(new MaterialsListModel(m_material_manager, this)) {
+      m_materials_list_model(new MaterialsListModel(m_material_manager, this)),
+      m_texture_load_timer(new QTimer(this)), m_scene_importer(std::make_unique<SceneImporter>(m_scene)),
+      m_import_timer(new QTimer(this)) {
   ui->setupUi(this);
 
   ui->nameLabel->setText("");
@@ -64,6 +71,7 @@ MainWindow::MainWindow(Scene* scene, TextureManager* texture_manager, MaterialMa
   connect(ui->actionAdd_Sphere, &QAction::triggered, this, &MainWindow::onActionAddSphereTriggered);
   connect(ui->actionAdd_Plane, &QAction::triggered, this, &MainWindow::onActionAddPlaneTriggered);
   connect(ui->actionLoad_OBJ, &QAction::triggered, this, &MainWindow::onActionLoadObjTriggered);
+  connect(ui->actionCancel_Imports, &QAction::triggered, this, &MainWindow::onActionCancelImportsTriggered);
 
   connect(ui->actionAdd_Directional_Light, &QAction::triggered, this,
           &MainWindow::onActionAddDirectionalLightTriggered);
@@ -100,6 +108,14 @@ MainWindow::MainWindow(Scene* scene, TextureManager* texture_manager, MaterialMa
 
   connect(ui->viewportSettingsWidget, &ViewportSettingsWidget::lightBakeRequested, this,
           &MainWindow::onBakeLightRequested);
+
+  connect(m_texture_load_timer, &QTimer::timeout, this, &MainWindow::onTextureLoadTimerTimeout);
+
+  connect(m_import_timer, &QTimer::timeout, this, &MainWindow::onImportTimerTimeout);
+  m_scene_importer->getImportFinishedObserver().add(
+      [this](SceneImporter::ImportID /*id*/, ImportStatus status, const std::string& object_name) {
+        onImportFinished(status, object_name);
+      });
 }
 
 void MainWindow::addObjectToScene(std::unique_ptr<Object3D> object, const std::string& base_name) {
@@ -117,8 +133,8 @@ void MainWindow::onActionAddCubeTriggered() {
   if(dialog.exec() == QDialog::Accepted) {
     const double          size = dialog.getSize();
     const CubeMeshBuilder cube_builder(size);
-    const Mesh            cube_mesh = cube_builder.build();
-    addObjectToScene(std::make_unique<Object3D>(cube_mesh), "Cube");
+    Mesh                  cube_mesh = cube_builder.build();
+    addObjectToScene(std::make_unique<Object3D>(std::move(cube_mesh)), "Cube");
   }
 }
 
@@ -130,9 +146,9 @@ void MainWindow::onActionAddSphereTriggered() {
     const int    rings    = dialog.getRings();
 
     const SphereMeshBuilder sphere_builder(radius, segments, rings);
-    const Mesh              sphere_mesh = sphere_builder.build();
+    Mesh                    sphere_mesh = sphere_builder.build();
 
-    addObjectToScene(std::make_unique<Object3D>(sphere_mesh), "Sphere");
+    addObjectToScene(std::make_unique<Object3D>(std::move(sphere_mesh), sphere_builder.getPrimitive()), "Sphere");
   }
 }
 
@@ -143,28 +159,58 @@ void MainWindow::onActionAddPlaneTriggered() {
     const double length = dialog.getLength();
 
     const PlaneMeshBuilder plane_builder(width, length);
-    const Mesh             plane_mesh = plane_builder.build();
+    Mesh                   plane_mesh = plane_builder.build();
 
-    addObjectToScene(std::make_unique<Object3D>(plane_mesh), "Plane");
+    addObjectToScene(std::make_unique<Object3D>(std::move(plane_mesh), plane_builder.getPrimitive()), "Plane");
   }
 }
 
 void MainWindow::onActionLoadObjTriggered() {
-  const QString file_name = QFileDialog::getOpenFileName(this, "Load .obj File", "", "OBJ Files (*.obj)");
-  if(file_name.isEmpty()) {
+  const QStringList file_names = QFileDialog::getOpenFileNames(this, "Load .obj Files", "", "OBJ Files (*.obj)");
+  if(file_names.isEmpty()) {
     return;
   }
 
-  const Mesh obj_mesh = OBJLoader::load(file_name.toStdString());
-  auto       object   = std::make_unique<Object3D>(obj_mesh);
+  // The files are loaded in the background, the objects are added to the scene as they are ready.
+  for(const QString& file_name : file_names) {
+    m_scene_importer->importOBJ(file_name.toStdString(), QFileInfo(file_name).baseName().toStdString());
+  }
+  ui->actionCancel_Imports->setEnabled(true);
+  m_import_timer->start(IMPORT_POLL_INTERVAL);
+}
+
+void MainWindow::onActionCancelImportsTriggered() { m_scene_importer->cancelAllImports(); }
 
-  if(!object) {
-    QMessageBox::warning(this, "Error", "Failed to load .obj file.");
+void MainWindow::onImportTimerTimeout() {
+  // Added objects upload themselves to the GPU when the scene notifies them.
+  ui->openGLWidget->makeCurrent();
+  m_scene_importer->processImports();
+  ui->openGLWidget->doneCurrent();
+
+  if(!m_scene_importer->hasPendingImports()) {
+    m_import_timer->stop();
+    ui->actionCancel_Imports->setEnabled(false);
     return;
   }
+  statusBar()->showMessage(QString("Importing %1 file(s)... %2%")
+                               .arg(m_scene_importer->getPendingImportCount())
+                               .arg(static_cast<int>(m_scene_importer->getProgress() * 100.0)));
+}
 
-  const std::string base_name = QFileInfo(file_name).baseName().toStdString();
-  addObjectToScene(std::move(object), base_name);
+void MainWindow::onImportFinished(ImportStatus status, const std::string& object_name) {
+  switch(status) {
+  case ImportStatus::COMPLETED:
+    ui->sceneView->addObject(QString::fromStdString(object_name));
+    statusBar()->showMessage(QString("Imported %1").arg(QString::fromStdString(object_name)), IMPORT_MESSAGE_DURATION);
+    break;
+  case ImportStatus::FAILED:
+    // A modal dialog would let the import timer run processImports again from within its notification.
+    statusBar()->showMessage("Failed to load .obj file.", IMPORT_MESSAGE_DURATION);
+    break;
+  case ImportStatus::CANCELLED:
+    statusBar()->showMessage("Import cancelled.", IMPORT_MESSAGE_DURATION);
+    break;
+  }
 }
 
 void MainWindow::addLightToScene(const std::string& base_name, std::unique_ptr<Light> light) {
@@ -334,14 +380,26 @@ QString MainWindow::createTextureFromFile(const std::string& file_path, ColorSpa
   texture_name         = QString::fromStdString(m_texture_manager->getAvailableTextureName(texture_name.toStdString()));
   m_textures_list_model->addItem(texture_name);
 
-  Texture* new_texture = m_texture_manager->getTexture(texture_name.toStdString());
-
-  new_texture->loadFromFile(file_path.c_str());
-  new_texture->setColorSpace(color_space);
+  // The color space is set before queueing the load, so that the worker converts the image to it.
+  m_texture_manager->addTexture(texture_name.toStdString());
+  m_texture_manager->getTexture(texture_name.toStdString())->setColorSpace(color_space);
+  m_texture_manager->loadTextureAsync(texture_name.toStdString(), file_path);
+  m_texture_load_timer->start(TEXTURE_LOAD_POLL_INTERVAL);
 
   return texture_name;
 }
 
+void MainWindow::onTextureLoadTimerTimeout() {
+  // Loaded textures upload themselves to the GPU when notified.
+  ui->openGLWidget->makeCurrent();
+  m_texture_manager->processLoadedTextures();
+  ui->openGLWidget->doneCurrent();
+
+  if(!m_texture_manager->hasPendingTextures()) {
+    m_texture_load_timer->stop();
+  }
+}
+
 MainWindow::~MainWindow() {
   delete ui;
   delete m_textures_list_model;
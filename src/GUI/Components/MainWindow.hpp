@@ -7,9 +7,12 @@
 
 #include <QAbstractListModel>
 #include <QMainWindow>
+#include <QTimer>
+#include <memory>
 
 #include "MaterialsListModel.hpp"
 #include "Scene/Scene.hpp"
+#include "Scene/SceneImporter.hpp"
 #include "TexturesListModel.hpp"
 
 class TextureManager;
@@ -41,6 +44,7 @@ private slots:
   void onActionAddSphereTriggered();
   void onActionAddPlaneTriggered();
   void onActionLoadObjTriggered();
+  void onActionCancelImportsTriggered();
 
   void onActionAddDirectionalLightTriggered();
   void onActionAddPointLightTriggered();
@@ -70,6 +74,9 @@ private slots:
 
   void onBakeLightRequested();
 
+  void onTextureLoadTimerTimeout();
+  void onImportTimerTimeout();
+
 private:
   Ui::MainWindow* ui;
 
@@ -79,9 +86,14 @@ private:
 
   TexturesListModel*  m_textures_list_model;
   MaterialsListModel* m_materials_list_model;
+  QTimer*             m_texture_load_timer; ///< Polls the textures decoded in the background while loads are pending.
+
+  std::unique_ptr<SceneImporter> m_scene_importer;
+  QTimer*                        m_import_timer; ///< Polls the meshes loaded in the background while imports run.
 
   void addLightToScene(const std::string& base_name, std::unique_ptr<Light> light);
   void addObjectToScene(std::unique_ptr<Object3D> object, const std::string& base_name);
+  void onImportFinished(ImportStatus status, const std::string& object_name);
 
   QString createTextureFromFile(const std::string& file_path, ColorSpace color_space);
 };
@@ -225,7 +225,7 @@ void MaterialsWidget::setupTextureBinding(TextureBinding* binding) {
 
   connect(binding->browse_button, &QPushButton::clicked, this, [this, binding]() {
     const QString texture_path =
-        QFileDialog::getOpenFileName(this, "Select Image", "", "Images (*.png *.jpg *.jpeg *.bmp *.tga *.hdr)");
+        QFileDialog::getOpenFileName(this, "Select Image", "", "Images (*.png *.jpg *.jpeg *.bmp *.tga *.hdr *.ltex)");
     if(!texture_path.isEmpty()) {
       binding->emitTextureCreatedSignal(texture_path);
     }
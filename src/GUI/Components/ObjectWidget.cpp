@@ -1,4 +1,5 @@
 // GCOVR_EXCL_START
+#include <QSignalBlocker>
 #include <string>
 
 #include "Core/Config.hpp"
@@ -13,6 +14,7 @@ ObjectWidget::ObjectWidget(QWidget* parent) : QGroupBox(parent), ui(new Ui::Obje
   setStyleSheet(QString::fromStdString(std::string(GROUP_BOX_STYLESHEET)));
 
   connect(ui->materialComboBox, &QComboBox::currentTextChanged, this, &ObjectWidget::onMaterialChanged);
+  connect(ui->subdivisionCheckBox, &QCheckBox::toggled, this, &ObjectWidget::onSubdivisionToggled);
 }
 
 void ObjectWidget::setObject3D(Object3D* object) {
@@ -52,6 +54,9 @@ void ObjectWidget::updateWidget() {
     material_name = "Default";
   }
   ui->materialComboBox->setCurrentText(QString::fromStdString(material_name));
+
+  const QSignalBlocker blocker(ui->subdivisionCheckBox);
+  ui->subdivisionCheckBox->setChecked(m_object->isSubdivisionSurface());
 }
 
 void ObjectWidget::onMaterialChanged(const QString& new_material) {
@@ -61,5 +66,12 @@ void ObjectWidget::onMaterialChanged(const QString& new_material) {
   emit materialChanged(m_object, new_material);
 }
 
+void ObjectWidget::onSubdivisionToggled(bool checked) {
+  if(m_object == nullptr) {
+    return;
+  }
+  m_object->setSubdivisionSurface(checked);
+}
+
 ObjectWidget::~ObjectWidget() { delete ui; }
 // GCOVR_EXCL_STOP
\ No newline at end of file
@@ -68,6 +68,7 @@ signals:
 
 private slots:
   void onMaterialChanged(const QString& new_material);
+  void onSubdivisionToggled(bool checked);
 
 private:
   Ui::ObjectWidget* ui;
@@ -52,7 +52,12 @@ void RenderSettingsWidget::updateWidget() {
   ui->samplesSpinBox->setValue(m_render_settings.getSamplesPerPixel());
 
   const RenderMode mode     = m_render_settings.getRenderMode();
-  const QString    mode_str = (mode == RenderMode::SINGLE_THREADED) ? "Single-threaded" : "Multi-threaded CPU";
+  QString          mode_str = "Multi-threaded CPU";
+  if(mode == RenderMode::SINGLE_THREADED) {
+    mode_str = "Single-threaded";
+  } else if(mode == RenderMode::WAVEFRONT_CPU) {
+    mode_str = "Wavefront CPU";
+  }
   ui->renderModeComboBox->setCurrentText(mode_str);
 
   ui->threadCountSpinBox->setValue(static_cast<int>(m_render_settings.getThreadCount()));
@@ -74,12 +79,15 @@ void RenderSettingsWidget::onRenderModeChanged(const QString& mode) {
     m_render_settings.setRenderMode(RenderMode::SINGLE_THREADED);
   } else if(mode == "Multi-threaded CPU") {
     m_render_settings.setRenderMode(RenderMode::MULTI_THREADED_CPU);
+  } else if(mode == "Wavefront CPU") {
+    m_render_settings.setRenderMode(RenderMode::WAVEFRONT_CPU);
   }
 
-  ui->chunksSizeSpinBox->setVisible(mode == "Multi-threaded CPU");
-  ui->chunksSizeLabel->setVisible(mode == "Multi-threaded CPU");
-  ui->threadCountSpinBox->setVisible(mode == "Multi-threaded CPU");
-  ui->threadCountLabel->setVisible(mode == "Multi-threaded CPU");
+  const bool is_chunked = (mode == "Multi-threaded CPU" || mode == "Wavefront CPU");
+  ui->chunksSizeSpinBox->setVisible(is_chunked);
+  ui->chunksSizeLabel->setVisible(is_chunked);
+  ui->threadCountSpinBox->setVisible(is_chunked);
+  ui->threadCountLabel->setVisible(is_chunked);
 }
 
 void RenderSettingsWidget::onThreadCountChanged(int count) { m_render_settings.setThreadCount(count); }
@@ -99,6 +107,8 @@ void RenderSettingsWidget::onRenderButtonClicked() {
           [this]() { emit renderProgress(m_renderer->getRenderTime()->getRenderStats()); });
   timer->start(1000); // NOLINT
 
+  // The subdivision surfaces are tessellated here: the viewport reads their meshes while the frame renders.
+  m_renderer->prepareFrame();
   auto     success = std::make_shared<bool>(false);
   QThread* thread  = QThread::create([this, success]() { *success = m_renderer->renderFrame(); });
 
@@ -103,6 +103,9 @@ void TexturesWidget::updateWidget() {
   case TextureSampling::TextureFiltering::NEAREST:
     ui->filteringComboBox->setCurrentText("Nearest");
     break;
+  case TextureSampling::TextureFiltering::TRILINEAR:
+    ui->filteringComboBox->setCurrentText("Trilinear");
+    break;
   }
 
   const TextureSampling::TextureWrapping wrapping_mode = m_current_texture->getWrappingMode();
@@ -216,6 +219,8 @@ void TexturesWidget::onFilteringModeChanged(const QString& mode) {
     m_current_texture->setFilteringMode(TextureSampling::TextureFiltering::BILINEAR);
   } else if(mode == "Nearest") {
     m_current_texture->setFilteringMode(TextureSampling::TextureFiltering::NEAREST);
+  } else if(mode == "Trilinear") {
+    m_current_texture->setFilteringMode(TextureSampling::TextureFiltering::TRILINEAR);
   }
 }
 
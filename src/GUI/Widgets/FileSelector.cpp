@@ -29,8 +29,8 @@ void FileSelector::openDialog() {
     break;
 
   case FileSelectorMode::IMAGE_FILE:
-    selected_path =
-        QFileDialog::getOpenFileName(this, "Select Image", getPath(), "Images (*.png *.jpg *.jpeg *.bmp *.tga *.hdr)");
+    selected_path = QFileDialog::getOpenFileName(this, "Select Image", getPath(),
+                                                 "Images (*.png *.jpg *.jpeg *.bmp *.tga *.hdr *.ltex)");
     break;
   }
 
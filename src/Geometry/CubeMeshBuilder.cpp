@@ -1,4 +1,5 @@
 #include <linalg/Vec3.hpp>
+#include <utility>
 #include <vector>
 
 #include "Core/ImageTypes.hpp"
@@ -49,5 +50,5 @@ Mesh CubeMeshBuilder::build() const {
     faces.push_back({{base, base + 2, base + 3}});
   }
 
-  return {vertices, faces};
+  return {std::move(vertices), std::move(faces)};
 }
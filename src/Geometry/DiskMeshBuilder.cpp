@@ -0,0 +1,42 @@
+#include <cmath>
+#include <linalg/Vec3.hpp>
+#include <numbers>
+#include <utility>
+#include <vector>
+
+#include "Geometry/DiskMeshBuilder.hpp"
+#include "Geometry/Mesh.hpp"
+
+namespace {
+constexpr int MIN_DISK_SEGMENTS = 3;
+} // namespace
+
+DiskMeshBuilder::DiskMeshBuilder(double radius, int segments) : m_radius(radius), m_segments(segments) {}
+
+Mesh DiskMeshBuilder::build() const {
+  if(m_radius <= 0 || m_segments < MIN_DISK_SEGMENTS) {
+    return {};
+  }
+
+  std::vector<Vertex> vertices(m_segments + 1);
+  std::vector<Face>   faces;
+  faces.reserve(m_segments);
+
+  for(int j = 0; j < m_segments; ++j) {
+    const double phi = j * 2.0 * std::numbers::pi / m_segments;
+
+    vertices[j + 1].position = linalg::Vec3d(m_radius * cos(phi), 0.0, m_radius * sin(phi));
+  }
+
+  for(auto& vertex : vertices) {
+    vertex.normal   = linalg::Vec3d(0.0, 1.0, 0.0);
+    vertex.uv_coord = {vertex.position.x + m_radius, vertex.position.z + m_radius};
+  }
+
+  for(int j = 0; j < m_segments; ++j) {
+    const int next = (j + 1) % m_segments;
+    faces.push_back({{0, next + 1, j + 1}});
+  }
+
+  return {std::move(vertices), std::move(faces)};
+}
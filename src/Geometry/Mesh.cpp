@@ -1,79 +1,198 @@
 #include <algorithm>
+#include <cmath>
 #include <cstddef>
-#include <linalg/Vec2.hpp>
 #include <linalg/Vec3.hpp>
 #include <linalg/linalg.hpp>
 #include <memory>
+#include <mutex>
+#include <utility>
 #include <vector>
 
 #include "BVH/BVHBuilder.hpp"
 #include "BVH/BVHNode.hpp"
 #include "Core/Config.hpp"
 #include "Core/ImageTypes.hpp"
+#include "Core/MathConstants.hpp"
 #include "Geometry/Mesh.hpp"
+#include "Geometry/MeshSimplifier.hpp"
+#include "Geometry/TangentGenerator.hpp"
+#include "Geometry/VertexEncoding.hpp"
 
-Mesh::Mesh(const std::vector<Vertex>& vertices, const std::vector<Face>& faces) : m_vertices(vertices) {
-  for(const auto& face : faces) {
-    if(std::max({face.vertex_indices[0], face.vertex_indices[1], face.vertex_indices[2]}) <
-       static_cast<int>(m_vertices.size())) {
-      this->m_faces.push_back(face);
-    }
+void VertexStreams::reserve(std::size_t vertex_count) {
+  positions.reserve(vertex_count);
+  normals.reserve(vertex_count);
+  uvs.reserve(vertex_count);
+}
+
+void VertexStreams::pushBack(const Vertex& vertex) {
+  positions.emplace_back(vertex.position);
+  normals.push_back(VertexEncoding::encodeDirection(vertex.normal));
+  uvs.push_back({static_cast<float>(vertex.uv_coord.u), static_cast<float>(vertex.uv_coord.v)});
+}
+
+Mesh::Mesh(std::vector<Vertex> vertices, std::vector<Face> faces) : m_faces(std::move(faces)) {
+  const int vertex_count = static_cast<int>(vertices.size());
+  std::erase_if(m_faces, [vertex_count](const Face& face) {
+    return std::max({face.vertex_indices[0], face.vertex_indices[1], face.vertex_indices[2]}) >= vertex_count;
+  });
+
+  m_streams.reserve(vertices.size());
+  for(const auto& vertex : vertices) {
+    m_streams.pushBack(vertex);
   }
-  computeTangentsAndBitangents();
+  computeBounds();
+  m_build_state.tangents_built = m_streams.size() == 0;
 }
 
-void Mesh::computeTangentsAndBitangents() {
-  for(const auto& face : m_faces) {
-    const Vertex& v0 = m_vertices[face.vertex_indices[0]];
-    const Vertex& v1 = m_vertices[face.vertex_indices[1]];
-    const Vertex& v2 = m_vertices[face.vertex_indices[2]];
+Mesh Mesh::FromPrecomputed(VertexStreams streams, std::vector<Face> faces, std::shared_ptr<BVHNode> bvh_root) {
+  Mesh mesh;
+  mesh.m_streams  = std::move(streams);
+  mesh.m_faces    = std::move(faces);
+  mesh.m_bvh_root = std::move(bvh_root);
+  mesh.computeBounds();
+  mesh.m_build_state.bvh_built      = true;
+  mesh.m_build_state.tangents_built = mesh.m_streams.tangents.size() == mesh.m_streams.size();
+  return mesh;
+}
 
-    const linalg::Vec3d edge1 = v1.position - v0.position;
-    const linalg::Vec3d edge2 = v2.position - v0.position;
+Mesh Mesh::FromStreams(VertexStreams streams, std::vector<Face> faces) {
+  Mesh mesh;
+  mesh.m_streams = std::move(streams);
+  mesh.m_faces   = std::move(faces);
+  mesh.computeBounds();
+  mesh.m_build_state.tangents_built = mesh.m_streams.tangents.size() == mesh.m_streams.size();
+  return mesh;
+}
 
-    const linalg::Vec2d delta_u_v1 = {v1.uv_coord.u - v0.uv_coord.u, v1.uv_coord.v - v0.uv_coord.v};
-    const linalg::Vec2d delta_u_v2 = {v2.uv_coord.u - v0.uv_coord.u, v2.uv_coord.v - v0.uv_coord.v};
+void Mesh::computeBounds() {
+  const std::vector<linalg::Vec3f>& positions = m_streams.positions;
+  if(positions.empty()) {
+    return;
+  }
+  linalg::Vec3f min_bound = positions[0];
+  linalg::Vec3f max_bound = positions[0];
+  for(const linalg::Vec3f& position : positions) {
+    min_bound = linalg::cwiseMin(min_bound, position);
+    max_bound = linalg::cwiseMax(max_bound, position);
+  }
+  m_min_bound = linalg::Vec3d(min_bound);
+  m_max_bound = linalg::Vec3d(max_bound);
+}
 
-    const double f = 1.0 / (delta_u_v1.x * delta_u_v2.y - delta_u_v2.x * delta_u_v1.y);
+void Mesh::buildTangents() const {
+  // The levels of detail built afterwards get their tangents with them.
+  if(hasTangents()) {
+    return;
+  }
+  const std::lock_guard<std::mutex> lock(m_build_state.mutex);
+  if(!hasTangents()) {
+    TangentGenerator::generate(m_streams, m_faces);
+    m_build_state.tangents_built.store(true, std::memory_order_release);
+  }
+  for(const auto& lod : m_lods) {
+    lod->buildTangents();
+  }
+}
+
+void Mesh::buildLODs() const {
+  if(m_build_state.lods_built.load(std::memory_order_acquire)) {
+    return;
+  }
+  const std::lock_guard<std::mutex> lock(m_build_state.mutex);
+  if(m_build_state.lods_built.load(std::memory_order_relaxed)) {
+    return;
+  }
+  // The BVH and tangents are published under the same lock, no level misses them.
+  std::vector<std::shared_ptr<Mesh>> lods = MeshSimplifier::buildLevels(*this);
+  for(const auto& lod : lods) {
+    if(m_build_state.bvh_built.load(std::memory_order_relaxed)) {
+      lod->buildBVH();
+    }
+    if(hasTangents()) {
+      lod->buildTangents();
+    }
+  }
+  m_lods = std::move(lods);
+  m_build_state.lods_built.store(true, std::memory_order_release);
+}
 
-    const linalg::Vec3d tangent   = f * (delta_u_v2.y * edge1 - delta_u_v1.y * edge2);
-    const linalg::Vec3d bitangent = f * (-delta_u_v2.x * edge1 + delta_u_v1.x * edge2);
+std::size_t Mesh::selectLODForScreenRadius(double screen_radius) const {
+  const double max_faces = PI * screen_radius * screen_radius / LOD_PIXELS_PER_FACE;
+  for(std::size_t level = 0; level < getLODCount(); ++level) {
+    if(static_cast<double>(getLOD(level).getFaces().size()) <= max_faces) {
+      return level;
+    }
+  }
+  return getLODCount() - 1;
+}
 
-    m_vertices[face.vertex_indices[0]].tangent += tangent;
-    m_vertices[face.vertex_indices[1]].tangent += tangent;
-    m_vertices[face.vertex_indices[2]].tangent += tangent;
+std::size_t Mesh::selectLODForDistance(double distance, double lod_distance) const {
+  const std::size_t lod_count = publishedLODs().size();
+  if(lod_count == 0 || lod_distance <= 0.0 || distance < lod_distance) {
+    return 0;
+  }
+  const auto level = static_cast<std::size_t>(std::floor(std::log2(distance / lod_distance))) + 1;
+  return std::min(level, lod_count);
+}
 
-    m_vertices[face.vertex_indices[0]].bitangent += bitangent;
-    m_vertices[face.vertex_indices[1]].bitangent += bitangent;
-    m_vertices[face.vertex_indices[2]].bitangent += bitangent;
+Vertex Mesh::getVertex(int index) const {
+  Vertex vertex;
+  vertex.position  = linalg::Vec3d(m_streams.positions[index]);
+  vertex.normal    = getVertexNormal(index);
+  vertex.uv_coord  = getVertexUV(index);
+  if(hasTangents()) {
+    vertex.tangent   = getVertexTangent(index);
+    vertex.bitangent = vertex.normal.cross(vertex.tangent) * static_cast<double>(m_streams.bitangent_signs[index]);
+  } else {
+    vertex.tangent   = TangentGenerator::orthogonalize({0.0, 0.0, 0.0}, vertex.normal);
+    vertex.bitangent = vertex.normal.cross(vertex.tangent);
   }
+  return vertex;
+}
 
-  for(auto& vertex : m_vertices) {
-    vertex.tangent.normalize();
-    vertex.bitangent.normalize();
+std::vector<Vertex> Mesh::getVertices() const {
+  std::vector<Vertex> vertices;
+  vertices.reserve(m_streams.size());
+  for(std::size_t i = 0; i < m_streams.size(); ++i) {
+    vertices.push_back(getVertex(static_cast<int>(i)));
   }
+  return vertices;
 }
 
-void Mesh::buildBVH() {
-  if(m_faces.size() < MINIMUM_FACES_FOR_BVH_CONSTRUCTION) {
-    m_bvh_root = nullptr;
+void Mesh::buildBVH() const {
+  if(m_build_state.bvh_built.load(std::memory_order_acquire)) {
+    return;
+  }
+  const std::lock_guard<std::mutex> lock(m_build_state.mutex);
+  if(m_build_state.bvh_built.load(std::memory_order_relaxed)) {
     return;
   }
-  m_bvh_root = std::make_shared<BVHNode>();
+  for(const auto& lod : m_lods) {
+    lod->buildBVH();
+  }
+  if(m_faces.size() >= MINIMUM_FACES_FOR_BVH_CONSTRUCTION) {
+    m_bvh_root = buildBVHRoot();
+  }
+  m_build_state.bvh_built.store(true, std::memory_order_release);
+}
+
+std::shared_ptr<BVHNode> Mesh::buildBVHRoot() const {
+  auto root = std::make_shared<BVHNode>();
 
   std::vector<std::shared_ptr<BVHNode>> bvh_leaves;
   bvh_leaves.reserve(m_faces.size());
 
   for(size_t i = 0; i < m_faces.size(); ++i) {
     const auto& face = m_faces[i];
-    const auto& v0   = m_vertices[face.vertex_indices[0]].position;
-    const auto& v1   = m_vertices[face.vertex_indices[1]].position;
-    const auto& v2   = m_vertices[face.vertex_indices[2]].position;
+    const auto  v0   = linalg::Vec3d(m_streams.positions[face.vertex_indices[0]]);
+    const auto  v1   = linalg::Vec3d(m_streams.positions[face.vertex_indices[1]]);
+    const auto  v2   = linalg::Vec3d(m_streams.positions[face.vertex_indices[2]]);
 
     const linalg::Vec3d min_bound = linalg::cwiseMin(v0, linalg::cwiseMin(v1, v2));
     const linalg::Vec3d max_bound = linalg::cwiseMax(v0, linalg::cwiseMax(v1, v2));
 
     bvh_leaves.emplace_back(std::make_shared<BVHNode>(min_bound, max_bound, static_cast<int>(i)));
   }
-  BVH::constructNode(m_bvh_root, bvh_leaves, 0, static_cast<int>(bvh_leaves.size()));
+  BVH::constructNode(root, bvh_leaves, 0, static_cast<int>(bvh_leaves.size()));
+  return root;
 }
\ No newline at end of file
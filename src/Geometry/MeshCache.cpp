@@ -0,0 +1,246 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <linalg/Vec3.hpp>
+#include <memory>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "BVH/FlatBVH.hpp"
+#include "Core/MappedFile.hpp"
+#include "Geometry/Mesh.hpp"
+#include "Geometry/MeshCache.hpp"
+#include "Geometry/VertexEncoding.hpp"
+
+namespace {
+
+constexpr std::uint32_t LMESH_MAGIC     = 0x48534D4CU; // "LMSH" read as a little-endian word
+constexpr std::uint32_t LMESH_VERSION   = 3;
+constexpr const char*   LMESH_EXTENSION = ".lmesh";
+constexpr std::size_t   SECTION_ALIGN   = 16;
+
+constexpr std::uint32_t FLAG_HAS_TANGENTS = 1U; // the tangent and bitangent sign sections are stored
+
+// Size of one vertex over all the streams, checked so that a change of encoding invalidates the caches.
+constexpr std::size_t VERTEX_SIZE = sizeof(linalg::Vec3f) + 2 * sizeof(PackedDirection) + sizeof(PackedUV) +
+                                    sizeof(std::int8_t);
+
+constexpr std::uint64_t HASH_SEED       = 0xCBF29CE484222325ULL;
+constexpr std::uint64_t HASH_MULTIPLIER = 0x9E3779B97F4A7C15ULL;
+constexpr unsigned int  HASH_SHIFT      = 32;
+
+struct FileHeader {
+  std::uint32_t magic        = LMESH_MAGIC;
+  std::uint32_t version      = LMESH_VERSION;
+  std::uint32_t vertex_size  = VERTEX_SIZE;
+  std::uint32_t face_size    = sizeof(Face);
+  std::uint32_t node_size    = sizeof(FlatBVHNode);
+  std::uint32_t flags        = 0;
+  std::uint64_t source_hash  = 0;
+  std::uint64_t vertex_count = 0;
+  std::uint64_t face_count   = 0;
+  std::uint64_t node_count   = 0;
+};
+
+std::size_t tangentCount(const FileHeader& header) {
+  return (header.flags & FLAG_HAS_TANGENTS) != 0 ? header.vertex_count : 0;
+}
+
+std::size_t alignSection(std::size_t offset) { return (offset + SECTION_ALIGN - 1) / SECTION_ALIGN * SECTION_ALIGN; }
+
+/**
+ * @struct SectionOffsets
+ * @brief Byte offsets of the arrays of an .lmesh file, each section starting on a SECTION_ALIGN boundary.
+ *
+ * The vertex streams are stored one after the other, in the order of VertexStreams. The tangent sections are empty
+ * when the mesh was written before its tangents were built.
+ */
+struct SectionOffsets {
+  std::size_t positions       = 0;
+  std::size_t normals         = 0;
+  std::size_t tangents        = 0;
+  std::size_t uvs             = 0;
+  std::size_t bitangent_signs = 0;
+  std::size_t faces           = 0;
+  std::size_t nodes           = 0;
+  std::size_t end             = 0;
+
+  explicit SectionOffsets(const FileHeader& header) {
+    const std::size_t tangent_count = tangentCount(header);
+
+    positions       = alignSection(sizeof(FileHeader));
+    normals         = alignSection(positions + header.vertex_count * sizeof(linalg::Vec3f));
+    tangents        = alignSection(normals + header.vertex_count * sizeof(PackedDirection));
+    uvs             = alignSection(tangents + tangent_count * sizeof(PackedDirection));
+    bitangent_signs = alignSection(uvs + header.vertex_count * sizeof(PackedUV));
+    faces           = alignSection(bitangent_signs + tangent_count * sizeof(std::int8_t));
+    nodes           = alignSection(faces + header.face_count * sizeof(Face));
+    end             = nodes + header.node_count * sizeof(FlatBVHNode);
+  }
+};
+
+template <typename T> void writeSection(std::ofstream& file, std::size_t offset, const T* data, std::size_t count) {
+  static const char zeros[SECTION_ALIGN] = {};
+  const auto        position             = static_cast<std::size_t>(file.tellp());
+  file.write(zeros, static_cast<std::streamsize>(offset - position));
+  file.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(count * sizeof(T)));
+}
+
+template <typename T> std::vector<T> readSection(std::string_view content, std::size_t offset, std::size_t count) {
+  std::vector<T> values(count);
+  std::memcpy(values.data(), content.data() + offset, count * sizeof(T));
+  return values;
+}
+
+bool isHeaderValid(const FileHeader& header, std::size_t file_size) {
+  // The counts are bounded by the file size first so that computing the section offsets cannot overflow.
+  if(header.magic != LMESH_MAGIC || header.version != LMESH_VERSION || header.vertex_size != VERTEX_SIZE ||
+     header.face_size != sizeof(Face) || header.node_size != sizeof(FlatBVHNode) ||
+     header.vertex_count > file_size || header.face_count > file_size || header.node_count > file_size ||
+     (header.flags & ~FLAG_HAS_TANGENTS) != 0) {
+    return false;
+  }
+  return SectionOffsets(header).end == file_size;
+}
+
+bool areIndicesValid(const std::vector<Face>& faces, std::size_t vertex_count, const std::vector<FlatBVHNode>& nodes) {
+  for(const Face& face : faces) {
+    for(const int index : face.vertex_indices) {
+      if(index < 0 || static_cast<std::size_t>(index) >= vertex_count) {
+        return false;
+      }
+    }
+  }
+  for(const FlatBVHNode& node : nodes) {
+    if(node.leaf_index >= 0 && static_cast<std::size_t>(node.leaf_index) >= faces.size()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::string getTemporaryPath(const std::string& path) {
+  // Unique to the writing thread, and random across processes: concurrent imports of the same file each write their
+  // own temporary file, and the last rename wins with a complete cache.
+  static std::atomic<std::uint64_t> write_count{0};
+  const std::uint64_t thread_hash = std::hash<std::thread::id>{}(std::this_thread::get_id());
+  const std::uint64_t random_part = (static_cast<std::uint64_t>(std::random_device{}()) << 32U) ^ write_count++;
+  std::ostringstream  name;
+  name << path << '.' << std::hex << thread_hash << '.' << random_part << ".tmp";
+  return name.str();
+}
+
+} // namespace
+
+std::string MeshCache::getCachePath(const std::string& source_path) {
+  return std::filesystem::path(source_path).replace_extension(LMESH_EXTENSION).string();
+}
+
+std::uint64_t MeshCache::hashSource(std::string_view content) {
+  std::uint64_t hash   = HASH_SEED ^ content.size();
+  std::size_t   offset = 0;
+  for(; offset + sizeof(std::uint64_t) <= content.size(); offset += sizeof(std::uint64_t)) {
+    std::uint64_t word = 0;
+    std::memcpy(&word, content.data() + offset, sizeof(word));
+    hash = (hash ^ word) * HASH_MULTIPLIER;
+    hash ^= hash >> HASH_SHIFT;
+  }
+  for(; offset < content.size(); ++offset) {
+    hash = (hash ^ static_cast<unsigned char>(content[offset])) * HASH_MULTIPLIER;
+  }
+  return hash ^ (hash >> HASH_SHIFT);
+}
+
+bool MeshCache::write(const std::string& path, Mesh& mesh, std::uint64_t source_hash) {
+  mesh.buildBVH();
+  const std::vector<FlatBVHNode> nodes = BVH::flatten(mesh.getBVHRoot());
+
+  FileHeader header;
+  header.source_hash  = source_hash;
+  header.flags        = mesh.hasTangents() ? FLAG_HAS_TANGENTS : 0;
+  header.vertex_count = mesh.getVertexCount();
+  header.face_count   = mesh.getFaces().size();
+  header.node_count   = nodes.size();
+  const SectionOffsets offsets(header);
+
+  // Written aside then renamed, so that a reader never maps a partially written cache.
+  const std::string temporary_path = getTemporaryPath(path);
+  {
+    std::ofstream file(temporary_path, std::ios::binary | std::ios::trunc);
+    if(!file) {
+      std::cerr << "Error writing mesh cache: cannot open " << temporary_path << '\n';
+      return false;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    const VertexStreams& streams = mesh.getStreams();
+    writeSection(file, offsets.positions, streams.positions.data(), streams.size());
+    writeSection(file, offsets.normals, streams.normals.data(), streams.size());
+    writeSection(file, offsets.tangents, streams.tangents.data(), streams.tangents.size());
+    writeSection(file, offsets.uvs, streams.uvs.data(), streams.size());
+    writeSection(file, offsets.bitangent_signs, streams.bitangent_signs.data(), streams.bitangent_signs.size());
+    writeSection(file, offsets.faces, mesh.getFaces().data(), mesh.getFaces().size());
+    writeSection(file, offsets.nodes, nodes.data(), nodes.size());
+    if(!file) {
+      std::cerr << "Error writing mesh cache: cannot write " << temporary_path << '\n';
+      file.close();
+      std::filesystem::remove(temporary_path);
+      return false;
+    }
+  }
+
+  std::error_code error;
+  std::filesystem::rename(temporary_path, path, error);
+  if(error) {
+    std::cerr << "Error writing mesh cache: cannot rename " << temporary_path << " to " << path << '\n';
+    std::filesystem::remove(temporary_path, error);
+    return false;
+  }
+  return true;
+}
+
+std::optional<Mesh> MeshCache::read(const std::string& path, std::uint64_t source_hash) {
+  const MappedFile file(path);
+  const std::string_view content = file.getContent();
+  if(content.size() < sizeof(FileHeader)) {
+    return std::nullopt;
+  }
+
+  FileHeader header;
+  std::memcpy(&header, content.data(), sizeof(header));
+  if(!isHeaderValid(header, content.size()) || header.source_hash != source_hash) {
+    return std::nullopt;
+  }
+
+  const SectionOffsets offsets(header);
+  const std::size_t    tangent_count = tangentCount(header);
+  VertexStreams        streams;
+  streams.positions       = readSection<linalg::Vec3f>(content, offsets.positions, header.vertex_count);
+  streams.normals         = readSection<PackedDirection>(content, offsets.normals, header.vertex_count);
+  streams.tangents        = readSection<PackedDirection>(content, offsets.tangents, tangent_count);
+  streams.uvs             = readSection<PackedUV>(content, offsets.uvs, header.vertex_count);
+  streams.bitangent_signs = readSection<std::int8_t>(content, offsets.bitangent_signs, tangent_count);
+
+  std::vector<Face>        faces = readSection<Face>(content, offsets.faces, header.face_count);
+  std::vector<FlatBVHNode> nodes = readSection<FlatBVHNode>(content, offsets.nodes, header.node_count);
+  if(!areIndicesValid(faces, streams.size(), nodes)) {
+    return std::nullopt;
+  }
+
+  std::shared_ptr<BVHNode> bvh_root = BVH::unflatten(nodes.data(), nodes.size());
+  if(bvh_root == nullptr && !nodes.empty()) {
+    return std::nullopt;
+  }
+  return Mesh::FromPrecomputed(std::move(streams), std::move(faces), std::move(bvh_root));
+}
@@ -0,0 +1,449 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <linalg/Vec3.hpp>
+#include <memory>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "Core/Config.hpp"
+#include "Geometry/Mesh.hpp"
+#include "Geometry/MeshSimplifier.hpp"
+
+namespace {
+
+/**
+ * @struct Quadric
+ * @brief Sum of squared distances to planes, the symmetric matrix Q of the form (p, 1) Q (p, 1)^T stored by its upper
+ * triangle.
+ */
+struct Quadric {
+  double xx = 0.0, xy = 0.0, xz = 0.0, xw = 0.0;
+  double yy = 0.0, yz = 0.0, yw = 0.0;
+  double zz = 0.0, zw = 0.0;
+  double ww = 0.0;
+
+  /**
+   * @brief Creates the quadric of the plane through a point.
+   * @param normal The unit normal of the plane.
+   * @param point A point of the plane.
+   * @return The quadric.
+   */
+  static Quadric FromPlane(const linalg::Vec3d& normal, const linalg::Vec3d& point) {
+    const double offset = -normal.dot(point);
+    return {normal.x * normal.x, normal.x * normal.y, normal.x * normal.z, normal.x * offset,
+            normal.y * normal.y, normal.y * normal.z, normal.y * offset,   normal.z * normal.z,
+            normal.z * offset,   offset * offset};
+  }
+
+  Quadric& operator+=(const Quadric& other) {
+    xx += other.xx, xy += other.xy, xz += other.xz, xw += other.xw;
+    yy += other.yy, yz += other.yz, yw += other.yw;
+    zz += other.zz, zw += other.zw;
+    ww += other.ww;
+    return *this;
+  }
+
+  /**
+   * @brief Evaluates the sum of squared distances of a point to the planes.
+   * @param p The point.
+   * @return The error, never negative up to rounding.
+   */
+  double evaluate(const linalg::Vec3d& p) const {
+    return (p.x * ((xx * p.x) + (2.0 * ((xy * p.y) + (xz * p.z) + xw)))) +
+           (p.y * ((yy * p.y) + (2.0 * ((yz * p.z) + yw)))) + (p.z * ((zz * p.z) + (2.0 * zw))) + ww;
+  }
+};
+
+/**
+ * @struct Collapse
+ * @brief Candidate collapse of the point from onto the point to, valid while neither point changed since it was
+ * queued.
+ */
+struct Collapse {
+  double        cost         = 0.0;
+  std::uint32_t from         = 0;
+  std::uint32_t to           = 0;
+  std::uint32_t from_version = 0;
+  std::uint32_t to_version   = 0;
+
+  bool operator>(const Collapse& other) const { return cost > other.cost; }
+};
+
+std::uint64_t edgeKey(std::uint32_t a, std::uint32_t b) {
+  return (static_cast<std::uint64_t>(std::min(a, b)) << 32U) | std::max(a, b);
+}
+
+/**
+ * @class Simplifier
+ * @brief State of the simplification of one mesh.
+ *
+ * The connectivity is the one of the points, the vertices welded by position: the vertices split along a texture seam
+ * are one point, and collapsing that point moves each of its vertices onto the vertex of the same side of the seam,
+ * so that the seam stays closed. Faces degenerate once welded, such as the ones at the poles of a sphere, are dropped.
+ * The lists of faces around the points are updated by the collapses and may hold removed faces, which are skipped.
+ */
+class Simplifier {
+private:
+  const Mesh& m_mesh;
+
+  std::vector<std::uint32_t>              m_point_of;
+  std::vector<linalg::Vec3d>              m_positions;
+  std::vector<Face>                       m_faces;
+  std::vector<bool>                       m_face_alive;
+  std::vector<std::vector<std::uint32_t>> m_point_faces;
+  std::vector<Quadric>                    m_quadrics;
+  std::vector<bool>                       m_locked;
+  std::vector<bool>                       m_border;
+  std::vector<bool>                       m_removed;
+  std::vector<std::uint32_t>              m_versions;
+  std::size_t                             m_alive_face_count = 0;
+  double                                  m_max_cost         = 0.0;
+
+  std::priority_queue<Collapse, std::vector<Collapse>, std::greater<>> m_queue;
+
+  std::uint32_t point(const Face& face, int corner) const { return m_point_of[face.vertex_indices[corner]]; }
+
+  bool hasPoint(const Face& face, std::uint32_t p) const {
+    return point(face, 0) == p || point(face, 1) == p || point(face, 2) == p;
+  }
+
+  linalg::Vec3d faceCross(std::uint32_t p0, std::uint32_t p1, std::uint32_t p2) const {
+    return (m_positions[p1] - m_positions[p0]).cross(m_positions[p2] - m_positions[p0]);
+  }
+
+  linalg::Vec3d faceCross(const Face& face) const { return faceCross(point(face, 0), point(face, 1), point(face, 2)); }
+
+  void weldPositions() {
+    const std::vector<linalg::Vec3f>& positions = m_mesh.getStreams().positions;
+
+    // Positions are compared on a grid, vertices of a seam computed with different rounding fall in the same cell.
+    const double diagonal = (m_mesh.getMaxBound() - m_mesh.getMinBound()).length();
+    const double scale    = diagonal > 0.0 ? 1.0 / (LOD_WELD_TOLERANCE * diagonal) : 1.0;
+    std::vector<std::array<std::int64_t, 3>> cells(positions.size());
+    for(std::size_t v = 0; v < positions.size(); ++v) {
+      cells[v] = {std::llround(positions[v].x * scale), std::llround(positions[v].y * scale),
+                  std::llround(positions[v].z * scale)};
+    }
+
+    std::vector<std::uint32_t> order(positions.size());
+    for(std::size_t v = 0; v < order.size(); ++v) {
+      order[v] = static_cast<std::uint32_t>(v);
+    }
+    std::ranges::sort(order, [&cells](std::uint32_t a, std::uint32_t b) { return cells[a] < cells[b]; });
+
+    m_point_of.resize(positions.size());
+    for(std::size_t i = 0; i < order.size(); ++i) {
+      if(i == 0 || cells[order[i - 1]] != cells[order[i]]) {
+        m_positions.emplace_back(positions[order[i]]);
+      }
+      m_point_of[order[i]] = static_cast<std::uint32_t>(m_positions.size() - 1);
+    }
+  }
+
+  void classifyEdges() {
+    std::vector<std::uint64_t> edges;
+    edges.reserve(m_faces.size() * 3);
+    for(const Face& face : m_faces) {
+      for(int i = 0; i < 3; ++i) {
+        edges.push_back(edgeKey(point(face, i), point(face, (i + 1) % 3)));
+      }
+    }
+    std::ranges::sort(edges);
+
+    std::vector<std::uint64_t> border_edges;
+    for(std::size_t begin = 0; begin < edges.size();) {
+      std::size_t end = begin + 1;
+      while(end < edges.size() && edges[end] == edges[begin]) {
+        ++end;
+      }
+      const auto a = static_cast<std::uint32_t>(edges[begin] >> 32U);
+      const auto b = static_cast<std::uint32_t>(edges[begin] & 0xFFFFFFFFU);
+      if(end - begin == 1) {
+        m_border[a] = true;
+        m_border[b] = true;
+        border_edges.push_back(edges[begin]);
+      } else if(end - begin > 2) {
+        // Non-manifold edge: its points stay in place.
+        m_locked[a] = true;
+        m_locked[b] = true;
+      }
+      begin = end;
+    }
+
+    // Planes through the open borders, orthogonal to their faces, keep the borders in place (Garland and Heckbert).
+    for(const Face& face : m_faces) {
+      const linalg::Vec3d normal = faceCross(face).normalized();
+      for(int i = 0; i < 3; ++i) {
+        const std::uint32_t a = point(face, i);
+        const std::uint32_t b = point(face, (i + 1) % 3);
+        if(!std::ranges::binary_search(border_edges, edgeKey(a, b))) {
+          continue;
+        }
+        const Quadric border =
+            Quadric::FromPlane((m_positions[b] - m_positions[a]).cross(normal).normalized(), m_positions[a]);
+        m_quadrics[a] += border;
+        m_quadrics[b] += border;
+      }
+    }
+  }
+
+  void pushCollapse(std::uint32_t from, std::uint32_t to) {
+    if(m_locked[from]) {
+      return;
+    }
+    Quadric quadric = m_quadrics[from];
+    quadric += m_quadrics[to];
+    const double cost = quadric.evaluate(m_positions[to]);
+    if(cost <= m_max_cost) {
+      m_queue.push({cost, from, to, m_versions[from], m_versions[to]});
+    }
+  }
+
+  void pushCandidates(std::uint32_t a, std::uint32_t b) {
+    pushCollapse(a, b);
+    pushCollapse(b, a);
+  }
+
+  std::vector<std::uint32_t> neighbors(std::uint32_t p) const {
+    std::vector<std::uint32_t> result;
+    for(const std::uint32_t f : m_point_faces[p]) {
+      if(!m_face_alive[f]) {
+        continue;
+      }
+      for(int corner = 0; corner < 3; ++corner) {
+        if(point(m_faces[f], corner) != p) {
+          result.push_back(point(m_faces[f], corner));
+        }
+      }
+    }
+    std::ranges::sort(result);
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+  }
+
+  /**
+   * @brief Checks a collapse and matches each vertex of the point from with the vertex of the point to it moves onto.
+   * @param from The point removed.
+   * @param to The point kept.
+   * @param moves The pairs of vertices, filled when the collapse is valid.
+   * @return True if the collapse keeps the surface manifold, its faces unflipped and its seams closed.
+   */
+  bool canCollapse(std::uint32_t from, std::uint32_t to, std::vector<std::pair<int, int>>& moves) const {
+    moves.clear();
+    std::size_t shared_faces = 0;
+    for(const std::uint32_t f : m_point_faces[from]) {
+      if(!m_face_alive[f] || !hasPoint(m_faces[f], to)) {
+        continue;
+      }
+      ++shared_faces;
+      int from_vertex = -1;
+      int to_vertex   = -1;
+      for(const int vertex : m_faces[f].vertex_indices) {
+        from_vertex = m_point_of[vertex] == from ? vertex : from_vertex;
+        to_vertex   = m_point_of[vertex] == to ? vertex : to_vertex;
+      }
+      const auto match = std::ranges::find(moves, from_vertex, &std::pair<int, int>::first);
+      if(match == moves.end()) {
+        moves.emplace_back(from_vertex, to_vertex);
+      } else if(match->second != to_vertex) {
+        // The edge is a seam for the point kept but not for the point removed.
+        return false;
+      }
+    }
+    // A point on an open border only slides along it.
+    if(shared_faces == 0 || (m_border[from] && shared_faces != 1)) {
+      return false;
+    }
+
+    for(const std::uint32_t f : m_point_faces[from]) {
+      if(!m_face_alive[f] || hasPoint(m_faces[f], to)) {
+        continue;
+      }
+      // Every vertex of a moved face needs a vertex to move onto, on the same side of the seams.
+      for(const int vertex : m_faces[f].vertex_indices) {
+        if(m_point_of[vertex] == from && std::ranges::find(moves, vertex, &std::pair<int, int>::first) == moves.end()) {
+          return false;
+        }
+      }
+      // The moved faces must not flip nor become degenerate.
+      std::array<std::uint32_t, 3> moved = {point(m_faces[f], 0), point(m_faces[f], 1), point(m_faces[f], 2)};
+      std::ranges::replace(moved, from, to);
+      if(faceCross(m_faces[f]).dot(faceCross(moved[0], moved[1], moved[2])) <= 0.0) {
+        return false;
+      }
+    }
+
+    // Link condition: the points adjacent to both ends are the opposite corners of the faces of the edge, otherwise
+    // the collapse would pinch the surface.
+    const std::vector<std::uint32_t> from_neighbors = neighbors(from);
+    const std::vector<std::uint32_t> to_neighbors   = neighbors(to);
+    std::vector<std::uint32_t>       common;
+    std::ranges::set_intersection(from_neighbors, to_neighbors, std::back_inserter(common));
+    return common.size() == shared_faces;
+  }
+
+  void collapse(std::uint32_t from, std::uint32_t to, const std::vector<std::pair<int, int>>& moves) {
+    for(const std::uint32_t f : m_point_faces[from]) {
+      if(!m_face_alive[f]) {
+        continue;
+      }
+      Face& face = m_faces[f];
+      if(hasPoint(face, to)) {
+        m_face_alive[f] = false;
+        --m_alive_face_count;
+        continue;
+      }
+      for(int& vertex : face.vertex_indices) {
+        const auto match = std::ranges::find(moves, vertex, &std::pair<int, int>::first);
+        vertex           = match != moves.end() ? match->second : vertex;
+      }
+      m_point_faces[to].push_back(f);
+    }
+    std::vector<std::uint32_t>().swap(m_point_faces[from]);
+    std::erase_if(m_point_faces[to], [this](std::uint32_t f) { return !m_face_alive[f]; });
+
+    m_quadrics[to] += m_quadrics[from];
+    m_removed[from] = true;
+    ++m_versions[to];
+    for(const std::uint32_t neighbor : neighbors(to)) {
+      pushCandidates(to, neighbor);
+    }
+  }
+
+public:
+  /**
+   * @brief Prepares the simplification of a mesh.
+   * @param mesh The mesh, which must outlive the simplifier.
+   * @param max_error The largest distance of a kept point to the planes of the faces merged into it.
+   */
+  Simplifier(const Mesh& mesh, double max_error) : m_mesh(mesh), m_max_cost(max_error * max_error) {
+    weldPositions();
+    const std::size_t point_count = m_positions.size();
+    m_point_faces.resize(point_count);
+    m_quadrics.resize(point_count);
+    m_locked.resize(point_count, false);
+    m_border.resize(point_count, false);
+    m_removed.resize(point_count, false);
+    m_versions.resize(point_count, 0);
+
+    for(const Face& face : mesh.getFaces()) {
+      if(faceCross(face).length() > 0.0) {
+        m_faces.push_back(face);
+      }
+    }
+    m_face_alive.resize(m_faces.size(), true);
+    m_alive_face_count = m_faces.size();
+
+    for(std::size_t f = 0; f < m_faces.size(); ++f) {
+      const Quadric plane = Quadric::FromPlane(faceCross(m_faces[f]).normalized(), m_positions[point(m_faces[f], 0)]);
+      for(int corner = 0; corner < 3; ++corner) {
+        m_point_faces[point(m_faces[f], corner)].push_back(static_cast<std::uint32_t>(f));
+        m_quadrics[point(m_faces[f], corner)] += plane;
+      }
+    }
+    classifyEdges();
+
+    for(std::uint32_t p = 0; p < point_count; ++p) {
+      for(const std::uint32_t neighbor : neighbors(p)) {
+        if(p < neighbor) {
+          pushCandidates(p, neighbor);
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Collapses the edges of lowest error until the mesh has the target number of faces, or no collapse within
+   * the error bound is left.
+   * @param target_face_count The number of faces to reach.
+   */
+  void run(std::size_t target_face_count) {
+    std::vector<std::pair<int, int>> moves;
+    while(m_alive_face_count > target_face_count && !m_queue.empty()) {
+      const Collapse candidate = m_queue.top();
+      m_queue.pop();
+      if(m_removed[candidate.from] || m_removed[candidate.to] || m_versions[candidate.from] != candidate.from_version ||
+         m_versions[candidate.to] != candidate.to_version || !canCollapse(candidate.from, candidate.to, moves)) {
+        continue;
+      }
+      collapse(candidate.from, candidate.to, moves);
+    }
+  }
+
+  /**
+   * @brief Builds the simplified mesh from the vertices still used by a face, in their original order.
+   * @return The simplified mesh, whose vertices keep their encoded attributes.
+   */
+  Mesh extract() const {
+    const VertexStreams& source       = m_mesh.getStreams();
+    const bool           has_tangents = m_mesh.hasTangents();
+
+    std::vector<int> remap(source.size(), -1);
+    for(std::size_t f = 0; f < m_faces.size(); ++f) {
+      if(m_face_alive[f]) {
+        for(const int vertex : m_faces[f].vertex_indices) {
+          remap[vertex] = 0;
+        }
+      }
+    }
+
+    VertexStreams streams;
+    for(std::size_t v = 0; v < remap.size(); ++v) {
+      if(remap[v] < 0) {
+        continue;
+      }
+      remap[v] = static_cast<int>(streams.positions.size());
+      streams.positions.push_back(source.positions[v]);
+      streams.normals.push_back(source.normals[v]);
+      streams.uvs.push_back(source.uvs[v]);
+      if(has_tangents) {
+        streams.tangents.push_back(source.tangents[v]);
+        streams.bitangent_signs.push_back(source.bitangent_signs[v]);
+      }
+    }
+
+    std::vector<Face> faces;
+    faces.reserve(m_alive_face_count);
+    for(std::size_t f = 0; f < m_faces.size(); ++f) {
+      if(m_face_alive[f]) {
+        const auto& indices = m_faces[f].vertex_indices;
+        faces.push_back({{remap[indices[0]], remap[indices[1]], remap[indices[2]]}});
+      }
+    }
+    return Mesh::FromStreams(std::move(streams), std::move(faces));
+  }
+};
+
+} // namespace
+
+Mesh MeshSimplifier::simplify(const Mesh& mesh, std::size_t target_face_count, double max_error) {
+  Simplifier simplifier(mesh, max_error);
+  simplifier.run(target_face_count);
+  return simplifier.extract();
+}
+
+std::vector<std::shared_ptr<Mesh>> MeshSimplifier::buildLevels(const Mesh& mesh) {
+  std::vector<std::shared_ptr<Mesh>> levels;
+  const Mesh*                        previous  = &mesh;
+  double                             max_error = LOD_MAX_ERROR * (mesh.getMaxBound() - mesh.getMinBound()).length();
+  while(levels.size() < LOD_MAX_LEVELS && previous->getFaces().size() > LOD_MIN_FACES) {
+    const std::size_t face_count = previous->getFaces().size();
+    const std::size_t target =
+        std::max(LOD_MIN_FACES, static_cast<std::size_t>(static_cast<double>(face_count) * LOD_REDUCTION_RATIO));
+
+    auto level = std::make_shared<Mesh>(simplify(*previous, target, max_error));
+    if(static_cast<double>(level->getFaces().size()) > static_cast<double>(face_count) * LOD_MAX_KEPT_RATIO) {
+      break;
+    }
+    previous = level.get();
+    levels.push_back(std::move(level));
+    max_error *= 2.0;
+  }
+  return levels;
+}
@@ -0,0 +1,334 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <linalg/Vec3.hpp>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "Core/Config.hpp"
+#include "Core/ImageTypes.hpp"
+#include "Core/MathConstants.hpp"
+#include "Core/ThreadPool.hpp"
+#include "Geometry/Mesh.hpp"
+#include "Geometry/MeshSubdivider.hpp"
+
+namespace {
+
+constexpr double EDGE_END_WEIGHT      = 3.0 / 8.0;  // endpoints of an interior edge
+constexpr double EDGE_OPPOSITE_WEIGHT = 1.0 / 8.0;  // corners facing an interior edge
+constexpr double BORDER_WEIGHT        = 1.0 / 8.0;  // neighbors of a vertex along the border
+constexpr double VALENCE_3_WEIGHT     = 3.0 / 16.0; // neighbors of an interior vertex of valence 3
+constexpr double NEIGHBORS_WEIGHT     = 3.0 / 8.0;  // neighbors of an interior vertex of higher valence, together
+
+/**
+ * @brief Runs a function over the ranges of SUBDIVISION_JOB_SIZE items of [0, count), in parallel when there are
+ * several.
+ * @param count The number of items.
+ * @param function The function called with the first and past-the-end indices of each range.
+ */
+template <typename Function> void forEachRange(std::size_t count, const Function& function) {
+  const std::size_t job_count = (count + SUBDIVISION_JOB_SIZE - 1) / SUBDIVISION_JOB_SIZE;
+  if(job_count <= 1) {
+    function(std::size_t{0}, count);
+    return;
+  }
+
+  const auto thread_count = static_cast<unsigned int>(
+      std::min<std::size_t>(job_count, std::max(1U, std::thread::hardware_concurrency())));
+  ThreadPool                     pool(thread_count);
+  std::vector<std::future<void>> jobs;
+  jobs.reserve(job_count);
+  for(std::size_t begin = 0; begin < count; begin += SUBDIVISION_JOB_SIZE) {
+    const std::size_t end = std::min(begin + SUBDIVISION_JOB_SIZE, count);
+    jobs.push_back(pool.submit([&function, begin, end]() { function(begin, end); }));
+  }
+  for(auto& job : jobs) {
+    job.get();
+  }
+}
+
+std::uint64_t edgeKey(std::uint32_t a, std::uint32_t b) {
+  return (static_cast<std::uint64_t>(std::min(a, b)) << 32U) | std::max(a, b);
+}
+
+struct HalfEdge {
+  std::uint64_t key    = 0;
+  std::uint32_t face   = 0;
+  std::uint32_t corner = 0; ///< The half-edge goes from this corner of the face to the next one.
+
+  bool operator<(const HalfEdge& other) const {
+    return std::tie(key, face, corner) < std::tie(other.key, other.face, other.corner);
+  }
+};
+
+/**
+ * @struct SubdividedMesh
+ * @brief Mesh being subdivided: the positions are held by the points the vertices are welded into, the texture
+ * coordinates by the vertices.
+ */
+struct SubdividedMesh {
+  std::vector<linalg::Vec3d> points;
+  std::vector<std::uint32_t> point_of; ///< Point of each vertex.
+  std::vector<TextureUV>     uvs;
+  std::vector<linalg::Vec3d> normals; ///< Interpolated from the cage, for the points where the surface has no normal.
+  std::vector<Face>          faces;
+
+  std::uint32_t point(const Face& face, std::uint32_t corner) const {
+    return point_of[face.vertex_indices[corner % 3]];
+  }
+};
+
+SubdividedMesh weld(const Mesh& mesh) {
+  const std::vector<linalg::Vec3f>& positions = mesh.getStreams().positions;
+
+  // Positions are compared on a grid, vertices of a seam computed with different rounding fall in the same cell.
+  const double diagonal = (mesh.getMaxBound() - mesh.getMinBound()).length();
+  const double scale    = diagonal > 0.0 ? 1.0 / (SUBDIVISION_WELD_TOLERANCE * diagonal) : 1.0;
+  std::vector<std::array<std::int64_t, 3>> cells(positions.size());
+  for(std::size_t v = 0; v < positions.size(); ++v) {
+    cells[v] = {std::llround(positions[v].x * scale), std::llround(positions[v].y * scale),
+                std::llround(positions[v].z * scale)};
+  }
+
+  std::vector<std::uint32_t> order(positions.size());
+  for(std::size_t v = 0; v < order.size(); ++v) {
+    order[v] = static_cast<std::uint32_t>(v);
+  }
+  std::ranges::sort(order, [&cells](std::uint32_t a, std::uint32_t b) { return cells[a] < cells[b]; });
+
+  SubdividedMesh result;
+  result.point_of.resize(positions.size());
+  for(std::size_t i = 0; i < order.size(); ++i) {
+    if(i == 0 || cells[order[i - 1]] != cells[order[i]]) {
+      result.points.emplace_back(positions[order[i]]);
+    }
+    result.point_of[order[i]] = static_cast<std::uint32_t>(result.points.size() - 1);
+  }
+
+  result.uvs.resize(positions.size());
+  result.normals.resize(positions.size());
+  for(std::size_t v = 0; v < positions.size(); ++v) {
+    result.uvs[v]     = mesh.getVertexUV(static_cast<int>(v));
+    result.normals[v] = mesh.getVertexNormal(static_cast<int>(v));
+  }
+
+  for(const Face& face : mesh.getFaces()) {
+    const std::uint32_t p0 = result.point(face, 0);
+    const std::uint32_t p1 = result.point(face, 1);
+    const std::uint32_t p2 = result.point(face, 2);
+    if(p0 != p1 && p1 != p2 && p2 != p0) {
+      result.faces.push_back(face);
+    }
+  }
+  return result;
+}
+
+/**
+ * @brief Moves a point of the cage with the vertex rule of Loop subdivision.
+ * @param position The position of the point.
+ * @param neighbor_sum The sum of the positions of the neighbors of the point.
+ * @param valence The number of neighbors of the point.
+ * @param border_sum The sum of the positions of the neighbors along the border.
+ * @param border_count The number of border edges of the point.
+ * @return The position of the point in the subdivided mesh.
+ */
+linalg::Vec3d movePoint(const linalg::Vec3d& position, const linalg::Vec3d& neighbor_sum, std::uint32_t valence,
+                        const linalg::Vec3d& border_sum, std::uint32_t border_count) {
+  if(border_count == 0 && valence > 0) {
+    const double n    = static_cast<double>(valence);
+    const double beta = valence == 3 ? VALENCE_3_WEIGHT : NEIGHBORS_WEIGHT / n;
+    return position * (1.0 - (n * beta)) + neighbor_sum * beta;
+  }
+  if(border_count == 2) {
+    return position * (1.0 - (2.0 * BORDER_WEIGHT)) + border_sum * BORDER_WEIGHT;
+  }
+  return position; // Corner, or isolated point.
+}
+
+/**
+ * @brief Runs one step of Loop subdivision.
+ *
+ * The points of the cage keep their indices and are followed by one point per edge. The vertices of the cage keep
+ * their indices too, and are followed by one vertex per edge and pair of vertices along it: two along a texture seam.
+ * @param mesh The mesh to subdivide.
+ * @return The subdivided mesh, with four faces per face of the mesh.
+ */
+SubdividedMesh loopStep(const SubdividedMesh& mesh) {
+  const std::size_t point_count = mesh.points.size();
+  const std::size_t face_count  = mesh.faces.size();
+
+  std::vector<HalfEdge> half_edges(face_count * 3);
+  for(std::uint32_t f = 0; f < face_count; ++f) {
+    for(std::uint32_t c = 0; c < 3; ++c) {
+      half_edges[(3 * f) + c] = {edgeKey(mesh.point(mesh.faces[f], c), mesh.point(mesh.faces[f], c + 1)), f, c};
+    }
+  }
+  std::sort(half_edges.begin(), half_edges.end());
+
+  // The half-edges of edge e are half_edges[edge_begins[e]] to half_edges[edge_begins[e + 1]].
+  std::vector<std::uint32_t> edge_begins;
+  for(std::size_t h = 0; h < half_edges.size(); ++h) {
+    if(h == 0 || half_edges[h - 1].key != half_edges[h].key) {
+      edge_begins.push_back(static_cast<std::uint32_t>(h));
+    }
+  }
+  const std::size_t edge_count = edge_begins.size();
+  edge_begins.push_back(static_cast<std::uint32_t>(half_edges.size()));
+
+  std::vector<linalg::Vec3d> neighbor_sums(point_count, linalg::Vec3d(0.0, 0.0, 0.0));
+  std::vector<linalg::Vec3d> border_sums(point_count, linalg::Vec3d(0.0, 0.0, 0.0));
+  std::vector<std::uint32_t> valences(point_count, 0);
+  std::vector<std::uint32_t> border_counts(point_count, 0);
+  for(std::size_t e = 0; e < edge_count; ++e) {
+    const auto          a          = static_cast<std::uint32_t>(half_edges[edge_begins[e]].key >> 32U);
+    const auto          b          = static_cast<std::uint32_t>(half_edges[edge_begins[e]].key & 0xFFFFFFFFU);
+    const std::uint32_t edge_faces = edge_begins[e + 1] - edge_begins[e];
+    neighbor_sums[a] += mesh.points[b];
+    neighbor_sums[b] += mesh.points[a];
+    ++valences[a];
+    ++valences[b];
+    if(edge_faces == 1) {
+      border_sums[a] += mesh.points[b];
+      border_sums[b] += mesh.points[a];
+      ++border_counts[a];
+      ++border_counts[b];
+    } else if(edge_faces > 2) {
+      // Non-manifold edge: its points stay in place, as corners do.
+      border_counts[a] = border_counts[b] = 3;
+    }
+  }
+
+  SubdividedMesh result;
+  result.points.resize(point_count + edge_count);
+  forEachRange(point_count, [&](std::size_t begin, std::size_t end) {
+    for(std::size_t p = begin; p < end; ++p) {
+      result.points[p] = movePoint(mesh.points[p], neighbor_sums[p], valences[p], border_sums[p], border_counts[p]);
+    }
+  });
+  forEachRange(edge_count, [&](std::size_t begin, std::size_t end) {
+    for(std::size_t e = begin; e < end; ++e) {
+      const HalfEdge&      first = half_edges[edge_begins[e]];
+      const linalg::Vec3d& a     = mesh.points[first.key >> 32U];
+      const linalg::Vec3d& b     = mesh.points[first.key & 0xFFFFFFFFU];
+      if(edge_begins[e + 1] - edge_begins[e] != 2) {
+        result.points[point_count + e] = (a + b) * HALF;
+        continue;
+      }
+      const HalfEdge&      second = half_edges[edge_begins[e] + 1];
+      const linalg::Vec3d& c      = mesh.points[mesh.point(mesh.faces[first.face], first.corner + 2)];
+      const linalg::Vec3d& d      = mesh.points[mesh.point(mesh.faces[second.face], second.corner + 2)];
+      result.points[point_count + e] = (a + b) * EDGE_END_WEIGHT + (c + d) * EDGE_OPPOSITE_WEIGHT;
+    }
+  });
+
+  // The faces on both sides of a seam reference different vertices, each side gets its own vertex on the edge.
+  result.point_of = mesh.point_of;
+  result.uvs      = mesh.uvs;
+  result.normals  = mesh.normals;
+  std::vector<int> corner_vertices(face_count * 3);
+  for(std::size_t e = 0; e < edge_count; ++e) {
+    for(std::uint32_t h = edge_begins[e]; h < edge_begins[e + 1]; ++h) {
+      const Face& face = mesh.faces[half_edges[h].face];
+      const int   a    = face.vertex_indices[half_edges[h].corner];
+      const int   b    = face.vertex_indices[(half_edges[h].corner + 1) % 3];
+
+      int vertex = -1;
+      for(std::uint32_t previous = edge_begins[e]; previous < h && vertex < 0; ++previous) {
+        const Face& other   = mesh.faces[half_edges[previous].face];
+        const int   other_a = other.vertex_indices[half_edges[previous].corner];
+        const int   other_b = other.vertex_indices[(half_edges[previous].corner + 1) % 3];
+        if((a == other_a && b == other_b) || (a == other_b && b == other_a)) {
+          vertex = corner_vertices[(3 * half_edges[previous].face) + half_edges[previous].corner];
+        }
+      }
+      if(vertex < 0) {
+        vertex = static_cast<int>(result.uvs.size());
+        result.point_of.push_back(static_cast<std::uint32_t>(point_count + e));
+        result.uvs.push_back({(mesh.uvs[a].u + mesh.uvs[b].u) * HALF, (mesh.uvs[a].v + mesh.uvs[b].v) * HALF});
+        result.normals.push_back(mesh.normals[a] + mesh.normals[b]);
+      }
+      corner_vertices[(3 * half_edges[h].face) + half_edges[h].corner] = vertex;
+    }
+  }
+
+  result.faces.resize(face_count * 4);
+  forEachRange(face_count, [&](std::size_t begin, std::size_t end) {
+    for(std::size_t f = begin; f < end; ++f) {
+      const std::array<int, 3>& v  = mesh.faces[f].vertex_indices;
+      const int                 m0 = corner_vertices[3 * f];       // On the edge from v0 to v1.
+      const int                 m1 = corner_vertices[(3 * f) + 1]; // On the edge from v1 to v2.
+      const int                 m2 = corner_vertices[(3 * f) + 2]; // On the edge from v2 to v0.
+      result.faces[4 * f]       = Face{{v[0], m0, m2}};
+      result.faces[(4 * f) + 1] = Face{{v[1], m1, m0}};
+      result.faces[(4 * f) + 2] = Face{{v[2], m2, m1}};
+      result.faces[(4 * f) + 3] = Face{{m0, m1, m2}};
+    }
+  });
+  return result;
+}
+
+Mesh toMesh(SubdividedMesh mesh) {
+  // Area weighted normals of the points, shared by the vertices of a seam so that it does not show.
+  std::vector<linalg::Vec3d> point_normals(mesh.points.size(), linalg::Vec3d(0.0, 0.0, 0.0));
+  for(const Face& face : mesh.faces) {
+    const std::uint32_t p0     = mesh.point(face, 0);
+    const std::uint32_t p1     = mesh.point(face, 1);
+    const std::uint32_t p2     = mesh.point(face, 2);
+    const linalg::Vec3d normal = (mesh.points[p1] - mesh.points[p0]).cross(mesh.points[p2] - mesh.points[p0]);
+    point_normals[p0] += normal;
+    point_normals[p1] += normal;
+    point_normals[p2] += normal;
+  }
+
+  std::vector<Vertex> vertices(mesh.point_of.size());
+  forEachRange(vertices.size(), [&](std::size_t begin, std::size_t end) {
+    for(std::size_t v = begin; v < end; ++v) {
+      const linalg::Vec3d& surface_normal = point_normals[mesh.point_of[v]];
+      const linalg::Vec3d& normal         = surface_normal.length() > 0.0 ? surface_normal : mesh.normals[v];
+      vertices[v].position                = mesh.points[mesh.point_of[v]];
+      vertices[v].normal                  = normal.length() > 0.0 ? normal.normalized() : normal;
+      vertices[v].uv_coord                = mesh.uvs[v];
+    }
+  });
+  return {std::move(vertices), std::move(mesh.faces)};
+}
+
+} // namespace
+
+Mesh MeshSubdivider::subdivide(const Mesh& mesh, int level) {
+  if(level <= 0) {
+    return mesh;
+  }
+  SubdividedMesh subdivided = weld(mesh);
+  for(int step = 0; step < level; ++step) {
+    subdivided = loopStep(subdivided);
+  }
+  return toMesh(std::move(subdivided));
+}
+
+int MeshSubdivider::selectLevel(const Mesh& mesh, double pixels_per_unit) {
+  double longest_edge = 0.0;
+  for(const Face& face : mesh.getFaces()) {
+    for(int c = 0; c < 3; ++c) {
+      const linalg::Vec3d a(mesh.getVertexPosition(face.vertex_indices[c]));
+      const linalg::Vec3d b(mesh.getVertexPosition(face.vertex_indices[(c + 1) % 3]));
+      longest_edge = std::max(longest_edge, (b - a).length());
+    }
+  }
+
+  double      edge_pixels = longest_edge * pixels_per_unit;
+  std::size_t face_count  = mesh.getFaces().size();
+  int         level       = 0;
+  while(level < SUBDIVISION_MAX_LEVEL && edge_pixels > SUBDIVISION_EDGE_PIXELS &&
+        face_count * 4 <= SUBDIVISION_MAX_FACES) {
+    edge_pixels *= HALF;
+    face_count *= 4;
+    ++level;
+  }
+  return level;
+}
@@ -1,129 +1,439 @@
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
 #include <cstdint>
-#include <fstream>
+#include <cstring>
+#include <future>
 #include <iostream>
 #include <linalg/Vec3.hpp>
-#include <sstream>
+#include <optional>
 #include <string>
-#include <unordered_map>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
 #include <vector>
 
+#include "Core/Config.hpp"
 #include "Core/ImageTypes.hpp"
+#include "Core/MappedFile.hpp"
+#include "Core/ThreadPool.hpp"
 #include "Geometry/Mesh.hpp"
+#include "Geometry/MeshCache.hpp"
 #include "Geometry/OBJLoader.hpp"
 
 namespace {
-void parseVertexLine(const std::string& line, std::vector<linalg::Vec3d>& positions);
-void parseNormalLine(const std::string& line, std::vector<linalg::Vec3d>& normals);
-void parseUVLine(const std::string& line, std::vector<TextureUV>& uvs);
-Face parseFaceLine(const std::string& line, const std::vector<linalg::Vec3d>& positions,
-                   const std::vector<linalg::Vec3d>& normals, const std::vector<TextureUV>& uvs,
-                   std::vector<Vertex>& vertices, std::unordered_map<std::string, int>& vertex_map);
 
-} // namespace
+/**
+ * @struct CornerIndex
+ * @brief One attribute index of a face corner, as written in the file.
+ *
+ * Positive indices are absolute. Negative ones count back from the last attribute defined before the face, they are
+ * stored relative to the first attribute of the chunk and only resolved at merge time, once the number of attributes
+ * defined by the previous chunks is known.
+ */
+struct CornerIndex {
+  int  index    = 0;
+  bool relative = false;
+  bool present  = false;
+};
 
-Mesh OBJLoader::load(const std::string& filename) {
-  std::ifstream file(filename);
-  if(!file.is_open()) {
-    std::cerr << "Error: Could not open file " << filename << '\n';
-    return {};
+struct Corner {
+  CornerIndex position;
+  CornerIndex uv;
+  CornerIndex normal;
+};
+
+struct ParsedChunk {
+  std::vector<linalg::Vec3d> positions;
+  std::vector<linalg::Vec3d> normals;
+  std::vector<TextureUV>     uvs;
+  std::vector<Corner>        corners;
+  std::vector<int>           polygon_sizes; ///< Number of corners of each face, in file order.
+  std::size_t                text_size = 0; ///< Number of bytes of content parsed into the chunk.
+};
+
+bool isCancelled(const OBJLoader::LoadControl* control) { return control != nullptr && control->isCancelled(); }
+
+void addWork(OBJLoader::LoadControl* control, std::size_t work) {
+  if(control != nullptr) {
+    control->done_work.fetch_add(work, std::memory_order_relaxed);
   }
+}
 
-  std::vector<linalg::Vec3d>           positions;
-  std::vector<linalg::Vec3d>           normals;
-  std::vector<TextureUV>               uvs;
-  std::vector<Vertex>                  vertices;
-  std::vector<Face>                    faces;
-  std::unordered_map<std::string, int> vertex_map;
+bool isBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+void skipBlanks(const char*& cursor, const char* end) {
+  while(cursor != end && isBlank(*cursor)) {
+    ++cursor;
+  }
+}
+
+bool parseNumber(const char*& cursor, const char* end, double& value) {
+  skipBlanks(cursor, end);
+  if(cursor != end && *cursor == '+') {
+    ++cursor; // std::from_chars does not accept an explicit plus sign.
+  }
+  const auto [next, error] = std::from_chars(cursor, end, value);
+  if(error != std::errc()) {
+    return false;
+  }
+  cursor = next;
+  return true;
+}
+
+bool parseVec3(const char* cursor, const char* end, linalg::Vec3d& vector) {
+  return parseNumber(cursor, end, vector.x) && parseNumber(cursor, end, vector.y) &&
+         parseNumber(cursor, end, vector.z);
+}
+
+// 'local_count' is the number of attributes of this kind already defined in the chunk.
+bool parseIndex(const char*& cursor, const char* end, int local_count, CornerIndex& corner_index) {
+  int value                = 0;
+  const auto [next, error] = std::from_chars(cursor, end, value);
+  if(error != std::errc() || value == 0) {
+    return false;
+  }
+  cursor                = next;
+  corner_index.present  = true;
+  corner_index.relative = value < 0;
+  corner_index.index    = value < 0 ? local_count + value : value - 1;
+  return true;
+}
+
+// Reads one "v", "v/vt", "v//vn" or "v/vt/vn" token.
+bool parseCorner(const char*& cursor, const char* end, const ParsedChunk& chunk, Corner& corner) {
+  if(!parseIndex(cursor, end, static_cast<int>(chunk.positions.size()), corner.position)) {
+    return false;
+  }
+  if(cursor == end || *cursor != '/') {
+    return true;
+  }
+  ++cursor;
+  if(cursor != end && *cursor != '/' && !parseIndex(cursor, end, static_cast<int>(chunk.uvs.size()), corner.uv)) {
+    return false;
+  }
+  if(cursor == end || *cursor != '/') {
+    return true;
+  }
+  ++cursor;
+  return parseIndex(cursor, end, static_cast<int>(chunk.normals.size()), corner.normal);
+}
 
-  std::string line;
-  while(std::getline(file, line)) {
-    if(line.empty() || line[0] == '#') {
-      continue;
+void parseFace(const char* cursor, const char* end, ParsedChunk& chunk) {
+  const std::size_t first_corner = chunk.corners.size();
+  while(true) {
+    skipBlanks(cursor, end);
+    if(cursor == end) {
+      break;
     }
+    Corner corner;
+    if(!parseCorner(cursor, end, chunk, corner) || (cursor != end && !isBlank(*cursor))) {
+      chunk.corners.resize(first_corner); // Malformed token, the whole face is dropped.
+      return;
+    }
+    chunk.corners.push_back(corner);
+  }
+
+  const std::size_t corner_count = chunk.corners.size() - first_corner;
+  if(corner_count < 3) {
+    chunk.corners.resize(first_corner);
+    return;
+  }
+  chunk.polygon_sizes.push_back(static_cast<int>(corner_count));
+}
+
+void parseLine(const char* cursor, const char* end, ParsedChunk& chunk) {
+  skipBlanks(cursor, end);
+  if(end - cursor < 2) {
+    return;
+  }
 
-    std::istringstream iss(line);
-    std::string        prefix;
-    iss >> prefix;
+  // The keyword is followed by a blank, which also rules out "vp", "vr" or "fo" like prefixes.
+  // Comments and the other statements (groups, materials, lines...) are skipped.
+  const char keyword = cursor[0];
+  const char second  = cursor[1];
+  if(keyword == 'f' && isBlank(second)) {
+    parseFace(cursor + 1, end, chunk);
+    return;
+  }
+  if(keyword != 'v') {
+    return;
+  }
 
-    if(prefix == "v") {
-      parseVertexLine(line, positions);
-    } else if(prefix == "vn") {
-      parseNormalLine(line, normals);
-    } else if(prefix == "vt") {
-      parseUVLine(line, uvs);
-    } else if(prefix == "f") {
-      faces.push_back(parseFaceLine(line, positions, normals, uvs, vertices, vertex_map));
+  if(isBlank(second)) {
+    linalg::Vec3d position;
+    if(parseVec3(cursor + 1, end, position)) {
+      chunk.positions.push_back(position);
+    }
+  } else if(second == 'n' && end - cursor > 2 && isBlank(cursor[2])) {
+    linalg::Vec3d normal;
+    if(parseVec3(cursor + 2, end, normal)) {
+      chunk.normals.push_back(normal);
+    }
+  } else if(second == 't' && end - cursor > 2 && isBlank(cursor[2])) {
+    const char* values = cursor + 2;
+    TextureUV   uv;
+    if(parseNumber(values, end, uv.u)) {
+      parseNumber(values, end, uv.v); // The second coordinate is optional and defaults to 0.
+      chunk.uvs.push_back(uv);
     }
   }
+}
 
-  file.close();
-  return {vertices, faces};
+ParsedChunk parseChunk(std::string_view text, OBJLoader::LoadControl* control) {
+  ParsedChunk chunk;
+  chunk.text_size    = text.size();
+  const char* cursor = text.data();
+  const char* end    = text.data() + text.size();
+  while(cursor != end) {
+    if(isCancelled(control)) {
+      return chunk;
+    }
+    const auto* line_end = static_cast<const char*>(std::memchr(cursor, '\n', static_cast<std::size_t>(end - cursor)));
+    if(line_end == nullptr) {
+      line_end = end;
+    }
+    parseLine(cursor, line_end, chunk);
+    cursor = line_end == end ? end : line_end + 1;
+  }
+  addWork(control, text.size());
+  return chunk;
 }
 
-namespace {
-void parseVertexLine(const std::string& line, std::vector<linalg::Vec3d>& positions) {
-  std::istringstream iss(line.substr(2));
-  linalg::Vec3d      pos;
-  iss >> pos.x >> pos.y >> pos.z;
-  positions.push_back(pos);
+// Splits the content in parts of about 'chunk_size' bytes, each ending after a line feed so that no line is cut.
+std::vector<std::string_view> splitIntoChunks(std::string_view content, std::size_t chunk_size) {
+  chunk_size = std::max<std::size_t>(chunk_size, 1);
+
+  std::vector<std::string_view> chunks;
+  std::size_t                   begin = 0;
+  while(begin < content.size()) {
+    std::size_t split = content.size();
+    if(content.size() - begin > chunk_size) {
+      split = content.find('\n', begin + chunk_size - 1);
+      split = split == std::string_view::npos ? content.size() : split + 1;
+    }
+    chunks.push_back(content.substr(begin, split - begin));
+    begin = split;
+  }
+  return chunks;
 }
 
-void parseNormalLine(const std::string& line, std::vector<linalg::Vec3d>& normals) {
-  std::istringstream iss(line.substr(3));
-  linalg::Vec3d      normal;
-  iss >> normal.x >> normal.y >> normal.z;
-  normals.push_back(normal);
+std::vector<ParsedChunk> parseChunks(std::string_view content, std::size_t chunk_size,
+                                     OBJLoader::LoadControl* control) {
+  const std::vector<std::string_view> texts = splitIntoChunks(content, chunk_size);
+  std::vector<ParsedChunk>            chunks;
+  chunks.reserve(texts.size());
+  if(texts.size() <= 1) {
+    for(const std::string_view text : texts) {
+      chunks.push_back(parseChunk(text, control));
+    }
+    return chunks;
+  }
+
+  const unsigned int max_threads = control != nullptr && control->thread_count > 0
+                                       ? control->thread_count
+                                       : std::max(1U, std::thread::hardware_concurrency());
+  const auto thread_count = static_cast<unsigned int>(std::min<std::size_t>(texts.size(), max_threads));
+  ThreadPool                            pool(thread_count);
+  std::vector<std::future<ParsedChunk>> parsed;
+  parsed.reserve(texts.size());
+  for(const std::string_view text : texts) {
+    parsed.push_back(pool.submit([text, control]() { return parseChunk(text, control); }));
+  }
+  for(auto& chunk : parsed) {
+    chunks.push_back(chunk.get());
+  }
+  return chunks;
 }
 
-void parseUVLine(const std::string& line, std::vector<TextureUV>& uvs) {
-  std::istringstream iss(line.substr(3));
-  TextureUV          uv;
-  iss >> uv.u >> uv.v;
-  uvs.push_back(uv);
+template <typename T>
+std::vector<T> concatenate(std::vector<ParsedChunk>& chunks, std::vector<T> ParsedChunk::*member) {
+  std::size_t total = 0;
+  for(const ParsedChunk& chunk : chunks) {
+    total += (chunk.*member).size();
+  }
+  std::vector<T> values;
+  values.reserve(total);
+  for(ParsedChunk& chunk : chunks) {
+    values.insert(values.end(), (chunk.*member).begin(), (chunk.*member).end());
+    std::vector<T>().swap(chunk.*member);
+  }
+  return values;
 }
 
-Face parseFaceLine(const std::string& line, const std::vector<linalg::Vec3d>& positions,
-                   const std::vector<linalg::Vec3d>& normals, const std::vector<TextureUV>& uvs,
-                   std::vector<Vertex>& vertices, std::unordered_map<std::string, int>& vertex_map) {
-  std::istringstream iss(line);
-  std::string        prefix;
-  iss >> prefix;
-
-  Face face;
-  for(std::uint64_t i = 0; i < 3; ++i) {
-    std::string vertex_data;
-    iss >> vertex_data;
-
-    if(vertex_map.find(vertex_data) == vertex_map.end()) {
-      std::istringstream vss(vertex_data);
-      std::string        v_str;
-      std::string        vt_str;
-      std::string        vn_str;
-      std::getline(vss, v_str, '/');
-      std::getline(vss, vt_str, '/');
-      std::getline(vss, vn_str, '/');
-
-      const int v_index  = std::stoi(v_str) - 1;
-      const int vt_index = vt_str.empty() ? -1 : std::stoi(vt_str) - 1;
-      const int vn_index = vn_str.empty() ? -1 : std::stoi(vn_str) - 1;
-
-      Vertex vertex;
-      vertex.position = positions[v_index];
-      if(vt_index >= 0) {
-        vertex.uv_coord = uvs[vt_index];
+/**
+ * @class MeshBuilder
+ * @brief Merges the parsed chunks into the vertices and faces of a mesh, releasing the chunks once merged.
+ *
+ * A cancelled merge stops between two chunks, leaving a partial mesh.
+ *
+ * Corners are deduplicated on their resolved (position, uv, normal) index triple. Vertices are chained per position
+ * index, so that finding a corner compares a few integers instead of hashing a key.
+ */
+class MeshBuilder {
+private:
+  static constexpr int NO_VERTEX = -1;
+
+  struct VertexKey {
+    int uv;
+    int normal;
+  };
+
+  std::vector<linalg::Vec3d> m_positions;
+  std::vector<linalg::Vec3d> m_normals;
+  std::vector<TextureUV>     m_uvs;
+
+  std::vector<int>       m_first_vertex; ///< First vertex using each position.
+  std::vector<int>       m_next_vertex;  ///< Next vertex sharing the position of each vertex.
+  std::vector<VertexKey> m_vertex_keys;
+
+  std::vector<Vertex> m_vertices;
+  std::vector<Face>   m_faces;
+  std::size_t         m_skipped_faces = 0;
+
+  static int Resolve(const CornerIndex& corner_index, int base, std::size_t count) {
+    if(!corner_index.present) {
+      return NO_VERTEX;
+    }
+    const int index = corner_index.relative ? base + corner_index.index : corner_index.index;
+    return index >= 0 && static_cast<std::size_t>(index) < count ? index : NO_VERTEX;
+  }
+
+  int findOrAddVertex(int position, int uv, int normal) {
+    for(int vertex = m_first_vertex[position]; vertex != NO_VERTEX; vertex = m_next_vertex[vertex]) {
+      if(m_vertex_keys[vertex].uv == uv && m_vertex_keys[vertex].normal == normal) {
+        return vertex;
       }
-      if(vn_index >= 0) {
-        vertex.normal = normals[vn_index];
+    }
+
+    Vertex vertex;
+    vertex.position = m_positions[position];
+    if(uv != NO_VERTEX) {
+      vertex.uv_coord = m_uvs[uv];
+    }
+    if(normal != NO_VERTEX) {
+      vertex.normal = m_normals[normal];
+    }
+
+    const int index = static_cast<int>(m_vertices.size());
+    m_vertices.push_back(vertex);
+    m_vertex_keys.push_back({uv, normal});
+    m_next_vertex.push_back(m_first_vertex[position]);
+    m_first_vertex[position] = index;
+    return index;
+  }
+
+  void addPolygon(const Corner* corners, int corner_count, const std::array<int, 3>& bases) {
+    std::vector<int> indices(static_cast<std::size_t>(corner_count));
+    for(int i = 0; i < corner_count; ++i) {
+      const Corner& corner   = corners[i];
+      const int     position = Resolve(corner.position, bases[0], m_positions.size());
+      const int     uv       = Resolve(corner.uv, bases[1], m_uvs.size());
+      const int     normal   = Resolve(corner.normal, bases[2], m_normals.size());
+      if(position == NO_VERTEX || (corner.uv.present && uv == NO_VERTEX) ||
+         (corner.normal.present && normal == NO_VERTEX)) {
+        ++m_skipped_faces;
+        return;
       }
+      indices[i] = findOrAddVertex(position, uv, normal);
+    }
+
+    for(int i = 1; i + 1 < corner_count; ++i) {
+      m_faces.push_back(Face{{indices[0], indices[i], indices[i + 1]}});
+    }
+  }
 
-      vertex_map[vertex_data] = static_cast<int>(vertices.size());
-      vertices.push_back(vertex);
+public:
+  MeshBuilder(std::vector<ParsedChunk>& chunks, OBJLoader::LoadControl* control) {
+    // Bases are the number of positions, uvs and normals defined by the previous chunks.
+    std::vector<std::array<int, 3>> chunk_bases;
+    std::array<int, 3>              bases = {0, 0, 0};
+    for(const ParsedChunk& chunk : chunks) {
+      chunk_bases.push_back(bases);
+      bases[0] += static_cast<int>(chunk.positions.size());
+      bases[1] += static_cast<int>(chunk.uvs.size());
+      bases[2] += static_cast<int>(chunk.normals.size());
     }
 
-    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
-    face.vertex_indices[i] = vertex_map[vertex_data];
+    m_positions = concatenate(chunks, &ParsedChunk::positions);
+    m_uvs       = concatenate(chunks, &ParsedChunk::uvs);
+    m_normals   = concatenate(chunks, &ParsedChunk::normals);
+    m_first_vertex.assign(m_positions.size(), NO_VERTEX);
+
+    for(std::size_t i = 0; i < chunks.size() && !isCancelled(control); ++i) {
+      const Corner* corners = chunks[i].corners.data();
+      for(const int polygon_size : chunks[i].polygon_sizes) {
+        addPolygon(corners, polygon_size, chunk_bases[i]);
+        corners += polygon_size;
+      }
+      addWork(control, chunks[i].text_size);
+    }
+    std::vector<ParsedChunk>().swap(chunks);
   }
 
-  return face;
+  Mesh build() && {
+    if(m_skipped_faces > 0) {
+      std::cerr << "Warning: " << m_skipped_faces << " faces with out of range indices were skipped\n";
+    }
+    // The lookup tables are released before the mesh encodes the vertices, to lower the peak memory of an import.
+    std::vector<linalg::Vec3d>().swap(m_positions);
+    std::vector<linalg::Vec3d>().swap(m_normals);
+    std::vector<TextureUV>().swap(m_uvs);
+    std::vector<int>().swap(m_first_vertex);
+    std::vector<int>().swap(m_next_vertex);
+    std::vector<VertexKey>().swap(m_vertex_keys);
+    return {std::move(m_vertices), std::move(m_faces)};
+  }
+};
+
+} // namespace
+
+Mesh OBJLoader::load(const std::string& filename, bool use_cache, LoadControl* control) {
+  if(isCancelled(control)) {
+    return {};
+  }
+  const MappedFile file(filename);
+  if(!file.isOpen()) {
+    std::cerr << "Error: Could not open file " << filename << '\n';
+    return {};
+  }
+  if(!use_cache) {
+    return parse(file.getContent(), OBJ_PARSE_CHUNK_SIZE, control);
+  }
+
+  const std::uint64_t source_hash = MeshCache::hashSource(file.getContent());
+  const std::string   cache_path  = MeshCache::getCachePath(filename);
+  if(std::optional<Mesh> cached = MeshCache::read(cache_path, source_hash)) {
+    if(control != nullptr) {
+      control->total_work.store(file.getContent().size(), std::memory_order_relaxed);
+      control->done_work.store(file.getContent().size(), std::memory_order_relaxed);
+    }
+    return std::move(*cached);
+  }
+
+  Mesh mesh = parse(file.getContent(), OBJ_PARSE_CHUNK_SIZE, control);
+  if(isCancelled(control)) {
+    return {};
+  }
+  MeshCache::write(cache_path, mesh, source_hash);
+  return mesh;
+}
+
+Mesh OBJLoader::parse(std::string_view content, std::size_t chunk_size, LoadControl* control) {
+  if(control != nullptr) {
+    control->done_work.store(0, std::memory_order_relaxed);
+    control->total_work.store(2 * content.size(), std::memory_order_relaxed);
+  }
+
+  std::vector<ParsedChunk> chunks = parseChunks(content, chunk_size, control);
+  if(isCancelled(control)) {
+    return {};
+  }
+  MeshBuilder builder(chunks, control);
+  if(isCancelled(control)) {
+    return {};
+  }
+  return std::move(builder).build();
 }
-} // namespace
\ No newline at end of file
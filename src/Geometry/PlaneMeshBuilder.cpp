@@ -1,4 +1,5 @@
 #include <linalg/Vec3.hpp>
+#include <utility>
 #include <vector>
 
 #include "Core/MathConstants.hpp"
@@ -28,5 +29,5 @@ Mesh PlaneMeshBuilder::build() const {
   faces.push_back({{0, 2, 1}});
   faces.push_back({{0, 3, 2}});
 
-  return {vertices, faces};
+  return {std::move(vertices), std::move(faces)};
 }
\ No newline at end of file
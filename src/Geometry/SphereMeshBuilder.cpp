@@ -1,5 +1,6 @@
 #include <cmath>
 #include <numbers>
+#include <utility>
 #include <vector>
 
 #include "Geometry/Mesh.hpp"
@@ -52,5 +53,5 @@ Mesh SphereMeshBuilder::build() const {
     }
   }
 
-  return Mesh{vertices, faces};
+  return Mesh{std::move(vertices), std::move(faces)};
 }
\ No newline at end of file
@@ -0,0 +1,149 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <linalg/Vec3.hpp>
+#include <thread>
+#include <vector>
+
+#include "Core/Config.hpp"
+#include "Core/ThreadPool.hpp"
+#include "Geometry/Mesh.hpp"
+#include "Geometry/TangentGenerator.hpp"
+#include "Geometry/VertexEncoding.hpp"
+
+namespace {
+
+constexpr double MIN_TANGENT_LENGTH  = 1e-12;
+constexpr double FALLBACK_AXIS_LIMIT = 0.9;
+
+/**
+ * @brief Runs a function over the ranges of TANGENT_JOB_SIZE items of [0, count), in parallel when there are several.
+ * @param count The number of items.
+ * @param function The function called with the first and past-the-end indices of each range.
+ */
+template <typename Function> void forEachRange(std::size_t count, const Function& function) {
+  const std::size_t job_count = (count + TANGENT_JOB_SIZE - 1) / TANGENT_JOB_SIZE;
+  if(job_count <= 1) {
+    function(std::size_t{0}, count);
+    return;
+  }
+
+  const auto thread_count = static_cast<unsigned int>(
+      std::min<std::size_t>(job_count, std::max(1U, std::thread::hardware_concurrency())));
+  ThreadPool                     pool(thread_count);
+  std::vector<std::future<void>> jobs;
+  jobs.reserve(job_count);
+  for(std::size_t begin = 0; begin < count; begin += TANGENT_JOB_SIZE) {
+    const std::size_t end = std::min(begin + TANGENT_JOB_SIZE, count);
+    jobs.push_back(pool.submit([&function, begin, end]() { function(begin, end); }));
+  }
+  for(auto& job : jobs) {
+    job.get();
+  }
+}
+
+/**
+ * @struct FaceTangent
+ * @brief Tangent and bitangent of a face, the derivatives of its position along u and v.
+ */
+struct FaceTangent {
+  linalg::Vec3d tangent   = {0.0, 0.0, 0.0};
+  linalg::Vec3d bitangent = {0.0, 0.0, 0.0};
+};
+
+FaceTangent computeFaceTangent(const VertexStreams& streams, const Face& face) {
+  const linalg::Vec3d p0(streams.positions[face.vertex_indices[0]]);
+  const linalg::Vec3d p1(streams.positions[face.vertex_indices[1]]);
+  const linalg::Vec3d p2(streams.positions[face.vertex_indices[2]]);
+  const PackedUV&     uv0 = streams.uvs[face.vertex_indices[0]];
+  const PackedUV&     uv1 = streams.uvs[face.vertex_indices[1]];
+  const PackedUV&     uv2 = streams.uvs[face.vertex_indices[2]];
+
+  const linalg::Vec3d edge1 = p1 - p0;
+  const linalg::Vec3d edge2 = p2 - p0;
+  const double        du1   = static_cast<double>(uv1.u) - uv0.u;
+  const double        dv1   = static_cast<double>(uv1.v) - uv0.v;
+  const double        du2   = static_cast<double>(uv2.u) - uv0.u;
+  const double        dv2   = static_cast<double>(uv2.v) - uv0.v;
+
+  // A face with collinear texture coordinates has no uv gradient, dividing by its determinant would yield infinities.
+  const double determinant = du1 * dv2 - du2 * dv1;
+  if(!(std::abs(determinant) > DEGENERATE_UV_DETERMINANT)) {
+    return {};
+  }
+  const double f = 1.0 / determinant;
+  return {f * (dv2 * edge1 - dv1 * edge2), f * (-du2 * edge1 + du1 * edge2)};
+}
+
+/**
+ * @struct VertexFaces
+ * @brief Faces around each vertex in compressed rows: the faces of vertex i are faces[offsets[i]] to
+ * faces[offsets[i + 1]], sorted by index.
+ */
+struct VertexFaces {
+  std::vector<std::uint32_t> offsets;
+  std::vector<std::uint32_t> faces;
+
+  VertexFaces(std::size_t vertex_count, const std::vector<Face>& mesh_faces) : offsets(vertex_count + 1, 0) {
+    for(const Face& face : mesh_faces) {
+      for(const int index : face.vertex_indices) {
+        ++offsets[index + 1];
+      }
+    }
+    for(std::size_t i = 0; i < vertex_count; ++i) {
+      offsets[i + 1] += offsets[i];
+    }
+
+    faces.resize(offsets[vertex_count]);
+    std::vector<std::uint32_t> cursors(offsets.begin(), offsets.end() - 1);
+    for(std::size_t f = 0; f < mesh_faces.size(); ++f) {
+      for(const int index : mesh_faces[f].vertex_indices) {
+        faces[cursors[index]++] = static_cast<std::uint32_t>(f);
+      }
+    }
+  }
+};
+
+} // namespace
+
+linalg::Vec3d TangentGenerator::orthogonalize(const linalg::Vec3d& tangent, const linalg::Vec3d& normal) {
+  const linalg::Vec3d projected = tangent - normal * normal.dot(tangent);
+  const double        length    = projected.length();
+  if(length > MIN_TANGENT_LENGTH && std::isfinite(length)) {
+    return projected * (1.0 / length);
+  }
+  const linalg::Vec3d axis =
+      std::abs(normal.x) < FALLBACK_AXIS_LIMIT ? linalg::Vec3d(1.0, 0.0, 0.0) : linalg::Vec3d(0.0, 1.0, 0.0);
+  return normal.cross(axis).cross(normal).normalized();
+}
+
+void TangentGenerator::generate(VertexStreams& streams, const std::vector<Face>& faces) {
+  std::vector<FaceTangent> face_tangents(faces.size());
+  forEachRange(faces.size(), [&](std::size_t begin, std::size_t end) {
+    for(std::size_t f = begin; f < end; ++f) {
+      face_tangents[f] = computeFaceTangent(streams, faces[f]);
+    }
+  });
+
+  const VertexFaces vertex_faces(streams.size(), faces);
+  streams.tangents.resize(streams.size());
+  streams.bitangent_signs.resize(streams.size());
+  forEachRange(streams.size(), [&](std::size_t begin, std::size_t end) {
+    for(std::size_t v = begin; v < end; ++v) {
+      linalg::Vec3d tangent(0.0, 0.0, 0.0);
+      linalg::Vec3d bitangent(0.0, 0.0, 0.0);
+      for(std::uint32_t i = vertex_faces.offsets[v]; i < vertex_faces.offsets[v + 1]; ++i) {
+        tangent += face_tangents[vertex_faces.faces[i]].tangent;
+        bitangent += face_tangents[vertex_faces.faces[i]].bitangent;
+      }
+
+      // Orthogonal to the normal as it is decoded, so that the decoded frame stays orthonormal.
+      const linalg::Vec3d normal = VertexEncoding::decodeDirection(streams.normals[v]);
+      const linalg::Vec3d unit   = orthogonalize(tangent, normal);
+      streams.tangents[v]        = VertexEncoding::encodeDirection(unit);
+      streams.bitangent_signs[v] = normal.cross(unit).dot(bitangent) < 0.0 ? -1 : 1;
+    }
+  });
+}
@@ -21,6 +21,10 @@ void CameraRayEmitter::initializeViewport(const RayEmitterParameters& parameters
 
   m_horizontal_vector = viewport_top_right_corner - m_viewport_top_left_corner;
   m_vertical_vector   = viewport_bottom_left_corner - m_viewport_top_left_corner;
+
+  m_pixel_spread_angle = m_parameters.focal_length > 0.0
+                             ? m_parameters.sensor_width * m_parameters.pixel_width / m_parameters.focal_length
+                             : 0.0;
 }
 
 linalg::Vec3d CameraRayEmitter::generateCorner(double x, double y) const {
@@ -41,5 +45,8 @@ linalg::Vec3d CameraRayEmitter::getRayOrigin() const {
 Ray CameraRayEmitter::generateRay(double u, double v) const {
   const linalg::Vec3d origin      = getRayOrigin();
   const linalg::Vec3d focus_point = getFocusPoint(u, v);
-  return Ray::FromPoint(origin, focus_point);
+
+  Ray ray  = Ray::FromPoint(origin, focus_point);
+  ray.cone = {0.0, m_pixel_spread_angle};
+  return ray;
 }
\ No newline at end of file
@@ -69,6 +69,10 @@ void MultiThreadedCPU::generateChunks(int width, int height) {
   }
 }
 
+void MultiThreadedCPU::renderChunk(int /*thread_id*/, const Chunk& chunk, double sample_weight, double cell_size) {
+  renderer()->renderSample(chunk.start, chunk.end, sample_weight, chunk.subpixel_grid_pos, cell_size);
+}
+
 void MultiThreadedCPU::threadWorker(int thread_id, double sample_weight, double cell_size) {
   Framebuffer::SetThreadId(thread_id);
   while(true) {
@@ -83,8 +87,7 @@ void MultiThreadedCPU::threadWorker(int thread_id, double sample_weight, double
       break;
     }
 
-    const Chunk& chunk = m_chunks[chunk_index];
-    renderer()->renderSample(chunk.start, chunk.end, sample_weight, chunk.subpixel_grid_pos, cell_size);
+    renderChunk(thread_id, m_chunks[chunk_index], sample_weight, cell_size);
     if(chunk_index % (m_chunks.size() / m_samples_per_pixel) == 0) {
       renderer()->getRenderProgressObserver().notify(static_cast<double>(chunk_index) /
                                                      static_cast<double>(m_chunks.size()));
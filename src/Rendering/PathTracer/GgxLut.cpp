@@ -0,0 +1,109 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <linalg/Vec3.hpp>
+#include <linalg/linalg.hpp>
+
+#include "Core/Config.hpp"
+#include "Core/MathConstants.hpp"
+#include "Rendering/PathTracer/GgxLut.hpp"
+#include "Rendering/PathTracer/PBR.hpp"
+
+namespace PBR {
+
+namespace {
+
+constexpr double MIN_TABLE_COSINE = 1e-3; // keeps the grazing column of the table away from the 1 / cos_theta pole
+
+// Van der Corput sequence, the second coordinate of a Hammersley point set.
+double radicalInverse(std::uint32_t bits) {
+  bits = (bits << 16U) | (bits >> 16U);
+  bits = ((bits & 0x55555555U) << 1U) | ((bits & 0xAAAAAAAAU) >> 1U);
+  bits = ((bits & 0x33333333U) << 2U) | ((bits & 0xCCCCCCCCU) >> 2U);
+  bits = ((bits & 0x0F0F0F0FU) << 4U) | ((bits & 0xF0F0F0F0U) >> 4U);
+  bits = ((bits & 0x00FF00FFU) << 8U) | ((bits & 0xFF00FF00U) >> 8U);
+  return static_cast<double>(bits) * 0x1p-32;
+}
+
+// Integrates the lobe of getCookTorranceSpecular over the hemisphere, importance sampling the GGX distribution so
+// that D cancels out of each sample: f * cos_l / pdf = G * v_dot_h / (n_dot_v * n_dot_h).
+SpecularAlbedo integrateSpecularAlbedo(double cos_theta, double roughness) {
+  const linalg::Vec3d normal(0.0, 0.0, 1.0);
+  const linalg::Vec3d view(std::sqrt(1.0 - cos_theta * cos_theta), 0.0, cos_theta);
+  const double        alpha = roughness * roughness;
+
+  SpecularAlbedo albedo{0.0, 0.0};
+  for(int i = 0; i < GGX_LUT_SAMPLE_COUNT; ++i) {
+    const double u1 = (i + 0.5) / GGX_LUT_SAMPLE_COUNT;
+    const double u2 = radicalInverse(static_cast<std::uint32_t>(i));
+
+    const double        cos2_h = (1.0 - u1) / (1.0 + (alpha * alpha - 1.0) * u1);
+    const double        sin_h  = std::sqrt(std::max(0.0, 1.0 - cos2_h));
+    const double        phi    = TWO_PI * u2;
+    const linalg::Vec3d half_vector(sin_h * std::cos(phi), sin_h * std::sin(phi), std::sqrt(cos2_h));
+
+    const double        v_dot_h = linalg::dot(view, half_vector);
+    const linalg::Vec3d light   = half_vector * (2.0 * v_dot_h) - view;
+    if(light.z <= 0.0 || v_dot_h <= 0.0) {
+      continue;
+    }
+
+    const double weight = getGeometrySmith(normal, view, light, roughness) * v_dot_h / (cos_theta * half_vector.z);
+    const double fresnel = getSchlickWeight(v_dot_h);
+    albedo.scale += weight * (1.0 - fresnel);
+    albedo.bias  += weight * fresnel;
+  }
+  albedo.scale /= GGX_LUT_SAMPLE_COUNT;
+  albedo.bias  /= GGX_LUT_SAMPLE_COUNT;
+  return albedo;
+}
+
+// Rows are indexed by roughness and columns by cos_theta, both sampled uniformly on [0, 1] end points included.
+struct SpecularAlbedoTable {
+  std::array<SpecularAlbedo, static_cast<std::size_t>(GGX_LUT_RESOLUTION) * GGX_LUT_RESOLUTION> entries;
+
+  SpecularAlbedoTable() {
+    constexpr double step = 1.0 / (GGX_LUT_RESOLUTION - 1);
+    for(int row = 0; row < GGX_LUT_RESOLUTION; ++row) {
+      for(int column = 0; column < GGX_LUT_RESOLUTION; ++column) {
+        const double cos_theta = std::max(column * step, MIN_TABLE_COSINE);
+        entry(column, row)     = integrateSpecularAlbedo(cos_theta, row * step);
+      }
+    }
+  }
+
+  SpecularAlbedo& entry(int column, int row) {
+    return entries[static_cast<std::size_t>(row) * GGX_LUT_RESOLUTION + column];
+  }
+  const SpecularAlbedo& entry(int column, int row) const {
+    return entries[static_cast<std::size_t>(row) * GGX_LUT_RESOLUTION + column];
+  }
+};
+
+const SpecularAlbedoTable& specularAlbedoTable() {
+  static const SpecularAlbedoTable table;
+  return table;
+}
+
+} // namespace
+
+SpecularAlbedo lookupSpecularAlbedo(double cos_theta, double roughness) {
+  const SpecularAlbedoTable& table = specularAlbedoTable();
+
+  constexpr int last = GGX_LUT_RESOLUTION - 1;
+  const double  x    = std::clamp(cos_theta, 0.0, 1.0) * last;
+  const double  y    = std::clamp(roughness, 0.0, 1.0) * last;
+  const int     x0   = std::min(static_cast<int>(x), last - 1);
+  const int     y0   = std::min(static_cast<int>(y), last - 1);
+  const double  tx   = x - x0;
+  const double  ty   = y - y0;
+
+  const auto lerp = [](const SpecularAlbedo& a, const SpecularAlbedo& b, double t) {
+    return SpecularAlbedo{a.scale + (b.scale - a.scale) * t, a.bias + (b.bias - a.bias) * t};
+  };
+  return lerp(lerp(table.entry(x0, y0), table.entry(x0 + 1, y0), tx),
+              lerp(table.entry(x0, y0 + 1), table.entry(x0 + 1, y0 + 1), tx), ty);
+}
+
+} // namespace PBR
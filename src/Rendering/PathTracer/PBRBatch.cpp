@@ -0,0 +1,302 @@
+#include <algorithm>
+#include <cmath>
+#include <linalg/Vec3.hpp>
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#endif
+
+#include "Core/Color.hpp"
+#include "Core/MathConstants.hpp"
+#include "Rendering/PathTracer/PBR.hpp"
+#include "Rendering/PathTracer/PBRBatch.hpp"
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+namespace PBRBatch {
+
+namespace {
+
+constexpr float PI_F         = static_cast<float>(PI);
+constexpr float PI_2_F       = static_cast<float>(PI_2);
+constexpr float INV_PI_F     = static_cast<float>(INV_PI);
+constexpr float TWO_PI_F     = static_cast<float>(TWO_PI);
+constexpr float DIELECTRIC_F = static_cast<float>(PBR::DIELECTRIC_REFLECTANCE);
+constexpr float MIN_ALPHA_F  = 1e-6F;
+
+// Taylor coefficients of sin(x) up to x^9, accurate to ~4e-6 on [-PI/2, PI/2].
+constexpr float SIN_C3 = -1.0F / 6.0F;
+constexpr float SIN_C5 = 1.0F / 120.0F;
+constexpr float SIN_C7 = -1.0F / 5040.0F;
+constexpr float SIN_C9 = 1.0F / 362880.0F;
+
+float sinPolynomial(float x) {
+  const float x2 = x * x;
+  return x * (1.0F + x2 * (SIN_C3 + x2 * (SIN_C5 + x2 * (SIN_C7 + x2 * SIN_C9))));
+}
+
+// Folds x in [-PI, PI] into [-PI/2, PI/2] while preserving sin(x).
+float foldToHalfPi(float x) {
+  const float upper = std::min(x, PI_F - x);
+  return std::max(upper, -PI_F - upper);
+}
+
+#if defined(__AVX2__) && defined(__FMA__)
+__m256 sinPolynomial(__m256 x) {
+  const __m256 x2 = _mm256_mul_ps(x, x);
+  __m256       p  = _mm256_fmadd_ps(x2, _mm256_set1_ps(SIN_C9), _mm256_set1_ps(SIN_C7));
+  p               = _mm256_fmadd_ps(x2, p, _mm256_set1_ps(SIN_C5));
+  p               = _mm256_fmadd_ps(x2, p, _mm256_set1_ps(SIN_C3));
+  p               = _mm256_fmadd_ps(x2, p, _mm256_set1_ps(1.0F));
+  return _mm256_mul_ps(x, p);
+}
+
+__m256 foldToHalfPi(__m256 x) {
+  const __m256 pi    = _mm256_set1_ps(PI_F);
+  const __m256 upper = _mm256_min_ps(x, _mm256_sub_ps(pi, x));
+  return _mm256_max_ps(upper, _mm256_sub_ps(_mm256_sub_ps(_mm256_setzero_ps(), pi), upper));
+}
+
+__m256 dot3(__m256 ax, __m256 ay, __m256 az, __m256 bx, __m256 by, __m256 bz) {
+  return _mm256_fmadd_ps(ax, bx, _mm256_fmadd_ps(ay, by, _mm256_mul_ps(az, bz)));
+}
+
+__m256 shadeChannel(__m256 albedo, __m256 metalness, __m256 dielectric, __m256 diffuse_k, __m256 fresnel,
+                    __m256 specular, __m256 compensation) {
+  const __m256 one = _mm256_set1_ps(1.0F);
+  const __m256 f0  = _mm256_fmadd_ps(albedo, metalness, dielectric);
+  const __m256 ks  = _mm256_fmadd_ps(_mm256_sub_ps(one, f0), fresnel, f0);
+  const __m256 kd  = _mm256_mul_ps(_mm256_sub_ps(one, ks), _mm256_mul_ps(diffuse_k, albedo));
+  return _mm256_fmadd_ps(_mm256_mul_ps(ks, compensation), specular, kd);
+}
+
+void evaluateAvx2(const BRDFBatchInput& input, const Vec3Batch& outgoing_dir, ColorBatch& result) {
+  const __m256 zero = _mm256_setzero_ps();
+  const __m256 one  = _mm256_set1_ps(1.0F);
+
+  const __m256 vx = _mm256_load_ps(input.incoming_dir.x.data());
+  const __m256 vy = _mm256_load_ps(input.incoming_dir.y.data());
+  const __m256 vz = _mm256_load_ps(input.incoming_dir.z.data());
+  const __m256 lx = _mm256_load_ps(outgoing_dir.x.data());
+  const __m256 ly = _mm256_load_ps(outgoing_dir.y.data());
+  const __m256 lz = _mm256_load_ps(outgoing_dir.z.data());
+  const __m256 nx = _mm256_load_ps(input.normal.x.data());
+  const __m256 ny = _mm256_load_ps(input.normal.y.data());
+  const __m256 nz = _mm256_load_ps(input.normal.z.data());
+
+  __m256       hx      = _mm256_add_ps(vx, lx);
+  __m256       hy      = _mm256_add_ps(vy, ly);
+  __m256       hz      = _mm256_add_ps(vz, lz);
+  const __m256 inv_len = _mm256_div_ps(one, _mm256_sqrt_ps(dot3(hx, hy, hz, hx, hy, hz)));
+  hx                   = _mm256_mul_ps(hx, inv_len);
+  hy                   = _mm256_mul_ps(hy, inv_len);
+  hz                   = _mm256_mul_ps(hz, inv_len);
+
+  const __m256 n_dot_v = _mm256_max_ps(zero, dot3(nx, ny, nz, vx, vy, vz));
+  const __m256 n_dot_l = _mm256_max_ps(zero, dot3(nx, ny, nz, lx, ly, lz));
+  const __m256 n_dot_h = _mm256_max_ps(zero, dot3(nx, ny, nz, hx, hy, hz));
+  const __m256 v_dot_h = _mm256_max_ps(zero, dot3(vx, vy, vz, hx, hy, hz));
+
+  const __m256 roughness = _mm256_load_ps(input.roughness.data());
+  const __m256 metalness = _mm256_load_ps(input.metalness.data());
+
+  const __m256 alpha   = _mm256_mul_ps(roughness, roughness);
+  const __m256 alpha2  = _mm256_mul_ps(alpha, alpha);
+  const __m256 alpha_d = _mm256_max_ps(_mm256_set1_ps(MIN_ALPHA_F), alpha);
+  const __m256 a2_d    = _mm256_mul_ps(alpha_d, alpha_d);
+  const __m256 denom   = _mm256_fmadd_ps(_mm256_mul_ps(n_dot_h, n_dot_h), _mm256_sub_ps(a2_d, one), one);
+  const __m256 d = _mm256_div_ps(a2_d, _mm256_mul_ps(_mm256_set1_ps(PI_F), _mm256_mul_ps(denom, denom)));
+
+  const __m256 one_minus_a2 = _mm256_sub_ps(one, alpha2);
+  const __m256 ggx_v        = _mm256_div_ps(n_dot_v, _mm256_fmadd_ps(n_dot_v, one_minus_a2, alpha2));
+  const __m256 ggx_l        = _mm256_div_ps(n_dot_l, _mm256_fmadd_ps(n_dot_l, one_minus_a2, alpha2));
+
+  const __m256 cos_product = _mm256_mul_ps(_mm256_set1_ps(4.0F), _mm256_mul_ps(n_dot_l, n_dot_v));
+  const __m256 valid =
+      _mm256_and_ps(_mm256_cmp_ps(n_dot_l, zero, _CMP_GT_OQ), _mm256_cmp_ps(n_dot_v, zero, _CMP_GT_OQ));
+  const __m256 specular =
+      _mm256_and_ps(valid, _mm256_div_ps(_mm256_mul_ps(d, _mm256_mul_ps(ggx_v, ggx_l)), cos_product));
+
+  const __m256 m       = _mm256_sub_ps(one, v_dot_h);
+  const __m256 m2      = _mm256_mul_ps(m, m);
+  const __m256 fresnel = _mm256_mul_ps(_mm256_mul_ps(m2, m2), m);
+
+  const __m256 one_minus_metal = _mm256_sub_ps(one, metalness);
+  const __m256 dielectric      = _mm256_mul_ps(_mm256_set1_ps(DIELECTRIC_F), one_minus_metal);
+  const __m256 diffuse_k       = _mm256_mul_ps(_mm256_set1_ps(INV_PI_F), one_minus_metal);
+
+  const ColorBatch& compensation = input.specular_compensation;
+  _mm256_store_ps(result.r.data(), shadeChannel(_mm256_load_ps(input.base_color.r.data()), metalness, dielectric,
+                                                diffuse_k, fresnel, specular, _mm256_load_ps(compensation.r.data())));
+  _mm256_store_ps(result.g.data(), shadeChannel(_mm256_load_ps(input.base_color.g.data()), metalness, dielectric,
+                                                diffuse_k, fresnel, specular, _mm256_load_ps(compensation.g.data())));
+  _mm256_store_ps(result.b.data(), shadeChannel(_mm256_load_ps(input.base_color.b.data()), metalness, dielectric,
+                                                diffuse_k, fresnel, specular, _mm256_load_ps(compensation.b.data())));
+}
+
+void sampleAvx2(const Lanes& roughness, const Lanes& u1, const Lanes& u2, const Vec3Batch& tangent,
+                const Vec3Batch& bitangent, const Vec3Batch& normal, Vec3Batch& half_vector) {
+  const __m256 one = _mm256_set1_ps(1.0F);
+
+  const __m256 rough  = _mm256_load_ps(roughness.data());
+  const __m256 alpha  = _mm256_mul_ps(rough, rough);
+  const __m256 alpha2 = _mm256_mul_ps(alpha, alpha);
+  const __m256 r1     = _mm256_load_ps(u1.data());
+
+  const __m256 cos2_theta =
+      _mm256_div_ps(_mm256_sub_ps(one, r1), _mm256_fmadd_ps(_mm256_sub_ps(alpha2, one), r1, one));
+  const __m256 cos_theta = _mm256_sqrt_ps(cos2_theta);
+  const __m256 sin_theta = _mm256_sqrt_ps(_mm256_max_ps(_mm256_setzero_ps(), _mm256_sub_ps(one, cos2_theta)));
+
+  const __m256 x       = _mm256_fmsub_ps(_mm256_set1_ps(TWO_PI_F), _mm256_load_ps(u2.data()), _mm256_set1_ps(PI_F));
+  const __m256 abs_x   = _mm256_andnot_ps(_mm256_set1_ps(-0.0F), x);
+  const __m256 sin_phi = _mm256_sub_ps(_mm256_setzero_ps(), sinPolynomial(foldToHalfPi(x)));
+  const __m256 cos_phi =
+      _mm256_sub_ps(_mm256_setzero_ps(), sinPolynomial(_mm256_sub_ps(_mm256_set1_ps(PI_2_F), abs_x)));
+
+  const __m256 local_x = _mm256_mul_ps(sin_theta, cos_phi);
+  const __m256 local_y = _mm256_mul_ps(sin_theta, sin_phi);
+
+  const auto to_world = [&](const Lanes& t, const Lanes& b, const Lanes& n, Lanes& out) {
+    const __m256 along_n = _mm256_mul_ps(_mm256_load_ps(n.data()), cos_theta);
+    const __m256 along_b = _mm256_fmadd_ps(_mm256_load_ps(b.data()), local_y, along_n);
+    _mm256_store_ps(out.data(), _mm256_fmadd_ps(_mm256_load_ps(t.data()), local_x, along_b));
+  };
+  to_world(tangent.x, bitangent.x, normal.x, half_vector.x);
+  to_world(tangent.y, bitangent.y, normal.y, half_vector.y);
+  to_world(tangent.z, bitangent.z, normal.z, half_vector.z);
+}
+#else
+float schlickWeight(float cos_theta) {
+  const float m  = 1.0F - cos_theta;
+  const float m2 = m * m;
+  return m2 * m2 * m;
+}
+
+void evaluateLane(const BRDFBatchInput& input, const Vec3Batch& outgoing_dir, ColorBatch& result, int i) {
+  const float vx = input.incoming_dir.x[i];
+  const float vy = input.incoming_dir.y[i];
+  const float vz = input.incoming_dir.z[i];
+  const float lx = outgoing_dir.x[i];
+  const float ly = outgoing_dir.y[i];
+  const float lz = outgoing_dir.z[i];
+  const float nx = input.normal.x[i];
+  const float ny = input.normal.y[i];
+  const float nz = input.normal.z[i];
+
+  float       hx       = vx + lx;
+  float       hy       = vy + ly;
+  float       hz       = vz + lz;
+  const float inv_len  = 1.0F / std::sqrt(hx * hx + hy * hy + hz * hz);
+  hx                  *= inv_len;
+  hy                  *= inv_len;
+  hz                  *= inv_len;
+
+  const float n_dot_v = std::max(0.0F, nx * vx + ny * vy + nz * vz);
+  const float n_dot_l = std::max(0.0F, nx * lx + ny * ly + nz * lz);
+  const float n_dot_h = std::max(0.0F, nx * hx + ny * hy + nz * hz);
+  const float v_dot_h = std::max(0.0F, vx * hx + vy * hy + vz * hz);
+
+  const float roughness = input.roughness[i];
+  const float metalness = input.metalness[i];
+
+  float specular = 0.0F;
+  if(n_dot_l > 0.0F && n_dot_v > 0.0F) {
+    const float alpha   = roughness * roughness;
+    const float alpha2  = alpha * alpha;
+    const float alpha_d = std::max(MIN_ALPHA_F, alpha);
+    const float a2_d    = alpha_d * alpha_d;
+    const float denom   = n_dot_h * n_dot_h * (a2_d - 1.0F) + 1.0F;
+    const float d       = a2_d / (PI_F * denom * denom);
+    const float ggx_v   = n_dot_v / (n_dot_v * (1.0F - alpha2) + alpha2);
+    const float ggx_l   = n_dot_l / (n_dot_l * (1.0F - alpha2) + alpha2);
+    specular            = d * ggx_v * ggx_l / (4.0F * n_dot_l * n_dot_v);
+  }
+
+  const float fresnel    = schlickWeight(v_dot_h);
+  const float dielectric = DIELECTRIC_F * (1.0F - metalness);
+  const float diffuse_k  = (1.0F - metalness) * INV_PI_F;
+
+  const auto shade = [&](float albedo, float compensation) {
+    const float f0 = dielectric + albedo * metalness;
+    const float ks = f0 + (1.0F - f0) * fresnel;
+    return (1.0F - ks) * diffuse_k * albedo + ks * compensation * specular;
+  };
+
+  const ColorBatch& compensation = input.specular_compensation;
+  result.r[i]                    = shade(input.base_color.r[i], compensation.r[i]);
+  result.g[i]                    = shade(input.base_color.g[i], compensation.g[i]);
+  result.b[i]                    = shade(input.base_color.b[i], compensation.b[i]);
+}
+#endif
+
+} // namespace
+
+void Vec3Batch::set(int lane, const linalg::Vec3d& value) {
+  x[lane] = static_cast<float>(value.x);
+  y[lane] = static_cast<float>(value.y);
+  z[lane] = static_cast<float>(value.z);
+}
+
+linalg::Vec3d Vec3Batch::get(int lane) const { return {x[lane], y[lane], z[lane]}; }
+
+void ColorBatch::set(int lane, const ColorRGB& value) {
+  r[lane] = static_cast<float>(value.r);
+  g[lane] = static_cast<float>(value.g);
+  b[lane] = static_cast<float>(value.b);
+}
+
+ColorRGB ColorBatch::get(int lane) const { return {r[lane], g[lane], b[lane]}; }
+
+void BRDFBatchInput::set(int lane, const PBR::BRDFInput& input) {
+  incoming_dir.set(lane, input.incoming_dir);
+  normal.set(lane, input.normal);
+  base_color.set(lane, input.base_color);
+  roughness[lane] = static_cast<float>(input.roughness);
+  metalness[lane] = static_cast<float>(input.metalness);
+  specular_compensation.set(lane, input.specular_compensation);
+}
+
+void fastSinCos(float angle, float& sin_value, float& cos_value) {
+  // sin(a) = -sin(a - PI) and cos(a) = -sin(PI/2 - |a - PI|), both arguments lie in [-PI/2, PI/2] after folding.
+  const float x = angle - PI_F;
+  sin_value     = -sinPolynomial(foldToHalfPi(x));
+  cos_value     = -sinPolynomial(PI_2_F - std::abs(x));
+}
+
+void evaluateBrdf(const BRDFBatchInput& input, const Vec3Batch& outgoing_dir, ColorBatch& result) {
+#if defined(__AVX2__) && defined(__FMA__)
+  evaluateAvx2(input, outgoing_dir, result);
+#else
+  for(int i = 0; i < BATCH_SIZE; ++i) {
+    evaluateLane(input, outgoing_dir, result, i);
+  }
+#endif
+}
+
+void sampleHalfVectorGgx(const Lanes& roughness, const Lanes& u1, const Lanes& u2, const Vec3Batch& tangent,
+                         const Vec3Batch& bitangent, const Vec3Batch& normal, Vec3Batch& half_vector) {
+#if defined(__AVX2__) && defined(__FMA__)
+  sampleAvx2(roughness, u1, u2, tangent, bitangent, normal, half_vector);
+#else
+  for(int i = 0; i < BATCH_SIZE; ++i) {
+    const float alpha      = roughness[i] * roughness[i];
+    const float cos2_theta = (1.0F - u1[i]) / (1.0F + (alpha * alpha - 1.0F) * u1[i]);
+    const float cos_theta  = std::sqrt(cos2_theta);
+    const float sin_theta  = std::sqrt(std::max(0.0F, 1.0F - cos2_theta));
+
+    float sin_phi = 0.0F;
+    float cos_phi = 0.0F;
+    fastSinCos(TWO_PI_F * u2[i], sin_phi, cos_phi);
+
+    const float local_x = sin_theta * cos_phi;
+    const float local_y = sin_theta * sin_phi;
+
+    half_vector.x[i] = tangent.x[i] * local_x + bitangent.x[i] * local_y + normal.x[i] * cos_theta;
+    half_vector.y[i] = tangent.y[i] * local_x + bitangent.y[i] * local_y + normal.y[i] * cos_theta;
+    half_vector.z[i] = tangent.z[i] * local_x + bitangent.z[i] * local_y + normal.z[i] * cos_theta;
+  }
+#endif
+}
+
+} // namespace PBRBatch
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
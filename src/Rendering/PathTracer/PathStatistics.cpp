@@ -0,0 +1,55 @@
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+
+#include "Core/Color.hpp"
+#include "Rendering/PathTracer/PathStatistics.hpp"
+
+PathStatistics::DepthCounters& PathStatistics::countersAt(int depth) {
+  if(depth >= static_cast<int>(m_depths.size())) {
+    m_depths.resize(depth + 1);
+  }
+  return m_depths[depth];
+}
+
+void PathStatistics::recordRay(int depth, const ColorRGB& throughput) {
+  DepthCounters& counters = countersAt(depth);
+  counters.rays_traced++;
+  counters.throughput_sum += throughput.maxComponent();
+}
+
+void PathStatistics::recordTermination(int depth) { countersAt(depth).paths_terminated++; }
+
+void PathStatistics::merge(const PathStatistics& other) {
+  if(other.m_depths.size() > m_depths.size()) {
+    m_depths.resize(other.m_depths.size());
+  }
+  for(std::size_t depth = 0; depth < other.m_depths.size(); ++depth) {
+    m_depths[depth].rays_traced += other.m_depths[depth].rays_traced;
+    m_depths[depth].paths_terminated += other.m_depths[depth].paths_terminated;
+    m_depths[depth].throughput_sum += other.m_depths[depth].throughput_sum;
+  }
+}
+
+std::uint64_t PathStatistics::getRaysTraced(int depth) const {
+  return depth < getDepthCount() ? m_depths[depth].rays_traced : 0;
+}
+
+std::uint64_t PathStatistics::getPathsTerminated(int depth) const {
+  return depth < getDepthCount() ? m_depths[depth].paths_terminated : 0;
+}
+
+double PathStatistics::getAverageThroughput(int depth) const {
+  if(depth >= getDepthCount() || m_depths[depth].rays_traced == 0) {
+    return 0.0;
+  }
+  return m_depths[depth].throughput_sum / static_cast<double>(m_depths[depth].rays_traced);
+}
+
+void PathStatistics::print() const {
+  for(int depth = 0; depth < getDepthCount(); ++depth) {
+    std::cout << "[Paths] depth " << depth << " | rays: " << getRaysTraced(depth)
+              << " | terminated: " << getPathsTerminated(depth)
+              << " | average throughput: " << getAverageThroughput(depth) << '\n';
+  }
+}
@@ -5,12 +5,14 @@
 #include <vector>
 
 #include "Core/Color.hpp"
+#include "Core/Config.hpp"
 #include "Core/Random.hpp"
 #include "Core/Ray.hpp"
 #include "Rendering/PathTracer/DirectionSampler.hpp"
 #include "Rendering/PathTracer/PBR.hpp"
 #include "Rendering/PathTracer/PathTracer.hpp"
 #include "Rendering/PathTracer/RayIntersection.hpp"
+#include "Rendering/RenderSettings.hpp"
 #include "Scene/LightSample.hpp"
 #include "Scene/Scene.hpp"
 #include "SceneObjects/Camera.hpp"
@@ -20,38 +22,161 @@ bool PathTracer::isValidHit(double distance) const {
 }
 
 PBR::BRDFInput PathTracer::CreateBrdfInput(const RayHitInfo& hit_info, const linalg::Vec3d& incoming_dir) {
-  return {incoming_dir, hit_info.normal, hit_info.material->getDiffuse(hit_info.bary_coords),
-          hit_info.material->getRoughness(hit_info.bary_coords), hit_info.material->getMetalness(hit_info.bary_coords)};
+  const MaterialRecord& record       = hit_info.material->getRecord();
+  const TextureUV&      uv           = hit_info.bary_coords;
+  const double          footprint    = hit_info.uv_footprint;
+  const double          metalness    = record.metalness.sample(uv, footprint);
+  const double          transmission = record.transmission.sample(uv, footprint) * (1.0 - metalness);
+
+  // Transmissive surfaces are shaded on the side of the path, which reaches their back faces from inside the object.
+  const bool          back_face = transmission > 0.0 && !IsEntering(hit_info, incoming_dir);
+  const linalg::Vec3d normal    = back_face ? -hit_info.normal : hit_info.normal;
+  PBR::BRDFInput      input(incoming_dir, normal, record.diffuse.sample(uv, footprint),
+                            record.roughness.sample(uv, footprint), metalness);
+  input.transmission = transmission;
+  input.eta          = back_face ? 1.0 / record.index_of_refraction : record.index_of_refraction;
+  return input;
 }
 
-linalg::Vec3d PathTracer::SampleOutgoingDirection(const PBR::BRDFInput& brdf_input, const linalg::Mat3d& tbn,
-                                                  double& pdf) {
+const Material* PathTracer::EnclosingMedium(const PathState& state, const Material* excluded) {
+  const Material* medium  = nullptr;
+  bool            skipped = false;
+  // Most recent media first, so that the last one entered wins between equal priorities.
+  for(int i = state.media_count - 1; i >= 0; --i) {
+    const Material* candidate = state.media[i];
+    if(candidate == excluded && !skipped) {
+      skipped = true;
+      continue;
+    }
+    if(medium == nullptr || candidate->getRecord().dielectric_priority > medium->getRecord().dielectric_priority) {
+      medium = candidate;
+    }
+  }
+  return medium;
+}
+
+bool PathTracer::IsFalseHit(const PathState& state, const Material* material, bool entering) {
+  const auto media_end = state.media.begin() + state.media_count;
+  if(!entering && std::find(state.media.begin(), media_end, material) == media_end) {
+    return false;
+  }
+  const Material* medium = EnclosingMedium(state, entering ? nullptr : material);
+  return medium != nullptr && medium->getRecord().dielectric_priority > material->getRecord().dielectric_priority;
+}
 
+void PathTracer::CrossInterface(PathState& state, const Material* material, bool entering) {
+  if(entering) {
+    if(state.media_count < MAX_NESTED_DIELECTRICS) {
+      state.media[state.media_count++] = material;
+    }
+    return;
+  }
+  for(int i = state.media_count - 1; i >= 0; --i) {
+    if(state.media[i] == material) {
+      std::copy(state.media.begin() + i + 1, state.media.begin() + state.media_count, state.media.begin() + i);
+      --state.media_count;
+      return;
+    }
+  }
+}
+
+void PathTracer::ApplyMedia(PBR::BRDFInput& input, const RayHitInfo& hit_info, const PathState& state) {
+  if(input.transmission <= 0.0) {
+    return;
+  }
+  const auto ior = [](const Material* medium) {
+    return medium == nullptr ? 1.0 : medium->getRecord().index_of_refraction;
+  };
+  const Material* material = hit_info.material;
+  if(IsEntering(hit_info, input.incoming_dir)) {
+    input.eta = ior(material) / ior(EnclosingMedium(state));
+  } else {
+    input.eta = ior(EnclosingMedium(state, material)) / ior(material);
+  }
+}
+
+RayHitInfo PathTracer::IntersectThroughMedia(const Ray& ray, const Scene* scene, PathState& state,
+                                             double lod_distance) {
+  RayHitInfo hit      = RayIntersection::getSceneIntersection(ray, scene, lod_distance);
+  Ray        segment  = ray;
+  double     traveled = 0.0;
+  while(hit.material != nullptr && hit.material->getRecord().isTransmissive()) {
+    const bool entering = IsEntering(hit, -segment.direction);
+    if(!IsFalseHit(state, hit.material, entering)) {
+      break;
+    }
+    CrossInterface(state, hit.material, entering);
+    traveled += hit.distance;
+    segment   = RayIntersection::spawnRay(hit, segment.direction);
+    hit       = RayIntersection::getSceneIntersection(segment, scene, lod_distance);
+  }
+  if(hit.material != nullptr) {
+    hit.distance += traveled;
+  }
+  return hit;
+}
+
+template <typename HalfVectorSampler>
+linalg::Vec3d PathTracer::SampleLobe(const PBR::BRDFInput& brdf_input, const linalg::Mat3d& tbn,
+                                     const HalfVectorSampler& sample_half_vector, double& pdf,
+                                     BounceType& bounce_type) {
   const linalg::Vec3d& incoming_dir = brdf_input.incoming_dir;
 
   linalg::Vec3d outgoing_dir;
+  if(brdf_input.transmission > 0.0 && randomUniform01() < brdf_input.transmission) {
+    // Dielectric lobe: reflect with the Fresnel probability of the sampled microfacet, refract otherwise.
+    const linalg::Vec3d half_dir = sample_half_vector();
+    const double        fresnel  = PBR::getFresnelDielectric(linalg::dot(incoming_dir, half_dir), brdf_input.eta);
+    if(randomUniform01() < fresnel || !PBR::refract(incoming_dir, half_dir, brdf_input.eta, outgoing_dir)) {
+      outgoing_dir = Reflect(-incoming_dir, half_dir);
+      bounce_type  = BounceType::GLOSSY;
+    } else {
+      bounce_type = BounceType::TRANSMISSION;
+    }
+    // Rough microfacets can send the direction to the wrong side of the surface, such samples are lost.
+    const bool above = linalg::dot(brdf_input.normal, outgoing_dir) > 0.0;
+    const bool valid = above == (bounce_type == BounceType::GLOSSY);
+    pdf              = valid ? brdf_input.transmission * PBR::pdfDielectric(brdf_input, outgoing_dir) : 0.0;
+    return outgoing_dir;
+  }
+
+  const double opaque = 1.0 - brdf_input.transmission;
   if(randomUniform01() < brdf_input.specular_ratio) {
-    const linalg::Vec3d half_dir = Sampler::sampleHalfVectorGgx(brdf_input.roughness, tbn);
+    const linalg::Vec3d half_dir = sample_half_vector();
     outgoing_dir                 = Reflect(-incoming_dir, half_dir);
-    pdf = Sampler::pdfHalfVectorGgx(brdf_input.specular_ratio, brdf_input.roughness, brdf_input.incoming_dir,
+    bounce_type                  = BounceType::GLOSSY;
+    pdf = Sampler::pdfHalfVectorGgx(opaque * brdf_input.specular_ratio, brdf_input.roughness, brdf_input.incoming_dir,
                                     brdf_input.normal, half_dir);
   } else {
     outgoing_dir = Sampler::sampleCosineHemisphere(tbn);
-    pdf          = Sampler::pdfCosineHemisphere(1 - brdf_input.specular_ratio, brdf_input.normal, outgoing_dir);
+    bounce_type  = BounceType::DIFFUSE;
+    pdf = Sampler::pdfCosineHemisphere(opaque * (1 - brdf_input.specular_ratio), brdf_input.normal, outgoing_dir);
   }
 
   return outgoing_dir;
 }
 
-ColorRGB PathTracer::computeDirectLighting(const PBR::BRDFInput& brdf_input, const linalg::Vec3d& hit_position) const {
+linalg::Vec3d PathTracer::SampleOutgoingDirection(const PBR::BRDFInput& brdf_input, const linalg::Mat3d& tbn,
+                                                  double& pdf, BounceType& bounce_type) {
+  const auto sample_half_vector = [&]() { return Sampler::sampleHalfVectorGgx(brdf_input.roughness, tbn); };
+  return SampleLobe(brdf_input, tbn, sample_half_vector, pdf, bounce_type);
+}
+
+linalg::Vec3d PathTracer::SampleOutgoingDirection(const PBR::BRDFInput& brdf_input, const linalg::Mat3d& tbn,
+                                                  const linalg::Vec3d& half_dir, double& pdf,
+                                                  BounceType& bounce_type) {
+  return SampleLobe(brdf_input, tbn, [&]() { return half_dir; }, pdf, bounce_type);
+}
+
+ColorRGB PathTracer::computeDirectLighting(const PBR::BRDFInput& brdf_input, const RayHitInfo& hit) const {
   const LightSample* light_sample = m_scene->getLightSample();
   if(light_sample == nullptr) {
     return ColorRGB(0.0);
   }
-  const linalg::Vec3d light_dir = Sampler::sampleLight(light_sample, hit_position);
+  const linalg::Vec3d light_dir = Sampler::sampleLight(light_sample, hit.position);
 
-  const Ray        light_ray = Ray::FromDirection(hit_position, light_dir);
-  const RayHitInfo light_hit = RayIntersection::getSceneIntersection(light_ray, m_scene);
+  const Ray        light_ray = RayIntersection::spawnRay(hit, light_dir);
+  const RayHitInfo light_hit = RayIntersection::getSceneIntersection(light_ray, m_scene, getLODDistance());
 
   const ColorRGB light_color = light_hit.emitted_light;
   if(light_color == ColorRGB(0.0)) {
@@ -59,8 +184,7 @@ ColorRGB PathTracer::computeDirectLighting(const PBR::BRDFInput& brdf_input, con
   }
 
   const double        pdf      = Sampler::pdfLightSample(m_scene->getLightSampleCount(), light_hit, light_dir);
-  std::vector<double> all_pdfs = Sampler::pdfListBrdf(brdf_input.specular_ratio, brdf_input.roughness,
-                                                      brdf_input.incoming_dir, brdf_input.normal, light_dir);
+  std::vector<double> all_pdfs = Sampler::pdfListBsdf(brdf_input, light_dir);
   all_pdfs.push_back(pdf);
   const double mis_weight = Sampler::balanceHeuristic(pdf, all_pdfs);
 
@@ -71,8 +195,11 @@ ColorRGB PathTracer::computeDirectLighting(const PBR::BRDFInput& brdf_input, con
 
 ColorRGB PathTracer::ComputeBrdfContribution(const PBR::BRDFInput& brdf_input, const linalg::Vec3d& outgoing_dir,
                                              double pdf) {
-  const ColorRGB brdf_eval = PBR::evaluateBrdf(brdf_input, outgoing_dir);
-  const double   cos_theta = std::max(0.0, linalg::dot(brdf_input.normal, outgoing_dir));
+  if(pdf <= 0.0) {
+    return ColorRGB(0.0);
+  }
+  const ColorRGB brdf_eval = PBR::evaluateBsdf(brdf_input, outgoing_dir);
+  const double   cos_theta = PBR::getCosineFactor(brdf_input, outgoing_dir);
 
   return brdf_eval * cos_theta / pdf;
 }
@@ -97,19 +224,19 @@ ColorRGB PathTracer::traceRayRecursion(const Ray& ray_in, const ColorRGB& throug
   }
 
   const PBR::BRDFInput brdf_input      = CreateBrdfInput(hit, -ray_in.direction);
-  const ColorRGB       direct_lighting = computeDirectLighting(brdf_input, hit.position);
+  const ColorRGB       direct_lighting = computeDirectLighting(brdf_input, hit);
 
-  const linalg::Mat3d tbn          = linalg::Mat3d::FromColumns(hit.tangent, hit.bitangent, hit.normal);
+  const linalg::Mat3d tbn          = linalg::Mat3d::FromColumns(hit.tangent, hit.bitangent, brdf_input.normal);
   double              pdf_brdf     = 0.0;
-  const linalg::Vec3d outgoing_dir = SampleOutgoingDirection(brdf_input, tbn, pdf_brdf);
+  BounceType          bounce_type  = BounceType::DIFFUSE;
+  const linalg::Vec3d outgoing_dir = SampleOutgoingDirection(brdf_input, tbn, pdf_brdf, bounce_type);
 
   const ColorRGB            brdf_contribution = ComputeBrdfContribution(brdf_input, outgoing_dir, pdf_brdf);
-  const std::vector<double> brdf_pdf_list     = Sampler::pdfListBrdf(brdf_input.specular_ratio, brdf_input.roughness,
-                                                                     -ray_in.direction, brdf_input.normal, outgoing_dir);
+  const std::vector<double> brdf_pdf_list     = Sampler::pdfListBsdf(brdf_input, outgoing_dir);
 
   const ColorRGB next_throughput = throughput * brdf_contribution / rr_prob;
 
-  const Ray      ray_out = Ray::FromDirection(hit.position, outgoing_dir);
+  const Ray      ray_out = RayIntersection::spawnRay(hit, outgoing_dir);
   const ColorRGB indirect_lighting =
       brdf_contribution * traceRayRecursion(ray_out, next_throughput, depth + 1, pdf_brdf, brdf_pdf_list);
 
@@ -117,16 +244,55 @@ ColorRGB PathTracer::traceRayRecursion(const Ray& ray_in, const ColorRGB& throug
   return mis_weight * emission;
 }
 
-ColorRGB PathTracer::traceRay(const Ray& ray_in) const {
+ColorRGB PathTracer::ClampRadiance(const ColorRGB& radiance, double max_value) {
+  const double max_component = radiance.maxComponent();
+  if(max_value <= 0.0 || max_component <= max_value) {
+    return radiance;
+  }
+  return radiance * (max_value / max_component);
+}
+
+bool PathTracer::RegisterBounce(PathState& state, BounceType bounce_type, const RenderSettings& render_settings) {
+  int& count = state.bounce_counts[static_cast<int>(bounce_type)];
+  if(count >= render_settings.getMaxBounces(bounce_type)) {
+    return false;
+  }
+  count++;
+  return true;
+}
+
+void PathTracer::RegularizeRoughness(PBR::BRDFInput& input, double min_roughness, bool& after_rough_bounce) {
+  if(after_rough_bounce) {
+    input.setRoughness(std::max(input.roughness, min_roughness));
+  }
+  after_rough_bounce = after_rough_bounce || input.roughness >= REGULARIZATION_ROUGHNESS_THRESHOLD;
+}
+
+ColorRGB PathTracer::clampIndirect(const ColorRGB& radiance, int bounce_count) const {
+  // Light reaching the camera after a single bounce is direct lighting and is never clamped.
+  return bounce_count > 1 ? ClampRadiance(radiance, m_render_settings->getIndirectClamp()) : radiance;
+}
+
+ColorRGB PathTracer::traceRay(const Ray& ray_in, PathStatistics* statistics) const {
   ColorRGB            ray_color(1.0);
   int                 depth         = 0;
   double              brdf_pdf      = 1.0;
   std::vector<double> brdf_pdf_list = {1.0};
   Ray                 ray           = ray_in;
+  PathState           state;
+
+  const int    max_depth      = m_render_settings->getMaxPathDepth();
+  const int    roulette_start = m_render_settings->getRouletteStartDepth();
+  const bool   regularize     = m_render_settings->isPathRegularizationEnabled();
+  const double min_roughness  = m_render_settings->getRegularizationRoughness();
+  const double lod_distance   = m_render_settings->getLODDistance();
 
   ColorRGB total_radiance(0.0);
   while(true) {
-    const RayHitInfo hit = RayIntersection::getSceneIntersection(ray, m_scene);
+    if(statistics != nullptr) {
+      statistics->recordRay(depth, ray_color);
+    }
+    const RayHitInfo hit = IntersectThroughMedia(ray, m_scene, state, depth > 0 ? lod_distance : 0.0);
     if(depth > 0) {
       brdf_pdf_list.push_back(Sampler::pdfLightSample(m_scene->getLightSampleCount(), hit, ray.direction));
     }
@@ -134,32 +300,48 @@ ColorRGB PathTracer::traceRay(const Ray& ray_in) const {
     ray_color *= mis_weight;
 
     if(!isValidHit(hit.distance)) {
-      total_radiance += ray_color * ColorRGB(m_scene->getSkybox()->getColor(ray.direction));
+      total_radiance += clampIndirect(ray_color * ColorRGB(m_scene->getSkybox()->getColor(ray.direction)), depth);
+      break;
+    }
+
+    total_radiance += clampIndirect(ray_color * hit.emitted_light, depth);
+    if(depth >= max_depth) {
       break;
     }
 
-    const double rr_prob = std::min(ray_color.maxComponent(), 1.0);
+    const double rr_prob = depth < roulette_start ? 1.0 : std::min(ray_color.maxComponent(), 1.0);
     if(randomUniform01() >= rr_prob) {
-      total_radiance += ray_color * hit.emitted_light;
       break;
     }
 
-    const PBR::BRDFInput brdf_input      = CreateBrdfInput(hit, -ray.direction);
-    const ColorRGB       direct_lighting = computeDirectLighting(brdf_input, hit.position);
+    PBR::BRDFInput brdf_input = CreateBrdfInput(hit, -ray.direction);
+    ApplyMedia(brdf_input, hit, state);
+    if(regularize) {
+      RegularizeRoughness(brdf_input, min_roughness, state.after_rough_bounce);
+    }
+    const ColorRGB direct_lighting = computeDirectLighting(brdf_input, hit);
+    total_radiance += clampIndirect(ray_color * direct_lighting / rr_prob, depth + 1);
 
-    const linalg::Mat3d tbn          = linalg::Mat3d::FromColumns(hit.tangent, hit.bitangent, hit.normal);
-    const linalg::Vec3d outgoing_dir = SampleOutgoingDirection(brdf_input, tbn, brdf_pdf);
+    const linalg::Mat3d tbn          = linalg::Mat3d::FromColumns(hit.tangent, hit.bitangent, brdf_input.normal);
+    BounceType          bounce_type  = BounceType::DIFFUSE;
+    const linalg::Vec3d outgoing_dir = SampleOutgoingDirection(brdf_input, tbn, brdf_pdf, bounce_type);
+    if(!RegisterBounce(state, bounce_type, *m_render_settings)) {
+      break;
+    }
+    if(bounce_type == BounceType::TRANSMISSION) {
+      CrossInterface(state, hit.material, IsEntering(hit, brdf_input.incoming_dir));
+    }
 
     const ColorRGB brdf_contribution = ComputeBrdfContribution(brdf_input, outgoing_dir, brdf_pdf);
 
-    total_radiance += ray_color * (hit.emitted_light + (direct_lighting / rr_prob));
-
     ray_color *= brdf_contribution / rr_prob;
-    brdf_pdf_list = Sampler::pdfListBrdf(brdf_input.specular_ratio, brdf_input.roughness, -ray.direction,
-                                         brdf_input.normal, outgoing_dir);
-    ray           = Ray::FromDirection(hit.position, outgoing_dir);
+    brdf_pdf_list = Sampler::pdfListBsdf(brdf_input, outgoing_dir);
+    ray           = RayIntersection::spawnRay(hit, outgoing_dir);
     depth++;
   }
 
+  if(statistics != nullptr) {
+    statistics->recordTermination(depth);
+  }
   return total_radiance;
 }
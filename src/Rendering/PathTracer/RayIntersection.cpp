@@ -1,5 +1,6 @@
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <limits>
 #include <linalg/Mat3.hpp>
 #include <linalg/Vec3.hpp>
@@ -13,27 +14,152 @@
 #include "BVH/BVHNode.hpp"
 #include "Core/Color.hpp"
 #include "Core/ImageTypes.hpp"
+#include "Core/MathConstants.hpp"
 #include "Core/Ray.hpp"
 #include "Geometry/Mesh.hpp"
+#include "Geometry/Primitive.hpp"
+#include "Geometry/TangentGenerator.hpp"
 #include "Rendering/PathTracer/RayIntersection.hpp"
 #include "Scene/Scene.hpp"
 #include "SceneObjects/Object3D.hpp"
+#include "Surface/Material.hpp"
+
+namespace {
+
+constexpr double NO_HIT = std::numeric_limits<double>::max();
+
+/**
+ * @struct PrimitiveSurface
+ * @brief Local geometry of a primitive at a hit point.
+ */
+struct PrimitiveSurface {
+  linalg::Vec3d normal;
+  linalg::Vec3d tangent;
+  linalg::Vec3d bitangent;
+  TextureUV     uv;
+  double        jacobian = 0.0; ///< Area of the surface per unit of texture space area.
+};
+
+/**
+ * @brief Gets the distance to the first hit of a ray with a sphere centered at the origin.
+ *
+ * The discriminant is computed from the distance between the center and the line of the ray rather than from the
+ * expanded quadratic, which keeps its precision when the sphere is small compared to its distance to the origin.
+ */
+double getSphereDistance(const Ray& ray, double radius) {
+  const double        b             = -linalg::dot(ray.origin, ray.direction);
+  const linalg::Vec3d closest_point = ray.origin + b * ray.direction;
+  const double        discriminant  = (radius * radius) - linalg::dot(closest_point, closest_point);
+  if(discriminant < 0.0) {
+    return NO_HIT;
+  }
+
+  const double q = b + std::copysign(std::sqrt(discriminant), b);
+  if(q == 0.0) {
+    return NO_HIT;
+  }
+  const double c      = linalg::dot(ray.origin, ray.origin) - (radius * radius);
+  const double t_near = std::min(q, c / q);
+  const double t_far  = std::max(q, c / q);
+  if(t_near > 0.0) {
+    return t_near;
+  }
+  return t_far > 0.0 ? t_far : NO_HIT;
+}
+
+PrimitiveSurface getSphereSurface(const linalg::Vec3d& position, double radius) {
+  const linalg::Vec3d normal    = position.normalized();
+  const double        cos_theta = std::clamp(normal.y, -1.0, 1.0);
+  const double        sin_theta = std::sqrt(std::max(0.0, 1.0 - (cos_theta * cos_theta)));
+  double              phi       = std::atan2(normal.z, normal.x);
+  if(phi < 0.0) {
+    phi += TWO_PI;
+  }
+  const double sin_phi = std::sin(phi);
+  const double cos_phi = std::cos(phi);
+
+  PrimitiveSurface surface;
+  surface.normal    = normal;
+  surface.tangent   = {-sin_phi, 0.0, cos_phi};
+  surface.bitangent = {cos_theta * cos_phi, -sin_theta, cos_theta * sin_phi};
+  surface.uv        = {phi * INV_2PI, std::acos(cos_theta) * INV_PI};
+  surface.jacobian  = TWO_PI * PI * radius * radius * sin_theta;
+  return surface;
+}
+
+/**
+ * @brief Gets the distance to the hit of a ray with the XZ plane.
+ */
+double getPlaneDistance(const Ray& ray) {
+  if(ray.direction.y == 0.0) {
+    return NO_HIT;
+  }
+  const double distance = -ray.origin.y / ray.direction.y;
+  return distance > 0.0 ? distance : NO_HIT;
+}
+
+PrimitiveSurface getPlaneSurface(double u, double v) {
+  PrimitiveSurface surface;
+  surface.normal    = {0.0, 1.0, 0.0};
+  surface.tangent   = {1.0, 0.0, 0.0};
+  surface.bitangent = {0.0, 0.0, 1.0};
+  surface.uv        = {u, v};
+  surface.jacobian  = 1.0;
+  return surface;
+}
+
+/**
+ * @brief Selects the mesh, or level of detail of the mesh, a ray is intersected with.
+ *
+ * The distance is the one of the ray origin to the bounds of the object rather than to the hit, known before the
+ * intersection: an object containing the origin of the ray, such as the surface it leaves from, keeps its full mesh.
+ * Emitters keep it too, their triangles being the ones picked by the light sampling.
+ * @param ray The ray, in world space.
+ * @param object The object.
+ * @param lod_distance The distance at which simplified meshes start to be used, 0 to always use the full mesh.
+ * @return The mesh to intersect.
+ */
+const Mesh& selectMeshLOD(const Ray& ray, const Object3D& object, double lod_distance) {
+  const Mesh& mesh            = object.getRenderMesh();
+  double      bounds_distance = 0.0;
+  if(lod_distance <= 0.0 || mesh.getLODCount() == 1 || object.getMaterial()->getEmissiveIntensity() > 0.0 ||
+     !RayIntersection::getAABBIntersection(ray.origin, ray.direction.cwiseInverse(), object.getMinBound(),
+                                           object.getMaxBound(), bounds_distance)) {
+    return mesh;
+  }
+  return mesh.getLOD(mesh.selectLODForDistance(std::max(bounds_distance, 0.0), lod_distance));
+}
+
+} // namespace
 
 namespace RayIntersection {
 
 void processFaceIntersection(const Ray& ray, const Mesh& mesh, const Face& face, RayHitInfo& closest_hit) {
-  const Vertex& v0 = mesh.getVertex(face.vertex_indices[0]);
-  const Vertex& v1 = mesh.getVertex(face.vertex_indices[1]);
-  const Vertex& v2 = mesh.getVertex(face.vertex_indices[2]);
+  processFaceIntersection(RayF(ray), mesh, face, closest_hit);
+}
 
-  double        hit_distance = std::numeric_limits<double>::max();
-  linalg::Vec3d bary_coords;
+void processFaceIntersection(const RayF& ray, const Mesh& mesh, const Face& face, RayHitInfo& closest_hit) {
+  const linalg::Vec3f& p0 = mesh.getVertexPosition(face.vertex_indices[0]);
+  const linalg::Vec3f& p1 = mesh.getVertexPosition(face.vertex_indices[1]);
+  const linalg::Vec3f& p2 = mesh.getVertexPosition(face.vertex_indices[2]);
 
-  if(!getTriangleIntersection(ray, v0.position, v1.position, v2.position, hit_distance, bary_coords)) {
+  float         hit_distance = std::numeric_limits<float>::max();
+  linalg::Vec3f bary_coords;
+
+  if(!getTriangleIntersection(ray, p0, p1, p2, hit_distance, bary_coords)) {
     return;
   }
-  if(hit_distance > 0 && hit_distance < closest_hit.distance) {
-    updateHitInfoFromBarycentric(closest_hit, hit_distance, bary_coords, v0, v1, v2);
+  if(hit_distance < closest_hit.distance) {
+    // Only the closest hit so far decodes its vertices, the test above reads the positions alone.
+    const Vertex v0 = mesh.getVertex(face.vertex_indices[0]);
+    const Vertex v1 = mesh.getVertex(face.vertex_indices[1]);
+    const Vertex v2 = mesh.getVertex(face.vertex_indices[2]);
+    updateHitInfoFromBarycentric(closest_hit, hit_distance, linalg::Vec3d(bary_coords), v0, v1, v2);
+    if(!mesh.hasTangents()) {
+      // Without a normal map any frame around the normal does, built at the hit so that it cannot flip across the face.
+      closest_hit.tangent   = TangentGenerator::orthogonalize({0.0, 0.0, 0.0}, closest_hit.normal);
+      closest_hit.bitangent = closest_hit.normal.cross(closest_hit.tangent);
+    }
   }
 }
 
@@ -42,10 +168,11 @@ RayHitInfo getMeshIntersectionWithBVH(const Ray& ray, const Mesh& mesh) {
   hit_info.distance = std::numeric_limits<double>::max();
 
   const std::vector<RayBVHHitInfo> bvh_hits = getBVHIntersection(ray, mesh.getBVHRoot());
+  const RayF                       ray_f(ray);
 
   for(const auto& bvh_hit : bvh_hits) {
     const Face& face = mesh.getFaces()[bvh_hit.index_to_check];
-    processFaceIntersection(ray, mesh, face, hit_info);
+    processFaceIntersection(ray_f, mesh, face, hit_info);
   }
 
   return hit_info;
@@ -55,8 +182,9 @@ RayHitInfo getMeshIntersectionWithoutBVH(const Ray& ray, const Mesh& mesh) {
   RayHitInfo hit_info;
   hit_info.distance = std::numeric_limits<double>::max();
 
+  const RayF ray_f(ray);
   for(const auto& face : mesh.getFaces()) {
-    processFaceIntersection(ray, mesh, face, hit_info);
+    processFaceIntersection(ray_f, mesh, face, hit_info);
   }
   return hit_info;
 }
@@ -75,19 +203,77 @@ void updateNormalWithTangentSpace(RayHitInfo& hit_info) {
 
   const linalg::Mat3d tangent_space = linalg::Mat3d::FromColumns(hit_info.tangent, hit_info.bitangent, hit_info.normal);
 
-  const ColorRGB normal_color     = hit_info.material->getNormal(hit_info.bary_coords);
-  linalg::Vec3d  normal_direction = {normal_color.r, normal_color.g, normal_color.b};
-  normal_direction                = (normal_direction * 2) - linalg::Vec3d(1.0, 1.0, 1.0);
+  const MaterialRecord& record           = hit_info.material->getRecord();
+  const ColorRGB        normal_color     = record.normal.sample(hit_info.bary_coords, hit_info.uv_footprint);
+  linalg::Vec3d         normal_direction = {normal_color.r, normal_color.g, normal_color.b};
+  normal_direction                       = (normal_direction * 2) - linalg::Vec3d(1.0, 1.0, 1.0);
 
   hit_info.normal = (tangent_space * normal_direction).normalized();
 }
 
-RayHitInfo getObjectIntersection(const Ray& ray, const Object3D* object) {
-  const Ray  local_ray = transformRayToObjectSpace(ray, object);
-  RayHitInfo hit_info  = getMeshIntersection(local_ray, object->getMesh());
+RayHitInfo getPrimitiveIntersection(const Ray& ray, const Primitive& primitive, std::size_t element_count) {
+  RayHitInfo       hit_info;
+  PrimitiveSurface surface;
+
+  switch(primitive.type) {
+  case PrimitiveType::SPHERE: {
+    const double distance = getSphereDistance(ray, primitive.radius);
+    if(distance == NO_HIT) {
+      return hit_info;
+    }
+    hit_info.distance = distance;
+    surface           = getSphereSurface(ray.origin + distance * ray.direction, primitive.radius);
+    hit_info.position = surface.normal * primitive.radius;
+    break;
+  }
+  case PrimitiveType::QUAD: {
+    const double        distance = getPlaneDistance(ray);
+    const linalg::Vec3d position = ray.origin + distance * ray.direction;
+    if(distance == NO_HIT || std::abs(position.x) > primitive.width * HALF ||
+       std::abs(position.z) > primitive.length * HALF) {
+      return hit_info;
+    }
+    hit_info.distance = distance;
+    hit_info.position = {position.x, 0.0, position.z};
+    surface           = getPlaneSurface(position.x + (primitive.width * HALF), position.z + (primitive.length * HALF));
+    break;
+  }
+  case PrimitiveType::DISK: {
+    const double        distance = getPlaneDistance(ray);
+    const linalg::Vec3d position = ray.origin + distance * ray.direction;
+    if(distance == NO_HIT ||
+       (position.x * position.x) + (position.z * position.z) > primitive.radius * primitive.radius) {
+      return hit_info;
+    }
+    hit_info.distance = distance;
+    hit_info.position = {position.x, 0.0, position.z};
+    surface           = getPlaneSurface(position.x + primitive.radius, position.z + primitive.radius);
+    break;
+  }
+  default:
+    return hit_info;
+  }
+
+  hit_info.normal           = surface.normal;
+  hit_info.geometric_normal = surface.normal;
+  hit_info.tangent          = surface.tangent;
+  hit_info.bitangent        = surface.bitangent;
+  hit_info.bary_coords      = surface.uv;
+
+  hit_info.uv_area = primitive.getUVArea() / static_cast<double>(std::max<std::size_t>(element_count, 1));
+  hit_info.area    = surface.jacobian * hit_info.uv_area;
+  return hit_info;
+}
+
+RayHitInfo getObjectIntersection(const Ray& ray, const Object3D* object, double lod_distance) {
+  const Ray        local_ray = transformRayToObjectSpace(ray, object);
+  const Primitive& primitive = object->getPrimitive();
+  RayHitInfo       hit_info  = object->isIntersectedAnalytically()
+                                   ? getPrimitiveIntersection(local_ray, primitive, object->getMesh().getFaces().size())
+                                   : getMeshIntersection(local_ray, selectMeshLOD(ray, *object, lod_distance));
 
   if(hit_info.distance < std::numeric_limits<double>::max()) {
-    transformHitInfoToWorldSpace(hit_info, local_ray, ray, object);
+    transformHitInfoToWorldSpace(hit_info, ray, object);
   }
 
   return hit_info;
@@ -149,7 +335,7 @@ std::vector<RayBVHHitInfo> getBVHIntersection(const Ray& ray, const BVHNode* bvh
   return std::move(bvh_hits);
 }
 
-RayHitInfo getSceneIntersectionWithBVH(const Ray& ray, const Scene* scene) {
+RayHitInfo getSceneIntersectionWithBVH(const Ray& ray, const Scene* scene, double lod_distance) {
   RayHitInfo                 closest_hit;
   std::vector<RayBVHHitInfo> bvh_hits = getBVHIntersection(ray, scene->getBVHRoot());
 
@@ -162,7 +348,7 @@ RayHitInfo getSceneIntersectionWithBVH(const Ray& ray, const Scene* scene) {
       return closest_hit;
     }
     const Object3D*  object   = scene->getObjectList()[bvh_hit.index_to_check];
-    const RayHitInfo hit_info = getObjectIntersection(ray, object);
+    const RayHitInfo hit_info = getObjectIntersection(ray, object, lod_distance);
     if(hit_info.distance < closest_hit.distance) {
       closest_hit = hit_info;
     }
@@ -172,12 +358,12 @@ RayHitInfo getSceneIntersectionWithBVH(const Ray& ray, const Scene* scene) {
   return closest_hit;
 }
 
-RayHitInfo getSceneIntersectionWithoutBVH(const Ray& ray, const Scene* scene) {
+RayHitInfo getSceneIntersectionWithoutBVH(const Ray& ray, const Scene* scene, double lod_distance) {
   RayHitInfo closest_hit;
   closest_hit.distance = std::numeric_limits<double>::max();
 
   for(const auto& object : scene->getObjectList()) {
-    const RayHitInfo hit_info = getObjectIntersection(ray, object);
+    const RayHitInfo hit_info = getObjectIntersection(ray, object, lod_distance);
     if(hit_info.distance < closest_hit.distance) {
       closest_hit = hit_info;
     }
@@ -203,10 +389,10 @@ std::string getObjectNameFromHit(const Ray& ray, const Scene* scene) {
   return scene->getObjectName(closest_object);
 }
 
-RayHitInfo getSceneIntersection(const Ray& ray, const Scene* scene) {
+RayHitInfo getSceneIntersection(const Ray& ray, const Scene* scene, double lod_distance) {
   if(scene->getBVHRoot() != nullptr) {
-    return getSceneIntersectionWithBVH(ray, scene);
+    return getSceneIntersectionWithBVH(ray, scene, lod_distance);
   }
-  return getSceneIntersectionWithoutBVH(ray, scene);
+  return getSceneIntersectionWithoutBVH(ray, scene, lod_distance);
 }
 } // namespace RayIntersection
\ No newline at end of file
@@ -0,0 +1,373 @@
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <linalg/Mat3.hpp>
+#include <linalg/Vec3.hpp>
+#include <linalg/linalg.hpp>
+#include <vector>
+
+#include "Core/Color.hpp"
+#include "Core/Framebuffer.hpp"
+#include "Core/ImageTypes.hpp"
+#include "Core/Random.hpp"
+#include "Core/Ray.hpp"
+#include "Rendering/CameraRayEmitter.hpp"
+#include "Rendering/PathTracer/DirectionSampler.hpp"
+#include "Rendering/PathTracer/PBR.hpp"
+#include "Rendering/PathTracer/PBRBatch.hpp"
+#include "Rendering/PathTracer/PathTracer.hpp"
+#include "Rendering/PathTracer/RayIntersection.hpp"
+#include "Rendering/PathTracer/WavefrontPathTracer.hpp"
+#include "Rendering/RenderSettings.hpp"
+#include "Scene/LightSample.hpp"
+#include "Scene/Scene.hpp"
+#include "SceneObjects/Camera.hpp"
+
+namespace {
+
+constexpr int OCTANT_COUNT = 8;
+
+} // namespace
+
+void PathQueue::push(const Ray& ray, const ColorRGB& path_throughput, double pdf, double pdf_sum, int pixel,
+                     const PathState& path_state) {
+  origin.push_back(ray.origin);
+  direction.push_back(ray.direction);
+  throughput.push_back(path_throughput);
+  brdf_pdf.push_back(pdf);
+  brdf_pdf_sum.push_back(pdf_sum);
+  pixel_index.push_back(pixel);
+  cone.push_back(ray.cone);
+  state.push_back(path_state);
+}
+
+void PathQueue::clear() {
+  origin.clear();
+  direction.clear();
+  throughput.clear();
+  brdf_pdf.clear();
+  brdf_pdf_sum.clear();
+  pixel_index.clear();
+  cone.clear();
+  state.clear();
+}
+
+void ShadowQueue::push(const linalg::Vec3d& ray_origin, const linalg::Vec3d& ray_direction,
+                       const ColorRGB& ray_contribution, double pdf_sum, int pixel) {
+  origin.push_back(ray_origin);
+  direction.push_back(ray_direction);
+  contribution.push_back(ray_contribution);
+  brdf_pdf_sum.push_back(pdf_sum);
+  pixel_index.push_back(pixel);
+}
+
+void ShadowQueue::clear() {
+  origin.clear();
+  direction.clear();
+  contribution.clear();
+  brdf_pdf_sum.clear();
+  pixel_index.clear();
+}
+
+void WavefrontPathTracer::setCamera(const CameraRayEmitter* ray_emitter, double dx, double dy) {
+  m_ray_emitter = ray_emitter;
+  m_dx          = dx;
+  m_dy          = dy;
+}
+
+bool WavefrontPathTracer::isValidHit(double distance) const {
+  return distance > 0.0 && distance <= m_scene->getCamera()->getFarPlane();
+}
+
+ColorRGB WavefrontPathTracer::clampIndirect(const ColorRGB& radiance, int bounce_count) const {
+  return bounce_count > 1 ? PathTracer::ClampRadiance(radiance, m_render_settings->getIndirectClamp()) : radiance;
+}
+
+int WavefrontPathTracer::DirectionOctant(const linalg::Vec3d& direction) {
+  return (direction.x < 0.0 ? 1 : 0) | (direction.y < 0.0 ? 2 : 0) | (direction.z < 0.0 ? 4 : 0); // NOLINT
+}
+
+void WavefrontPathTracer::generate(const PixelCoord& pixel_start, const PixelCoord& pixel_end,
+                                   const PixelCoord& subpixel_grid_pos, double cell_size) {
+  const int tile_width = pixel_end.x - pixel_start.x;
+  for(int y = pixel_start.y; y < pixel_end.y; ++y) {
+    for(int x = pixel_start.x; x < pixel_end.x; ++x) {
+      const double v   = (static_cast<double>(y) + (subpixel_grid_pos.y + randomUniform01()) * cell_size) * m_dy;
+      const double u   = (static_cast<double>(x) + (subpixel_grid_pos.x + randomUniform01()) * cell_size) * m_dx;
+      const Ray    ray = m_ray_emitter->generateRay(u, v);
+
+      const int pixel = ((y - pixel_start.y) * tile_width) + (x - pixel_start.x);
+      m_paths.push(ray, ColorRGB(1.0), 1.0, 1.0, pixel);
+    }
+  }
+}
+
+void WavefrontPathTracer::intersect(int depth) {
+  const int path_count = static_cast<int>(m_paths.size());
+  const int max_depth      = m_render_settings->getMaxPathDepth();
+  const int roulette_start = m_render_settings->getRouletteStartDepth();
+  // Camera rays keep the full meshes, secondary rays may use their simplified levels.
+  const double lod_distance = depth > 0 ? m_render_settings->getLODDistance() : 0.0;
+  m_hits.resize(path_count);
+  m_shading_items.clear();
+
+  for(int i = 0; i < path_count; ++i) {
+    Ray ray   = Ray::FromDirection(m_paths.origin[i], m_paths.direction[i]);
+    ray.cone  = m_paths.cone[i];
+    m_hits[i] = PathTracer::IntersectThroughMedia(ray, m_scene, m_paths.state[i], lod_distance);
+    m_statistics.recordRay(depth, m_paths.throughput[i]);
+
+    const RayHitInfo& hit = m_hits[i];
+
+    double pdf_sum = m_paths.brdf_pdf_sum[i];
+    if(depth > 0) {
+      pdf_sum += Sampler::pdfLightSample(m_scene->getLightSampleCount(), hit, ray.direction);
+    }
+    const double mis_weight = (pdf_sum > 0.0) ? m_paths.brdf_pdf[i] / pdf_sum : 0.0;
+
+    ColorRGB& throughput  = m_paths.throughput[i];
+    throughput           *= mis_weight;
+
+    ColorRGB& radiance = m_radiance[m_paths.pixel_index[i]];
+    if(!isValidHit(hit.distance)) {
+      radiance += clampIndirect(throughput * ColorRGB(m_scene->getSkybox()->getColor(ray.direction)), depth);
+      m_statistics.recordTermination(depth);
+      continue;
+    }
+
+    radiance += clampIndirect(throughput * hit.emitted_light, depth);
+    if(depth >= max_depth) {
+      m_statistics.recordTermination(depth);
+      continue;
+    }
+
+    const double rr_prob = depth < roulette_start ? 1.0 : std::min(throughput.maxComponent(), 1.0);
+    if(randomUniform01() >= rr_prob) {
+      m_statistics.recordTermination(depth);
+      continue;
+    }
+    throughput /= rr_prob;
+
+    m_shading_items.push_back({hit.material, DirectionOctant(ray.direction), i});
+  }
+}
+
+void WavefrontPathTracer::sortByMaterial() {
+  std::sort(m_shading_items.begin(), m_shading_items.end(), [](const ShadingItem& a, const ShadingItem& b) {
+    if(a.material != b.material) {
+      return std::less<const Material*>()(a.material, b.material);
+    }
+    if(a.octant != b.octant) {
+      return a.octant < b.octant;
+    }
+    return a.path < b.path;
+  });
+}
+
+void WavefrontPathTracer::shade(int depth) {
+  m_extension_paths.clear();
+  m_shadow_rays.clear();
+
+  const LightSample* light_sample  = m_scene->getLightSample();
+  const bool         regularize    = m_render_settings->isPathRegularizationEnabled();
+  const double       min_roughness = m_render_settings->getRegularizationRoughness();
+
+  std::vector<PBR::BRDFInput> inputs;
+  inputs.reserve(PBRBatch::BATCH_SIZE);
+
+  const int item_count = static_cast<int>(m_shading_items.size());
+  for(int first = 0; first < item_count; first += PBRBatch::BATCH_SIZE) {
+    const int lane_count = std::min(PBRBatch::BATCH_SIZE, item_count - first);
+
+    inputs.clear();
+    std::array<linalg::Vec3d, PBRBatch::BATCH_SIZE> outgoing_dirs{};
+    std::array<linalg::Vec3d, PBRBatch::BATCH_SIZE> light_dirs{};
+    std::array<double, PBRBatch::BATCH_SIZE>        outgoing_pdfs{};
+    std::array<BounceType, PBRBatch::BATCH_SIZE>    bounce_types{};
+    std::array<PathState, PBRBatch::BATCH_SIZE>     states{};
+
+    PBRBatch::BRDFBatchInput batch_input;
+    PBRBatch::Vec3Batch      batch_tangent;
+    PBRBatch::Vec3Batch      batch_bitangent;
+    PBRBatch::Vec3Batch      batch_half;
+    PBRBatch::Vec3Batch      batch_outgoing;
+    PBRBatch::Vec3Batch      batch_light;
+    PBRBatch::Lanes          u1{};
+    PBRBatch::Lanes          u2{};
+
+    for(int lane = 0; lane < lane_count; ++lane) {
+      const int         path = m_shading_items[first + lane].path;
+      const RayHitInfo& hit  = m_hits[path];
+
+      inputs.push_back(PathTracer::CreateBrdfInput(hit, -m_paths.direction[path]));
+      states[lane] = m_paths.state[path];
+      PathTracer::ApplyMedia(inputs.back(), hit, states[lane]);
+      if(regularize) {
+        PathTracer::RegularizeRoughness(inputs.back(), min_roughness, states[lane].after_rough_bounce);
+      }
+
+      batch_input.set(lane, inputs.back());
+      batch_tangent.set(lane, hit.tangent);
+      batch_bitangent.set(lane, hit.bitangent);
+      u1[lane] = static_cast<float>(randomUniform01());
+      u2[lane] = static_cast<float>(randomUniform01());
+    }
+
+    // Every lane gets a half vector, the ones sampling the diffuse lobe leave it unused.
+    PBRBatch::sampleHalfVectorGgx(batch_input.roughness, u1, u2, batch_tangent, batch_bitangent, batch_input.normal,
+                                  batch_half);
+
+    for(int lane = 0; lane < lane_count; ++lane) {
+      const RayHitInfo&     hit   = m_hits[m_shading_items[first + lane].path];
+      const PBR::BRDFInput& input = inputs[lane];
+
+      const linalg::Mat3d tbn      = linalg::Mat3d::FromColumns(hit.tangent, hit.bitangent, input.normal);
+      const linalg::Vec3d half_dir = batch_half.get(lane).normalized();
+      outgoing_dirs[lane] =
+          PathTracer::SampleOutgoingDirection(input, tbn, half_dir, outgoing_pdfs[lane], bounce_types[lane]);
+      if(light_sample != nullptr) {
+        light_dirs[lane] = Sampler::sampleLight(light_sample, hit.position);
+      }
+
+      batch_outgoing.set(lane, outgoing_dirs[lane]);
+      batch_light.set(lane, light_dirs[lane]);
+    }
+
+    PBRBatch::ColorBatch brdf_outgoing;
+    PBRBatch::ColorBatch brdf_light;
+    PBRBatch::evaluateBrdf(batch_input, batch_outgoing, brdf_outgoing);
+    if(light_sample != nullptr) {
+      PBRBatch::evaluateBrdf(batch_input, batch_light, brdf_light);
+    }
+    // The batched kernel only covers the opaque lobes.
+    for(int lane = 0; lane < lane_count; ++lane) {
+      if(inputs[lane].transmission > 0.0) {
+        brdf_outgoing.set(lane, PBR::evaluateBsdf(inputs[lane], outgoing_dirs[lane]));
+        if(light_sample != nullptr) {
+          brdf_light.set(lane, PBR::evaluateBsdf(inputs[lane], light_dirs[lane]));
+        }
+      }
+    }
+
+    for(int lane = 0; lane < lane_count; ++lane) {
+      const int             path       = m_shading_items[first + lane].path;
+      const RayHitInfo&     hit        = m_hits[path];
+      const PBR::BRDFInput& input      = inputs[lane];
+      const ColorRGB&       throughput = m_paths.throughput[path];
+      const int             pixel      = m_paths.pixel_index[path];
+
+      if(light_sample != nullptr) {
+        const linalg::Vec3d& light_dir = light_dirs[lane];
+        const double         cos_light = PBR::getCosineFactor(input, light_dir);
+        const double         pdf_sum   = Sampler::pdfSumBsdf(input, light_dir);
+        m_shadow_rays.push(RayIntersection::spawnRay(hit, light_dir).origin, light_dir,
+                           throughput * brdf_light.get(lane) * cos_light, pdf_sum, pixel);
+      }
+
+      if(!PathTracer::RegisterBounce(states[lane], bounce_types[lane], *m_render_settings)) {
+        m_statistics.recordTermination(depth);
+        continue;
+      }
+      if(bounce_types[lane] == BounceType::TRANSMISSION) {
+        PathTracer::CrossInterface(states[lane], hit.material, PathTracer::IsEntering(hit, input.incoming_dir));
+      }
+
+      const linalg::Vec3d& outgoing_dir = outgoing_dirs[lane];
+      const double         pdf          = outgoing_pdfs[lane];
+      const double         cos_theta    = PBR::getCosineFactor(input, outgoing_dir);
+      const ColorRGB       contribution = pdf > 0.0 ? brdf_outgoing.get(lane) * cos_theta / pdf : ColorRGB(0.0);
+      const double         pdf_sum      = Sampler::pdfSumBsdf(input, outgoing_dir);
+
+      m_extension_paths.push(RayIntersection::spawnRay(hit, outgoing_dir), throughput * contribution, pdf, pdf_sum,
+                             pixel, states[lane]);
+    }
+  }
+}
+
+void WavefrontPathTracer::traceShadowRays(int depth) {
+  const int    light_sample_count = m_scene->getLightSampleCount();
+  const int    shadow_count       = static_cast<int>(m_shadow_rays.size());
+  const double lod_distance       = m_render_settings->getLODDistance();
+
+  for(int i = 0; i < shadow_count; ++i) {
+    const Ray        light_ray = Ray::FromDirection(m_shadow_rays.origin[i], m_shadow_rays.direction[i]);
+    const RayHitInfo light_hit = RayIntersection::getSceneIntersection(light_ray, m_scene, lod_distance);
+
+    const ColorRGB light_color = light_hit.emitted_light;
+    if(light_color == ColorRGB(0.0)) {
+      continue;
+    }
+
+    // Balance heuristic weight times the light sampling estimator: (pdf / sum) * (f * cos / pdf) = f * cos / sum.
+    const double pdf     = Sampler::pdfLightSample(light_sample_count, light_hit, light_ray.direction);
+    const double pdf_sum = m_shadow_rays.brdf_pdf_sum[i] + pdf;
+    if(pdf <= 0.0 || pdf_sum <= 0.0) {
+      continue;
+    }
+    m_radiance[m_shadow_rays.pixel_index[i]] +=
+        clampIndirect(m_shadow_rays.contribution[i] * light_color / pdf_sum, depth + 1);
+  }
+}
+
+void WavefrontPathTracer::sortExtensionRaysByDirection() {
+  std::array<int, OCTANT_COUNT + 1> offsets{};
+  for(const linalg::Vec3d& direction : m_extension_paths.direction) {
+    ++offsets[DirectionOctant(direction) + 1];
+  }
+  for(int octant = 0; octant < OCTANT_COUNT; ++octant) {
+    offsets[octant + 1] += offsets[octant];
+  }
+
+  const std::size_t path_count = m_extension_paths.size();
+  m_paths.origin.resize(path_count);
+  m_paths.direction.resize(path_count);
+  m_paths.throughput.resize(path_count);
+  m_paths.brdf_pdf.resize(path_count);
+  m_paths.brdf_pdf_sum.resize(path_count);
+  m_paths.pixel_index.resize(path_count);
+  m_paths.cone.resize(path_count);
+  m_paths.state.resize(path_count);
+
+  for(std::size_t i = 0; i < path_count; ++i) {
+    const int destination             = offsets[DirectionOctant(m_extension_paths.direction[i])]++;
+    m_paths.origin[destination]       = m_extension_paths.origin[i];
+    m_paths.direction[destination]    = m_extension_paths.direction[i];
+    m_paths.throughput[destination]   = m_extension_paths.throughput[i];
+    m_paths.brdf_pdf[destination]     = m_extension_paths.brdf_pdf[i];
+    m_paths.brdf_pdf_sum[destination] = m_extension_paths.brdf_pdf_sum[i];
+    m_paths.pixel_index[destination]  = m_extension_paths.pixel_index[i];
+    m_paths.cone[destination]         = m_extension_paths.cone[i];
+    m_paths.state[destination]        = m_extension_paths.state[i];
+  }
+}
+
+void WavefrontPathTracer::accumulate(Framebuffer* framebuffer, const PixelCoord& pixel_start,
+                                     const PixelCoord& pixel_end, double sample_weight) const {
+  const int tile_width = pixel_end.x - pixel_start.x;
+  for(int y = pixel_start.y; y < pixel_end.y; ++y) {
+    for(int x = pixel_start.x; x < pixel_end.x; ++x) {
+      const int pixel = ((y - pixel_start.y) * tile_width) + (x - pixel_start.x);
+      framebuffer->setPixelColor({x, y}, m_radiance[pixel], sample_weight);
+    }
+  }
+}
+
+void WavefrontPathTracer::renderTile(Framebuffer* framebuffer, const PixelCoord& pixel_start,
+                                     const PixelCoord& pixel_end, double sample_weight,
+                                     const PixelCoord& subpixel_grid_pos, double cell_size) {
+  const int pixel_count = (pixel_end.x - pixel_start.x) * (pixel_end.y - pixel_start.y);
+  m_radiance.assign(pixel_count, ColorRGB(0.0));
+
+  m_paths.clear();
+  generate(pixel_start, pixel_end, subpixel_grid_pos, cell_size);
+
+  for(int depth = 0; m_paths.size() > 0; ++depth) {
+    intersect(depth);
+    sortByMaterial();
+    shade(depth);
+    traceShadowRays(depth);
+    sortExtensionRaysByDirection();
+  }
+
+  accumulate(framebuffer, pixel_start, pixel_end, sample_weight);
+}
@@ -2,6 +2,7 @@
 #include <iostream>
 #include <linalg/Vec3.hpp>
 #include <memory>
+#include <mutex>
 #include <stack>
 
 #include "Core/Color.hpp"
@@ -12,22 +13,31 @@
 #include "Core/ScopedTimer.hpp"
 #include "Rendering/CameraRayEmitter.hpp"
 #include "Rendering/MultiThreadedCPU.hpp"
+#include "Rendering/PathTracer/PathStatistics.hpp"
 #include "Rendering/RenderSettings.hpp"
 #include "Rendering/RenderTime.hpp"
 #include "Rendering/Renderer.hpp"
 #include "Rendering/SingleThreaded.hpp"
+#include "Rendering/WavefrontCPU.hpp"
 #include "Scene/Scene.hpp"
 #include "SceneObjects/Camera.hpp"
 #include "Surface/Material.hpp"
 
 Renderer::Renderer(RenderSettings* render_settings)
-    : m_framebuffer(new Framebuffer({1, 1})), m_render_settings(render_settings), m_path_tracer() {}
+    : m_framebuffer(new Framebuffer({1, 1})), m_render_settings(render_settings), m_path_tracer() {
+  m_path_tracer.setRenderSettings(render_settings);
+}
 
 void Renderer::setScene(Scene* scene) {
   m_scene = scene;
   m_path_tracer.setScene(scene);
 }
 
+void Renderer::mergePathStatistics(const PathStatistics& statistics) {
+  const std::lock_guard<std::mutex> lock(m_path_statistics_mutex);
+  m_path_statistics.merge(statistics);
+}
+
 void Renderer::updateRenderMode() {
   const Resolution properties = m_render_settings->getImageResolution();
   m_framebuffer->setResolution(properties);
@@ -42,6 +52,12 @@ void Renderer::updateRenderMode() {
     m_render_strategy               = std::make_unique<MultiThreadedCPU>(chunk_size, thread_count);
     break;
   }
+  case RenderMode::WAVEFRONT_CPU: {
+    const int          chunk_size   = m_render_settings->getChunkSize();
+    const unsigned int thread_count = m_render_settings->getThreadCount();
+    m_render_strategy               = std::make_unique<WavefrontCPU>(chunk_size, thread_count);
+    break;
+  }
   default:
     std::cerr << "Unknown render mode. Using single-threaded strategy by default." << '\n';
     m_render_strategy = std::make_unique<SingleThreaded>();
@@ -67,10 +83,20 @@ void Renderer::setupRayEmitterParameters() {
                                                    m_scene->getCamera()->getFocusDistance(),
                                                    m_scene->getCamera()->getLensRadius(),
                                                    static_cast<double>(m_render_settings->getWidth()) /
-                                                       static_cast<double>(m_render_settings->getHeight())};
+                                                       static_cast<double>(m_render_settings->getHeight()),
+                                                   m_render_settings->getDx()};
   m_camera_ray_emitter.initializeViewport(emitter_parameters);
 }
 
+void Renderer::prepareFrame() {
+  const Camera* camera = m_scene->getCamera();
+  if(camera == nullptr) {
+    return;
+  }
+  m_scene->tessellateSubdivisionSurfaces(
+      camera->getPosition(), camera->getSensorWidth() / (camera->getFocalLength() * m_render_settings->getWidth()));
+}
+
 bool Renderer::renderFrame() {
   if(!isReadyToRender()) {
     return false;
@@ -80,10 +106,11 @@ bool Renderer::renderFrame() {
   m_stop_requested.store(false);
   setupRayEmitterParameters();
 
-  m_scene->buildBVH();
+  m_scene->buildBVH(m_render_settings->getLODDistance() > 0.0);
+  m_path_statistics.clear();
 
-  const bool render_successed = m_render_strategy->render();
-  if(!render_successed) {
+  const bool render_succeeded = m_render_strategy->render();
+  if(!render_succeeded) {
     cancelRendering();
     return false;
   }
@@ -94,15 +121,16 @@ bool Renderer::renderFrame() {
   std::cout << "Rendering completed in " << m_render_time.getRenderStats().elapsed_time << " seconds.\n";
 
   ScopedTimer::PrintStats();
+  m_path_statistics.print();
   return true;
 }
 
 ColorRGB Renderer::getPixelColor(const PixelCoord& pixel, double dx, double dy, const PixelCoord& subpixel_grid_pos,
-                                 double cell_size) const {
+                                 double cell_size, PathStatistics* statistics) const {
   const double   v        = (static_cast<double>(pixel.y) + (subpixel_grid_pos.y + randomUniform01()) * cell_size) * dy;
   const double   u        = (static_cast<double>(pixel.x) + (subpixel_grid_pos.x + randomUniform01()) * cell_size) * dx;
   const Ray      ray      = m_camera_ray_emitter.generateRay(u, v);
-  const ColorRGB radiance = m_path_tracer.traceRay(ray);
+  const ColorRGB radiance = m_path_tracer.traceRay(ray, statistics);
   return radiance;
 }
 
@@ -111,12 +139,14 @@ void Renderer::renderSample(const PixelCoord& pixel_start, const PixelCoord& pix
   const double dx = m_render_settings->getDx();
   const double dy = m_render_settings->getDy();
 
+  PathStatistics statistics;
   for(int y = pixel_start.y; y < pixel_end.y; ++y) {
     for(int x = pixel_start.x; x < pixel_end.x; ++x) {
-      const ColorRGB color = getPixelColor({x, y}, dx, dy, subpixel_grid_pos, cell_size);
+      const ColorRGB color = getPixelColor({x, y}, dx, dy, subpixel_grid_pos, cell_size, &statistics);
       m_framebuffer->setPixelColor({x, y}, color, sample_weight);
     }
   }
+  mergePathStatistics(statistics);
 }
 
 const double* Renderer::getPreviewImage(double factor) {
@@ -0,0 +1,32 @@
+#include <memory>
+
+#include "Rendering/MultiThreadedCPU.hpp"
+#include "Rendering/PathTracer/WavefrontPathTracer.hpp"
+#include "Rendering/Renderer.hpp"
+#include "Rendering/WavefrontCPU.hpp"
+
+WavefrontCPU::WavefrontCPU(int chunk_size, unsigned int thread_count) : MultiThreadedCPU(chunk_size, thread_count) {}
+
+bool WavefrontCPU::render() {
+  const RenderSettings& settings = renderer()->getRenderSettings();
+
+  m_path_tracers.clear();
+  for(unsigned int t = 0; t < threadCount(); ++t) {
+    auto path_tracer = std::make_unique<WavefrontPathTracer>();
+    path_tracer->setScene(&renderer()->getScene());
+    path_tracer->setRenderSettings(&settings);
+    path_tracer->setCamera(&renderer()->getCameraRayEmitter(), settings.getDx(), settings.getDy());
+    m_path_tracers.push_back(std::move(path_tracer));
+  }
+
+  const bool render_succeeded = MultiThreadedCPU::render();
+  for(const auto& path_tracer : m_path_tracers) {
+    renderer()->mergePathStatistics(path_tracer->getStatistics());
+  }
+  return render_succeeded;
+}
+
+void WavefrontCPU::renderChunk(int thread_id, const Chunk& chunk, double sample_weight, double cell_size) {
+  m_path_tracers[thread_id]->renderTile(renderer()->getFramebuffer(), chunk.start, chunk.end, sample_weight,
+                                        chunk.subpixel_grid_pos, cell_size);
+}
@@ -1,9 +1,13 @@
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
+#include <limits>
 #include <linalg/Mat4.hpp>
 #include <linalg/linalg.hpp>
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -13,6 +17,7 @@
 #include "Core/MathConstants.hpp"
 #include "Core/Random.hpp"
 #include "Geometry/Mesh.hpp"
+#include "Geometry/MeshSubdivider.hpp"
 #include "Lighting/Light.hpp"
 #include "Scene/LightSample.hpp"
 #include "Scene/Scene.hpp"
@@ -156,13 +161,13 @@ std::string Scene::getLightName(const Light* light) const {
 }
 
 void Scene::addLightSample(const Object3D& object, double intensity) {
-  const Mesh&          mesh      = object.getMesh();
+  const Mesh&          mesh      = object.getRenderMesh();
   const linalg::Mat4d& transform = object.getTransformationMatrix();
   for(const auto& face : mesh.getFaces()) {
     LightSample sample;
-    sample.v1 = toVec3(transform * toVec4(mesh.getVertex(face.vertex_indices[0]).position));
-    sample.v2 = toVec3(transform * toVec4(mesh.getVertex(face.vertex_indices[1]).position));
-    sample.v3 = toVec3(transform * toVec4(mesh.getVertex(face.vertex_indices[2]).position));
+    sample.v1 = toVec3(transform * toVec4(linalg::Vec3d(mesh.getVertexPosition(face.vertex_indices[0]))));
+    sample.v2 = toVec3(transform * toVec4(linalg::Vec3d(mesh.getVertexPosition(face.vertex_indices[1]))));
+    sample.v3 = toVec3(transform * toVec4(linalg::Vec3d(mesh.getVertexPosition(face.vertex_indices[2]))));
 
     const linalg::Vec3d edge1 = sample.v2 - sample.v1;
     const linalg::Vec3d edge2 = sample.v3 - sample.v1;
@@ -184,15 +189,52 @@ const LightSample* Scene::getLightSample() const {
 
 int Scene::getLightSampleCount() const { return static_cast<int>(m_light_samples.size()); }
 
-void Scene::buildBVH() {
+void Scene::tessellateSubdivisionSurfaces(const linalg::Vec3d& eye, double pixel_angle) {
+  for(Object3D* object : m_object_index) {
+    if(!object->isSubdivisionSurface()) {
+      continue;
+    }
+    // The parts of the surface nearest to the camera set the level.
+    const linalg::Vec3d& min_bound = object->getMinBound();
+    const linalg::Vec3d& max_bound = object->getMaxBound();
+    const linalg::Vec3d  nearest(std::clamp(eye.x, min_bound.x, max_bound.x),
+                                 std::clamp(eye.y, min_bound.y, max_bound.y),
+                                 std::clamp(eye.z, min_bound.z, max_bound.z));
+    const double         pixel_size = (nearest - eye).length() * pixel_angle;
+
+    // The longest axis of the transformation scales the edges of the cage the most.
+    const linalg::Mat4d& transform = object->getTransformationMatrix();
+    double               scale     = 0.0;
+    for(int column = 0; column < 3; ++column) {
+      scale = std::max(scale, std::sqrt((transform(0, column) * transform(0, column)) +
+                                        (transform(1, column) * transform(1, column)) +
+                                        (transform(2, column) * transform(2, column))));
+    }
+    const double pixels_per_unit = pixel_size > 0.0 ? scale / pixel_size : std::numeric_limits<double>::infinity();
+    object->setSubdivisionLevel(MeshSubdivider::selectLevel(object->getMesh(), pixels_per_unit));
+  }
+}
+
+void Scene::buildBVH(bool with_lods) {
   std::vector<std::shared_ptr<BVHNode>> bvh_leaf_list;
+  std::unordered_set<Material*>         compiled_materials;
   m_light_samples.clear();
   for(size_t i = 0; i < m_object_index.size(); ++i) {
+    // Textures may have been edited since the materials last changed, refresh the records read by the renderer once
+    // per material, however many objects share it.
+    Material* material = m_object_index[i]->getMaterial();
+    if(compiled_materials.insert(material).second) {
+      material->compile();
+    }
     const double emissive_intensity = m_object_index[i]->getMaterial()->getEmissiveIntensity();
     if(emissive_intensity > 0.0) {
       addLightSample(*m_object_index[i], m_object_index[i]->getMaterial()->getEmissiveIntensity());
     }
-    m_object_index[i]->getMesh().buildBVH();
+    if(with_lods) {
+      m_object_index[i]->buildMeshLODs();
+    }
+    m_object_index[i]->buildMeshBVH();
+    m_object_index[i]->buildMeshTangentsIfNeeded();
     bvh_leaf_list.push_back(
         std::make_shared<BVHNode>(m_object_index[i]->getMinBound(), m_object_index[i]->getMaxBound(), i));
   }
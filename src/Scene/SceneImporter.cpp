@@ -0,0 +1,119 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "Core/Config.hpp"
+#include "Core/ThreadPool.hpp"
+#include "Geometry/Mesh.hpp"
+#include "Geometry/OBJLoader.hpp"
+#include "Scene/Scene.hpp"
+#include "Scene/SceneImporter.hpp"
+#include "SceneObjects/Object3D.hpp"
+
+SceneImporter::SceneImporter(Scene* scene) : m_scene(scene) {}
+
+SceneImporter::~SceneImporter() {
+  cancelAllImports();
+  m_import_pool.reset();
+}
+
+SceneImporter::ImportID SceneImporter::importOBJ(const std::string& path, const std::string& base_name) {
+  if(m_import_pool == nullptr) {
+    m_import_pool = std::make_unique<ThreadPool>(MAX_CONCURRENT_IMPORTS);
+  }
+
+  PendingImport pending{m_next_id++, base_name, std::make_shared<OBJLoader::LoadControl>(), {}};
+  pending.loaded = m_import_pool->submit([this, path, control = pending.control]() -> std::shared_ptr<const Mesh> {
+    if(control->isCancelled()) {
+      return nullptr;
+    }
+    // The imports running at once share the hardware threads, the ones starting later get at least one.
+    const unsigned int running = m_running_imports.fetch_add(1) + 1;
+    control->thread_count      = std::max(1U, std::thread::hardware_concurrency() / running);
+    auto mesh                  = std::make_shared<const Mesh>(OBJLoader::load(path, true, control.get()));
+    m_running_imports.fetch_sub(1);
+    return mesh;
+  });
+
+  const ImportID id = pending.id;
+  m_pending_imports.push_back(std::move(pending));
+  return id;
+}
+
+bool SceneImporter::cancelImport(ImportID id) {
+  const auto it = std::find_if(m_pending_imports.begin(), m_pending_imports.end(),
+                               [id](const PendingImport& pending) { return pending.id == id; });
+  if(it == m_pending_imports.end()) {
+    return false;
+  }
+  it->control->cancel();
+  return true;
+}
+
+void SceneImporter::cancelAllImports() {
+  for(const PendingImport& pending : m_pending_imports) {
+    pending.control->cancel();
+  }
+}
+
+int SceneImporter::processImports() {
+  // The observers are notified once the pending imports are updated, so that they can queue or cancel imports.
+  std::vector<std::pair<ImportID, double>>                     progresses;
+  std::vector<std::tuple<ImportID, ImportStatus, std::string>> finished;
+  for(auto it = m_pending_imports.begin(); it != m_pending_imports.end();) {
+    if(it->loaded.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+      const double progress = it->control->getProgress();
+      if(progress != it->reported_progress) {
+        it->reported_progress = progress;
+        progresses.emplace_back(it->id, progress);
+      }
+      ++it;
+      continue;
+    }
+
+    std::shared_ptr<const Mesh> mesh = it->loaded.get();
+    if(it->control->isCancelled()) {
+      finished.emplace_back(it->id, ImportStatus::CANCELLED, "");
+    } else if(mesh == nullptr || mesh->getFaces().empty()) {
+      finished.emplace_back(it->id, ImportStatus::FAILED, "");
+    } else {
+      const std::string object_name = m_scene->getAvailableObjectName(it->base_name);
+      m_scene->addObject(object_name, std::make_unique<Object3D>(std::move(mesh)));
+      finished.emplace_back(it->id, ImportStatus::COMPLETED, object_name);
+    }
+    it = m_pending_imports.erase(it);
+  }
+
+  for(const auto& [id, progress] : progresses) {
+    m_import_progress_observer.notify(id, progress);
+  }
+  for(const auto& [id, status, object_name] : finished) {
+    m_import_finished_observer.notify(id, status, object_name);
+  }
+  return static_cast<int>(finished.size());
+}
+
+void SceneImporter::waitForImports() {
+  for(const PendingImport& pending : m_pending_imports) {
+    pending.loaded.wait();
+  }
+  processImports();
+}
+
+double SceneImporter::getProgress() const {
+  if(m_pending_imports.empty()) {
+    return 1.0;
+  }
+  double progress = 0.0;
+  for(const PendingImport& pending : m_pending_imports) {
+    progress += pending.control->getProgress();
+  }
+  return progress / static_cast<double>(m_pending_imports.size());
+}
@@ -1,16 +1,65 @@
-#include <cstddef>
-#include <functional>
+#include <cmath>
+#include <linalg/Mat4.hpp>
 #include <linalg/Vec3.hpp>
 #include <linalg/linalg.hpp>
+#include <memory>
+#include <utility>
 
+#include "Core/MathConstants.hpp"
 #include "Geometry/Mesh.hpp"
+#include "Geometry/MeshSubdivider.hpp"
+#include "Geometry/Primitive.hpp"
 #include "SceneObjects/Object3D.hpp"
 #include "Surface/Material.hpp"
 #include "Surface/MaterialManager.hpp"
 
-Object3D::Object3D() : m_material(MaterialManager::DefaultMaterial()) {}
+Object3D::Object3D() : Object3D(std::make_shared<const Mesh>()) {}
 
-Object3D::Object3D(const Mesh& mesh) : m_mesh(mesh), m_material(MaterialManager::DefaultMaterial()) {}
+Object3D::Object3D(Mesh mesh) : Object3D(std::make_shared<const Mesh>(std::move(mesh))) {}
+
+Object3D::Object3D(std::shared_ptr<const Mesh> mesh) : m_material(MaterialManager::DefaultMaterial()) {
+  // The object can neither be copied nor moved, capturing this stays valid for its lifetime.
+  getTransformationChangedObserver().add([this]() { updateBounds(); });
+  setMesh(std::move(mesh));
+}
+
+Object3D::Object3D(Mesh mesh, const Primitive& primitive)
+    : Object3D(std::make_shared<const Mesh>(std::move(mesh)), primitive) {}
+
+Object3D::Object3D(std::shared_ptr<const Mesh> mesh, const Primitive& primitive) : Object3D(std::move(mesh)) {
+  setPrimitive(primitive);
+}
+
+void Object3D::setMesh(std::shared_ptr<const Mesh> mesh) {
+  m_mesh              = mesh != nullptr ? std::move(mesh) : std::make_shared<const Mesh>();
+  m_primitive         = {};
+  m_subdivision_level = 0;
+  m_subdivided_mesh.reset();
+  updateBounds();
+}
+
+void Object3D::setSubdivisionSurface(bool subdivision_surface) {
+  if(!subdivision_surface) {
+    setSubdivisionLevel(0);
+  }
+  m_subdivision_surface = subdivision_surface;
+}
+
+void Object3D::setSubdivisionLevel(int level) {
+  if(!m_subdivision_surface || m_primitive.isAnalytic()) {
+    level = 0;
+  }
+  if(level == m_subdivision_level) {
+    return;
+  }
+  m_subdivision_level = level;
+  m_subdivided_mesh   = level > 0 ? std::make_shared<const Mesh>(MeshSubdivider::subdivide(*m_mesh, level)) : nullptr;
+}
+
+void Object3D::setPrimitive(const Primitive& primitive) {
+  m_primitive = primitive;
+  updateBounds();
+}
 
 void Object3D::setMaterial(Material* material) {
   if(material == nullptr) {
@@ -20,33 +69,43 @@ void Object3D::setMaterial(Material* material) {
   m_material_changed_observer.notify(this);
 }
 
-linalg::Vec3d Object3D::computeBound(
-    const std::function<linalg::Vec3d(const linalg::Vec3d&, const linalg::Vec3d&)>& comparator) const {
-  const auto& vertices = m_mesh.getVertices();
-  if(vertices.empty()) {
-    return {0.0, 0.0, 0.0};
+void Object3D::updateBounds() {
+  if(!m_primitive.isAnalytic() && m_mesh->getVertexCount() == 0) {
+    m_min_bound = {0.0, 0.0, 0.0};
+    m_max_bound = {0.0, 0.0, 0.0};
+    return;
   }
 
-  const auto transform = getTransformationMatrix();
+  // Center and half extent of the box: the extent along each world axis is the sum of the absolute contributions
+  // of the local half extents, which bounds the eight transformed corners.
+  const linalg::Vec3d  local_min = m_primitive.isAnalytic() ? m_primitive.getMinBound() : m_mesh->getMinBound();
+  const linalg::Vec3d  local_max = m_primitive.isAnalytic() ? m_primitive.getMaxBound() : m_mesh->getMaxBound();
+  const linalg::Mat4d& transform = getTransformationMatrix();
+  const linalg::Vec3d  center    = (local_min + local_max) * HALF;
+  const linalg::Vec3d  extent    = (local_max - local_min) * HALF;
 
-  linalg::Vec3d bound = linalg::toVec3(transform * linalg::toVec4(vertices[0].position));
-  for(size_t i = 1; i < vertices.size(); ++i) {
-    const linalg::Vec3d transformed = linalg::toVec3(transform * linalg::toVec4(vertices[i].position));
-    bound                           = comparator(bound, transformed);
-  }
+  const linalg::Vec3d world_center = linalg::toVec3(transform * linalg::toVec4(center));
+  const auto          world_extent = [&transform, &extent](int row) {
+    return std::abs(transform(row, 0)) * extent.x + std::abs(transform(row, 1)) * extent.y +
+           std::abs(transform(row, 2)) * extent.z;
+  };
+  const linalg::Vec3d half_size(world_extent(0), world_extent(1), world_extent(2));
 
-  return bound;
+  m_min_bound = world_center - half_size;
+  m_max_bound = world_center + half_size;
 }
 
-linalg::Vec3d Object3D::getMinBound() const {
-  return computeBound([](const linalg::Vec3d& a, const linalg::Vec3d& b) { return linalg::cwiseMin(a, b); });
-}
+Material* Object3D::getMaterial() const { return m_material; }
 
-linalg::Vec3d Object3D::getMaxBound() const {
-  return computeBound([](const linalg::Vec3d& a, const linalg::Vec3d& b) { return linalg::cwiseMax(a, b); });
+bool Object3D::isIntersectedAnalytically() const {
+  return m_primitive.isAnalytic() && m_material->getEmissiveIntensity() <= 0.0;
 }
 
-Material* Object3D::getMaterial() const { return m_material; }
+void Object3D::buildMeshTangentsIfNeeded() {
+  if(m_material != nullptr && m_material->hasNormalMap()) {
+    getRenderMesh().buildTangents();
+  }
+}
 
 Object3D::~Object3D() {
   m_object_deleted_observer.notify(this);
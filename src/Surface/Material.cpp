@@ -4,16 +4,58 @@
 #include "Core/Config.hpp"
 #include "Core/ImageTypes.hpp"
 #include "Surface/Material.hpp"
+#include "Surface/MaterialRecord.hpp"
 #include "Surface/Texture.hpp"
 #include "Surface/TextureManager.hpp"
 
+namespace {
+
+MaterialChannel3d compileChannel(const Texture* texture) {
+  if(texture->isConstant()) {
+    return {nullptr, texture->getValue3d({0.0, 0.0})};
+  }
+  return {texture, ColorRGB(0.0)};
+}
+
+MaterialChannel1d compileChannel(const Texture* texture, bool use_texture, double value) {
+  if(!use_texture) {
+    return {nullptr, value};
+  }
+  if(texture->isConstant()) {
+    return {nullptr, texture->getValue1d({0.0, 0.0})};
+  }
+  return {texture, 0.0};
+}
+
+} // namespace
+
+Material::Material() { compile(); }
+
+void Material::notifyChanged() {
+  compile();
+  m_material_changed_observer.notify(this);
+}
+
+void Material::compile() {
+  m_record.diffuse             = compileChannel(m_diffuse_texture);
+  m_record.normal              = compileChannel(m_normal_texture);
+  m_record.roughness           = compileChannel(m_roughness_texture, m_use_texture_roughness, m_roughness_value);
+  m_record.metalness           = compileChannel(m_metallic_texture, m_use_texture_metallic, m_metallic_value);
+  m_record.emissive            = compileChannel(m_emissive_texture);
+  m_record.transmission        = compileChannel(m_transmission_texture, m_use_texture_transmission,
+                                                m_transmission_value);
+  m_record.emissive_intensity  = m_emissive_intensity;
+  m_record.index_of_refraction = m_index_of_refraction;
+  m_record.dielectric_priority = m_dielectric_priority;
+}
+
 void Material::setDiffuseTexture(Texture* texture) {
   if(texture != nullptr) {
     m_diffuse_texture = texture;
   } else {
     m_diffuse_texture = TextureManager::DefaultDiffuseTexture();
   }
-  m_material_changed_observer.notify(this);
+  notifyChanged();
 }
 
 void Material::setNormalTexture(Texture* texture) {
@@ -22,7 +64,7 @@ void Material::setNormalTexture(Texture* texture) {
   } else {
     m_normal_texture = TextureManager::DefaultNormalTexture();
   }
-  m_material_changed_observer.notify(this);
+  notifyChanged();
 }
 
 void Material::setRoughnessTexture(Texture* texture) {
@@ -31,17 +73,17 @@ void Material::setRoughnessTexture(Texture* texture) {
   } else {
     m_roughness_texture = TextureManager::DefaultMidGrayTexture();
   }
-  m_material_changed_observer.notify(this);
+  notifyChanged();
 }
 
 void Material::setRoughnessValue(double value) {
   m_roughness_value = std::clamp(value, 0.0, 1.0);
-  m_material_changed_observer.notify(this);
+  notifyChanged();
 }
 
 void Material::setUseTextureRoughness(bool use_texture) {
   m_use_texture_roughness = use_texture;
-  m_material_changed_observer.notify(this);
+  notifyChanged();
 }
 
 void Material::setMetallicTexture(Texture* texture) {
@@ -50,17 +92,17 @@ void Material::setMetallicTexture(Texture* texture) {
   } else {
     m_metallic_texture = TextureManager::DefaultBlackTexture();
   }
-  m_material_changed_observer.notify(this);
+  notifyChanged();
 }
 
 void Material::setMetallicValue(double value) {
   m_metallic_value = std::clamp(value, 0.0, 1.0);
-  m_material_changed_observer.notify(this);
+  notifyChanged();
 }
 
 void Material::setUseTextureMetallic(bool use_texture) {
   m_use_texture_metallic = use_texture;
-  m_material_changed_observer.notify(this);
+  notifyChanged();
 }
 
 void Material::setEmissiveTexture(Texture* texture) {
@@ -69,12 +111,12 @@ void Material::setEmissiveTexture(Texture* texture) {
   } else {
     m_emissive_texture = TextureManager::DefaultBlackTexture();
   }
-  m_material_changed_observer.notify(this);
+  notifyChanged();
 }
 
 void Material::setEmissiveIntensity(double intensity) {
   m_emissive_intensity = std::max(0.0, intensity);
-  m_material_changed_observer.notify(this);
+  notifyChanged();
 }
 
 void Material::setTransmissionTexture(Texture* texture) {
@@ -83,47 +125,58 @@ void Material::setTransmissionTexture(Texture* texture) {
   } else {
     m_transmission_texture = TextureManager::DefaultBlackTexture();
   }
-  m_material_changed_observer.notify(this);
+  notifyChanged();
 }
 
 void Material::setTransmissionValue(double value) {
   m_transmission_value = std::clamp(value, 0.0, 1.0);
-  m_material_changed_observer.notify(this);
+  notifyChanged();
 }
 
 void Material::setUseTextureTransmission(bool use_texture) {
   m_use_texture_transmission = use_texture;
-  m_material_changed_observer.notify(this);
+  notifyChanged();
 }
 
 void Material::setIndexOfRefraction(double ior) {
   m_index_of_refraction = std::clamp(ior, 1.0, MAX_IOR);
-  m_material_changed_observer.notify(this);
+  notifyChanged();
+}
+
+void Material::setDielectricPriority(int priority) {
+  m_dielectric_priority = priority;
+  notifyChanged();
 }
 
-ColorRGB Material::getDiffuse(TextureUV uv_coord) const { return m_diffuse_texture->getValue3d(uv_coord); }
+ColorRGB Material::getDiffuse(TextureUV uv_coord, double uv_footprint) const {
+  return m_diffuse_texture->getValue3d(uv_coord, uv_footprint);
+}
 
-ColorRGB Material::getNormal(TextureUV uv_coord) const { return m_normal_texture->getValue3d(uv_coord); }
+ColorRGB Material::getNormal(TextureUV uv_coord, double uv_footprint) const {
+  return m_normal_texture->getValue3d(uv_coord, uv_footprint);
+}
 
-double Material::getRoughness(TextureUV uv_coord) const {
+double Material::getRoughness(TextureUV uv_coord, double uv_footprint) const {
   if(m_use_texture_roughness) {
-    return m_roughness_texture->getValue1d(uv_coord);
+    return m_roughness_texture->getValue1d(uv_coord, uv_footprint);
   }
   return m_roughness_value;
 }
 
-double Material::getMetalness(TextureUV uv_coord) const {
+double Material::getMetalness(TextureUV uv_coord, double uv_footprint) const {
   if(m_use_texture_metallic) {
-    return m_metallic_texture->getValue1d(uv_coord);
+    return m_metallic_texture->getValue1d(uv_coord, uv_footprint);
   }
   return m_metallic_value;
 }
 
-ColorRGB Material::getEmissive(TextureUV uv_coord) const { return m_emissive_texture->getValue3d(uv_coord); }
+ColorRGB Material::getEmissive(TextureUV uv_coord, double uv_footprint) const {
+  return m_emissive_texture->getValue3d(uv_coord, uv_footprint);
+}
 
-double Material::getTransmission(TextureUV uv_coord) const {
+double Material::getTransmission(TextureUV uv_coord, double uv_footprint) const {
   if(m_use_texture_transmission) {
-    return m_transmission_texture->getValue1d(uv_coord);
+    return m_transmission_texture->getValue1d(uv_coord, uv_footprint);
   }
   return m_transmission_value;
 }
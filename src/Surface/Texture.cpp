@@ -1,7 +1,9 @@
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -12,11 +14,21 @@
 #include "Surface/Texture.hpp"
 #include "Surface/TextureFiltering.hpp"
 #include "Surface/TextureLoader.hpp"
+#include "Surface/TextureManager.hpp"
+#include "Surface/TextureStorage.hpp"
+#include "Surface/TextureTileCache.hpp"
 #include "Surface/TextureWrapping.hpp"
+#include "Surface/TiledTextureFile.hpp"
+
+namespace {
+constexpr int ALPHA_CHANNEL = 3;
+} // namespace
 
 Texture::Texture()
-    : m_texture_properties({1, 1, 3}), m_image_data({1.0, 0.0, 1.0}), m_preview_properties({1, 1, 3}),
+    : m_texture_properties({1, 1, 3}), m_preview_properties({1, 1, 3}),
       m_texture_preview({COLOR8_MAX_VALUE, 0, COLOR8_MAX_VALUE}) {
+  m_image_data.setFloat64({1.0, 0.0, 1.0});
+  m_image_data.setImageLayout({1, 1}, m_texture_properties.channels);
   generatePreviewData();
 }
 
@@ -51,28 +63,55 @@ std::pair<int, int> Texture::computePreviewSize() const {
   return {resized_width, MAX_PREVIEW_TEXTURE_SIZE};
 }
 
+int Texture::computePreviewLevel(int preview_width, int preview_height) const {
+  if(!isStreamed()) {
+    return 0;
+  }
+
+  // Read the smallest level still covering the preview, instead of streaming the full resolution image.
+  int level = 0;
+  while(level + 1 < m_tiled_file->getLevelCount()) {
+    const Resolution next = m_tiled_file->getLevelResolution(level + 1);
+    if(next.width < preview_width || next.height < preview_height) {
+      break;
+    }
+    ++level;
+  }
+  return level;
+}
+
 void Texture::generateRescaledImage(int new_width, int new_height) {
-  const int original_width  = m_texture_properties.width;
-  const int original_height = m_texture_properties.height;
-  const int channels        = m_texture_properties.channels;
+  const int        level = computePreviewLevel(new_width, new_height);
+  const Resolution source =
+      TextureSampling::getMipResolution({m_texture_properties.width, m_texture_properties.height}, level);
 
+  StreamedTile tile;
   for(int y = 0; y < new_height; ++y) {
     for(int x = 0; x < new_width; ++x) {
       const double u = static_cast<double>(x) / new_width;
       const double v = static_cast<double>(y) / new_height;
 
-      const int src_x = static_cast<int>(u * original_width);
-      const int src_y = static_cast<int>(v * original_height);
+      const int src_x = static_cast<int>(u * source.width);
+      const int src_y = static_cast<int>(v * source.height);
 
-      appendPixelFromSource(src_x, src_y, channels, original_width);
+      appendPixelFromSource(level, src_x, src_y, tile);
     }
   }
 }
 
-void Texture::appendPixelFromSource(int src_x, int src_y, int channels, int original_width) {
+void Texture::appendPixelFromSource(int level, int src_x, int src_y, StreamedTile& tile) {
+  const int             channels = m_texture_properties.channels;
+  std::array<double, 4> texel{};
+  if(isStreamed()) {
+    readStreamedTexel(level, src_x, src_y, tile, false, texel.data());
+  } else {
+    for(int c = 0; c < channels; ++c) {
+      texel[c] = m_image_data.load(m_image_data.getTexelIndex(src_x, src_y) + c);
+    }
+  }
+
   for(int c = 0; c < channels; ++c) {
-    const std::uint64_t src_index = (static_cast<std::uint64_t>(src_y) * original_width + src_x) * channels + c;
-    m_texture_preview.push_back(static_cast<unsigned char>(m_image_data[src_index] * NORMALIZED_TO_COLOR8));
+    m_texture_preview.push_back(static_cast<unsigned char>(texel[c] * NORMALIZED_TO_COLOR8));
   }
 }
 
@@ -104,33 +143,64 @@ void Texture::setTextureType(TextureType type) {
 }
 
 void Texture::loadFromFile(const char* filename) {
-  TextureLoader::load(filename, m_image_data, m_texture_properties);
+  m_tiled_file = TiledTextureFile::HasTiledExtension(filename) ? TiledTextureFile::Open(filename) : nullptr;
+  if(isStreamed()) {
+    m_texture_properties = m_tiled_file->getProperties();
+    m_image_data         = TextureStorage();
+  } else {
+    TextureLoader::load(filename, m_image_data, m_texture_properties);
+    m_image_data.setImageLayout({m_texture_properties.width, m_texture_properties.height},
+                                m_texture_properties.channels);
+  }
+  updateLinearData();
   m_texture_type = TextureType::IMAGE_TEXTURE;
   m_texture_path = filename;
   generatePreviewData();
   m_texture_data_observer.notify();
 }
 
+void Texture::takeImageFrom(Texture& source) {
+  m_image_data         = std::move(source.m_image_data);
+  m_tiled_file         = std::move(source.m_tiled_file);
+  m_texture_properties = source.m_texture_properties;
+  m_texture_type       = source.m_texture_type;
+  m_texture_path       = std::move(source.m_texture_path);
+  m_texture_preview    = std::move(source.m_texture_preview);
+  m_preview_properties = source.m_preview_properties;
+
+  // The source builds the linear data and mip levels with the sampling settings it was given when it was queued.
+  if(source.m_color_space == m_color_space && source.m_filtering_mode == m_filtering_mode) {
+    m_linear_image_data = std::move(source.m_linear_image_data);
+    m_mip_levels        = std::move(source.m_mip_levels);
+  } else {
+    updateLinearData();
+  }
+
+  // The source preview was built unflipped, which only differs for streamed textures (see flipVertically).
+  if(isStreamed() && m_flipped_vertically) {
+    generatePreviewData();
+  }
+  m_texture_data_observer.notify();
+}
+
 void Texture::generateTexture(const ImageProperties& properties, const std::vector<double>& image_data) {
   m_texture_properties = properties;
-  m_image_data         = image_data;
+  m_tiled_file.reset();
+  m_image_data.setFloat64(image_data);
+  m_image_data.setImageLayout({properties.width, properties.height}, properties.channels);
   m_texture_path.clear();
+  updateLinearData();
 
   generatePreviewData();
   m_texture_data_observer.notify();
 }
 
 void Texture::flipVertically() {
-  for(int y = 0; y < m_texture_properties.height / 2; ++y) {
-    for(int x = 0; x < m_texture_properties.width; ++x) {
-      for(int c = 0; c < m_texture_properties.channels; ++c) {
-        std::swap(m_image_data[(y * m_texture_properties.width + x) * m_texture_properties.channels + c],
-                  m_image_data[((m_texture_properties.height - 1 - y) * m_texture_properties.width + x) *
-                                   m_texture_properties.channels +
-                               c]);
-      }
-    }
+  // Streamed textures flip the rows when reading their tiles.
+  if(!isStreamed()) {
+    m_image_data.flipRows(m_texture_properties.width, m_texture_properties.height, m_texture_properties.channels);
   }
+  updateLinearData();
   generatePreviewData();
   m_texture_data_observer.notify();
 }
@@ -142,104 +212,245 @@ void Texture::setFlippedVertically(bool flipped) {
   }
 }
 
-void Texture::readPixelChannels(int x, int y, double* out) const {
-  const int w     = m_texture_properties.width;
-  const int c     = m_texture_properties.channels;
-  const int index = (y * w + x) * c;
-  for(int i = 0; i < c; ++i) {
-    out[i] = m_image_data[index + i];
+void Texture::setStorageFormat(TexelFormat format) {
+  if(isStreamed()) {
+    return;
   }
+  m_image_data.convertTo(format);
+  updateLinearData();
+  generatePreviewData();
+  m_texture_data_observer.notify();
 }
 
-ColorRGBA Texture::samplePixelColor(TextureUV uv) const {
-  TextureSampling::wrapCoordinates(uv, m_wrapping_mode);
-  const int             c = m_texture_properties.channels;
-  std::array<double, 4> out{0.0, 0.0, 0.0, 1.0};
+bool Texture::isConstant() const {
+  return !isStreamed() && m_texture_properties.width == 1 && m_texture_properties.height == 1 &&
+         m_wrapping_mode != TextureSampling::TextureWrapping::CLAMP_TO_BORDER;
+}
 
-  if(uv.u == -1.0 || uv.v == -1.0) {
-    if(c == 1) {
-      const double g = m_border_color.grayscale();
-      out[0] = out[1] = out[2] = g;
+TexelFormat Texture::getStorageFormat() const {
+  return isStreamed() ? m_tiled_file->getFormat() : m_image_data.getFormat();
+}
+
+int Texture::getMipLevelCount() const {
+  return isStreamed() ? m_tiled_file->getLevelCount() : static_cast<int>(m_mip_levels.size()) + 1;
+}
+
+template <typename Texel, typename Decoder>
+void Texture::readPixelChannels(const Texel* data, const TextureLayout& layout, int x, int y, double* out,
+                                Decoder decode) const {
+  const std::size_t index = layout.getTexelIndex(x, y);
+  for(int i = 0; i < layout.channels; ++i) {
+    out[i] = decode(data[index + i], i);
+  }
+}
+
+const TextureStorage& Texture::getLevelStorage(int level) const {
+  if(level > 0) {
+    return m_mip_levels[level - 1];
+  }
+  if(m_color_space == ColorSpace::LINEAR && m_image_data.getFormat() != TexelFormat::UNORM8) {
+    return m_linear_image_data;
+  }
+  return m_image_data;
+}
+
+void Texture::readStreamedTexel(int level, int x, int y, StreamedTile& tile, bool to_linear, double* out) const {
+  if(m_flipped_vertically) {
+    y = m_tiled_file->getLevelResolution(level).height - 1 - y;
+  }
+
+  const int tile_size = m_tiled_file->getTileSize();
+  const int tile_x    = x / tile_size;
+  const int tile_y    = y / tile_size;
+  if(tile.texels == nullptr || tile.tile_x != tile_x || tile.tile_y != tile_y) {
+    tile = {TextureManager::TileCache().getTile(*m_tiled_file, level, tile_x, tile_y), tile_x, tile_y};
+  }
+
+  const TextureStorage& texels = *tile.texels;
+  const std::size_t     index  = texels.getTexelIndex(x - (tile_x * tile_size), y - (tile_y * tile_size));
+  const std::uint8_t*   unorm8 = texels.data<std::uint8_t>();
+  for(int c = 0; c < m_texture_properties.channels; ++c) {
+    if(!to_linear || c == ALPHA_CHANNEL) {
+      out[c] = texels.load(index + c);
+    } else if(unorm8 != nullptr) {
+      out[c] = decodeSRGBTexel(unorm8[index + c]);
     } else {
-      out[0] = m_border_color.r;
-      out[1] = m_border_color.g;
-      out[2] = m_border_color.b;
+      out[c] = texels.load(index + c);
+      convertToLinearSpace(out[c]);
     }
-  } else {
-    const int w = m_texture_properties.width;
-    const int h = m_texture_properties.height;
+  }
+}
 
-    if(m_filtering_mode == TextureSampling::TextureFiltering::NEAREST) {
-      const auto coord = TextureSampling::sampleNearest(uv, {w, h});
-      readPixelChannels(coord.x, coord.y, out.data());
-    } else {
-      const auto            info = TextureSampling::sampleBilinear(uv, {w, h});
-      std::array<double, 4> c00{}, c01{}, c10{}, c11{}; // NOLINT(readability-isolate-declaration)
-      readPixelChannels(info.x0, info.y0, c00.data());
-      readPixelChannels(info.x1, info.y0, c01.data());
-      readPixelChannels(info.x0, info.y1, c10.data());
-      readPixelChannels(info.x1, info.y1, c11.data());
-
-      for(int ch = 0; ch < c; ++ch) {
-        out[ch] = (1.0 - info.dx) * (1.0 - info.dy) * c00[ch] + info.dx * (1.0 - info.dy) * c01[ch] +
-                  (1.0 - info.dx) * info.dy * c10[ch] + info.dx * info.dy * c11[ch];
-      }
+ColorRGBA Texture::sampleLevel(int level, TextureUV uv) const {
+  if(isStreamed()) {
+    return sampleStreamedLevel(level, uv);
+  }
+
+  const TextureStorage& storage = getLevelStorage(level);
+  const TextureLayout&  layout  = storage.getLayout();
+  const auto            decode  = [](auto texel, int /*channel*/) { return decodeTexel(texel); };
+  const auto            filter  = [&](const auto* data, auto decoder) {
+    return filterLevel(layout, uv, [&](int x, int y, double* out) {
+      readPixelChannels(data, layout, x, y, out, decoder);
+    });
+  };
+
+  switch(storage.getFormat()) {
+  case TexelFormat::UNORM8:
+    if(m_color_space == ColorSpace::LINEAR) {
+      const auto decode_srgb = [](std::uint8_t texel, int channel) {
+        return channel == ALPHA_CHANNEL ? decodeTexel(texel) : decodeSRGBTexel(texel);
+      };
+      return filter(storage.data<std::uint8_t>(), decode_srgb);
+    }
+    return filter(storage.data<std::uint8_t>(), decode);
+  case TexelFormat::HALF:
+    return filter(storage.data<Half>(), decode);
+  case TexelFormat::FLOAT32:
+    return filter(storage.data<float>(), decode);
+  default:
+    return filter(storage.data<double>(), decode);
+  }
+}
+
+ColorRGBA Texture::sampleStreamedLevel(int level, TextureUV uv) const {
+  const TextureLayout layout{m_tiled_file->getLevelResolution(level), m_texture_properties.channels, false};
+  const bool          to_linear = m_color_space == ColorSpace::LINEAR;
+
+  // The texels of a bilinear footprint usually share a tile, only look it up in the cache when it changes.
+  StreamedTile tile;
+  return filterLevel(layout, uv,
+                     [&](int x, int y, double* out) { readStreamedTexel(level, x, y, tile, to_linear, out); });
+}
+
+template <typename TexelReader>
+ColorRGBA Texture::filterLevel(const TextureLayout& layout, TextureUV uv, TexelReader read) const {
+  const int             c = layout.channels;
+  std::array<double, 4> out{0.0, 0.0, 0.0, 1.0};
+
+  if(m_filtering_mode == TextureSampling::TextureFiltering::NEAREST) {
+    const auto coord = TextureSampling::sampleNearest(uv, layout.resolution);
+    read(coord.x, coord.y, out.data());
+  } else {
+    const auto            info = TextureSampling::sampleBilinear(uv, layout.resolution);
+    std::array<double, 4> c00{}, c01{}, c10{}, c11{}; // NOLINT(readability-isolate-declaration)
+    read(info.x0, info.y0, c00.data());
+    read(info.x1, info.y0, c01.data());
+    read(info.x0, info.y1, c10.data());
+    read(info.x1, info.y1, c11.data());
+
+    for(int ch = 0; ch < c; ++ch) {
+      out[ch] = (1.0 - info.dx) * (1.0 - info.dy) * c00[ch] + info.dx * (1.0 - info.dy) * c01[ch] +
+                (1.0 - info.dx) * info.dy * c10[ch] + info.dx * info.dy * c11[ch];
     }
   }
 
-  ColorRGBA color{0.0};
   switch(c) {
   case 1:
-    color = {out[0], out[0], out[0], 1.0};
-    break;
+    return {out[0], out[0], out[0], 1.0};
   case 3:
-    color = {out[0], out[1], out[2], 1.0};
-    break;
+    return {out[0], out[1], out[2], 1.0};
   default:
-    color = {out[0], out[1], out[2], out[3]};
-    break;
+    return {out[0], out[1], out[2], out[3]};
   }
+}
+
+ColorRGBA Texture::samplePixelColor(TextureUV uv, double uv_footprint) const {
+  TextureSampling::wrapCoordinates(uv, m_wrapping_mode);
+
+  if(uv.u == -1.0 || uv.v == -1.0) {
+    const ColorRGB& border = m_color_space == ColorSpace::LINEAR ? m_linear_border_color : m_border_color;
+    if(m_texture_properties.channels == 1) {
+      const double g = border.grayscale();
+      return {g, g, g, 1.0};
+    }
+    return {border.r, border.g, border.b, 1.0};
+  }
+
+  const int max_level = getMipLevelCount() - 1;
+  if(m_filtering_mode != TextureSampling::TextureFiltering::TRILINEAR || max_level == 0 || uv_footprint <= 0.0) {
+    return sampleLevel(0, uv);
+  }
+
+  const double level = std::min(
+      TextureSampling::computeMipLevel(uv_footprint, {m_texture_properties.width, m_texture_properties.height}),
+      static_cast<double>(max_level));
+  const int    level0 = static_cast<int>(level);
+  const double t      = level - level0;
 
-  if(m_color_space == ColorSpace::LINEAR) {
-    color = color.toLinearSpace();
+  const ColorRGBA color0 = sampleLevel(level0, uv);
+  if(t <= 0.0) {
+    return color0;
   }
-  return color;
+  return color0 * (1.0 - t) + sampleLevel(level0 + 1, uv) * t;
 }
 
-double Texture::getValue1d(TextureUV uv) const {
-  const ColorRGBA c = samplePixelColor(uv);
+double Texture::getValue1d(TextureUV uv, double uv_footprint) const {
+  const ColorRGBA c = samplePixelColor(uv, uv_footprint);
   return c.grayscale();
 }
 
-ColorRGB Texture::getValue3d(TextureUV uv) const {
-  const ColorRGBA c = samplePixelColor(uv);
+ColorRGB Texture::getValue3d(TextureUV uv, double uv_footprint) const {
+  const ColorRGBA c = samplePixelColor(uv, uv_footprint);
   return {c.r, c.g, c.b};
 }
 
-ColorRGBA Texture::getValue4d(TextureUV uv) const { return samplePixelColor(uv); }
+ColorRGBA Texture::getValue4d(TextureUV uv, double uv_footprint) const { return samplePixelColor(uv, uv_footprint); }
 
 void Texture::setColorSpace(ColorSpace color_space) {
   m_color_space = color_space;
+  updateLinearData();
   m_texture_parameters_observer.notify();
 }
 
+void Texture::updateLinearData() {
+  m_linear_border_color = m_border_color.toLinearSpace();
+  if(m_color_space == ColorSpace::LINEAR && m_image_data.getFormat() != TexelFormat::UNORM8) {
+    m_linear_image_data = m_image_data.toLinearSpace(m_texture_properties.channels);
+  } else {
+    m_linear_image_data = TextureStorage();
+  }
+  updateMipLevels();
+}
+
+void Texture::updateMipLevels() {
+  m_mip_levels.clear();
+  if(m_filtering_mode != TextureSampling::TextureFiltering::TRILINEAR || isStreamed()) {
+    return;
+  }
+
+  const bool srgb_source = m_color_space == ColorSpace::LINEAR;
+  for(int level = 1;; ++level) {
+    const TextureStorage& previous = getLevelStorage(level - 1);
+    const Resolution&     size     = previous.getLayout().resolution;
+    if(size.width <= 1 && size.height <= 1) {
+      break;
+    }
+    m_mip_levels.push_back(previous.downsample(srgb_source));
+  }
+}
+
 void Texture::setBorderColor(const ColorRGBA& color) {
   m_border_color = ColorRGB(color);
+  m_linear_border_color = m_border_color.toLinearSpace();
   m_texture_parameters_observer.notify();
 }
 
 void Texture::setBorderColor(const ColorRGB& color) {
   m_border_color = color;
+  m_linear_border_color = m_border_color.toLinearSpace();
   m_texture_parameters_observer.notify();
 }
 
 void Texture::setBorderColor(double value) {
   m_border_color = {value, value, value};
+  m_linear_border_color = m_border_color.toLinearSpace();
   m_texture_parameters_observer.notify();
 }
 
 void Texture::setFilteringMode(TextureSampling::TextureFiltering filtering) {
   m_filtering_mode = filtering;
+  updateMipLevels();
   m_texture_parameters_observer.notify();
 }
 
@@ -32,4 +32,17 @@ BilinearSampleInfo sampleBilinear(TextureUV uv_coord, Resolution resolution) {
   return {x0, x1, y0, y1, dx, dy};
 }
 
+double computeMipLevel(double uv_footprint, Resolution resolution) {
+  const double texel_footprint =
+      uv_footprint * std::sqrt(static_cast<double>(resolution.width) * static_cast<double>(resolution.height));
+  if(texel_footprint <= 1.0) {
+    return 0.0;
+  }
+  return std::log2(texel_footprint);
+}
+
+Resolution getMipResolution(Resolution resolution, int level) {
+  return {std::max(1, resolution.width >> level), std::max(1, resolution.height >> level)};
+}
+
 } // namespace TextureSampling
@@ -12,6 +12,7 @@
 #include "Core/Color.hpp"
 #include "Core/ImageTypes.hpp"
 #include "Surface/TextureLoader.hpp"
+#include "Surface/TextureStorage.hpp"
 
 namespace TextureLoader {
 
@@ -26,61 +27,62 @@ std::string getFileExtension(const std::string& filename) {
   return ext;
 }
 
-void handleLoadFailure(std::vector<double>& image_data, ImageProperties& texture_properties, const char* reason) {
+void handleLoadFailure(TextureStorage& storage, ImageProperties& texture_properties, const char* reason) {
   std::cerr << "Error loading texture: " << reason << '\n';
   texture_properties = {1, 1, 3};
-  image_data         = {1.0, 0.0, 1.0};
+  storage.setFloat64({1.0, 0.0, 1.0});
 }
 
-void loadHDR(const char* filename, std::vector<double>& image_data, ImageProperties& texture_properties) {
+void loadHDR(const char* filename, TextureStorage& storage, ImageProperties& texture_properties) {
   int    width    = 0;
   int    height   = 0;
   int    channels = 0;
   float* data     = stbi_loadf(filename, &width, &height, &channels, 0);
   if(data == nullptr) {
-    handleLoadFailure(image_data, texture_properties, stbi_failure_reason());
+    handleLoadFailure(storage, texture_properties, stbi_failure_reason());
     return;
   }
 
   texture_properties = {width, height, channels};
-  image_data.resize(texture_properties.bufferSize());
-
-  for(std::uint64_t i = 0; i < image_data.size(); ++i) {
-    image_data[i] = static_cast<double>(data[i]);
-  }
+  storage.setFloat32(std::vector<float>(data, data + texture_properties.bufferSize()));
   stbi_image_free(data);
 }
 
-void loadLDR(const char* filename, std::vector<double>& image_data, ImageProperties& texture_properties) {
+void loadLDR(const char* filename, TextureStorage& storage, ImageProperties& texture_properties) {
   int            width    = 0;
   int            height   = 0;
   int            channels = 0;
   unsigned char* data     = stbi_load(filename, &width, &height, &channels, 0);
   if(data == nullptr) {
-    handleLoadFailure(image_data, texture_properties, stbi_failure_reason());
+    handleLoadFailure(storage, texture_properties, stbi_failure_reason());
     return;
   }
 
   texture_properties = {width, height, channels};
-  image_data.resize(texture_properties.bufferSize());
-
-  for(std::uint64_t i = 0; i < image_data.size(); ++i) {
-    image_data[i] = static_cast<double>(data[i]) * COLOR8_TO_NORMALIZED;
-  }
-
+  storage.setUnorm8(std::vector<std::uint8_t>(data, data + texture_properties.bufferSize()));
   stbi_image_free(data);
 }
 } // namespace
 
-void load(const char* filename, std::vector<double>& image_data, ImageProperties& texture_properties) {
+void load(const char* filename, TextureStorage& storage, ImageProperties& texture_properties) {
   const std::string extension = getFileExtension(filename);
 
   if(extension.empty()) {
-    handleLoadFailure(image_data, texture_properties, "No file extension found");
+    handleLoadFailure(storage, texture_properties, "No file extension found");
   } else if(extension == "hdr") {
-    loadHDR(filename, image_data, texture_properties);
+    loadHDR(filename, storage, texture_properties);
   } else {
-    loadLDR(filename, image_data, texture_properties);
+    loadLDR(filename, storage, texture_properties);
+  }
+}
+
+void load(const char* filename, std::vector<double>& image_data, ImageProperties& texture_properties) {
+  TextureStorage storage;
+  load(filename, storage, texture_properties);
+
+  image_data.resize(storage.size());
+  for(std::size_t i = 0; i < image_data.size(); ++i) {
+    image_data[i] = storage.load(i);
   }
 }
 
@@ -1,5 +1,9 @@
+#include <algorithm>
+#include <chrono>
 #include <cstddef>
+#include <future>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -7,8 +11,10 @@
 
 #include "Core/Config.hpp"
 #include "Core/MathConstants.hpp"
+#include "Core/ThreadPool.hpp"
 #include "Surface/Texture.hpp"
 #include "Surface/TextureManager.hpp"
+#include "Surface/TextureTileCache.hpp"
 
 std::unique_ptr<Texture> TextureManager::s_default_skybox_texture   = nullptr;
 std::unique_ptr<Texture> TextureManager::s_default_diffuse_texture  = nullptr;
@@ -72,6 +78,83 @@ Texture* TextureManager::DefaultBlackTexture() {
   return s_default_black_texture.get();
 }
 
+TextureTileCache& TextureManager::TileCache() {
+  static TextureTileCache tile_cache;
+  return tile_cache;
+}
+
+TextureManager::TextureManager() = default;
+
+TextureManager::~TextureManager() = default;
+
+std::future<Texture*> TextureManager::loadTextureAsync(const std::string& texture_name, const std::string& path) {
+  addTexture(texture_name);
+  if(m_decode_pool == nullptr) {
+    m_decode_pool = std::make_unique<ThreadPool>();
+  }
+
+  PendingTexture pending{getTexture(texture_name), {}, {}};
+  // The staging texture takes the sampling settings of the target, so that the worker builds its linear data and mip
+  // levels. The storage format chosen for a previously loaded image is kept as well.
+  const Texture*                          target         = pending.target;
+  const ColorSpace                        color_space    = target->getColorSpace();
+  const TextureSampling::TextureFiltering filtering      = target->getFilteringMode();
+  const std::optional<TexelFormat>        storage_format =
+      target->getTexturePath().empty() ? std::nullopt : std::optional<TexelFormat>(target->getStorageFormat());
+  pending.decoded = m_decode_pool->submit([path, color_space, filtering, storage_format]() {
+    // The staging texture has no observer, loading it off the owning thread notifies nobody.
+    auto staging = std::make_unique<Texture>();
+    staging->setColorSpace(color_space);
+    staging->setFilteringMode(filtering);
+    staging->loadFromFile(path.c_str());
+    if(storage_format.has_value() && *storage_format != staging->getStorageFormat()) {
+      staging->setStorageFormat(*storage_format);
+    }
+    return staging;
+  });
+
+  std::future<Texture*> loaded = pending.loaded.get_future();
+  m_pending_textures.push_back(std::move(pending));
+  return loaded;
+}
+
+int TextureManager::processLoadedTextures() {
+  const auto is_decoded = [](const PendingTexture& pending) {
+    return pending.decoded.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+  };
+
+  // A texture loaded several times keeps the image of its last load: its later loads wait for the earlier ones.
+  int                         processed_count = 0;
+  std::vector<const Texture*> still_decoding;
+  for(auto it = m_pending_textures.begin(); it != m_pending_textures.end();) {
+    const bool earlier_load_pending =
+        std::find(still_decoding.begin(), still_decoding.end(), it->target) != still_decoding.end();
+    if(earlier_load_pending || !is_decoded(*it)) {
+      if(it->target != nullptr) {
+        still_decoding.push_back(it->target);
+      }
+      ++it;
+      continue;
+    }
+
+    const std::unique_ptr<Texture> staging = it->decoded.get();
+    if(it->target != nullptr) {
+      it->target->takeImageFrom(*staging);
+    }
+    it->loaded.set_value(it->target);
+    it = m_pending_textures.erase(it);
+    ++processed_count;
+  }
+  return processed_count;
+}
+
+void TextureManager::waitForLoadedTextures() {
+  for(const PendingTexture& pending : m_pending_textures) {
+    pending.decoded.wait();
+  }
+  processLoadedTextures();
+}
+
 void TextureManager::addTexture(const std::string& texture_name) {
   if(m_texture_map.find(texture_name) == m_texture_map.end()) {
     m_texture_map[texture_name] = std::make_unique<Texture>();
@@ -133,6 +216,12 @@ bool TextureManager::renameTexture(const std::string& old_name, const std::strin
 void TextureManager::removeTexture(const std::string& texture_name) {
   auto it = m_texture_map.find(texture_name);
   if(it != m_texture_map.end()) {
+    const Texture* removed = it->second.get();
+    for(PendingTexture& pending : m_pending_textures) {
+      if(pending.target == removed) {
+        pending.target = nullptr;
+      }
+    }
     m_texture_map.erase(it);
     m_texture_removed_observer.notify(texture_name);
   }
@@ -0,0 +1,384 @@
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Core/Color.hpp"
+#include "Core/ImageTypes.hpp"
+#include "Surface/TextureStorage.hpp"
+
+namespace {
+
+// NOLINTBEGIN(readability-magic-numbers)
+constexpr std::uint32_t FLOAT_ABS_MASK       = 0x7FFFFFFFU;
+constexpr std::uint32_t FLOAT_INFINITY_BITS  = 0x7F800000U;
+constexpr std::uint32_t HALF_OVERFLOW_BITS   = 0x47800000U; // 65536.0F, first float rounding past the largest half
+constexpr std::uint32_t HALF_MIN_NORMAL_BITS = 0x38800000U; // 2^-14, smallest normal half
+constexpr std::uint32_t EXPONENT_REBIAS      = 0x38000000U; // (127 - 15) << 23
+constexpr std::uint32_t HALF_SIGN_MASK       = 0x8000U;
+constexpr std::uint32_t HALF_INFINITY        = 0x7C00U;
+constexpr std::uint32_t HALF_QUIET_NAN       = 0x7E00U;
+constexpr std::uint32_t HALF_EXPONENT_MASK   = 0x1FU;
+constexpr std::uint32_t HALF_MANTISSA_MASK   = 0x3FFU;
+constexpr int           MANTISSA_SHIFT       = 13; // 23 - 10 mantissa bits
+constexpr int           HALF_EXPONENT_SHIFT  = 10;
+constexpr int           FLOAT_EXPONENT_SHIFT = 23;
+constexpr int           SIGN_SHIFT           = 16;
+constexpr std::uint32_t EXPONENT_OFFSET      = 112; // 127 - 15
+constexpr float         HALF_SUBNORMAL_SCALE = 16777216.0F; // 2^24
+constexpr int           RGBA_CHANNELS        = 4;
+constexpr std::size_t   ALPHA_CHANNEL        = 3;
+constexpr double        BOX_FILTER_WEIGHT    = 0.25; // 2x2 texels averaged per texel of the next mip level
+// NOLINTEND(readability-magic-numbers)
+
+std::array<double, SRGB_LUT_SIZE> buildSRGBToLinearLut() {
+  std::array<double, SRGB_LUT_SIZE> lut{};
+  for(int i = 0; i < SRGB_LUT_SIZE; ++i) {
+    double value = decodeTexel(static_cast<std::uint8_t>(i));
+    convertToLinearSpace(value);
+    lut[i] = value;
+  }
+  return lut;
+}
+
+template <typename Texel> std::vector<Texel> convertValues(const TextureStorage& storage);
+
+template <> std::vector<std::uint8_t> convertValues<std::uint8_t>(const TextureStorage& storage) {
+  std::vector<std::uint8_t> values(storage.size());
+  for(std::size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<std::uint8_t>(std::lround(std::clamp(storage.load(i), 0.0, 1.0) * COLOR8_MAX_VALUE));
+  }
+  return values;
+}
+
+template <> std::vector<Half> convertValues<Half>(const TextureStorage& storage) {
+  std::vector<Half> values(storage.size());
+  for(std::size_t i = 0; i < values.size(); ++i) {
+    values[i] = Half::FromFloat(static_cast<float>(storage.load(i)));
+  }
+  return values;
+}
+
+template <> std::vector<float> convertValues<float>(const TextureStorage& storage) {
+  std::vector<float> values(storage.size());
+  for(std::size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<float>(storage.load(i));
+  }
+  return values;
+}
+
+template <> std::vector<double> convertValues<double>(const TextureStorage& storage) {
+  std::vector<double> values(storage.size());
+  for(std::size_t i = 0; i < values.size(); ++i) {
+    values[i] = storage.load(i);
+  }
+  return values;
+}
+
+template <typename Texel> void flipTexelRows(std::vector<Texel>& values, int width, int height, int channels) {
+  const std::size_t row_size = static_cast<std::size_t>(width) * static_cast<std::size_t>(channels);
+  for(int y = 0; y < height / 2; ++y) {
+    const auto top    = values.begin() + static_cast<std::ptrdiff_t>(y * row_size);
+    const auto bottom = values.begin() + static_cast<std::ptrdiff_t>((height - 1 - y) * row_size);
+    std::swap_ranges(top, top + static_cast<std::ptrdiff_t>(row_size), bottom);
+  }
+}
+
+template <typename Texel> void convertTexelsToLinearSpace(std::vector<Texel>& values, int channels) {
+  for(std::size_t i = 0; i < values.size(); ++i) {
+    if(channels == RGBA_CHANNELS && i % RGBA_CHANNELS == ALPHA_CHANNEL) {
+      continue;
+    }
+    double value = decodeTexel(values[i]);
+    convertToLinearSpace(value);
+    if constexpr(std::is_same_v<Texel, Half>) {
+      values[i] = Half::FromFloat(static_cast<float>(value));
+    } else {
+      values[i] = static_cast<Texel>(value);
+    }
+  }
+}
+
+template <typename Texel>
+std::vector<Texel> reorderTexels(const std::vector<Texel>& values, const TextureLayout& from, const TextureLayout& to) {
+  std::vector<Texel> reordered(to.getValueCount());
+  for(int y = 0; y < from.resolution.height; ++y) {
+    for(int x = 0; x < from.resolution.width; ++x) {
+      const std::size_t source      = from.getTexelIndex(x, y);
+      const std::size_t destination = to.getTexelIndex(x, y);
+      std::copy_n(values.begin() + static_cast<std::ptrdiff_t>(source), from.channels,
+                  reordered.begin() + static_cast<std::ptrdiff_t>(destination));
+    }
+  }
+  return reordered;
+}
+
+} // namespace
+
+const std::array<double, SRGB_LUT_SIZE> SRGB_TO_LINEAR_LUT = buildSRGBToLinearLut();
+
+Half Half::FromFloat(float value) {
+  const auto          bits      = std::bit_cast<std::uint32_t>(value);
+  const std::uint32_t sign      = (bits >> SIGN_SHIFT) & HALF_SIGN_MASK;
+  const std::uint32_t magnitude = bits & FLOAT_ABS_MASK;
+
+  std::uint32_t result = 0;
+  if(magnitude >= FLOAT_INFINITY_BITS) {
+    result = magnitude > FLOAT_INFINITY_BITS ? HALF_QUIET_NAN : HALF_INFINITY;
+  } else if(magnitude >= HALF_OVERFLOW_BITS) {
+    result = HALF_INFINITY;
+  } else if(magnitude < HALF_MIN_NORMAL_BITS) {
+    result = static_cast<std::uint32_t>(std::nearbyint(std::bit_cast<float>(magnitude) * HALF_SUBNORMAL_SCALE));
+  } else {
+    const std::uint32_t round_to_even = (magnitude >> MANTISSA_SHIFT) & 1U;
+    result = (magnitude - EXPONENT_REBIAS + ((1U << (MANTISSA_SHIFT - 1)) - 1U) + round_to_even) >> MANTISSA_SHIFT;
+  }
+  return {static_cast<std::uint16_t>(sign | result)};
+}
+
+float Half::toFloat() const {
+  const std::uint32_t sign     = (static_cast<std::uint32_t>(bits) & HALF_SIGN_MASK) << SIGN_SHIFT;
+  const std::uint32_t exponent = (static_cast<std::uint32_t>(bits) >> HALF_EXPONENT_SHIFT) & HALF_EXPONENT_MASK;
+  const std::uint32_t mantissa = static_cast<std::uint32_t>(bits) & HALF_MANTISSA_MASK;
+
+  if(exponent == 0) {
+    const float subnormal = static_cast<float>(mantissa) / HALF_SUBNORMAL_SCALE;
+    return sign != 0 ? -subnormal : subnormal;
+  }
+  if(exponent == HALF_EXPONENT_MASK) {
+    return std::bit_cast<float>(sign | FLOAT_INFINITY_BITS | (mantissa << MANTISSA_SHIFT));
+  }
+  return std::bit_cast<float>(sign | ((exponent + EXPONENT_OFFSET) << FLOAT_EXPONENT_SHIFT) |
+                              (mantissa << MANTISSA_SHIFT));
+}
+
+std::size_t TextureLayout::getValueCount() const {
+  if(!tiled) {
+    return static_cast<std::size_t>(resolution.width) * resolution.height * channels;
+  }
+  const std::size_t tile_count_x = (resolution.width + TEXTURE_TILE_MASK) >> TEXTURE_TILE_SHIFT;
+  const std::size_t tile_count_y = (resolution.height + TEXTURE_TILE_MASK) >> TEXTURE_TILE_SHIFT;
+  return ((tile_count_x * tile_count_y) << (2 * TEXTURE_TILE_SHIFT)) * channels;
+}
+
+void TextureStorage::releaseAll() {
+  m_unorm8  = {};
+  m_half    = {};
+  m_float32 = {};
+  m_float64 = {};
+}
+
+std::size_t TextureStorage::size() const {
+  switch(m_format) {
+  case TexelFormat::UNORM8:
+    return m_unorm8.size();
+  case TexelFormat::HALF:
+    return m_half.size();
+  case TexelFormat::FLOAT32:
+    return m_float32.size();
+  default:
+    return m_float64.size();
+  }
+}
+
+std::size_t TextureStorage::getMemorySize() const {
+  switch(m_format) {
+  case TexelFormat::UNORM8:
+    return m_unorm8.size() * sizeof(std::uint8_t);
+  case TexelFormat::HALF:
+    return m_half.size() * sizeof(Half);
+  case TexelFormat::FLOAT32:
+    return m_float32.size() * sizeof(float);
+  default:
+    return m_float64.size() * sizeof(double);
+  }
+}
+
+void TextureStorage::reorder(const TextureLayout& layout) {
+  switch(m_format) {
+  case TexelFormat::UNORM8:
+    m_unorm8 = reorderTexels(m_unorm8, m_layout, layout);
+    break;
+  case TexelFormat::HALF:
+    m_half = reorderTexels(m_half, m_layout, layout);
+    break;
+  case TexelFormat::FLOAT32:
+    m_float32 = reorderTexels(m_float32, m_layout, layout);
+    break;
+  default:
+    m_float64 = reorderTexels(m_float64, m_layout, layout);
+    break;
+  }
+  m_layout = layout;
+}
+
+void TextureStorage::setImageLayout(Resolution resolution, int channels) {
+  m_layout = {resolution, channels, false};
+  if(resolution.width > TEXTURE_TILE_SIZE && resolution.height > TEXTURE_TILE_SIZE) {
+    reorder({resolution, channels, true});
+  }
+}
+
+TextureStorage TextureStorage::toScanlineLayout() const {
+  TextureStorage scanline = *this;
+  if(m_layout.tiled) {
+    scanline.reorder({m_layout.resolution, m_layout.channels, false});
+  }
+  return scanline;
+}
+
+void TextureStorage::setUnorm8(std::vector<std::uint8_t> data) {
+  releaseAll();
+  m_unorm8 = std::move(data);
+  m_format = TexelFormat::UNORM8;
+  m_layout = TextureLayout();
+}
+
+void TextureStorage::setHalf(std::vector<Half> data) {
+  releaseAll();
+  m_half   = std::move(data);
+  m_format = TexelFormat::HALF;
+  m_layout = TextureLayout();
+}
+
+void TextureStorage::setFloat32(std::vector<float> data) {
+  releaseAll();
+  m_float32 = std::move(data);
+  m_format  = TexelFormat::FLOAT32;
+  m_layout  = TextureLayout();
+}
+
+void TextureStorage::setFloat64(std::vector<double> data) {
+  releaseAll();
+  m_float64 = std::move(data);
+  m_format  = TexelFormat::FLOAT64;
+  m_layout  = TextureLayout();
+}
+
+void TextureStorage::convertTo(TexelFormat format) {
+  if(format == m_format) {
+    return;
+  }
+
+  const TextureLayout layout = m_layout;
+
+  switch(format) {
+  case TexelFormat::UNORM8:
+    setUnorm8(convertValues<std::uint8_t>(*this));
+    break;
+  case TexelFormat::HALF:
+    setHalf(convertValues<Half>(*this));
+    break;
+  case TexelFormat::FLOAT32:
+    setFloat32(convertValues<float>(*this));
+    break;
+  default:
+    setFloat64(convertValues<double>(*this));
+    break;
+  }
+  m_layout = layout;
+}
+
+TextureStorage TextureStorage::toLinearSpace(int channels) const {
+  TextureStorage linear = *this;
+  if(linear.m_format == TexelFormat::UNORM8) {
+    linear.convertTo(TexelFormat::HALF);
+  }
+
+  switch(linear.m_format) {
+  case TexelFormat::HALF:
+    convertTexelsToLinearSpace(linear.m_half, channels);
+    break;
+  case TexelFormat::FLOAT32:
+    convertTexelsToLinearSpace(linear.m_float32, channels);
+    break;
+  default:
+    convertTexelsToLinearSpace(linear.m_float64, channels);
+    break;
+  }
+  return linear;
+}
+
+TextureStorage TextureStorage::downsample(bool srgb_encoded) const {
+  const Resolution& resolution  = m_layout.resolution;
+  const int         channels    = m_layout.channels;
+  const bool        srgb_unorm8 = srgb_encoded && m_format == TexelFormat::UNORM8;
+  const auto        is_srgb     = [&](int c) {
+    return srgb_unorm8 && !(channels == RGBA_CHANNELS && c == static_cast<int>(ALPHA_CHANNEL));
+  };
+  const auto load_value = [&](int x, int y, int c) {
+    const std::size_t index = m_layout.getTexelIndex(x, y) + c;
+    return is_srgb(c) ? decodeSRGBTexel(m_unorm8[index]) : load(index);
+  };
+
+  const int           width  = std::max(1, resolution.width / 2);
+  const int           height = std::max(1, resolution.height / 2);
+  std::vector<double> values(static_cast<std::size_t>(width) * height * channels);
+  for(int y = 0; y < height; ++y) {
+    const int y0 = std::min(2 * y, resolution.height - 1);
+    const int y1 = std::min((2 * y) + 1, resolution.height - 1);
+    for(int x = 0; x < width; ++x) {
+      const int x0 = std::min(2 * x, resolution.width - 1);
+      const int x1 = std::min((2 * x) + 1, resolution.width - 1);
+      for(int c = 0; c < channels; ++c) {
+        double value = (load_value(x0, y0, c) + load_value(x1, y0, c) + load_value(x0, y1, c) +
+                        load_value(x1, y1, c)) *
+                       BOX_FILTER_WEIGHT;
+        if(is_srgb(c)) {
+          convertToSRGBSpace(value);
+        }
+        values[((static_cast<std::size_t>(y) * width + x) * channels) + c] = value;
+      }
+    }
+  }
+
+  TextureStorage level;
+  level.setFloat64(std::move(values));
+  level.setImageLayout({width, height}, channels);
+  level.convertTo(m_format);
+  return level;
+}
+
+double TextureStorage::load(std::size_t index) const {
+  switch(m_format) {
+  case TexelFormat::UNORM8:
+    return decodeTexel(m_unorm8[index]);
+  case TexelFormat::HALF:
+    return decodeTexel(m_half[index]);
+  case TexelFormat::FLOAT32:
+    return decodeTexel(m_float32[index]);
+  default:
+    return decodeTexel(m_float64[index]);
+  }
+}
+
+void TextureStorage::flipRows(int width, int height, int channels) {
+  const TextureLayout layout = m_layout;
+  if(layout.tiled) {
+    reorder({layout.resolution, layout.channels, false});
+  }
+
+  switch(m_format) {
+  case TexelFormat::UNORM8:
+    flipTexelRows(m_unorm8, width, height, channels);
+    break;
+  case TexelFormat::HALF:
+    flipTexelRows(m_half, width, height, channels);
+    break;
+  case TexelFormat::FLOAT32:
+    flipTexelRows(m_float32, width, height, channels);
+    break;
+  default:
+    flipTexelRows(m_float64, width, height, channels);
+    break;
+  }
+
+  if(layout.tiled) {
+    reorder(layout);
+  }
+}
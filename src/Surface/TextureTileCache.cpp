@@ -0,0 +1,113 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#include "Surface/TextureStorage.hpp"
+#include "Surface/TextureTileCache.hpp"
+#include "Surface/TiledTextureFile.hpp"
+
+namespace {
+// NOLINTBEGIN(readability-magic-numbers)
+constexpr std::uint64_t HASH_MULTIPLIER = 0x9E3779B97F4A7C15ULL; // 2^64 / golden ratio
+constexpr int           LEVEL_SHIFT     = 56;
+constexpr int           TILE_Y_SHIFT    = 28;
+constexpr int           HASH_SHIFT      = 32;
+// NOLINTEND(readability-magic-numbers)
+} // namespace
+
+std::size_t TextureTileKeyHash::operator()(const TextureTileKey& key) const {
+  const std::uint64_t tile = (static_cast<std::uint64_t>(key.level) << LEVEL_SHIFT) ^
+                             (static_cast<std::uint64_t>(key.tile_y) << TILE_Y_SHIFT) ^
+                             static_cast<std::uint64_t>(key.tile_x);
+  const std::uint64_t hash = (tile ^ (static_cast<std::uint64_t>(key.file_id) << HASH_SHIFT)) * HASH_MULTIPLIER;
+  return static_cast<std::size_t>(hash ^ (hash >> HASH_SHIFT));
+}
+
+TextureTileCache::TextureTileCache(std::size_t memory_budget, int shard_count) : m_memory_budget(memory_budget) {
+  m_shards.resize(std::max(shard_count, 1));
+  for(auto& shard : m_shards) {
+    shard = std::make_unique<Shard>();
+  }
+}
+
+TextureTileCache::Shard& TextureTileCache::getShard(const TextureTileKey& key) const {
+  return *m_shards[TextureTileKeyHash()(key) % m_shards.size()];
+}
+
+void TextureTileCache::evict(Shard& shard) const {
+  const std::size_t shard_budget = m_memory_budget / m_shards.size();
+  while(shard.memory > shard_budget && shard.lru.size() > 1) {
+    const auto entry = shard.entries.find(shard.lru.back());
+    shard.memory -= entry->second.tile->getMemorySize();
+    shard.entries.erase(entry);
+    shard.lru.pop_back();
+  }
+}
+
+std::shared_ptr<const TextureStorage> TextureTileCache::getTile(const TiledTextureFile& file, int level, int tile_x,
+                                                                int tile_y) {
+  const TextureTileKey key{file.getId(), level, tile_x, tile_y};
+  Shard&               shard = getShard(key);
+
+  {
+    const std::lock_guard<std::mutex> lock(shard.mutex);
+    const auto                        found = shard.entries.find(key);
+    if(found != shard.entries.end()) {
+      shard.lru.splice(shard.lru.begin(), shard.lru, found->second.lru_position);
+      ++m_hit_count;
+      return found->second.tile;
+    }
+  }
+
+  ++m_miss_count;
+  TilePtr tile = std::make_shared<const TextureStorage>(file.readTile(level, tile_x, tile_y));
+
+  const std::lock_guard<std::mutex> lock(shard.mutex);
+  const auto                        found = shard.entries.find(key);
+  if(found != shard.entries.end()) {
+    // Another worker read the same tile meanwhile, keep a single copy.
+    return found->second.tile;
+  }
+  shard.lru.push_front(key);
+  shard.entries.emplace(key, Entry{tile, shard.lru.begin()});
+  shard.memory += tile->getMemorySize();
+  evict(shard);
+  return tile;
+}
+
+void TextureTileCache::setMemoryBudget(std::size_t memory_budget) {
+  m_memory_budget = memory_budget;
+  for(const auto& shard : m_shards) {
+    const std::lock_guard<std::mutex> lock(shard->mutex);
+    evict(*shard);
+  }
+}
+
+std::size_t TextureTileCache::getMemoryUsage() const {
+  std::size_t memory = 0;
+  for(const auto& shard : m_shards) {
+    const std::lock_guard<std::mutex> lock(shard->mutex);
+    memory += shard->memory;
+  }
+  return memory;
+}
+
+std::size_t TextureTileCache::getTileCount() const {
+  std::size_t count = 0;
+  for(const auto& shard : m_shards) {
+    const std::lock_guard<std::mutex> lock(shard->mutex);
+    count += shard->entries.size();
+  }
+  return count;
+}
+
+void TextureTileCache::clear() {
+  for(const auto& shard : m_shards) {
+    const std::lock_guard<std::mutex> lock(shard->mutex);
+    shard->lru.clear();
+    shard->entries.clear();
+    shard->memory = 0;
+  }
+}
@@ -0,0 +1,246 @@
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Core/ImageTypes.hpp"
+#include "Surface/TextureFiltering.hpp"
+#include "Surface/TextureLoader.hpp"
+#include "Surface/TextureStorage.hpp"
+#include "Surface/TiledTextureFile.hpp"
+
+namespace {
+
+constexpr std::uint32_t LTEX_MAGIC     = 0x5845544CU; // "LTEX" read as a little-endian word
+constexpr std::uint32_t LTEX_VERSION   = 1;
+constexpr int           MAX_CHANNELS   = 4;
+constexpr const char*   LTEX_EXTENSION = ".ltex";
+
+struct FileHeader {
+  std::uint32_t magic       = LTEX_MAGIC;
+  std::uint32_t version     = LTEX_VERSION;
+  std::uint32_t format      = 0;
+  std::uint32_t channels    = 0;
+  std::uint32_t width       = 0;
+  std::uint32_t height      = 0;
+  std::uint32_t level_count = 0;
+  std::uint32_t tile_size   = 0;
+};
+
+std::atomic<std::uint32_t> next_file_id{1};
+
+std::size_t getValueSize(TexelFormat format) {
+  switch(format) {
+  case TexelFormat::UNORM8:
+    return sizeof(std::uint8_t);
+  case TexelFormat::HALF:
+    return sizeof(Half);
+  case TexelFormat::FLOAT32:
+    return sizeof(float);
+  default:
+    return sizeof(double);
+  }
+}
+
+int getTileCount(int size, int tile_size) { return (size + tile_size - 1) / tile_size; }
+
+int countLevels(Resolution resolution) {
+  int level_count = 1;
+  while(resolution.width > 1 || resolution.height > 1) {
+    resolution = TextureSampling::getMipResolution(resolution, 1);
+    ++level_count;
+  }
+  return level_count;
+}
+
+template <typename Texel>
+void writeTiles(std::ofstream& file, const Texel* data, const TextureLayout& layout, int tile_size) {
+  const int width    = layout.resolution.width;
+  const int height   = layout.resolution.height;
+  const int channels = layout.channels;
+
+  std::vector<Texel> tile(static_cast<std::size_t>(tile_size) * tile_size * channels);
+  for(int tile_y = 0; tile_y < getTileCount(height, tile_size); ++tile_y) {
+    for(int tile_x = 0; tile_x < getTileCount(width, tile_size); ++tile_x) {
+      auto out = tile.begin();
+      for(int y = 0; y < tile_size; ++y) {
+        const int source_y = std::min((tile_y * tile_size) + y, height - 1);
+        for(int x = 0; x < tile_size; ++x) {
+          const int source_x = std::min((tile_x * tile_size) + x, width - 1);
+          out = std::copy_n(data + layout.getTexelIndex(source_x, source_y), channels, out);
+        }
+      }
+      file.write(reinterpret_cast<const char*>(tile.data()), static_cast<std::streamsize>(tile.size() * sizeof(Texel)));
+    }
+  }
+}
+
+void writeLevel(std::ofstream& file, const TextureStorage& level, int tile_size) {
+  switch(level.getFormat()) {
+  case TexelFormat::UNORM8:
+    writeTiles(file, level.data<std::uint8_t>(), level.getLayout(), tile_size);
+    break;
+  case TexelFormat::HALF:
+    writeTiles(file, level.data<Half>(), level.getLayout(), tile_size);
+    break;
+  case TexelFormat::FLOAT32:
+    writeTiles(file, level.data<float>(), level.getLayout(), tile_size);
+    break;
+  default:
+    writeTiles(file, level.data<double>(), level.getLayout(), tile_size);
+    break;
+  }
+}
+
+template <typename Texel> std::vector<Texel> readValues(std::ifstream& stream, std::size_t count) {
+  std::vector<Texel> values(count);
+  stream.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(count * sizeof(Texel)));
+  if(!stream) {
+    std::fill(values.begin(), values.end(), Texel{});
+  }
+  return values;
+}
+
+} // namespace
+
+bool TiledTextureFile::HasTiledExtension(const std::string& path) {
+  const std::string extension = std::filesystem::path(path).extension().string();
+  return std::equal(extension.begin(), extension.end(), LTEX_EXTENSION, LTEX_EXTENSION + std::strlen(LTEX_EXTENSION),
+                    [](char a, char b) { return std::tolower(static_cast<unsigned char>(a)) == b; });
+}
+
+std::shared_ptr<const TiledTextureFile> TiledTextureFile::Open(const std::string& path) {
+  std::shared_ptr<TiledTextureFile> file(new TiledTextureFile());
+  file->m_stream.open(path, std::ios::binary);
+  if(!file->m_stream) {
+    std::cerr << "Error opening tiled texture: cannot read " << path << '\n';
+    return nullptr;
+  }
+
+  FileHeader header;
+  file->m_stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+  const Resolution resolution{static_cast<int>(header.width), static_cast<int>(header.height)};
+  if(!file->m_stream || header.magic != LTEX_MAGIC || header.version != LTEX_VERSION ||
+     header.format > static_cast<std::uint32_t>(TexelFormat::FLOAT64) || header.channels == 0 ||
+     header.channels > MAX_CHANNELS || header.width == 0 || header.height == 0 || header.tile_size == 0 ||
+     static_cast<int>(header.level_count) != countLevels(resolution)) {
+    std::cerr << "Error opening tiled texture: invalid header in " << path << '\n';
+    return nullptr;
+  }
+
+  file->m_path        = path;
+  file->m_id          = next_file_id++;
+  file->m_format      = static_cast<TexelFormat>(header.format);
+  file->m_properties  = {resolution.width, resolution.height, static_cast<int>(header.channels)};
+  file->m_level_count = static_cast<int>(header.level_count);
+  file->m_tile_size   = static_cast<int>(header.tile_size);
+  file->m_tile_bytes  = static_cast<std::size_t>(file->m_tile_size) * file->m_tile_size * header.channels *
+                       getValueSize(file->m_format);
+
+  std::uint64_t offset = sizeof(FileHeader);
+  for(int level = 0; level < file->m_level_count; ++level) {
+    file->m_level_offsets.push_back(offset);
+    const Resolution level_resolution = file->getLevelResolution(level);
+    offset += static_cast<std::uint64_t>(getTileCount(level_resolution.width, file->m_tile_size)) *
+              getTileCount(level_resolution.height, file->m_tile_size) * file->m_tile_bytes;
+  }
+  return file;
+}
+
+bool TiledTextureFile::Write(const std::string& path, const TextureStorage& image, bool srgb_encoded,
+                             int tile_size) {
+  const TextureLayout& layout = image.getLayout();
+  if(tile_size <= 0 || image.size() == 0 || layout.getValueCount() != image.size()) {
+    std::cerr << "Error writing tiled texture: invalid image for " << path << '\n';
+    return false;
+  }
+
+  std::ofstream file(path, std::ios::binary);
+  if(!file) {
+    std::cerr << "Error writing tiled texture: cannot open " << path << '\n';
+    return false;
+  }
+
+  FileHeader header;
+  header.format      = static_cast<std::uint32_t>(image.getFormat());
+  header.channels    = static_cast<std::uint32_t>(layout.channels);
+  header.width       = static_cast<std::uint32_t>(layout.resolution.width);
+  header.height      = static_cast<std::uint32_t>(layout.resolution.height);
+  header.level_count = static_cast<std::uint32_t>(countLevels(layout.resolution));
+  header.tile_size   = static_cast<std::uint32_t>(tile_size);
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  writeLevel(file, image, tile_size);
+  TextureStorage level = image;
+  for(std::uint32_t i = 1; i < header.level_count; ++i) {
+    level = level.downsample(srgb_encoded);
+    writeLevel(file, level, tile_size);
+  }
+
+  if(!file) {
+    std::cerr << "Error writing tiled texture: write failed for " << path << '\n';
+    return false;
+  }
+  return true;
+}
+
+bool TiledTextureFile::Convert(const std::string& image_path, const std::string& output_path, bool srgb_encoded) {
+  if(!std::filesystem::exists(image_path)) {
+    std::cerr << "Error converting texture: " << image_path << " does not exist" << '\n';
+    return false;
+  }
+
+  TextureStorage  image;
+  ImageProperties properties;
+  TextureLoader::load(image_path.c_str(), image, properties);
+  image.setImageLayout({properties.width, properties.height}, properties.channels);
+  return Write(output_path, image, srgb_encoded);
+}
+
+Resolution TiledTextureFile::getLevelResolution(int level) const {
+  return TextureSampling::getMipResolution({m_properties.width, m_properties.height}, level);
+}
+
+TextureStorage TiledTextureFile::readTile(int level, int tile_x, int tile_y) const {
+  const Resolution  resolution   = getLevelResolution(level);
+  const int         tile_count_x = getTileCount(resolution.width, m_tile_size);
+  const std::size_t value_count  = static_cast<std::size_t>(m_tile_size) * m_tile_size * m_properties.channels;
+  const std::uint64_t offset =
+      m_level_offsets[level] + ((static_cast<std::uint64_t>(tile_y) * tile_count_x) + tile_x) * m_tile_bytes;
+
+  TextureStorage tile;
+  {
+    const std::lock_guard<std::mutex> lock(m_stream_mutex);
+    m_stream.clear();
+    m_stream.seekg(static_cast<std::streamoff>(offset));
+    switch(m_format) {
+    case TexelFormat::UNORM8:
+      tile.setUnorm8(readValues<std::uint8_t>(m_stream, value_count));
+      break;
+    case TexelFormat::HALF:
+      tile.setHalf(readValues<Half>(m_stream, value_count));
+      break;
+    case TexelFormat::FLOAT32:
+      tile.setFloat32(readValues<float>(m_stream, value_count));
+      break;
+    default:
+      tile.setFloat64(readValues<double>(m_stream, value_count));
+      break;
+    }
+    if(!m_stream) {
+      std::cerr << "Error reading tiled texture: truncated tile in " << m_path << '\n';
+    }
+  }
+
+  tile.setImageLayout({m_tile_size, m_tile_size}, m_properties.channels);
+  return tile;
+}
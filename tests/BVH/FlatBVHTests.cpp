@@ -0,0 +1,53 @@
+#include "BVH/FlatBVH.hpp"
+#include "Geometry/Mesh.hpp"
+#include "Geometry/SphereMeshBuilder.hpp"
+
+#include <gtest/gtest.h>
+
+namespace {
+
+void expectSameTree(const BVHNode* expected, const BVHNode* actual) {
+  ASSERT_NE(actual, nullptr);
+  EXPECT_EQ(actual->getLeafIndex(), expected->getLeafIndex());
+  EXPECT_EQ(actual->getMinBound(), expected->getMinBound());
+  EXPECT_EQ(actual->getMaxBound(), expected->getMaxBound());
+  EXPECT_EQ(actual->getCenter(), expected->getCenter());
+  if(expected->getLeafIndex() < 0) {
+    expectSameTree(expected->getLeftChild().get(), actual->getLeftChild().get());
+    expectSameTree(expected->getRightChild().get(), actual->getRightChild().get());
+  }
+}
+
+} // namespace
+
+TEST(FlatBVHTest, RoundTripKeepsTheTreeBitForBit) {
+  Mesh mesh = SphereMeshBuilder(1.0, 16, 8).build();
+  mesh.buildBVH();
+
+  const std::vector<FlatBVHNode> nodes = BVH::flatten(mesh.getBVHRoot());
+  ASSERT_EQ(nodes.size(), 2 * mesh.getFaces().size() - 1);
+  EXPECT_EQ(nodes[0].leaf_index, -1);
+
+  const std::shared_ptr<BVHNode> root = BVH::unflatten(nodes.data(), nodes.size());
+  expectSameTree(mesh.getBVHRoot(), root.get());
+}
+
+TEST(FlatBVHTest, EmptyTree) {
+  EXPECT_TRUE(BVH::flatten(nullptr).empty());
+  EXPECT_EQ(BVH::unflatten(nullptr, 0), nullptr);
+}
+
+TEST(FlatBVHTest, RejectsInconsistentNodes) {
+  std::vector<FlatBVHNode> nodes(3);
+  nodes[1].leaf_index  = 0;
+  nodes[2].leaf_index  = 1;
+  nodes[0].right_child = 2;
+  EXPECT_NE(BVH::unflatten(nodes.data(), nodes.size()), nullptr);
+
+  nodes[0].right_child = 5;
+  EXPECT_EQ(BVH::unflatten(nodes.data(), nodes.size()), nullptr);
+
+  nodes[0].right_child = 2;
+  nodes[2].leaf_index  = -1; // Inner node without children.
+  EXPECT_EQ(BVH::unflatten(nodes.data(), nodes.size()), nullptr);
+}
@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "Core/ThreadPool.hpp"
+
+TEST(ThreadPoolTest, RunsJobsAndReturnsResults) {
+  ThreadPool pool(4);
+  EXPECT_EQ(pool.getThreadCount(), 4U);
+
+  std::vector<std::future<int>> results;
+  for(int i = 0; i < 100; ++i) {
+    results.push_back(pool.submit([i]() { return i * i; }));
+  }
+  for(int i = 0; i < 100; ++i) {
+    EXPECT_EQ(results[i].get(), i * i);
+  }
+}
+
+TEST(ThreadPoolTest, UsesAtLeastOneThread) {
+  ThreadPool pool(0);
+  EXPECT_EQ(pool.getThreadCount(), 1U);
+  EXPECT_EQ(pool.submit([]() { return 7; }).get(), 7);
+}
+
+TEST(ThreadPoolTest, ForwardsExceptions) {
+  ThreadPool       pool(2);
+  std::future<int> result = pool.submit([]() -> int { throw std::runtime_error("decode failed"); });
+  EXPECT_THROW(result.get(), std::runtime_error);
+}
+
+TEST(ThreadPoolTest, DestructorRunsQueuedJobs) {
+  std::atomic<int> run_count{0};
+  {
+    ThreadPool pool(2);
+    for(int i = 0; i < 50; ++i) {
+      pool.submit([&run_count]() {
+        std::this_thread::yield();
+        ++run_count;
+      });
+    }
+  }
+  EXPECT_EQ(run_count, 50);
+}
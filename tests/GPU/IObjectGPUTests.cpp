@@ -11,9 +11,8 @@ public:
     void uploadToGPU() override { }
     void release() override {}
 
-    using IObjectGPU::vertices;
-    using IObjectGPU::indices;
-    using IObjectGPU::dataSize;
+    using IObjectGPU::vertexStreams;
+    using IObjectGPU::faces;
     using IObjectGPU::indicesSize;
 };
 
@@ -65,22 +64,24 @@ TEST_F(IObjectGPUTest, InitializationTest) {
 TEST_F(IObjectGPUTest, VertexAndIndexDataTest) {
     TestObjectGPU gpuObject(&object);
 
-    const std::vector<float>& vertices = gpuObject.vertices();
-    const std::vector<unsigned int>& indices = gpuObject.indices();
+    const VertexStreams& streams = gpuObject.vertexStreams();
+    const std::vector<Face>& faces = gpuObject.faces();
 
-    EXPECT_EQ(indices.size(), 3u);
-    EXPECT_EQ(vertices.size(), 3u * Vertex::ValuePerVertex());
+    ASSERT_EQ(faces.size(), 1u);
+    EXPECT_EQ(streams.size(), 3u);
+    EXPECT_EQ(streams.normals.size(), 3u);
+    EXPECT_EQ(streams.uvs.size(), 3u);
+    EXPECT_TRUE(streams.tangents.empty()); // built only for normal mapping
 
-    EXPECT_EQ(indices[0], 0u);
-    EXPECT_EQ(indices[1], 1u);
-    EXPECT_EQ(indices[2], 2u);
+    EXPECT_EQ(faces[0].vertex_indices[0], 0);
+    EXPECT_EQ(faces[0].vertex_indices[1], 1);
+    EXPECT_EQ(faces[0].vertex_indices[2], 2);
 
-    EXPECT_EQ(gpuObject.dataSize(), 3u * Vertex::ValuePerVertex() * sizeof(float));
     EXPECT_EQ(gpuObject.indicesSize(), 3u * sizeof(unsigned int));
 
-    EXPECT_FLOAT_EQ(vertices[0], 1.0f); // x
-    EXPECT_FLOAT_EQ(vertices[1], 0.0f); // y
-    EXPECT_FLOAT_EQ(vertices[2], 0.0f); // z
+    EXPECT_FLOAT_EQ(streams.positions[0].x, 1.0f);
+    EXPECT_FLOAT_EQ(streams.positions[0].y, 0.0f);
+    EXPECT_FLOAT_EQ(streams.positions[0].z, 0.0f);
 }
 
 TEST_F(IObjectGPUTest, GetSourceTest) {
@@ -0,0 +1,46 @@
+#include "Geometry/DiskMeshBuilder.hpp"
+#include "Geometry/Mesh.hpp"
+
+#include <cmath>
+#include <gtest/gtest.h>
+
+TEST(DiskMeshBuilderTest, BuildFan) {
+    DiskMeshBuilder builder(2.0, 8);
+    Mesh mesh = builder.build();
+
+    EXPECT_EQ(mesh.getVertexCount(), 9);
+    EXPECT_EQ(mesh.getFaces().size(), 8);
+    EXPECT_EQ(mesh.getVertex(0).position, linalg::Vec3d(0.0, 0.0, 0.0));
+    for (int i = 1; i < 9; ++i) {
+        const linalg::Vec3d position = mesh.getVertex(i).position;
+        EXPECT_NEAR(std::sqrt(position.x * position.x + position.z * position.z), 2.0, 1e-6);
+        EXPECT_DOUBLE_EQ(position.y, 0.0);
+    }
+}
+
+TEST(DiskMeshBuilderTest, FacesPointUp) {
+    DiskMeshBuilder builder(1.0, 16);
+    Mesh mesh = builder.build();
+
+    for (const Face& face : mesh.getFaces()) {
+        const linalg::Vec3d p0 = mesh.getVertex(face.vertex_indices[0]).position;
+        const linalg::Vec3d p1 = mesh.getVertex(face.vertex_indices[1]).position;
+        const linalg::Vec3d p2 = mesh.getVertex(face.vertex_indices[2]).position;
+        EXPECT_GT((p1 - p0).cross(p2 - p0).y, 0.0);
+    }
+}
+
+TEST(DiskMeshBuilderTest, BuildVertexUVs) {
+    DiskMeshBuilder builder(2.0, 4);
+    Mesh mesh = builder.build();
+
+    EXPECT_NEAR(mesh.getVertex(0).uv_coord.u, 2.0, 1e-6);
+    EXPECT_NEAR(mesh.getVertex(0).uv_coord.v, 2.0, 1e-6);
+    EXPECT_NEAR(mesh.getVertex(1).uv_coord.u, 4.0, 1e-6);
+    EXPECT_NEAR(mesh.getVertex(1).uv_coord.v, 2.0, 1e-6);
+}
+
+TEST(DiskMeshBuilderTest, InvalidParameters) {
+    EXPECT_EQ(DiskMeshBuilder(0.0, 8).build().getVertexCount(), 0);
+    EXPECT_EQ(DiskMeshBuilder(1.0, 2).build().getVertexCount(), 0);
+}
@@ -0,0 +1,104 @@
+#include "BVH/BVHNode.hpp"
+#include "Geometry/Mesh.hpp"
+#include "Geometry/MeshCache.hpp"
+#include "Geometry/OBJLoader.hpp"
+#include "Geometry/SphereMeshBuilder.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <string>
+
+class MeshCacheTest : public ::testing::Test {
+protected:
+  std::string cache_path = "mesh_cache_test.lmesh";
+  std::string obj_path   = "mesh_cache_test.obj";
+
+  void TearDown() override {
+    std::remove(cache_path.c_str());
+    std::remove(obj_path.c_str());
+  }
+
+  void writeObj(const std::string& content) const {
+    std::ofstream file(obj_path);
+    file << content;
+  }
+};
+
+TEST_F(MeshCacheTest, CachePathReplacesTheExtension) {
+  EXPECT_EQ(MeshCache::getCachePath("models/bunny.obj"), std::filesystem::path("models/bunny.lmesh").string());
+}
+
+TEST_F(MeshCacheTest, HashDependsOnEveryByte) {
+  EXPECT_EQ(MeshCache::hashSource("v 1 2 3\n"), MeshCache::hashSource("v 1 2 3\n"));
+  EXPECT_NE(MeshCache::hashSource("v 1 2 3\n"), MeshCache::hashSource("v 1 2 4\n"));
+  EXPECT_NE(MeshCache::hashSource("v 1 2 3 0.0000"), MeshCache::hashSource("v 1 2 3 0.00000"));
+  EXPECT_NE(MeshCache::hashSource(""), MeshCache::hashSource(std::string(1, '\0')));
+}
+
+TEST_F(MeshCacheTest, RoundTripKeepsVerticesFacesAndBVH) {
+  Mesh mesh = SphereMeshBuilder(1.0, 16, 8).build();
+  mesh.buildTangents();
+  ASSERT_TRUE(MeshCache::write(cache_path, mesh, 42));
+  ASSERT_NE(mesh.getBVHRoot(), nullptr);
+
+  const std::optional<Mesh> cached = MeshCache::read(cache_path, 42);
+  ASSERT_TRUE(cached.has_value());
+  EXPECT_EQ(*cached, mesh);
+  EXPECT_EQ(cached->getStreams().tangents, mesh.getStreams().tangents);
+  EXPECT_EQ(cached->getStreams().bitangent_signs, mesh.getStreams().bitangent_signs);
+  EXPECT_EQ(cached->getVertexPosition(5), mesh.getVertexPosition(5));
+  ASSERT_NE(cached->getBVHRoot(), nullptr);
+  EXPECT_EQ(cached->getBVHRoot()->getMinBound(), mesh.getBVHRoot()->getMinBound());
+  EXPECT_EQ(cached->getBVHRoot()->getMaxBound(), mesh.getBVHRoot()->getMaxBound());
+}
+
+TEST_F(MeshCacheTest, RoundTripWithoutTangents) {
+  Mesh mesh = SphereMeshBuilder(1.0, 8, 4).build();
+  ASSERT_TRUE(MeshCache::write(cache_path, mesh, 7));
+
+  std::optional<Mesh> cached = MeshCache::read(cache_path, 7);
+  ASSERT_TRUE(cached.has_value());
+  EXPECT_EQ(*cached, mesh);
+  EXPECT_FALSE(cached->hasTangents());
+
+  cached->buildTangents();
+  mesh.buildTangents();
+  EXPECT_EQ(cached->getStreams().tangents, mesh.getStreams().tangents);
+}
+
+TEST_F(MeshCacheTest, RejectsStaleMissingAndTruncatedFiles) {
+  Mesh mesh = SphereMeshBuilder(1.0, 8, 4).build();
+  ASSERT_TRUE(MeshCache::write(cache_path, mesh, 1));
+
+  EXPECT_FALSE(MeshCache::read(cache_path, 2).has_value());
+  EXPECT_FALSE(MeshCache::read("missing_cache.lmesh", 1).has_value());
+
+  std::filesystem::resize_file(cache_path, std::filesystem::file_size(cache_path) - 1);
+  EXPECT_FALSE(MeshCache::read(cache_path, 1).has_value());
+}
+
+TEST_F(MeshCacheTest, LoaderWritesThenReadsTheCache) {
+  writeObj("v 0 0 0\nv 1 0 0\nv 0 1 0\nv 1 1 0\nf 1 2 3 4\n");
+
+  const Mesh parsed = OBJLoader::load(obj_path);
+  ASSERT_EQ(parsed.getFaces().size(), 2);
+  ASSERT_TRUE(std::filesystem::exists(cache_path));
+
+  // A forged cache for the same source proves that the second load does not parse the file again.
+  Mesh forged({Vertex{}, Vertex{}, Vertex{}}, {Face{{0, 1, 2}}});
+  std::ifstream source(obj_path);
+  const std::string content((std::istreambuf_iterator<char>(source)), std::istreambuf_iterator<char>());
+  ASSERT_TRUE(MeshCache::write(cache_path, forged, MeshCache::hashSource(content)));
+  EXPECT_EQ(OBJLoader::load(obj_path).getFaces().size(), 1);
+  EXPECT_EQ(OBJLoader::load(obj_path, false).getFaces().size(), 2);
+
+  // Editing the source invalidates the cache, which is rewritten.
+  writeObj("v 0 0 0\nv 1 0 0\nv 0 1 0\nv 1 1 0\nv 2 2 0\nf 1 2 3 4 5\n");
+  EXPECT_EQ(OBJLoader::load(obj_path).getFaces().size(), 3);
+  EXPECT_EQ(OBJLoader::load(obj_path).getFaces().size(), 3);
+}
@@ -0,0 +1,223 @@
+#include "Core/Config.hpp"
+#include "Core/MathConstants.hpp"
+#include "Geometry/Mesh.hpp"
+#include "Geometry/MeshSimplifier.hpp"
+#include "Geometry/SphereMeshBuilder.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <linalg/Vec3.hpp>
+#include <map>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Closed torus sharing the vertices of its wrapping rows and columns: every edge has two faces.
+Mesh buildTorus(int rings, int sides) {
+  constexpr double major_radius = 2.0;
+  constexpr double minor_radius = 0.5;
+
+  std::vector<Vertex> vertices;
+  std::vector<Face>   faces;
+  for(int i = 0; i < rings; ++i) {
+    const double phi = TWO_PI * i / rings;
+    for(int j = 0; j < sides; ++j) {
+      const double        theta  = TWO_PI * j / sides;
+      const linalg::Vec3d normal = {std::cos(theta) * std::cos(phi), std::sin(theta), std::cos(theta) * std::sin(phi)};
+      const linalg::Vec3d center = {major_radius * std::cos(phi), 0.0, major_radius * std::sin(phi)};
+      vertices.push_back({center + normal * minor_radius, normal, {static_cast<double>(i) / rings, 0.0}});
+    }
+  }
+  for(int i = 0; i < rings; ++i) {
+    for(int j = 0; j < sides; ++j) {
+      const int a = i * sides + j;
+      const int b = ((i + 1) % rings) * sides + j;
+      const int c = ((i + 1) % rings) * sides + (j + 1) % sides;
+      const int d = i * sides + (j + 1) % sides;
+      faces.push_back({{a, d, c}});
+      faces.push_back({{a, c, b}});
+    }
+  }
+  return {std::move(vertices), std::move(faces)};
+}
+
+// Flat grid in the XZ plane facing +Y, with an open border.
+Mesh buildGrid(int size) {
+  std::vector<Vertex> vertices;
+  std::vector<Face>   faces;
+  for(int z = 0; z <= size; ++z) {
+    for(int x = 0; x <= size; ++x) {
+      vertices.push_back({{static_cast<double>(x), 0.0, static_cast<double>(z)},
+                          {0.0, 1.0, 0.0},
+                          {static_cast<double>(x) / size, static_cast<double>(z) / size}});
+    }
+  }
+  for(int z = 0; z < size; ++z) {
+    for(int x = 0; x < size; ++x) {
+      const int corner = z * (size + 1) + x;
+      faces.push_back({{corner, corner + size + 1, corner + size + 2}});
+      faces.push_back({{corner, corner + size + 2, corner + 1}});
+    }
+  }
+  return {std::move(vertices), std::move(faces)};
+}
+
+bool isBorder(const linalg::Vec3f& position, float size) {
+  return position.x == 0.0F || position.z == 0.0F || position.x == size || position.z == size;
+}
+
+} // namespace
+
+TEST(MeshSimplifierTest, SimplifiesClosedMeshToTarget) {
+  const Mesh torus      = buildTorus(64, 32);
+  const Mesh simplified = MeshSimplifier::simplify(torus, 1000);
+
+  EXPECT_LE(simplified.getFaces().size(), 1000U);
+  EXPECT_GT(simplified.getFaces().size(), 900U);
+  // Closed surface: V - E + F = 0 for a torus, with E = 3F / 2.
+  EXPECT_EQ(simplified.getVertexCount() * 2, simplified.getFaces().size());
+
+  // The simplified vertices are vertices of the torus, the surface keeps its shape.
+  for(const linalg::Vec3f& position : simplified.getStreams().positions) {
+    const double ring_distance = std::hypot(std::hypot(position.x, position.z) - 2.0, position.y);
+    EXPECT_NEAR(ring_distance, 0.5, 1e-5);
+  }
+  EXPECT_NEAR(simplified.getMaxBound().x, torus.getMaxBound().x, 0.05);
+  EXPECT_NEAR(simplified.getMaxBound().y, torus.getMaxBound().y, 0.05);
+}
+
+TEST(MeshSimplifierTest, KeepsOrientationOfFaces) {
+  const Mesh simplified = MeshSimplifier::simplify(buildGrid(32), 100);
+  ASSERT_LT(simplified.getFaces().size(), 2048U);
+
+  for(const Face& face : simplified.getFaces()) {
+    const linalg::Vec3d p0(simplified.getVertexPosition(face.vertex_indices[0]));
+    const linalg::Vec3d p1(simplified.getVertexPosition(face.vertex_indices[1]));
+    const linalg::Vec3d p2(simplified.getVertexPosition(face.vertex_indices[2]));
+    EXPECT_GT((p1 - p0).cross(p2 - p0).y, 0.0);
+  }
+}
+
+TEST(MeshSimplifierTest, KeepsOpenBorders) {
+  const int  size       = 16;
+  const Mesh simplified = MeshSimplifier::simplify(buildGrid(size), 0, 1e-6);
+
+  // Flat and square: the border vertices slide along the straight sides down to the corners.
+  EXPECT_LT(simplified.getFaces().size(), 8U);
+  EXPECT_EQ(simplified.getMinBound(), linalg::Vec3d(0.0, 0.0, 0.0));
+  EXPECT_EQ(simplified.getMaxBound(), linalg::Vec3d(size, 0.0, size));
+  for(const linalg::Vec3f& position : simplified.getStreams().positions) {
+    EXPECT_TRUE(isBorder(position, size));
+  }
+
+  double area = 0.0;
+  for(const Face& face : simplified.getFaces()) {
+    const linalg::Vec3d p0(simplified.getVertexPosition(face.vertex_indices[0]));
+    const linalg::Vec3d p1(simplified.getVertexPosition(face.vertex_indices[1]));
+    const linalg::Vec3d p2(simplified.getVertexPosition(face.vertex_indices[2]));
+    area += (p1 - p0).cross(p2 - p0).length() * HALF;
+  }
+  EXPECT_NEAR(area, size * size, 1e-6);
+}
+
+TEST(MeshSimplifierTest, KeepsSeamsClosed) {
+  const Mesh sphere     = SphereMeshBuilder(1.0, 32, 16).build();
+  const Mesh simplified = MeshSimplifier::simplify(sphere, 200);
+  EXPECT_LE(simplified.getFaces().size(), 200U);
+
+  // Welded by position, every edge has two faces: the texture seam and the poles have no crack.
+  const auto key = [&simplified](int index) {
+    const linalg::Vec3f& p = simplified.getVertexPosition(index);
+    return std::array<long, 3>{std::lround(p.x * 1e4), std::lround(p.y * 1e4), std::lround(p.z * 1e4)};
+  };
+  std::map<std::pair<std::array<long, 3>, std::array<long, 3>>, int> edge_faces;
+  for(const Face& face : simplified.getFaces()) {
+    for(int i = 0; i < 3; ++i) {
+      ++edge_faces[std::minmax(key(face.vertex_indices[i]), key(face.vertex_indices[(i + 1) % 3]))];
+    }
+  }
+  for(const auto& [edge, count] : edge_faces) {
+    EXPECT_EQ(count, 2);
+  }
+}
+
+TEST(MeshSimplifierTest, KeepsTangents) {
+  Mesh grid = buildGrid(8);
+  grid.buildTangents();
+
+  const Mesh simplified = MeshSimplifier::simplify(grid, 10);
+  ASSERT_TRUE(simplified.hasTangents());
+  EXPECT_NEAR(simplified.getVertexTangent(0).x, 1.0, 1e-3);
+}
+
+TEST(MeshSimplifierTest, BuildsDecreasingLevels) {
+  EXPECT_TRUE(MeshSimplifier::buildLevels(buildGrid(4)).empty());
+
+  const Mesh torus  = buildTorus(64, 32);
+  const auto levels = MeshSimplifier::buildLevels(torus);
+  ASSERT_FALSE(levels.empty());
+  EXPECT_LE(levels.size(), LOD_MAX_LEVELS);
+
+  std::size_t previous = torus.getFaces().size();
+  for(const auto& level : levels) {
+    EXPECT_LE(static_cast<double>(level->getFaces().size()), static_cast<double>(previous) * LOD_MAX_KEPT_RATIO);
+    EXPECT_GE(level->getFaces().size(), LOD_MIN_FACES / 2);
+    previous = level->getFaces().size();
+  }
+}
+
+TEST(MeshSimplifierTest, SelectsLevelsOfDetail) {
+  Mesh torus = buildTorus(64, 32);
+  EXPECT_EQ(torus.getLODCount(), 1U);
+  EXPECT_EQ(&torus.getLOD(2), &torus);
+
+  torus.buildBVH();
+  torus.buildLODs();
+  const std::size_t count = torus.getLODCount();
+  ASSERT_GT(count, 2U);
+  EXPECT_NE(torus.getLOD(1).getBVHRoot(), nullptr);
+  EXPECT_EQ(&torus.getLOD(count + 3), &torus.getLOD(count - 1));
+
+  // Large on screen: full mesh; tiny on screen: coarsest level.
+  EXPECT_EQ(torus.selectLODForScreenRadius(1e4), 0U);
+  EXPECT_EQ(torus.selectLODForScreenRadius(1.0), count - 1);
+  const std::size_t middle = torus.selectLODForScreenRadius(40.0);
+  EXPECT_LE(static_cast<double>(torus.getLOD(middle).getFaces().size()), PI * 40.0 * 40.0 / LOD_PIXELS_PER_FACE);
+
+  EXPECT_EQ(torus.selectLODForDistance(100.0, 0.0), 0U);
+  EXPECT_EQ(torus.selectLODForDistance(5.0, 10.0), 0U);
+  EXPECT_EQ(torus.selectLODForDistance(10.0, 10.0), 1U);
+  EXPECT_EQ(torus.selectLODForDistance(25.0, 10.0), 2U);
+  EXPECT_EQ(torus.selectLODForDistance(1e9, 10.0), count - 1);
+}
+
+TEST(MeshSimplifierTest, ConcurrentBuildsPublishCompleteLevels) {
+  Mesh torus = buildTorus(64, 32);
+
+  // The viewport builds the levels while the renderer builds the BVH: every published level has its BVH.
+  std::vector<std::thread> threads;
+  for(int i = 0; i < 4; ++i) {
+    threads.emplace_back([&torus, i]() {
+      if(i % 2 == 0) {
+        torus.buildLODs();
+      } else {
+        torus.buildBVH();
+      }
+      for(std::size_t level = 1; level < torus.getLODCount(); ++level) {
+        EXPECT_NE(&torus.getLOD(level), &torus);
+      }
+    });
+  }
+  for(std::thread& thread : threads) {
+    thread.join();
+  }
+  ASSERT_GT(torus.getLODCount(), 2U);
+  EXPECT_NE(torus.getBVHRoot(), nullptr);
+  for(std::size_t level = 1; level < torus.getLODCount(); ++level) {
+    EXPECT_NE(torus.getLOD(level).getBVHRoot(), nullptr);
+  }
+}
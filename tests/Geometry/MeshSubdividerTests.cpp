@@ -0,0 +1,123 @@
+#include "Core/Config.hpp"
+#include "Geometry/CubeMeshBuilder.hpp"
+#include "Geometry/Mesh.hpp"
+#include "Geometry/MeshSubdivider.hpp"
+#include "Geometry/PlaneMeshBuilder.hpp"
+#include "Geometry/SphereMeshBuilder.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <linalg/Vec3.hpp>
+#include <map>
+#include <utility>
+
+namespace {
+
+using PositionKey = std::array<float, 3>;
+
+PositionKey positionKey(const Mesh& mesh, int index) {
+  const linalg::Vec3f& position = mesh.getVertexPosition(index);
+  return {position.x, position.y, position.z};
+}
+
+// Number of faces along each edge, the vertices being identified by position.
+std::map<std::pair<PositionKey, PositionKey>, int> countEdgeFaces(const Mesh& mesh) {
+  std::map<std::pair<PositionKey, PositionKey>, int> edge_faces;
+  for(const Face& face : mesh.getFaces()) {
+    for(int c = 0; c < 3; ++c) {
+      const PositionKey a = positionKey(mesh, face.vertex_indices[c]);
+      const PositionKey b = positionKey(mesh, face.vertex_indices[(c + 1) % 3]);
+      ++edge_faces[std::minmax(a, b)];
+    }
+  }
+  return edge_faces;
+}
+
+} // namespace
+
+TEST(MeshSubdividerTest, LevelZeroKeepsTheCage) {
+  const Mesh cube = CubeMeshBuilder(2.0).build();
+  EXPECT_EQ(MeshSubdivider::subdivide(cube, 0), cube);
+}
+
+TEST(MeshSubdividerTest, EachLevelSplitsTheFacesInFour) {
+  const Mesh cube = CubeMeshBuilder(2.0).build();
+  for(int level = 1; level <= 3; ++level) {
+    EXPECT_EQ(MeshSubdivider::subdivide(cube, level).getFaces().size(), cube.getFaces().size() << (2 * level));
+  }
+}
+
+TEST(MeshSubdividerTest, ClosedCageGivesAWatertightSurfaceAcrossSeams) {
+  const Mesh cube       = CubeMeshBuilder(2.0).build();
+  const Mesh subdivided = MeshSubdivider::subdivide(cube, 2);
+
+  // The faces of the cube are split along their texture seams, yet every edge of the surface has two faces.
+  EXPECT_GT(subdivided.getVertexCount(), 0);
+  for(const auto& [edge, face_count] : countEdgeFaces(subdivided)) {
+    EXPECT_EQ(face_count, 2);
+  }
+}
+
+TEST(MeshSubdividerTest, SurfaceIsSmoothedWithinTheCageBounds) {
+  const Mesh cube       = CubeMeshBuilder(2.0).build();
+  const Mesh subdivided = MeshSubdivider::subdivide(cube, 3);
+
+  double max_radius = 0.0;
+  double min_radius = 10.0;
+  for(std::size_t v = 0; v < subdivided.getVertexCount(); ++v) {
+    const linalg::Vec3d position(subdivided.getVertexPosition(static_cast<int>(v)));
+    EXPECT_LE(std::max({std::abs(position.x), std::abs(position.y), std::abs(position.z)}), 1.0 + 1e-6);
+    max_radius = std::max(max_radius, position.length());
+    min_radius = std::min(min_radius, position.length());
+  }
+  // The corners of the cube, at sqrt(3), are pulled in towards a rounded surface.
+  EXPECT_LT(max_radius, 1.2);
+  EXPECT_GT(min_radius, 0.5);
+}
+
+TEST(MeshSubdividerTest, NormalsFollowTheSubdividedSurface) {
+  const Mesh sphere     = SphereMeshBuilder(1.0, 8, 6).build();
+  const Mesh subdivided = MeshSubdivider::subdivide(sphere, 2);
+
+  for(std::size_t v = 0; v < subdivided.getVertexCount(); ++v) {
+    const Vertex vertex = subdivided.getVertex(static_cast<int>(v));
+    EXPECT_NEAR(vertex.normal.length(), 1.0, 1e-3);
+    EXPECT_GT(vertex.normal.dot(vertex.position.normalized()), 0.9) << "vertex " << v;
+  }
+}
+
+TEST(MeshSubdividerTest, FlatCageStaysFlatWithInterpolatedUVs) {
+  const Mesh plane      = PlaneMeshBuilder(2.0, 2.0).build();
+  const Mesh subdivided = MeshSubdivider::subdivide(plane, 2);
+
+  ASSERT_EQ(subdivided.getFaces().size(), plane.getFaces().size() * 16);
+  for(std::size_t v = 0; v < subdivided.getVertexCount(); ++v) {
+    const Vertex vertex = subdivided.getVertex(static_cast<int>(v));
+    EXPECT_NEAR(vertex.position.y, 0.0, 1e-9);
+    EXPECT_NEAR(std::abs(vertex.normal.y), 1.0, 1e-3);
+    EXPECT_GE(vertex.uv_coord.u, -1e-9);
+    EXPECT_LE(vertex.uv_coord.u, 2.0 + 1e-9);
+  }
+
+  // The border is kept open: its edges have a single face.
+  int border_edges = 0;
+  for(const auto& [edge, face_count] : countEdgeFaces(subdivided)) {
+    EXPECT_LE(face_count, 2);
+    border_edges += face_count == 1 ? 1 : 0;
+  }
+  EXPECT_EQ(border_edges, 16);
+}
+
+TEST(MeshSubdividerTest, SelectsTheLevelFromTheProjectedEdgeLength) {
+  const Mesh cube = CubeMeshBuilder(2.0).build();
+
+  // The longest edges of the cube are its face diagonals, of length 2 * sqrt(2).
+  const double diagonal = 2.0 * std::sqrt(2.0);
+  EXPECT_EQ(MeshSubdivider::selectLevel(cube, 0.0), 0);
+  EXPECT_EQ(MeshSubdivider::selectLevel(cube, SUBDIVISION_EDGE_PIXELS / diagonal * 0.9), 0);
+  EXPECT_EQ(MeshSubdivider::selectLevel(cube, SUBDIVISION_EDGE_PIXELS / diagonal * 1.5), 1);
+  EXPECT_EQ(MeshSubdivider::selectLevel(cube, SUBDIVISION_EDGE_PIXELS / diagonal * 3.5), 2);
+  EXPECT_EQ(MeshSubdivider::selectLevel(cube, 1e12), SUBDIVISION_MAX_LEVEL);
+}
@@ -34,6 +34,7 @@ f 1/1/1 2/2/2 3/1/3
 
   void TearDown() override {
     std::remove(testFilename.c_str());
+    std::remove("test_model.lmesh");
   }
 };
 
@@ -43,9 +44,10 @@ TEST_F(OBJLoaderTest, LoadOBJFileWithCommentsAndNoise) {
   ASSERT_EQ(mesh.getVertices().size(), 3);
   ASSERT_EQ(mesh.getFaces().size(), 1);
 
-  const Vertex& v0 = mesh.getVertices()[0];
-  const Vertex& v1 = mesh.getVertices()[1];
-  const Vertex& v2 = mesh.getVertices()[2];
+  const std::vector<Vertex> vertices = mesh.getVertices();
+  const Vertex&             v0       = vertices[0];
+  const Vertex&             v1       = vertices[1];
+  const Vertex&             v2       = vertices[2];
 
   EXPECT_EQ(v0.position, linalg::Vec3d(1.0, 0.0, 0.0));
   EXPECT_EQ(v1.position, linalg::Vec3d(0.0, 1.0, 0.0));
@@ -75,3 +77,103 @@ TEST(OBJLoaderEdgeCaseTest, LoadNonExistentFile) {
   EXPECT_TRUE(mesh.getVertices().empty());
   EXPECT_TRUE(mesh.getFaces().empty());
 }
+
+TEST(OBJLoaderParseTest, TriangulatesQuadsAndPolygonsAsFans) {
+  const Mesh mesh = OBJLoader::parse("v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nv -1 1 0\n"
+                                     "f 1 2 3 4\n"
+                                     "f 1 2 3 4 5\n");
+
+  ASSERT_EQ(mesh.getVertices().size(), 5);
+  ASSERT_EQ(mesh.getFaces().size(), 5);
+  EXPECT_EQ(mesh.getFaces()[0], (Face{{0, 1, 2}}));
+  EXPECT_EQ(mesh.getFaces()[1], (Face{{0, 2, 3}}));
+  EXPECT_EQ(mesh.getFaces()[4], (Face{{0, 3, 4}}));
+}
+
+TEST(OBJLoaderParseTest, ResolvesNegativeIndicesAgainstPreviousElements) {
+  const Mesh mesh = OBJLoader::parse("v 0 0 0\nv 1 0 0\nv 0 1 0\nvt 0.5 0.5\nvn 0 0 1\n"
+                                     "f -3/-1/-1 -2/-1/-1 -1/-1/-1\n"
+                                     "v 5 5 5\n"
+                                     "f -4 -2 -1\n");
+
+  ASSERT_EQ(mesh.getFaces().size(), 2);
+  EXPECT_EQ(mesh.getVertex(mesh.getFaces()[0].vertex_indices[0]).position, linalg::Vec3d(0.0, 0.0, 0.0));
+  EXPECT_EQ(mesh.getVertex(mesh.getFaces()[0].vertex_indices[0]).normal, linalg::Vec3d(0.0, 0.0, 1.0));
+  EXPECT_DOUBLE_EQ(mesh.getVertex(mesh.getFaces()[0].vertex_indices[2]).uv_coord.u, 0.5);
+  EXPECT_EQ(mesh.getVertex(mesh.getFaces()[1].vertex_indices[0]).position, linalg::Vec3d(0.0, 0.0, 0.0));
+  EXPECT_EQ(mesh.getVertex(mesh.getFaces()[1].vertex_indices[2]).position, linalg::Vec3d(5.0, 5.0, 5.0));
+}
+
+TEST(OBJLoaderParseTest, DeduplicatesCornersOnAllTheirIndices) {
+  const Mesh mesh = OBJLoader::parse("v 0 0 0\nv 1 0 0\nv 0 1 0\nvn 0 0 1\nvn 0 0 -1\n"
+                                     "f 1//1 2//1 3//1\n"
+                                     "f 3//1 2//1 1//2\n");
+
+  ASSERT_EQ(mesh.getFaces().size(), 2);
+  EXPECT_EQ(mesh.getVertices().size(), 4);
+  EXPECT_EQ(mesh.getFaces()[1].vertex_indices[0], 2);
+  EXPECT_EQ(mesh.getFaces()[1].vertex_indices[1], 1);
+  EXPECT_EQ(mesh.getFaces()[1].vertex_indices[2], 3);
+  EXPECT_EQ(mesh.getVertex(3).normal, linalg::Vec3d(0.0, 0.0, -1.0));
+}
+
+TEST(OBJLoaderParseTest, SkipsMalformedAndOutOfRangeFaces) {
+  const Mesh mesh = OBJLoader::parse("v 0 0 0\r\nv 1 0 0\r\nv 0 1 0\r\n"
+                                     "f 1 2\r\n"
+                                     "f 1 2 7\r\n"
+                                     "f 1 2 x\r\n"
+                                     "f 1/5 2 3\r\n"
+                                     "\tf  1\t2 3 \r\n");
+
+  ASSERT_EQ(mesh.getFaces().size(), 1);
+  EXPECT_EQ(mesh.getFaces()[0], (Face{{0, 1, 2}}));
+}
+
+TEST(OBJLoaderParseTest, ChunkedParsingMatchesSingleChunk) {
+  std::string content;
+  for(int i = 0; i < 40; ++i) {
+    content += "v " + std::to_string(i) + " " + std::to_string(i * 0.5) + " -" + std::to_string(i) + "\n";
+    content += "vt 0." + std::to_string(i) + " 0.25\nvn 0 1 0\n";
+    if(i >= 3) {
+      content += "f -1/-1/-1 -2/-2/-1 -3/-3/-1 1/1/1\n";
+    }
+  }
+
+  const Mesh reference = OBJLoader::parse(content);
+  ASSERT_EQ(reference.getFaces().size(), 74);
+  for(const std::size_t chunk_size : {1, 16, 100, 1000}) {
+    EXPECT_EQ(OBJLoader::parse(content, chunk_size), reference) << "chunk size " << chunk_size;
+  }
+}
+
+TEST(OBJLoaderParseTest, ReportsProgressThroughTheControl) {
+  std::string content;
+  for(int i = 0; i < 40; ++i) {
+    content += "v " + std::to_string(i) + " 0 0\nv 0 " + std::to_string(i) + " 0\nv 0 0 " + std::to_string(i) + "\n";
+    content += "f -1 -2 -3\n";
+  }
+
+  OBJLoader::LoadControl control;
+  EXPECT_DOUBLE_EQ(control.getProgress(), 0.0);
+  const Mesh mesh = OBJLoader::parse(content, 64, &control);
+  EXPECT_EQ(mesh, OBJLoader::parse(content, 64));
+  EXPECT_DOUBLE_EQ(control.getProgress(), 1.0);
+}
+
+TEST(OBJLoaderParseTest, CancelledParseReturnsAnEmptyMesh) {
+  const std::string content = "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n";
+
+  OBJLoader::LoadControl control;
+  control.cancel();
+  const Mesh mesh = OBJLoader::parse(content, OBJ_PARSE_CHUNK_SIZE, &control);
+  EXPECT_TRUE(mesh.getFaces().empty());
+  EXPECT_EQ(mesh.getVertexCount(), 0);
+  EXPECT_LT(control.getProgress(), 1.0);
+}
+
+TEST_F(OBJLoaderTest, CancelledLoadDoesNotWriteTheCache) {
+  OBJLoader::LoadControl control;
+  control.cancel();
+  EXPECT_TRUE(OBJLoader::load(testFilename, true, &control).getFaces().empty());
+  EXPECT_FALSE(std::ifstream("test_model.lmesh").good());
+}
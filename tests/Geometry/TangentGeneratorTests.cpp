@@ -0,0 +1,105 @@
+#include "Core/Config.hpp"
+#include "Geometry/Mesh.hpp"
+#include "Geometry/TangentGenerator.hpp"
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <linalg/Vec3.hpp>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Grid in the XY plane whose texture coordinates follow x and y, so that every tangent is +X.
+Mesh buildGrid(int size) {
+  std::vector<Vertex> vertices;
+  std::vector<Face>   faces;
+  for(int y = 0; y <= size; ++y) {
+    for(int x = 0; x <= size; ++x) {
+      vertices.push_back({{static_cast<double>(x), static_cast<double>(y), 0.0},
+                          {0.0, 0.0, 1.0},
+                          {static_cast<double>(x) / size, static_cast<double>(y) / size}});
+    }
+  }
+  for(int y = 0; y < size; ++y) {
+    for(int x = 0; x < size; ++x) {
+      const int corner = y * (size + 1) + x;
+      faces.push_back({{corner, corner + 1, corner + size + 2}});
+      faces.push_back({{corner, corner + size + 2, corner + size + 1}});
+    }
+  }
+  return {std::move(vertices), std::move(faces)};
+}
+
+} // namespace
+
+TEST(TangentGeneratorTest, TangentsAreBuiltOnDemand) {
+  Mesh mesh = buildGrid(2);
+  EXPECT_FALSE(mesh.hasTangents());
+  EXPECT_TRUE(mesh.getStreams().tangents.empty());
+
+  // Without tangents, the decoded frame is still orthonormal.
+  const Vertex vertex = mesh.getVertex(0);
+  EXPECT_NEAR(vertex.tangent.dot(vertex.normal), 0.0, 1e-12);
+  EXPECT_NEAR(vertex.bitangent.length(), 1.0, 1e-12);
+
+  mesh.buildTangents();
+  EXPECT_TRUE(mesh.hasTangents());
+  EXPECT_EQ(mesh.getStreams().bitangent_signs.size(), mesh.getVertexCount());
+}
+
+TEST(TangentGeneratorTest, LargeMeshSplitInJobsFollowsTheTextureAxes) {
+  Mesh mesh = buildGrid(200);
+  ASSERT_GT(mesh.getFaces().size(), TANGENT_JOB_SIZE);
+  ASSERT_GT(mesh.getVertexCount(), TANGENT_JOB_SIZE);
+  mesh.buildTangents();
+
+  for(std::size_t i = 0; i < mesh.getVertexCount(); ++i) {
+    const Vertex vertex = mesh.getVertex(static_cast<int>(i));
+    ASSERT_NEAR((vertex.tangent - linalg::Vec3d(1.0, 0.0, 0.0)).length(), 0.0, 1e-9);
+    ASSERT_NEAR((vertex.bitangent - linalg::Vec3d(0.0, 1.0, 0.0)).length(), 0.0, 1e-9);
+  }
+}
+
+TEST(TangentGeneratorTest, ConcurrentBuildsPublishCompleteTangents) {
+  Mesh mesh = buildGrid(200);
+
+  // Threads building the tangents at once wait for the first one, the readers only see them complete.
+  std::vector<std::thread> threads;
+  for(int i = 0; i < 4; ++i) {
+    threads.emplace_back([&mesh]() {
+      mesh.buildTangents();
+      EXPECT_TRUE(mesh.hasTangents());
+      EXPECT_EQ(mesh.getStreams().tangents.size(), mesh.getVertexCount());
+    });
+  }
+  for(std::thread& thread : threads) {
+    thread.join();
+  }
+  EXPECT_NEAR((mesh.getVertex(0).tangent - linalg::Vec3d(1.0, 0.0, 0.0)).length(), 0.0, 1e-9);
+}
+
+TEST(TangentGeneratorTest, DegenerateTextureCoordinatesYieldAFrame) {
+  Vertex v0{{0.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {0.5, 0.5}};
+  Vertex v1{{1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {0.5, 0.5}};
+  Vertex v2{{0.0, 0.0, 1.0}, {0.0, 1.0, 0.0}, {0.5, 0.5}};
+  Mesh   mesh({v0, v1, v2}, {Face{{0, 1, 2}}});
+  mesh.buildTangents();
+
+  for(int i = 0; i < 3; ++i) {
+    const Vertex vertex = mesh.getVertex(i);
+    ASSERT_TRUE(std::isfinite(vertex.tangent.x) && std::isfinite(vertex.tangent.y) && std::isfinite(vertex.tangent.z));
+    EXPECT_NEAR(vertex.tangent.length(), 1.0, 1e-9);
+    EXPECT_NEAR(vertex.tangent.dot(vertex.normal), 0.0, 1e-9);
+  }
+}
+
+TEST(TangentGeneratorTest, OrthogonalizeRemovesTheNormalComponent) {
+  const linalg::Vec3d normal(0.0, 0.0, 1.0);
+  const linalg::Vec3d tangent = TangentGenerator::orthogonalize({1.0, 0.0, 1.0}, normal);
+  EXPECT_NEAR((tangent - linalg::Vec3d(1.0, 0.0, 0.0)).length(), 0.0, 1e-12);
+
+  const linalg::Vec3d fallback = TangentGenerator::orthogonalize({0.0, 0.0, 2.0}, normal);
+  EXPECT_NEAR(fallback.length(), 1.0, 1e-12);
+  EXPECT_NEAR(fallback.dot(normal), 0.0, 1e-12);
+}
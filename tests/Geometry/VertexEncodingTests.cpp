@@ -0,0 +1,53 @@
+#include "Geometry/Mesh.hpp"
+#include "Geometry/VertexEncoding.hpp"
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <linalg/Vec3.hpp>
+#include <vector>
+
+TEST(VertexEncodingTest, AxisDirectionsAreExact) {
+  const std::vector<linalg::Vec3d> axes = {{1.0, 0.0, 0.0}, {-1.0, 0.0, 0.0}, {0.0, 1.0, 0.0},
+                                           {0.0, -1.0, 0.0}, {0.0, 0.0, 1.0}, {0.0, 0.0, -1.0}};
+  for(const linalg::Vec3d& axis : axes) {
+    EXPECT_EQ(VertexEncoding::decodeDirection(VertexEncoding::encodeDirection(axis)), axis);
+  }
+}
+
+TEST(VertexEncodingTest, RoundTripErrorIsSmall) {
+  for(int i = 0; i < 500; ++i) {
+    // Spiral over the sphere, both hemispheres included.
+    const double        z   = 1.0 - (2.0 * i + 1.0) / 500.0;
+    const double        r   = std::sqrt(1.0 - z * z);
+    const double        phi = 2.399963 * i;
+    const linalg::Vec3d direction(r * std::cos(phi), r * std::sin(phi), z);
+
+    const linalg::Vec3d decoded = VertexEncoding::decodeDirection(VertexEncoding::encodeDirection(direction));
+    EXPECT_NEAR(decoded.length(), 1.0, 1e-12);
+    EXPECT_GT(decoded.dot(direction), std::cos(1e-4));
+  }
+}
+
+TEST(VertexEncodingTest, DegenerateDirectionDecodesToPositiveZ) {
+  EXPECT_EQ(VertexEncoding::decodeDirection(VertexEncoding::encodeDirection({0.0, 0.0, 0.0})),
+            linalg::Vec3d(0.0, 0.0, 1.0));
+  EXPECT_EQ(VertexEncoding::decodeDirection(VertexEncoding::encodeDirection({NAN, 0.0, 0.0})),
+            linalg::Vec3d(0.0, 0.0, 1.0));
+}
+
+TEST(VertexEncodingTest, MeshKeepsTangentFrameOrthonormalAndHanded) {
+  Vertex v0{{0.0, 0.0, 0.0}, {0.0, 0.0, 1.0}, {0.0, 0.0}};
+  Vertex v1{{1.0, 0.0, 0.0}, {0.0, 0.0, 1.0}, {1.0, 0.0}};
+  Vertex v2{{0.0, 1.0, 0.0}, {0.0, 0.0, 1.0}, {0.0, -1.0}};
+  Mesh mesh({v0, v1, v2}, {Face{{0, 1, 2}}});
+  mesh.buildTangents();
+
+  for(int i = 0; i < 3; ++i) {
+    const Vertex vertex = mesh.getVertex(i);
+    EXPECT_NEAR(vertex.tangent.dot(vertex.normal), 0.0, 1e-9);
+    EXPECT_NEAR((vertex.tangent - linalg::Vec3d(1.0, 0.0, 0.0)).length(), 0.0, 1e-9);
+    // The v axis of the texture points to -y: the bitangent is mirrored.
+    EXPECT_NEAR((vertex.bitangent - linalg::Vec3d(0.0, -1.0, 0.0)).length(), 0.0, 1e-9);
+    EXPECT_EQ(mesh.getStreams().bitangent_signs[i], -1);
+  }
+}
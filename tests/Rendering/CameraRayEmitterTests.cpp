@@ -97,3 +97,22 @@ TEST(CameraRayEmitterTest, GenerateRay) {
   EXPECT_TRUE(ray.direction.isApprox(linalg::Vec3d(0.0, 0.0, -1.0), 1e-6));
 }
 
+
+TEST(CameraRayEmitterTest, GeneratedRayConeSpreadsByOnePixel) {
+  RayEmitterParameters parameters;
+  parameters.sensor_width           = 36.0;
+  parameters.image_aspect_ratio     = 1.0;
+  parameters.focus_distance         = 1.0;
+  parameters.focal_length           = 18.0;
+  parameters.camera_rotation_matrix = linalg::Mat3d::Identity();
+  parameters.pixel_width            = 1.0 / 100.0;
+
+  CameraRayEmitter emitter;
+  emitter.initializeViewport(parameters);
+  EXPECT_NEAR(emitter.getPixelSpreadAngle(), 0.02, 1e-12);
+
+  const Ray ray = emitter.generateRay(0.5, 0.5);
+  EXPECT_DOUBLE_EQ(ray.cone.width, 0.0);
+  EXPECT_NEAR(ray.cone.spread_angle, 0.02, 1e-12);
+  EXPECT_NEAR(ray.cone.getWidth(10.0), 0.2, 1e-12);
+}
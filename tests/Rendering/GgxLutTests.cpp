@@ -0,0 +1,78 @@
+#include "Rendering/PathTracer/GgxLut.hpp"
+#include "Rendering/PathTracer/PBR.hpp"
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+namespace {
+
+// Integrates brdf * cos over the hemisphere with a stratified grid, uniform in cos_theta and phi.
+ColorRGB directionalAlbedo(const PBR::BRDFInput& input) {
+  constexpr int resolution = 256;
+  ColorRGB      sum(0.0);
+  for(int i = 0; i < resolution; ++i) {
+    for(int j = 0; j < resolution; ++j) {
+      const double        cos_theta = (i + 0.5) / resolution;
+      const double        sin_theta = std::sqrt(1.0 - cos_theta * cos_theta);
+      const double        phi       = TWO_PI * (j + 0.5) / resolution;
+      const linalg::Vec3d light(sin_theta * std::cos(phi), sin_theta * std::sin(phi), cos_theta);
+      sum += PBR::evaluateBrdf(input, light) * cos_theta;
+    }
+  }
+  return sum * (TWO_PI / (resolution * resolution));
+}
+
+linalg::Vec3d viewDirection(double cos_theta) { return {std::sqrt(1.0 - cos_theta * cos_theta), 0.0, cos_theta}; }
+
+} // namespace
+
+TEST(GgxLutTest, MirrorKeepsAllEnergyAndMatchesSchlick) {
+  for(const double cos_theta : {0.1, 0.5, 1.0}) {
+    const PBR::SpecularAlbedo albedo = PBR::lookupSpecularAlbedo(cos_theta, 0.0);
+    EXPECT_NEAR(albedo.energy(), 1.0, 1e-6);
+    EXPECT_NEAR(albedo.bias, PBR::getSchlickWeight(cos_theta), 1e-2);
+  }
+}
+
+TEST(GgxLutTest, EnergyDecreasesWithRoughness) {
+  double previous = 1.0;
+  for(int i = 0; i <= 10; ++i) {
+    const double energy = PBR::lookupSpecularAlbedo(0.5, i / 10.0).energy();
+    EXPECT_GT(energy, 0.0);
+    EXPECT_LE(energy, previous + 1e-3); // Quadrature noise of the table.
+    previous = energy;
+  }
+  EXPECT_LT(previous, 0.9);
+}
+
+TEST(GgxLutTest, MatchesNumericalIntegrationOfTheLobe) {
+  const linalg::Vec3d normal(0.0, 0.0, 1.0);
+  for(const double roughness : {0.4, 0.8}) {
+    const PBR::BRDFInput input(viewDirection(0.7), normal, ColorRGB(1.0), roughness, 1.0);
+    const double         energy = PBR::lookupSpecularAlbedo(0.7, roughness).energy();
+    EXPECT_NEAR(directionalAlbedo(input).r / input.specular_compensation.r, energy, 0.02);
+  }
+}
+
+TEST(GgxLutTest, CompensatedWhiteMetalConservesEnergy) {
+  const linalg::Vec3d normal(0.0, 0.0, 1.0);
+  for(const double roughness : {0.6, 1.0}) {
+    const PBR::BRDFInput input(viewDirection(0.6), normal, ColorRGB(1.0), roughness, 1.0);
+    EXPECT_GT(input.specular_compensation.r, 1.0);
+    EXPECT_NEAR(directionalAlbedo(input).r, 1.0, 0.03);
+  }
+}
+
+TEST(GgxLutTest, SetRoughnessUpdatesSpecularTerms) {
+  const linalg::Vec3d normal(0.0, 0.0, 1.0);
+  PBR::BRDFInput      input(viewDirection(0.8), normal, ColorRGB(0.5), 0.0, 0.0);
+  EXPECT_NEAR(input.specular_compensation.r, 1.0, 1e-6);
+
+  const double mirror_ratio = input.specular_ratio;
+  input.setRoughness(1.0);
+  EXPECT_EQ(input.roughness, 1.0);
+  EXPECT_GT(input.specular_compensation.r, 1.0);
+  EXPECT_NE(input.specular_ratio, mirror_ratio);
+  EXPECT_GT(input.specular_ratio, 0.0);
+  EXPECT_LT(input.specular_ratio, 1.0);
+}
@@ -0,0 +1,115 @@
+#include "Rendering/PathTracer/PBRBatch.hpp"
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+static constexpr double BATCH_EPSILON = 1e-3;
+
+namespace {
+
+linalg::Vec3d hemisphereDirection(double theta, double phi) {
+  return {std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi), std::cos(theta)};
+}
+
+} // namespace
+
+TEST(PBRBatchTest, FastSinCosMatchesStandardLibrary) {
+  for(int i = 0; i <= 1000; ++i) {
+    const float angle = static_cast<float>(TWO_PI * i / 1000.0);
+    float       s     = 0.0F;
+    float       c     = 0.0F;
+    PBRBatch::fastSinCos(angle, s, c);
+    EXPECT_NEAR(s, std::sin(angle), 1e-5);
+    EXPECT_NEAR(c, std::cos(angle), 1e-5);
+  }
+}
+
+TEST(PBRBatchTest, SchlickWeightMatchesPow) {
+  for(int i = 0; i <= 10; ++i) {
+    const double cos_theta = i / 10.0;
+    EXPECT_NEAR(PBR::getSchlickWeight(cos_theta), std::pow(1.0 - cos_theta, 5), 1e-12);
+  }
+}
+
+TEST(PBRBatchTest, EvaluateBrdfMatchesScalar) {
+  const linalg::Vec3d normal(0.0, 0.0, 1.0);
+
+  PBRBatch::BRDFBatchInput batch_input;
+  PBRBatch::Vec3Batch      outgoing;
+  std::vector<ColorRGB>    expected;
+
+  for(int lane = 0; lane < PBRBatch::BATCH_SIZE; ++lane) {
+    const linalg::Vec3d  incoming  = hemisphereDirection(0.1 + 0.15 * lane, 0.7 * lane);
+    const linalg::Vec3d  out_dir   = hemisphereDirection(1.2 - 0.12 * lane, 2.0 + 0.5 * lane);
+    const ColorRGB       albedo    = {0.2 + 0.1 * lane, 0.5, 0.9 - 0.1 * lane};
+    const double         roughness = 0.05 + 0.12 * lane;
+    const double         metalness = (lane % 3) / 2.0;
+    const PBR::BRDFInput input(incoming, normal, albedo, roughness, metalness);
+
+    batch_input.set(lane, input);
+    outgoing.set(lane, out_dir);
+    expected.push_back(PBR::evaluateBrdf(input, out_dir));
+  }
+
+  PBRBatch::ColorBatch result;
+  PBRBatch::evaluateBrdf(batch_input, outgoing, result);
+
+  for(int lane = 0; lane < PBRBatch::BATCH_SIZE; ++lane) {
+    const ColorRGB value = result.get(lane);
+    EXPECT_NEAR(value.r, expected[lane].r, BATCH_EPSILON * std::max(1.0, expected[lane].r));
+    EXPECT_NEAR(value.g, expected[lane].g, BATCH_EPSILON * std::max(1.0, expected[lane].g));
+    EXPECT_NEAR(value.b, expected[lane].b, BATCH_EPSILON * std::max(1.0, expected[lane].b));
+  }
+}
+
+TEST(PBRBatchTest, EvaluateBrdfBelowHorizonHasNoSpecular) {
+  PBRBatch::BRDFBatchInput batch_input;
+  PBRBatch::Vec3Batch      outgoing;
+  for(int lane = 0; lane < PBRBatch::BATCH_SIZE; ++lane) {
+    batch_input.set(lane, PBR::BRDFInput({0.0, 0.0, 1.0}, {0.0, 0.0, 1.0}, ColorRGB(0.0), 0.0, 1.0));
+    outgoing.set(lane, {0.0, 0.6, -0.8});
+  }
+
+  PBRBatch::ColorBatch result;
+  PBRBatch::evaluateBrdf(batch_input, outgoing, result);
+
+  for(int lane = 0; lane < PBRBatch::BATCH_SIZE; ++lane) {
+    const ColorRGB value = result.get(lane);
+    EXPECT_FALSE(std::isnan(value.r));
+    EXPECT_NEAR(value.r, 0.0, BATCH_EPSILON);
+  }
+}
+
+TEST(PBRBatchTest, SampleHalfVectorGgxIsNormalizedAndInHemisphere) {
+  PBRBatch::Lanes     roughness{};
+  PBRBatch::Lanes     u1{};
+  PBRBatch::Lanes     u2{};
+  PBRBatch::Vec3Batch tangent;
+  PBRBatch::Vec3Batch bitangent;
+  PBRBatch::Vec3Batch normal;
+  for(int lane = 0; lane < PBRBatch::BATCH_SIZE; ++lane) {
+    roughness[lane] = 0.1F + 0.1F * static_cast<float>(lane);
+    u1[lane]        = 0.05F + 0.12F * static_cast<float>(lane);
+    u2[lane]        = 0.9F - 0.11F * static_cast<float>(lane);
+    tangent.set(lane, {0.0, 1.0, 0.0});
+    bitangent.set(lane, {0.0, 0.0, 1.0});
+    normal.set(lane, {1.0, 0.0, 0.0});
+  }
+
+  PBRBatch::Vec3Batch half_vector;
+  PBRBatch::sampleHalfVectorGgx(roughness, u1, u2, tangent, bitangent, normal, half_vector);
+
+  for(int lane = 0; lane < PBRBatch::BATCH_SIZE; ++lane) {
+    const linalg::Vec3d h = half_vector.get(lane);
+    EXPECT_NEAR(h.length(), 1.0, BATCH_EPSILON);
+    EXPECT_GE(h.x, 0.0);
+
+    const double alpha     = static_cast<double>(roughness[lane]) * roughness[lane];
+    const double theta     = std::atan(alpha * std::sqrt(u1[lane] / (1.0 - u1[lane])));
+    const double phi       = TWO_PI * u2[lane];
+    const double sin_theta = std::sin(theta);
+    EXPECT_NEAR(h.x, std::cos(theta), BATCH_EPSILON);
+    EXPECT_NEAR(h.y, sin_theta * std::cos(phi), BATCH_EPSILON);
+    EXPECT_NEAR(h.z, sin_theta * std::sin(phi), BATCH_EPSILON);
+  }
+}
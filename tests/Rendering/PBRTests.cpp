@@ -0,0 +1,140 @@
+#include "Rendering/PathTracer/PBR.hpp"
+#include "Rendering/PathTracer/PathTracer.hpp"
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+namespace {
+
+PBR::BRDFInput glassInput(double cos_theta, double roughness, double eta) {
+  PBR::BRDFInput input({std::sqrt(1.0 - cos_theta * cos_theta), 0.0, cos_theta}, {0.0, 0.0, 1.0}, ColorRGB(1.0),
+                       roughness, 0.0);
+  input.transmission = 1.0;
+  input.eta          = eta;
+  return input;
+}
+
+// Integrates bsdf * |cos| over the whole sphere with a stratified grid, uniform in cos_theta and phi. The transmitted
+// part can be weighted, e.g. by eta^2 to undo the radiance scaling of the BTDF.
+double sphereIntegral(const PBR::BRDFInput& input, double transmitted_weight = 1.0) {
+  constexpr int resolution = 512;
+  double        sum        = 0.0;
+  for(int i = 0; i < resolution; ++i) {
+    for(int j = 0; j < resolution; ++j) {
+      const double        cos_theta = -1.0 + 2.0 * (i + 0.5) / resolution;
+      const double        sin_theta = std::sqrt(1.0 - cos_theta * cos_theta);
+      const double        phi       = TWO_PI * (j + 0.5) / resolution;
+      const linalg::Vec3d direction(sin_theta * std::cos(phi), sin_theta * std::sin(phi), cos_theta);
+      const double        weight = cos_theta < 0.0 ? transmitted_weight : 1.0;
+      sum += weight * PBR::evaluateBsdf(input, direction).r * PBR::getCosineFactor(input, direction);
+    }
+  }
+  return sum * (2.0 * TWO_PI / (resolution * resolution));
+}
+
+// Estimates the same integral with the sampling routine of the path tracer.
+double sampledIntegral(const PBR::BRDFInput& input) {
+  constexpr int       sample_count = 200000;
+  const linalg::Mat3d tbn = linalg::Mat3d::FromColumns({1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {0.0, 0.0, 1.0});
+  double              sum = 0.0;
+  for(int i = 0; i < sample_count; ++i) {
+    double              pdf         = 0.0;
+    BounceType          bounce_type = BounceType::DIFFUSE;
+    const linalg::Vec3d direction   = PathTracer::SampleOutgoingDirection(input, tbn, pdf, bounce_type);
+    if(pdf > 0.0) {
+      sum += PBR::evaluateBsdf(input, direction).r * PBR::getCosineFactor(input, direction) / pdf;
+    }
+  }
+  return sum / sample_count;
+}
+
+} // namespace
+
+TEST(PBRTest, FresnelDielectricMatchesNormalIncidenceAndTotalReflection) {
+  EXPECT_NEAR(PBR::getFresnelDielectric(1.0, 1.5), 0.04, 1e-12);
+  EXPECT_NEAR(PBR::getFresnelDielectric(1.0, 1.0 / 1.5), 0.04, 1e-12);
+  EXPECT_DOUBLE_EQ(PBR::getFresnelDielectric(0.3, 1.0 / 1.5), 1.0); // Past the critical angle.
+  EXPECT_NEAR(PBR::getFresnelDielectric(0.0, 1.5), 1.0, 1e-12);
+}
+
+TEST(PBRTest, RefractFollowsSnellsLaw) {
+  const double        sin_i = 0.5;
+  const linalg::Vec3d view(sin_i, 0.0, std::sqrt(1.0 - sin_i * sin_i));
+  linalg::Vec3d       refracted;
+  ASSERT_TRUE(PBR::refract(view, {0.0, 0.0, 1.0}, 1.5, refracted));
+  EXPECT_NEAR(refracted.length(), 1.0, 1e-12);
+  EXPECT_LT(refracted.z, 0.0);
+  EXPECT_NEAR(-refracted.x, sin_i / 1.5, 1e-12);
+
+  EXPECT_FALSE(PBR::refract({0.9, 0.0, std::sqrt(1.0 - 0.81)}, {0.0, 0.0, 1.0}, 1.0 / 1.5, refracted));
+}
+
+TEST(PBRTest, OpaqueInputsKeepTheBrdf) {
+  const PBR::BRDFInput input({0.0, 0.6, 0.8}, {0.0, 0.0, 1.0}, ColorRGB(0.5), 0.4, 0.2);
+  const linalg::Vec3d  direction(0.3, -0.4, std::sqrt(0.75));
+  EXPECT_EQ(PBR::evaluateBsdf(input, direction), PBR::evaluateBrdf(input, direction));
+  EXPECT_EQ(PBR::getCosineFactor(input, {0.0, 0.0, -1.0}), 0.0);
+}
+
+TEST(PBRTest, DielectricLobeConservesEnergy) {
+  for(const double eta : {1.5, 1.0 / 1.5}) {
+    const PBR::BRDFInput input  = glassInput(0.7, 0.4, eta);
+    const double         energy = sphereIntegral(input, eta * eta);
+    EXPECT_LT(energy, 1.01);
+    EXPECT_GT(energy, 0.8); // Single scattering loses some energy at this roughness.
+  }
+}
+
+TEST(PBRTest, DielectricSamplingMatchesTheBsdf) {
+  for(const double eta : {1.5, 1.0 / 1.5}) {
+    const PBR::BRDFInput input = glassInput(0.8, 0.5, eta);
+    const double         expected = sphereIntegral(input);
+    EXPECT_NEAR(sampledIntegral(input), expected, 0.03 * expected);
+  }
+}
+
+TEST(PBRTest, DielectricSamplingProducesBothBounceTypes) {
+  const PBR::BRDFInput input = glassInput(0.9, 0.1, 1.5);
+  const linalg::Mat3d  tbn   = linalg::Mat3d::FromColumns({1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {0.0, 0.0, 1.0});
+  int                  transmitted = 0;
+  for(int i = 0; i < 1000; ++i) {
+    double              pdf         = 0.0;
+    BounceType          bounce_type = BounceType::DIFFUSE;
+    const linalg::Vec3d direction   = PathTracer::SampleOutgoingDirection(input, tbn, pdf, bounce_type);
+    EXPECT_NE(bounce_type, BounceType::DIFFUSE);
+    if(bounce_type == BounceType::TRANSMISSION) {
+      EXPECT_LT(direction.z, 0.0);
+      ++transmitted;
+    }
+  }
+  EXPECT_GT(transmitted, 900); // About 4% of the light is reflected near normal incidence.
+}
+
+TEST(PBRTest, PdfSumMatchesTheLobeDensities) {
+  const PBR::BRDFInput opaque({0.0, 0.6, 0.8}, {0.0, 0.0, 1.0}, ColorRGB(0.5), 0.4, 0.2);
+  const PBR::BRDFInput glass = glassInput(0.7, 0.4, 1.5);
+  for(const PBR::BRDFInput& input : {opaque, glass}) {
+    for(const linalg::Vec3d& direction : {linalg::Vec3d(0.3, -0.4, std::sqrt(0.75)), linalg::Vec3d(0.0, 0.0, 1.0),
+                                          linalg::Vec3d(0.6, 0.0, -0.8)}) {
+      double expected = 0.0;
+      for(const double pdf : Sampler::pdfListBsdf(input, direction)) {
+        expected += pdf;
+      }
+      EXPECT_NEAR(Sampler::pdfSumBsdf(input, direction), expected, 1e-12 * std::max(1.0, expected));
+    }
+  }
+}
+
+TEST(PBRTest, GivenHalfVectorIsReflectedAbout) {
+  const PBR::BRDFInput input({0.0, 0.6, 0.8}, {0.0, 0.0, 1.0}, ColorRGB(0.5), 0.4, 1.0); // Fully metallic.
+  const linalg::Mat3d  tbn = linalg::Mat3d::FromColumns({1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {0.0, 0.0, 1.0});
+
+  double              pdf         = 0.0;
+  BounceType          bounce_type = BounceType::DIFFUSE;
+  const linalg::Vec3d direction = PathTracer::SampleOutgoingDirection(input, tbn, {0.0, 0.0, 1.0}, pdf, bounce_type);
+  EXPECT_EQ(bounce_type, BounceType::GLOSSY);
+  EXPECT_NEAR(direction.x, 0.0, 1e-12);
+  EXPECT_NEAR(direction.y, -0.6, 1e-12);
+  EXPECT_NEAR(direction.z, 0.8, 1e-12);
+  EXPECT_GT(pdf, 0.0);
+}
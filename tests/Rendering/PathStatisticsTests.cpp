@@ -0,0 +1,43 @@
+#include "Rendering/PathTracer/PathStatistics.hpp"
+#include <gtest/gtest.h>
+
+TEST(PathStatisticsTest, EmptyByDefault) {
+  PathStatistics statistics;
+  EXPECT_EQ(statistics.getDepthCount(), 0);
+  EXPECT_EQ(statistics.getRaysTraced(3), 0U);
+  EXPECT_EQ(statistics.getAverageThroughput(3), 0.0);
+}
+
+TEST(PathStatisticsTest, RecordsPerDepth) {
+  PathStatistics statistics;
+  statistics.recordRay(0, ColorRGB(1.0));
+  statistics.recordRay(1, ColorRGB(0.2, 0.6, 0.4));
+  statistics.recordRay(1, ColorRGB(0.2));
+  statistics.recordTermination(1);
+
+  EXPECT_EQ(statistics.getDepthCount(), 2);
+  EXPECT_EQ(statistics.getRaysTraced(0), 1U);
+  EXPECT_EQ(statistics.getRaysTraced(1), 2U);
+  EXPECT_EQ(statistics.getPathsTerminated(0), 0U);
+  EXPECT_EQ(statistics.getPathsTerminated(1), 1U);
+  EXPECT_NEAR(statistics.getAverageThroughput(1), 0.4, 1e-12);
+}
+
+TEST(PathStatisticsTest, MergeAddsCounters) {
+  PathStatistics first;
+  first.recordRay(0, ColorRGB(1.0));
+
+  PathStatistics second;
+  second.recordRay(0, ColorRGB(0.5));
+  second.recordRay(2, ColorRGB(0.5));
+  second.recordTermination(2);
+
+  first.merge(second);
+  EXPECT_EQ(first.getDepthCount(), 3);
+  EXPECT_EQ(first.getRaysTraced(0), 2U);
+  EXPECT_NEAR(first.getAverageThroughput(0), 0.75, 1e-12);
+  EXPECT_EQ(first.getPathsTerminated(2), 1U);
+
+  first.clear();
+  EXPECT_EQ(first.getDepthCount(), 0);
+}
@@ -0,0 +1,157 @@
+#include "Rendering/PathTracer/PathTracer.hpp"
+#include "Geometry/CubeMeshBuilder.hpp"
+#include "Scene/Scene.hpp"
+#include "SceneObjects/Object3D.hpp"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <memory>
+
+static constexpr double EPSILON = 1e-9;
+
+TEST(PathTracerTest, ClampRadianceKeepsDimSamples) {
+  const ColorRGB radiance(0.5, 1.0, 2.0);
+  EXPECT_EQ(PathTracer::ClampRadiance(radiance, 4.0), radiance);
+  EXPECT_EQ(PathTracer::ClampRadiance(radiance, 0.0), radiance);
+}
+
+TEST(PathTracerTest, ClampRadianceScalesBrightSamplesKeepingHue) {
+  const ColorRGB clamped = PathTracer::ClampRadiance(ColorRGB(10.0, 20.0, 40.0), 4.0);
+  EXPECT_NEAR(clamped.r, 1.0, EPSILON);
+  EXPECT_NEAR(clamped.g, 2.0, EPSILON);
+  EXPECT_NEAR(clamped.b, 4.0, EPSILON);
+}
+
+TEST(PathTracerTest, RegularizeRoughnessStartsAfterFirstRoughBounce) {
+  const linalg::Vec3d normal(0.0, 0.0, 1.0);
+  bool                after_rough_bounce = false;
+
+  PBR::BRDFInput mirror(normal, normal, ColorRGB(1.0), 0.0, 1.0);
+  PathTracer::RegularizeRoughness(mirror, 0.3, after_rough_bounce);
+  EXPECT_EQ(mirror.roughness, 0.0);
+  EXPECT_FALSE(after_rough_bounce);
+
+  PBR::BRDFInput diffuse(normal, normal, ColorRGB(1.0), 1.0, 0.0);
+  PathTracer::RegularizeRoughness(diffuse, 0.3, after_rough_bounce);
+  EXPECT_EQ(diffuse.roughness, 1.0);
+  EXPECT_TRUE(after_rough_bounce);
+
+  PBR::BRDFInput second_mirror(normal, normal, ColorRGB(1.0), 0.0, 1.0);
+  PathTracer::RegularizeRoughness(second_mirror, 0.3, after_rough_bounce);
+  EXPECT_EQ(second_mirror.roughness, 0.3);
+}
+
+TEST(PathTracerTest, RegisterBounceEnforcesPerTypeLimits) {
+  RenderSettings settings;
+  settings.setMaxBounces(BounceType::DIFFUSE, 2);
+  settings.setMaxBounces(BounceType::GLOSSY, 0);
+
+  PathState state;
+  EXPECT_TRUE(PathTracer::RegisterBounce(state, BounceType::DIFFUSE, settings));
+  EXPECT_TRUE(PathTracer::RegisterBounce(state, BounceType::DIFFUSE, settings));
+  EXPECT_FALSE(PathTracer::RegisterBounce(state, BounceType::DIFFUSE, settings));
+  EXPECT_FALSE(PathTracer::RegisterBounce(state, BounceType::GLOSSY, settings));
+  EXPECT_TRUE(PathTracer::RegisterBounce(state, BounceType::TRANSMISSION, settings));
+}
+
+TEST(PathTracerTest, CreateBrdfInputShadesTransmissiveBackFacesFromInside) {
+  Material glass;
+  glass.setTransmissionValue(1.0);
+  glass.setIndexOfRefraction(1.5);
+
+  RayHitInfo hit;
+  hit.normal           = {0.0, 0.0, 1.0};
+  hit.geometric_normal = {0.0, 0.0, 1.0};
+  hit.material         = &glass;
+
+  const PBR::BRDFInput entering = PathTracer::CreateBrdfInput(hit, {0.0, 0.0, 1.0});
+  EXPECT_EQ(entering.normal.z, 1.0);
+  EXPECT_DOUBLE_EQ(entering.eta, 1.5);
+  EXPECT_DOUBLE_EQ(entering.transmission, 1.0);
+
+  const PBR::BRDFInput leaving = PathTracer::CreateBrdfInput(hit, {0.0, 0.0, -1.0});
+  EXPECT_EQ(leaving.normal.z, -1.0);
+  EXPECT_DOUBLE_EQ(leaving.eta, 1.0 / 1.5);
+}
+
+TEST(PathTracerTest, HigherPriorityMediumHidesOverlappingSurfaces) {
+  Material glass;
+  glass.setTransmissionValue(1.0);
+  glass.setIndexOfRefraction(1.5);
+  glass.setDielectricPriority(1);
+  Material water;
+  water.setTransmissionValue(1.0);
+  water.setIndexOfRefraction(1.33);
+
+  PathState state;
+  EXPECT_FALSE(PathTracer::IsFalseHit(state, &glass, true));
+  PathTracer::CrossInterface(state, &glass, true);
+
+  EXPECT_TRUE(PathTracer::IsFalseHit(state, &water, true));
+  PathTracer::CrossInterface(state, &water, true);
+  EXPECT_EQ(PathTracer::EnclosingMedium(state), &glass);
+
+  EXPECT_TRUE(PathTracer::IsFalseHit(state, &water, false));
+  PathTracer::CrossInterface(state, &water, false);
+  EXPECT_FALSE(PathTracer::IsFalseHit(state, &glass, false));
+  PathTracer::CrossInterface(state, &glass, false);
+  EXPECT_EQ(state.media_count, 0);
+  EXPECT_EQ(PathTracer::EnclosingMedium(state), nullptr);
+}
+
+TEST(PathTracerTest, ApplyMediaUsesTheSurroundingIndexOfRefraction) {
+  Material glass;
+  glass.setTransmissionValue(1.0);
+  glass.setIndexOfRefraction(1.5);
+  Material water;
+  water.setTransmissionValue(1.0);
+  water.setIndexOfRefraction(1.33);
+
+  RayHitInfo hit;
+  hit.normal           = {0.0, 0.0, 1.0};
+  hit.geometric_normal = {0.0, 0.0, 1.0};
+  hit.material         = &water;
+
+  PathState state;
+  PathTracer::CrossInterface(state, &glass, true);
+
+  PBR::BRDFInput entering = PathTracer::CreateBrdfInput(hit, {0.0, 0.0, 1.0});
+  PathTracer::ApplyMedia(entering, hit, state);
+  EXPECT_DOUBLE_EQ(entering.eta, 1.33 / 1.5);
+
+  PathTracer::CrossInterface(state, &water, true);
+  PBR::BRDFInput leaving = PathTracer::CreateBrdfInput(hit, {0.0, 0.0, -1.0});
+  PathTracer::ApplyMedia(leaving, hit, state);
+  EXPECT_DOUBLE_EQ(leaving.eta, 1.5 / 1.33);
+}
+
+TEST(PathTracerTest, CrossInterfaceIgnoresMediaBeyondTheStack) {
+  Material  glass;
+  PathState state;
+  for(int i = 0; i < MAX_NESTED_DIELECTRICS + 2; ++i) {
+    PathTracer::CrossInterface(state, &glass, true);
+  }
+  EXPECT_EQ(state.media_count, MAX_NESTED_DIELECTRICS);
+
+  Material other;
+  PathTracer::CrossInterface(state, &other, false);
+  EXPECT_EQ(state.media_count, MAX_NESTED_DIELECTRICS);
+}
+
+TEST(PathTracerTest, TracesWithDefaultSettingsUntilSettingsAreSet) {
+  Material material;
+  auto     object = std::make_unique<Object3D>(CubeMeshBuilder(1.0).build());
+  object->setMaterial(&material);
+  Scene scene;
+  scene.addObject("cube", std::move(object));
+  scene.buildBVH();
+
+  PathTracer path_tracer;
+  path_tracer.setScene(&scene);
+  const Ray      ray   = Ray::FromPoint({0.0, 0.0, 3.0}, {0.0, 0.0, 0.0});
+  const ColorRGB color = path_tracer.traceRay(ray);
+  EXPECT_TRUE(std::isfinite(color.r) && std::isfinite(color.g) && std::isfinite(color.b));
+
+  path_tracer.setRenderSettings(nullptr);
+  const ColorRGB sky = path_tracer.traceRay(Ray::FromPoint({0.0, 0.0, 3.0}, {0.0, 0.0, 6.0}));
+  EXPECT_TRUE(std::isfinite(sky.r) && std::isfinite(sky.g) && std::isfinite(sky.b));
+}
@@ -2,7 +2,11 @@
 #include "Rendering/PathTracer/RayIntersection.hpp"
 #include "Scene/Scene.hpp"
 #include "Geometry/CubeMeshBuilder.hpp"
+#include "Geometry/DiskMeshBuilder.hpp"
+#include "Geometry/PlaneMeshBuilder.hpp"
+#include "Geometry/SphereMeshBuilder.hpp"
 #include "BVH/BVHNode.hpp"
+#include "Surface/Material.hpp"
 #include "Surface/Texture.hpp"
 #include "SceneObjects/Camera.hpp"
 
@@ -332,3 +336,221 @@ TEST(RayIntersectionTest, GetObjectNameFromHit) {
     EXPECT_EQ(object_name_1, "TestObject1");
     EXPECT_EQ(object_name_2, "TestObject2");
 }
+
+TEST(RayIntersectionTest, SinglePrecisionIntersection) {
+    const RayF ray(Ray::FromPoint({0, 0, -1}, {0, 0, 1}));
+    linalg::Vec3f p0(0, 1, 0), p1(-1, -1, 0), p2(1, -1, 0);
+
+    float distance = std::numeric_limits<float>::max();
+    linalg::Vec3f bary_coords;
+
+    bool success = RayIntersection::getTriangleIntersection(ray, p0, p1, p2, distance, bary_coords);
+    EXPECT_TRUE(success);
+    EXPECT_NEAR(distance, 1.0F, EPSILON);
+    EXPECT_NEAR(bary_coords.x, 0.5F, EPSILON);
+    EXPECT_NEAR(bary_coords.y, 0.25F, EPSILON);
+    EXPECT_NEAR(bary_coords.z, 0.25F, EPSILON);
+}
+
+TEST(RayIntersectionTest, OffsetRayOriginMovesAlongNormal) {
+    const linalg::Vec3d normal(0, 1, 0);
+    for(const double scale : {0.0, 1e-3, 1.0, 1e3, 1e5}) {
+        const linalg::Vec3d position(scale, scale, -scale);
+        const linalg::Vec3d above = RayIntersection::offsetRayOrigin(position, normal);
+        const linalg::Vec3d below = RayIntersection::offsetRayOrigin(position, -normal);
+
+        EXPECT_GT(static_cast<float>(above.y), static_cast<float>(position.y));
+        EXPECT_LT(static_cast<float>(below.y), static_cast<float>(position.y));
+        EXPECT_NEAR(above.y - position.y, 0.0, 1e-3 * std::max(1.0, scale));
+    }
+}
+
+TEST(RayIntersectionTest, SpawnedRayDoesNotHitItsOwnSurface) {
+    Vertex v0{{-1000, 0, -1000}, {0, 1, 0}, {0, 0}};
+    Vertex v1{{1000, 0, -1000}, {0, 1, 0}, {0, 0}};
+    Vertex v2{{0, 0, 1000}, {0, 1, 0}, {0, 0}};
+    Face face{{0, 1, 2}};
+
+    Mesh mesh({v0, v1, v2}, {face});
+    const Ray  ray = Ray::FromDirection({123.456, 50.0, -78.9}, linalg::Vec3d(0.3, -1.0, 0.2).normalized());
+    RayHitInfo hit = RayIntersection::getMeshIntersection(ray, mesh);
+    ASSERT_LT(hit.distance, std::numeric_limits<double>::max());
+
+    const Ray reflected = RayIntersection::spawnRay(hit, linalg::Vec3d(0.3, 1.0, 0.2).normalized());
+    EXPECT_EQ(RayIntersection::getMeshIntersection(reflected, mesh).distance, std::numeric_limits<double>::max());
+
+    const Ray transmitted = RayIntersection::spawnRay(hit, linalg::Vec3d(0.3, -1.0, 0.2).normalized());
+    EXPECT_GT(transmitted.origin.y, -1e-3);
+    EXPECT_LT(transmitted.origin.y, hit.position.y);
+}
+
+TEST(RayIntersectionTest, ObjectIntersectionComputesTextureFootprint) {
+  Vertex v0{{0, 0, 0}, {0, 0, 1}, {0, 0}};
+  Vertex v1{{2, 0, 0}, {0, 0, 1}, {1, 0}};
+  Vertex v2{{0, 2, 0}, {0, 0, 1}, {0, 1}};
+  Face   face{{0, 1, 2}};
+
+  Mesh     mesh({v0, v1, v2}, {face});
+  Object3D object(mesh);
+  Material material;
+  object.setMaterial(&material);
+
+  Ray ray  = Ray::FromPoint({0.5, 0.5, -4.0}, {0.5, 0.5, 0.0});
+  ray.cone = {0.0, 0.1};
+
+  const RayHitInfo hit = RayIntersection::getObjectIntersection(ray, &object);
+  EXPECT_NEAR(hit.distance, 4.0, EPSILON);
+  EXPECT_NEAR(hit.uv_area, 0.5, EPSILON);
+  EXPECT_NEAR(hit.cone.width, 0.4, EPSILON);
+  EXPECT_NEAR(hit.uv_footprint, 0.2, EPSILON);
+
+  const Ray spawned = RayIntersection::spawnRay(hit, {0.0, 0.0, -1.0});
+  EXPECT_NEAR(spawned.cone.width, 0.4, EPSILON);
+  EXPECT_NEAR(spawned.cone.spread_angle, 0.1, EPSILON);
+}
+
+TEST(RayIntersectionTest, DistantRayOriginHitsOnTheSurface) {
+  Vertex v0{{-1, -1, 0}, {0, 0, 1}, {0, 0}};
+  Vertex v1{{1, -1, 0}, {0, 0, 1}, {1, 0}};
+  Vertex v2{{0, 1, 0}, {0, 0, 1}, {0, 1}};
+  Face   face{{0, 1, 2}};
+
+  Mesh     mesh({v0, v1, v2}, {face});
+  Object3D object(mesh);
+  Material material;
+  object.setMaterial(&material);
+
+  // At this range the single precision distance along the ray puts its point off the surface, the hit must not be.
+  const Ray        ray = Ray::FromPoint({0.1234567, 0.0765432, -1e5}, {0.2345678, -0.1234567, 0.0});
+  const RayHitInfo hit = RayIntersection::getObjectIntersection(ray, &object);
+  ASSERT_LT(hit.distance, std::numeric_limits<double>::max());
+  EXPECT_NEAR(hit.position.x, 0.2345678, 1e-4);
+  EXPECT_NEAR(hit.position.y, -0.1234567, 1e-4);
+  EXPECT_NEAR(hit.position.z, 0.0, 1e-12);
+
+  const Ray reflected = RayIntersection::spawnRay(hit, linalg::Vec3d(0.3, 0.2, -1.0).normalized());
+  EXPECT_EQ(RayIntersection::getObjectIntersection(reflected, &object).distance, std::numeric_limits<double>::max());
+}
+
+TEST(RayIntersectionTest, SphereIntersectionFromOutsideAndInside) {
+  const Primitive sphere = Primitive::Sphere(2.0);
+
+  RayHitInfo hit = RayIntersection::getPrimitiveIntersection(Ray::FromDirection({0, 0, -10}, {0, 0, 1}), sphere);
+  EXPECT_NEAR(hit.distance, 8.0, EPSILON);
+  EXPECT_TRUE(hit.normal.isApprox(linalg::Vec3d(0, 0, -1), EPSILON));
+  EXPECT_TRUE(hit.geometric_normal.isApprox(hit.normal, EPSILON));
+
+  hit = RayIntersection::getPrimitiveIntersection(Ray::FromDirection({0, 0, 0}, {0, 0, 1}), sphere);
+  EXPECT_NEAR(hit.distance, 2.0, EPSILON);
+
+  hit = RayIntersection::getPrimitiveIntersection(Ray::FromDirection({0, 3, -10}, {0, 0, 1}), sphere);
+  EXPECT_EQ(hit.distance, std::numeric_limits<double>::max());
+  hit = RayIntersection::getPrimitiveIntersection(Ray::FromDirection({0, 0, 10}, {0, 0, 1}), sphere);
+  EXPECT_EQ(hit.distance, std::numeric_limits<double>::max());
+}
+
+TEST(RayIntersectionTest, AnalyticPrimitivesMatchTheirTessellation) {
+  const SphereMeshBuilder sphere_builder(1.5, 256, 128);
+  const PlaneMeshBuilder  plane_builder(4.0, 2.0);
+  const DiskMeshBuilder   disk_builder(1.0, 256);
+
+  for(const MeshBuilder* builder : std::initializer_list<const MeshBuilder*>{&sphere_builder, &plane_builder,
+                                                                              &disk_builder}) {
+    const Mesh      mesh      = builder->build();
+    const Primitive primitive = builder->getPrimitive();
+    ASSERT_TRUE(primitive.isAnalytic());
+
+    const Ray ray = Ray::FromPoint({0.7, 3.0, 0.3}, {0.2, 0.0, -0.4});
+    const RayHitInfo mesh_hit     = RayIntersection::getMeshIntersection(ray, mesh);
+    const RayHitInfo analytic_hit = RayIntersection::getPrimitiveIntersection(ray, primitive, mesh.getFaces().size());
+    ASSERT_LT(analytic_hit.distance, std::numeric_limits<double>::max());
+
+    EXPECT_NEAR(analytic_hit.distance, mesh_hit.distance, 1e-3);
+    EXPECT_NEAR(analytic_hit.bary_coords.u, mesh_hit.bary_coords.u, 1e-3);
+    EXPECT_NEAR(analytic_hit.bary_coords.v, mesh_hit.bary_coords.v, 1e-3);
+    EXPECT_TRUE(analytic_hit.normal.isApprox(mesh_hit.normal, 1e-3));
+    // The ratio of a triangle is its mean over the triangle, near the pole of the sphere it varies across a ring.
+    EXPECT_NEAR(analytic_hit.area / analytic_hit.uv_area, mesh_hit.area / mesh_hit.uv_area,
+                1e-1 * mesh_hit.area / mesh_hit.uv_area);
+    EXPECT_NEAR(analytic_hit.normal.dot(analytic_hit.tangent), 0.0, EPSILON);
+    EXPECT_NEAR(analytic_hit.normal.dot(analytic_hit.bitangent), 0.0, EPSILON);
+  }
+}
+
+TEST(RayIntersectionTest, QuadAndDiskBoundaries) {
+  const Ray inside_quad  = Ray::FromDirection({1.9, 1.0, 0.9}, {0, -1, 0});
+  const Ray outside_quad = Ray::FromDirection({2.1, 1.0, 0.0}, {0, -1, 0});
+  const Ray parallel     = Ray::FromDirection({0.0, 0.0, -5.0}, {0, 0, 1});
+  const Ray behind       = Ray::FromDirection({0.0, 1.0, 0.0}, {0, 1, 0});
+
+  const Primitive quad = Primitive::Quad(4.0, 2.0);
+  EXPECT_NEAR(RayIntersection::getPrimitiveIntersection(inside_quad, quad).distance, 1.0, EPSILON);
+  EXPECT_EQ(RayIntersection::getPrimitiveIntersection(outside_quad, quad).distance, std::numeric_limits<double>::max());
+  EXPECT_EQ(RayIntersection::getPrimitiveIntersection(parallel, quad).distance, std::numeric_limits<double>::max());
+  EXPECT_EQ(RayIntersection::getPrimitiveIntersection(behind, quad).distance, std::numeric_limits<double>::max());
+
+  const Primitive disk = Primitive::Disk(1.0);
+  EXPECT_EQ(RayIntersection::getPrimitiveIntersection(inside_quad, disk).distance, std::numeric_limits<double>::max());
+  const Ray        inside_disk = Ray::FromDirection({0.6, 1.0, 0.7}, {0, -1, 0});
+  const RayHitInfo hit         = RayIntersection::getPrimitiveIntersection(inside_disk, disk);
+  EXPECT_NEAR(hit.distance, 1.0, EPSILON);
+  EXPECT_NEAR(hit.bary_coords.u, 1.6, EPSILON);
+  EXPECT_NEAR(hit.bary_coords.v, 1.7, EPSILON);
+}
+
+TEST(RayIntersectionTest, SceneIntersectsTransformedAnalyticSphere) {
+  const SphereMeshBuilder builder(1.0, 16, 8);
+  auto object = std::make_unique<Object3D>(builder.build(), builder.getPrimitive());
+  object->setPosition({5.0, 0.0, 0.0});
+  object->setScale(2.0);
+
+  Scene scene;
+  scene.addObject("Sphere", std::move(object));
+  scene.buildBVH();
+
+  const Ray        ray = Ray::FromDirection({5.0, 0.0, -10.0}, {0, 0, 1});
+  const RayHitInfo hit = RayIntersection::getSceneIntersection(ray, &scene);
+  EXPECT_NEAR(hit.distance, 8.0, EPSILON);
+  EXPECT_TRUE(hit.position.isApprox(linalg::Vec3d(5.0, 0.0, -2.0), EPSILON));
+  EXPECT_TRUE(hit.normal.isApprox(linalg::Vec3d(0.0, 0.0, -1.0), EPSILON));
+}
+
+TEST(RayIntersectionTest, EmissivePrimitivesAreIntersectedAsTheirMesh) {
+  const SphereMeshBuilder builder(1.0, 16, 8);
+  const Mesh              mesh = builder.build();
+  Material                emissive;
+  emissive.setEmissiveIntensity(1.0);
+
+  Scene scene;
+  scene.addObject("Sphere", std::make_unique<Object3D>(mesh, builder.getPrimitive()));
+  Object3D* object = scene.getObject("Sphere");
+  object->setMaterial(&emissive);
+  scene.buildBVH();
+  EXPECT_FALSE(object->isIntersectedAnalytically());
+
+  // The light sampling picks the triangles of the emitter, the hit lies on them rather than on the sphere.
+  const Ray        ray = Ray::FromDirection({0.3, 0.2, -10.0}, {0, 0, 1});
+  const RayHitInfo hit = RayIntersection::getSceneIntersection(ray, &scene);
+  EXPECT_NEAR(hit.distance, RayIntersection::getMeshIntersection(ray, mesh).distance, 1e-5);
+  EXPECT_GT(std::abs(hit.distance - RayIntersection::getPrimitiveIntersection(ray, builder.getPrimitive()).distance),
+            1e-3);
+
+  object->setMaterial(nullptr);
+  EXPECT_TRUE(object->isIntersectedAnalytically());
+}
+
+TEST(RayIntersectionTest, DistantRaysIntersectLevelsOfDetail) {
+  const SphereMeshBuilder builder(1.0, 64, 32);
+  Scene scene;
+  scene.addObject("Sphere", std::make_unique<Object3D>(builder.build()));
+  scene.buildBVH(true);
+  ASSERT_GT(scene.getObjectList()[0]->getMesh().getLODCount(), 1U);
+
+  const Ray        ray      = Ray::FromDirection({0.1, 0.2, -100.0}, {0, 0, 1});
+  const RayHitInfo full_hit = RayIntersection::getSceneIntersection(ray, &scene);
+  const RayHitInfo near_hit = RayIntersection::getSceneIntersection(ray, &scene, 1000.0);
+  const RayHitInfo far_hit  = RayIntersection::getSceneIntersection(ray, &scene, 10.0);
+  EXPECT_EQ(near_hit.distance, full_hit.distance);
+  EXPECT_NEAR(far_hit.distance, full_hit.distance, 0.1);
+  EXPECT_NE(far_hit.distance, full_hit.distance);
+}
@@ -44,6 +44,62 @@ TEST(RenderSettingsTest, SamplesPerPixels) {
   EXPECT_EQ(settings.getSamplesPerPixel(), 9);
 }
 
+TEST(RenderSettingsTest, SetAndGetMaxPathDepth) {
+  RenderSettings settings;
+  EXPECT_EQ(settings.getMaxPathDepth(), DEFAULT_MAX_PATH_DEPTH);
+
+  settings.setMaxPathDepth(8);
+  EXPECT_EQ(settings.getMaxPathDepth(), 8);
+
+  settings.setMaxPathDepth(0);
+  EXPECT_EQ(settings.getMaxPathDepth(), MIN_MAX_PATH_DEPTH);
+}
+
+TEST(RenderSettingsTest, SetAndGetBounceLimits) {
+  RenderSettings settings;
+  EXPECT_EQ(settings.getMaxBounces(BounceType::GLOSSY), DEFAULT_MAX_BOUNCES);
+  EXPECT_EQ(settings.getRouletteStartDepth(), DEFAULT_ROULETTE_START_DEPTH);
+
+  settings.setMaxBounces(BounceType::DIFFUSE, 4);
+  settings.setMaxBounces(BounceType::TRANSMISSION, -1);
+  settings.setRouletteStartDepth(5);
+  EXPECT_EQ(settings.getMaxBounces(BounceType::DIFFUSE), 4);
+  EXPECT_EQ(settings.getMaxBounces(BounceType::GLOSSY), DEFAULT_MAX_BOUNCES);
+  EXPECT_EQ(settings.getMaxBounces(BounceType::TRANSMISSION), MIN_MAX_BOUNCES);
+  EXPECT_EQ(settings.getRouletteStartDepth(), 5);
+}
+
+TEST(RenderSettingsTest, SetAndGetIndirectClamp) {
+  RenderSettings settings;
+  EXPECT_EQ(settings.getIndirectClamp(), 0.0);
+
+  settings.setIndirectClamp(10.0);
+  EXPECT_EQ(settings.getIndirectClamp(), 10.0);
+
+  settings.setIndirectClamp(-1.0);
+  EXPECT_EQ(settings.getIndirectClamp(), MIN_INDIRECT_CLAMP);
+}
+
+TEST(RenderSettingsTest, SetAndGetPathRegularization) {
+  RenderSettings settings;
+  EXPECT_FALSE(settings.isPathRegularizationEnabled());
+
+  settings.setPathRegularization(true);
+  settings.setRegularizationRoughness(2.0);
+  EXPECT_TRUE(settings.isPathRegularizationEnabled());
+  EXPECT_EQ(settings.getRegularizationRoughness(), MAX_REGULARIZATION_ROUGHNESS);
+}
+
+TEST(RenderSettingsTest, SetAndGetLODDistance) {
+  RenderSettings settings;
+  EXPECT_EQ(settings.getLODDistance(), DEFAULT_LOD_DISTANCE);
+
+  settings.setLODDistance(25.0);
+  EXPECT_EQ(settings.getLODDistance(), 25.0);
+  settings.setLODDistance(-1.0);
+  EXPECT_EQ(settings.getLODDistance(), MIN_LOD_DISTANCE);
+}
+
 TEST(RendererSettingsTest, DefaultExecutionModeIsSingleThreaded) {
   RenderSettings settings;
 
@@ -56,6 +112,9 @@ TEST(RendererSettingsTest, SetAndGetExecutionMode) {
   settings.setRenderMode(RenderMode::MULTI_THREADED_CPU);
   EXPECT_EQ(settings.getRenderMode(), RenderMode::MULTI_THREADED_CPU);
 
+  settings.setRenderMode(RenderMode::WAVEFRONT_CPU);
+  EXPECT_EQ(settings.getRenderMode(), RenderMode::WAVEFRONT_CPU);
+
   settings.setRenderMode(RenderMode::SINGLE_THREADED);
   EXPECT_EQ(settings.getRenderMode(), RenderMode::SINGLE_THREADED);
 }
@@ -72,5 +72,123 @@ TEST_F(RendererTest, FramebufferUpdatesWhenRenderSettingsChange) {
   EXPECT_EQ(renderer.getFramebuffer()->getHeight(), 4);
 }
 
+TEST_F(RendererTest, WavefrontRenderFrameRendersSkybox) {
+  settings.setRenderMode(RenderMode::WAVEFRONT_CPU);
+  settings.setThreadCount(1);
+  Renderer renderer(&settings);
+  renderer.setScene(&scene);
+
+  Texture texture = Texture();
+  texture.setValue(ColorRGB(0.65, 0.65, 0.9));
+  texture.setColorSpace(ColorSpace::LINEAR);
+
+  scene.setSkybox(&texture);
+
+  ASSERT_TRUE(renderer.renderFrame());
+  const double* image = renderer.getFramebuffer()->getFramebuffer();
+
+  for(int i = 0; i < settings.getWidth() * settings.getHeight(); ++i) {
+    EXPECT_NEAR(image[i * 3 + 0], 0.65, 0.001);
+    EXPECT_NEAR(image[i * 3 + 1], 0.65, 0.001);
+    EXPECT_NEAR(image[i * 3 + 2], 0.9, 0.001);
+  }
+}
+
+TEST_F(RendererTest, WavefrontRenderFrameMatchesMultiThreaded) {
+  settings.setWidth(4);
+  settings.setHeight(4);
+  settings.setSamplesPerPixel(64);
+  settings.setThreadCount(1);
+
+  Texture sky_texture = Texture();
+  sky_texture.setValue(ColorRGB(1.0, 1.0, 1.0));
+  sky_texture.setColorSpace(ColorSpace::LINEAR);
+  scene.setSkybox(&sky_texture);
+
+  Texture diffuse_texture = Texture();
+  diffuse_texture.setValue(ColorRGB(0.3, 0.3, 0.3));
+  diffuse_texture.setColorSpace(ColorSpace::LINEAR);
+
+  Material material;
+  material.setDiffuseTexture(&diffuse_texture);
+  material.setRoughnessValue(1.0);
+
+  CubeMeshBuilder cube_builder(2.0);
+  auto            cube = std::make_unique<Object3D>(cube_builder.build());
+  cube->setPosition({0.0, 0.0, -3.0});
+  cube->setMaterial(&material);
+  scene.addObject("cube", std::move(cube));
 
+  const int center = ((settings.getHeight() / 2) * settings.getWidth() + settings.getWidth() / 2) * 3;
 
+  settings.setRenderMode(RenderMode::MULTI_THREADED_CPU);
+  Renderer reference_renderer(&settings);
+  reference_renderer.setScene(&scene);
+  ASSERT_TRUE(reference_renderer.renderFrame());
+  const double reference = reference_renderer.getFramebuffer()->getFramebuffer()[center];
+
+  settings.setRenderMode(RenderMode::WAVEFRONT_CPU);
+  Renderer renderer(&settings);
+  renderer.setScene(&scene);
+  ASSERT_TRUE(renderer.renderFrame());
+  const double* image = renderer.getFramebuffer()->getFramebuffer();
+
+  for(int i = 0; i < settings.getWidth() * settings.getHeight() * 3; ++i) {
+    EXPECT_TRUE(std::isfinite(image[i]));
+    EXPECT_GE(image[i], 0.0);
+  }
+  EXPECT_LT(image[center], 0.9);
+  EXPECT_NEAR(image[center], reference, 0.1);
+}
+
+TEST_F(RendererTest, RenderFrameRecordsPathStatistics) {
+  settings.setSamplesPerPixel(4);
+  settings.setMaxBounces(BounceType::DIFFUSE, 0);
+  settings.setMaxBounces(BounceType::GLOSSY, 0);
+
+  Texture diffuse_texture = Texture();
+  diffuse_texture.setValue(ColorRGB(0.5, 0.5, 0.5));
+  diffuse_texture.setColorSpace(ColorSpace::LINEAR);
+
+  Material material;
+  material.setDiffuseTexture(&diffuse_texture);
+
+  CubeMeshBuilder cube_builder(2.0);
+  auto            cube = std::make_unique<Object3D>(cube_builder.build());
+  cube->setPosition({0.0, 0.0, -3.0});
+  cube->setMaterial(&material);
+  scene.addObject("cube", std::move(cube));
+
+  Renderer renderer(&settings);
+  renderer.setScene(&scene);
+  ASSERT_TRUE(renderer.renderFrame());
+
+  const PathStatistics& statistics = renderer.getPathStatistics();
+  const std::uint64_t   path_count = settings.getWidth() * settings.getHeight() * settings.getSamplesPerPixel();
+  ASSERT_EQ(statistics.getDepthCount(), 1);
+  EXPECT_EQ(statistics.getRaysTraced(0), path_count);
+  EXPECT_EQ(statistics.getPathsTerminated(0), path_count);
+  EXPECT_DOUBLE_EQ(statistics.getAverageThroughput(0), 1.0);
+}
+
+TEST_F(RendererTest, PrepareFrameTessellatesSubdivisionSurfaces) {
+  settings.setWidth(512);
+  settings.setHeight(512);
+  Renderer renderer(&settings);
+  renderer.setScene(&scene);
+  scene.getCamera()->setPosition({0.0, 0.0, 5.0});
+  scene.addObject("cage", std::make_unique<Object3D>(CubeMeshBuilder(2.0).build()));
+  Object3D* cage = scene.getObject("cage");
+  cage->setSubdivisionSurface(true);
+
+  // The render thread leaves the tessellation as it is: the viewport may be reading it.
+  renderer.prepareFrame();
+  const int level = cage->getSubdivisionLevel();
+  EXPECT_GT(level, 0);
+
+  scene.getCamera()->setPosition({0.0, 0.0, 1e4});
+  settings.setWidth(2);
+  settings.setHeight(2);
+  ASSERT_TRUE(renderer.renderFrame());
+  EXPECT_EQ(cage->getSubdivisionLevel(), level);
+}
@@ -0,0 +1,106 @@
+#include "Scene/SceneImporter.hpp"
+#include "Scene/Scene.hpp"
+#include "SceneObjects/Object3D.hpp"
+#include "Geometry/Mesh.hpp"
+#include "Geometry/MeshCache.hpp"
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+class SceneImporterTest : public ::testing::Test {
+protected:
+  const std::string filename = "scene_importer_test.obj";
+  const std::string content  = "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nf 1 2 3 4\n";
+
+  void SetUp() override {
+    std::ofstream file(filename);
+    file << content;
+  }
+
+  void TearDown() override {
+    std::remove(filename.c_str());
+    std::remove("scene_importer_test.lmesh");
+  }
+};
+
+TEST_F(SceneImporterTest, ImportedObjectIsAddedToTheScene) {
+  Scene         scene;
+  SceneImporter importer(&scene);
+
+  std::vector<std::string>  names;
+  std::vector<ImportStatus> statuses;
+  importer.getImportFinishedObserver().add(
+      [&](SceneImporter::ImportID, ImportStatus status, const std::string& name) {
+        statuses.push_back(status);
+        names.push_back(name);
+      });
+
+  importer.importOBJ(filename, "Quad");
+  importer.importOBJ(filename, "Quad");
+  EXPECT_TRUE(importer.hasPendingImports());
+  importer.waitForImports();
+
+  EXPECT_FALSE(importer.hasPendingImports());
+  EXPECT_DOUBLE_EQ(importer.getProgress(), 1.0);
+  ASSERT_EQ(statuses.size(), 2);
+  EXPECT_EQ(statuses[0], ImportStatus::COMPLETED);
+  EXPECT_EQ(statuses[1], ImportStatus::COMPLETED);
+  EXPECT_NE(names[0], names[1]);
+
+  ASSERT_EQ(scene.getObjectList().size(), 2);
+  const Object3D* object = scene.getObject(names[0]);
+  ASSERT_NE(object, nullptr);
+  EXPECT_EQ(object->getMesh().getFaces().size(), 2);
+
+  // Both imports wrote the cache at once: the one left is complete.
+  const std::optional<Mesh> cached = MeshCache::read(MeshCache::getCachePath(filename), MeshCache::hashSource(content));
+  ASSERT_TRUE(cached.has_value());
+  EXPECT_EQ(cached->getFaces().size(), 2);
+}
+
+TEST_F(SceneImporterTest, MissingFileFails) {
+  Scene         scene;
+  SceneImporter importer(&scene);
+
+  ImportStatus status = ImportStatus::COMPLETED;
+  importer.getImportFinishedObserver().add(
+      [&](SceneImporter::ImportID, ImportStatus finished_status, const std::string&) { status = finished_status; });
+
+  importer.importOBJ("scene_importer_missing.obj", "Missing");
+  importer.waitForImports();
+
+  EXPECT_EQ(status, ImportStatus::FAILED);
+  EXPECT_TRUE(scene.getObjectList().empty());
+}
+
+TEST_F(SceneImporterTest, CancelledImportAddsNothing) {
+  Scene         scene;
+  SceneImporter importer(&scene);
+
+  ImportStatus status = ImportStatus::COMPLETED;
+  importer.getImportFinishedObserver().add(
+      [&](SceneImporter::ImportID, ImportStatus finished_status, const std::string&) { status = finished_status; });
+
+  const SceneImporter::ImportID id = importer.importOBJ(filename, "Quad");
+  EXPECT_TRUE(importer.cancelImport(id));
+  importer.waitForImports();
+
+  EXPECT_EQ(status, ImportStatus::CANCELLED);
+  EXPECT_TRUE(scene.getObjectList().empty());
+  EXPECT_FALSE(importer.cancelImport(id));
+}
+
+TEST_F(SceneImporterTest, DestroyingTheImporterCancelsPendingImports) {
+  Scene scene;
+  {
+    SceneImporter importer(&scene);
+    for(int i = 0; i < 8; ++i) {
+      importer.importOBJ(filename, "Quad");
+    }
+  }
+  EXPECT_TRUE(scene.getObjectList().empty());
+}
@@ -1,4 +1,5 @@
 #include "Scene/Scene.hpp"
+#include "Geometry/CubeMeshBuilder.hpp"
 #include "Scene/Skybox.hpp"
 #include "Lighting/DirectionalLight.hpp"
 #include "SceneObjects/Object3D.hpp"
@@ -202,4 +203,29 @@ TEST(SceneTest, SceneTest_GetAvailableLightName) {
   
   name = scene.getAvailableLightName("light");
   EXPECT_EQ(name, "light");
-}
\ No newline at end of file
+}
+TEST(SceneTest, TessellatesSubdivisionSurfacesFromTheCamera) {
+  Scene scene;
+  scene.addObject("cage", std::make_unique<Object3D>(CubeMeshBuilder(2.0).build()));
+  scene.addObject("mesh", std::make_unique<Object3D>(CubeMeshBuilder(2.0).build()));
+  Object3D* cage = scene.getObject("cage");
+  cage->setSubdivisionSurface(true);
+
+  constexpr double pixel_angle = 1e-2;
+  scene.tessellateSubdivisionSurfaces({0.0, 0.0, 1e4}, pixel_angle);
+  EXPECT_EQ(cage->getSubdivisionLevel(), 0);
+
+  scene.tessellateSubdivisionSurfaces({0.0, 0.0, 10.0}, pixel_angle);
+  const int near_level = cage->getSubdivisionLevel();
+  EXPECT_GT(near_level, 0);
+  EXPECT_EQ(scene.getObject("mesh")->getSubdivisionLevel(), 0);
+
+  // Doubling the scale of the object calls for one more level.
+  cage->setScale({2.0, 2.0, 2.0});
+  scene.tessellateSubdivisionSurfaces({0.0, 0.0, 10.0}, pixel_angle);
+  EXPECT_GT(cage->getSubdivisionLevel(), near_level);
+
+  scene.buildBVH();
+  const std::size_t cage_faces = cage->getMesh().getFaces().size();
+  EXPECT_EQ(cage->getRenderMesh().getFaces().size(), cage_faces << (2 * cage->getSubdivisionLevel()));
+}
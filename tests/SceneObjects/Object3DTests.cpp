@@ -1,9 +1,13 @@
 #include "SceneObjects/Object3D.hpp"
 #include "Geometry/CubeMeshBuilder.hpp"
+#include "Geometry/SphereMeshBuilder.hpp"
 #include "Surface/MaterialManager.hpp"
 #include "Surface/Material.hpp"
 
+#include <cmath>
 #include <gtest/gtest.h>
+#include <memory>
+#include <utility>
 
 TEST(Object3DTest, MeshConstructorTest) {
     Mesh mesh; 
@@ -21,6 +25,35 @@ TEST(Object3DTest, SetMeshTest) {
     EXPECT_EQ(obj.getMesh(), mesh1);
 }
 
+TEST(Object3DTest, SharedMeshIsNotCopied) {
+    auto mesh = std::make_shared<Mesh>(CubeMeshBuilder(1.0).build());
+
+    Object3D first(mesh);
+    Object3D second(mesh);
+    second.setPosition({5.0, 0.0, 0.0});
+
+    EXPECT_EQ(&first.getMesh(), mesh.get());
+    EXPECT_EQ(&second.getMesh(), mesh.get());
+    EXPECT_NE(first.getMaxBound(), second.getMaxBound());
+}
+
+TEST(Object3DTest, MovedMeshKeepsItsStorage) {
+    Mesh mesh = CubeMeshBuilder(1.0).build();
+    const linalg::Vec3f* positions = mesh.getStreams().positions.data();
+
+    Object3D obj(std::move(mesh));
+
+    EXPECT_EQ(obj.getMesh().getStreams().positions.data(), positions);
+}
+
+TEST(Object3DTest, NullSharedMeshIsEmpty) {
+    Object3D obj(std::shared_ptr<Mesh>{});
+    EXPECT_EQ(obj.getMesh().getVertexCount(), 0u);
+
+    obj.setMesh(std::shared_ptr<Mesh>{});
+    EXPECT_EQ(obj.getMesh().getVertexCount(), 0u);
+}
+
 TEST(Object3DTest, SetMaterialTest) {
     Mesh mesh;
     Object3D obj(mesh);
@@ -68,6 +101,44 @@ TEST(Object3DTest, BoundsTransformationTest) {
     linalg::Vec3d expectedMaxBound(1.0 + std::sqrt(8.0), 3.0, 3.0 + std::sqrt(8.0));
 }
 
+TEST(Object3DTest, BoundsFollowTransformationChanges) {
+    Object3D obj(CubeMeshBuilder(1.0).build());
+
+    obj.setPosition({1.0, 2.0, 3.0});
+    EXPECT_EQ(obj.getMinBound(), linalg::Vec3d(0.5, 1.5, 2.5));
+    EXPECT_EQ(obj.getMaxBound(), linalg::Vec3d(1.5, 2.5, 3.5));
+
+    obj.setScale(linalg::Vec3d(2.0, 2.0, 2.0));
+    obj.setRotationY(45.0);
+    EXPECT_NEAR(obj.getMinBound().x, 1.0 - std::sqrt(2.0), 1e-9);
+    EXPECT_NEAR(obj.getMaxBound().x, 1.0 + std::sqrt(2.0), 1e-9);
+    EXPECT_NEAR(obj.getMinBound().y, 1.0, 1e-9);
+    EXPECT_NEAR(obj.getMaxBound().y, 3.0, 1e-9);
+}
+
+TEST(Object3DTest, BoundsFollowMeshChanges) {
+    Object3D obj;
+    obj.setPosition({1.0, 0.0, 0.0});
+    EXPECT_EQ(obj.getMaxBound(), linalg::Vec3d(0.0));
+
+    obj.setMesh(CubeMeshBuilder(2.0).build());
+    EXPECT_EQ(obj.getMinBound(), linalg::Vec3d(0.0, -1.0, -1.0));
+    EXPECT_EQ(obj.getMaxBound(), linalg::Vec3d(2.0, 1.0, 1.0));
+}
+
+TEST(Object3DTest, PrimitiveBoundsAndMeshReset) {
+    const SphereMeshBuilder builder(2.0, 8, 4);
+    Object3D obj(builder.build(), builder.getPrimitive());
+    obj.setPosition({1.0, 0.0, 0.0});
+    EXPECT_EQ(obj.getPrimitive().type, PrimitiveType::SPHERE);
+    EXPECT_EQ(obj.getMinBound(), linalg::Vec3d(-1.0, -2.0, -2.0));
+    EXPECT_EQ(obj.getMaxBound(), linalg::Vec3d(3.0, 2.0, 2.0));
+
+    obj.setMesh(CubeMeshBuilder(1.0).build());
+    EXPECT_FALSE(obj.getPrimitive().isAnalytic());
+    EXPECT_EQ(obj.getMaxBound(), linalg::Vec3d(1.5, 0.5, 0.5));
+}
+
 TEST(Object3DTest, MaterialChangedObserverTest) {
     Mesh mesh;
     Object3D obj(mesh);
@@ -105,4 +176,30 @@ TEST(Object3DTest, SetMaterialNullptrTest) {
 
     obj.setMaterial(nullptr);
     EXPECT_EQ(obj.getMaterial(), MaterialManager::DefaultMaterial());
-}
\ No newline at end of file
+}
+TEST(Object3DTest, SubdivisionSurfaceTessellation) {
+    Object3D obj(CubeMeshBuilder(2.0).build());
+    const std::size_t cage_faces = obj.getMesh().getFaces().size();
+
+    // Plain meshes ignore the subdivision level.
+    obj.setSubdivisionLevel(2);
+    EXPECT_EQ(obj.getSubdivisionLevel(), 0);
+    EXPECT_EQ(&obj.getRenderMesh(), &obj.getMesh());
+
+    obj.setSubdivisionSurface(true);
+    obj.setSubdivisionLevel(2);
+    EXPECT_EQ(obj.getSubdivisionLevel(), 2);
+    EXPECT_EQ(obj.getMesh().getFaces().size(), cage_faces);
+    EXPECT_EQ(obj.getRenderMesh().getFaces().size(), cage_faces * 16);
+
+    obj.setSubdivisionSurface(false);
+    EXPECT_EQ(obj.getSubdivisionLevel(), 0);
+    EXPECT_EQ(&obj.getRenderMesh(), &obj.getMesh());
+
+    obj.setSubdivisionSurface(true);
+    obj.setSubdivisionLevel(1);
+    obj.setMesh(CubeMeshBuilder(1.0).build());
+    EXPECT_TRUE(obj.isSubdivisionSurface());
+    EXPECT_EQ(obj.getSubdivisionLevel(), 0);
+    EXPECT_EQ(&obj.getRenderMesh(), &obj.getMesh());
+}
@@ -210,3 +210,72 @@ TEST(MaterialTest, ObserverMultipleCallbacks) {
 
     EXPECT_EQ(counter, 11);
 }
+
+TEST(MaterialTest, RecordInlinesConstantTextures) {
+    Material material;
+    Texture texture;
+    texture.setValue(ColorRGB(0.25, 0.5, 0.75));
+    material.setDiffuseTexture(&texture);
+
+    const MaterialRecord& record = material.getRecord();
+    EXPECT_EQ(record.diffuse.texture, nullptr);
+    EXPECT_EQ(record.normal.texture, nullptr);
+    EXPECT_EQ(record.diffuse.sample({0.3, 0.7}, 0.0), material.getDiffuse({0.3, 0.7}));
+    EXPECT_EQ(record.normal.sample({0.3, 0.7}, 0.0), ColorRGB(0.5, 0.5, 1.0));
+}
+
+TEST(MaterialTest, RecordKeepsImageTextures) {
+    Material material;
+    Texture texture;
+    texture.generateTexture({2, 2, 3}, {0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 0.5, 0.5, 0.5, 0.25, 0.25, 0.25});
+    material.setDiffuseTexture(&texture);
+
+    EXPECT_EQ(material.getRecord().diffuse.texture, &texture);
+    EXPECT_EQ(material.getRecord().diffuse.sample({0.1, 0.9}, 0.0), material.getDiffuse({0.1, 0.9}));
+}
+
+TEST(MaterialTest, RecordUsesRoughnessValueWithoutTexture) {
+    Material material;
+    Texture texture;
+    texture.generateTexture({2, 1, 1}, {0.1, 0.9});
+    material.setRoughnessTexture(&texture);
+    material.setRoughnessValue(0.7);
+
+    EXPECT_EQ(material.getRecord().roughness.texture, nullptr);
+    EXPECT_DOUBLE_EQ(material.getRecord().roughness.sample({0.5, 0.5}, 0.0), 0.7);
+
+    material.setUseTextureRoughness(true);
+    EXPECT_EQ(material.getRecord().roughness.texture, &texture);
+}
+
+TEST(MaterialTest, RecordDoesNotFoldBorderedTextures) {
+    Material material;
+    Texture texture;
+    texture.setValue(ColorRGB(0.2, 0.2, 0.2));
+    texture.setWrappingMode(TextureSampling::TextureWrapping::CLAMP_TO_BORDER);
+    material.setDiffuseTexture(&texture);
+
+    EXPECT_EQ(material.getRecord().diffuse.texture, &texture);
+}
+
+TEST(MaterialTest, RecordEmissionScalesWithIntensity) {
+    Material material;
+    Texture texture;
+    texture.setValue(ColorRGB(1.0, 0.5, 0.0));
+    material.setEmissiveTexture(&texture);
+    EXPECT_EQ(material.getRecord().getEmission({0, 0}, 0.0), ColorRGB(0.0));
+
+    material.setEmissiveIntensity(2.0);
+    EXPECT_EQ(material.getRecord().getEmission({0, 0}, 0.0), material.getEmissive({0, 0}) * 2.0);
+}
+
+TEST(MaterialTest, CompileRefreshesEditedTextures) {
+    Material material;
+    Texture texture;
+    texture.setValue(ColorRGB(0.2, 0.2, 0.2));
+    material.setDiffuseTexture(&texture);
+
+    texture.setValue(ColorRGB(0.6, 0.6, 0.6));
+    material.compile();
+    EXPECT_EQ(material.getRecord().diffuse.sample({0, 0}, 0.0), material.getDiffuse({0, 0}));
+}
@@ -38,4 +38,20 @@ TEST(TextureFilteringTest, BilinearFilter) {
   EXPECT_EQ(sample_info.y1, 3);
   EXPECT_NEAR(sample_info.dx, 0.0, 1e-6);
   EXPECT_NEAR(sample_info.dy, 0.5, 1e-6);
-}
\ No newline at end of file
+}
+TEST(TextureFilteringTest, ComputeMipLevel) {
+  const Resolution resolution{256, 256};
+  EXPECT_DOUBLE_EQ(TextureSampling::computeMipLevel(0.0, resolution), 0.0);
+  EXPECT_DOUBLE_EQ(TextureSampling::computeMipLevel(1.0 / 512.0, resolution), 0.0);
+  EXPECT_NEAR(TextureSampling::computeMipLevel(4.0 / 256.0, resolution), 2.0, 1e-12);
+  EXPECT_NEAR(TextureSampling::computeMipLevel(1.0, resolution), 8.0, 1e-12);
+}
+
+TEST(TextureFilteringTest, GetMipResolution) {
+  const Resolution resolution{8, 3};
+  EXPECT_EQ(TextureSampling::getMipResolution(resolution, 0).width, 8);
+  EXPECT_EQ(TextureSampling::getMipResolution(resolution, 1).width, 4);
+  EXPECT_EQ(TextureSampling::getMipResolution(resolution, 1).height, 1);
+  EXPECT_EQ(TextureSampling::getMipResolution(resolution, 3).width, 1);
+  EXPECT_EQ(TextureSampling::getMipResolution(resolution, 3).height, 1);
+}
@@ -73,6 +73,31 @@ TEST(TextureLoaderTest, LoadValidHDRImage) {
   std::remove(testHDRImageFilename.c_str());
 }
 
+TEST(TextureLoaderTest, LoadKeepsNativeFormat) {
+  std::string ldrFilename = "test_native_texture.png";
+  std::string hdrFilename = "test_native_texture.hdr";
+
+  unsigned char ldrData[3] = {255, 128, 0};
+  float hdrData[3] = {4.0f, 0.5f, 0.0f};
+  stbi_write_png(ldrFilename.c_str(), 1, 1, 3, ldrData, 3);
+  stbi_write_hdr(hdrFilename.c_str(), 1, 1, 3, hdrData);
+
+  TextureStorage storage;
+  ImageProperties textureProperties;
+
+  TextureLoader::load(ldrFilename.c_str(), storage, textureProperties);
+  EXPECT_EQ(storage.getFormat(), TexelFormat::UNORM8);
+  EXPECT_EQ(storage.getMemorySize(), 3U);
+  EXPECT_NEAR(storage.load(1), 128.0 / 255.0, 1e-9);
+
+  TextureLoader::load(hdrFilename.c_str(), storage, textureProperties);
+  EXPECT_EQ(storage.getFormat(), TexelFormat::FLOAT32);
+  EXPECT_NEAR(storage.load(0), 4.0, 1e-6);
+
+  std::remove(ldrFilename.c_str());
+  std::remove(hdrFilename.c_str());
+}
+
 TEST(TextureLoaderTest, LoadInvalidImage) {
   std::string invalidImageFilename = "invalid_texture.png";
 
@@ -1,6 +1,15 @@
 #include <gtest/gtest.h>
+
+#include <filesystem>
+#include <future>
+#include <string>
+#include <vector>
+
 #include "Surface/TextureManager.hpp"
 #include "Surface/Texture.hpp"
+#include "Surface/TiledTextureFile.hpp"
+
+#include "stb_image_write.h"
 
 TEST(TextureManagerTest, AddTextureAndAvoidDuplicates) {
     TextureManager manager;
@@ -171,3 +180,74 @@ TEST(TextureManagerTest, GetAllTexturesNameReturnsAllNames) {
     EXPECT_NE(std::find(names.begin(), names.end(), "t2"), names.end());
     EXPECT_NE(std::find(names.begin(), names.end(), "t3"), names.end());
 }
+
+TEST(TextureManagerTest, LoadTextureAsyncUpdatesTextureOnProcess) {
+  const std::string path = (std::filesystem::temp_directory_path() / "lumen_async.ltex").string();
+  TextureStorage    image;
+  image.setFloat32({0.25F, 0.5F, 0.75F, 1.0F});
+  image.setImageLayout({2, 2}, 1);
+  ASSERT_TRUE(TiledTextureFile::Write(path, image, false));
+
+  TextureManager manager;
+  int            notification_count = 0;
+  manager.addTexture("async");
+  manager.getTexture("async")->getTextureDataObserver().add([&]() { ++notification_count; });
+  manager.getTexture("async")->setColorSpace(ColorSpace::S_RGB);
+
+  std::future<Texture*> loaded = manager.loadTextureAsync("async", path);
+  EXPECT_TRUE(manager.hasPendingTextures());
+  manager.waitForLoadedTextures();
+  EXPECT_FALSE(manager.hasPendingTextures());
+
+  Texture* texture = loaded.get();
+  ASSERT_EQ(texture, manager.getTexture("async"));
+  EXPECT_EQ(notification_count, 1);
+  EXPECT_EQ(texture->getTexturePath(), path);
+  EXPECT_EQ(texture->getProperties().width, 2);
+  EXPECT_EQ(texture->getColorSpace(), ColorSpace::S_RGB);
+  EXPECT_NEAR(texture->getPreviewData()[1], 0.5 * 255.0, 1.0);
+  std::filesystem::remove(path);
+}
+
+TEST(TextureManagerTest, LoadTextureAsyncBuildsSamplingDataOnWorker) {
+  const std::string  path = (std::filesystem::temp_directory_path() / "lumen_async_mips.hdr").string();
+  std::vector<float> pixels(4 * 4 * 3, 0.5F);
+  ASSERT_NE(stbi_write_hdr(path.c_str(), 4, 4, 3, pixels.data()), 0);
+
+  TextureManager manager;
+  manager.addTexture("async");
+  Texture* texture = manager.getTexture("async");
+  texture->setColorSpace(ColorSpace::LINEAR);
+  texture->setFilteringMode(TextureSampling::TextureFiltering::TRILINEAR);
+
+  manager.loadTextureAsync("async", path);
+  manager.waitForLoadedTextures();
+
+  // The mip levels and the linear data come with the image, sampling the coarsest level reads converted values.
+  EXPECT_EQ(texture->getMipLevelCount(), 3);
+  EXPECT_NEAR(texture->getValue1d({0.5, 0.5}, 1.0), ColorRGB(0.5).toLinearSpace().r, 1e-3);
+  std::filesystem::remove(path);
+}
+
+TEST(TextureManagerTest, LoadManyTexturesAsync) {
+  TextureManager                     manager;
+  std::vector<std::future<Texture*>> loads;
+  for(int i = 0; i < 16; ++i) {
+    loads.push_back(manager.loadTextureAsync("missing" + std::to_string(i), "missing_file.png"));
+  }
+  manager.waitForLoadedTextures();
+
+  for(int i = 0; i < 16; ++i) {
+    Texture* texture = loads[i].get();
+    ASSERT_EQ(texture, manager.getTexture("missing" + std::to_string(i)));
+    EXPECT_EQ(texture->getTexturePath(), "missing_file.png");
+  }
+}
+
+TEST(TextureManagerTest, RemovedTextureIsNotLoaded) {
+  TextureManager        manager;
+  std::future<Texture*> loaded = manager.loadTextureAsync("removed", "missing_file.png");
+  manager.removeTexture("removed");
+  manager.waitForLoadedTextures();
+  EXPECT_EQ(loaded.get(), nullptr);
+}
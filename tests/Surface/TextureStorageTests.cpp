@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+
+#include "Surface/TextureStorage.hpp"
+
+TEST(TextureStorageTest, HalfRoundTrip) {
+  for(const float value : {0.0F, 1.0F, -2.5F, 0.333F, 1000.0F, 65504.0F, 6.1e-5F, 3.0e-7F}) {
+    const float converted = Half::FromFloat(value).toFloat();
+    EXPECT_NEAR(converted, value, std::abs(value) * 1e-3F + 1e-7F);
+  }
+}
+
+TEST(TextureStorageTest, HalfSpecialValues) {
+  EXPECT_TRUE(std::isinf(Half::FromFloat(1e6F).toFloat()));
+  EXPECT_TRUE(std::isinf(Half::FromFloat(std::numeric_limits<float>::infinity()).toFloat()));
+  EXPECT_TRUE(std::isnan(Half::FromFloat(std::numeric_limits<float>::quiet_NaN()).toFloat()));
+  EXPECT_EQ(Half::FromFloat(1.0F).bits, 0x3C00);
+}
+
+TEST(TextureStorageTest, Unorm8DecodesToNormalized) {
+  TextureStorage storage;
+  storage.setUnorm8({0, 128, 255});
+
+  EXPECT_EQ(storage.getFormat(), TexelFormat::UNORM8);
+  EXPECT_EQ(storage.size(), 3U);
+  EXPECT_EQ(storage.getMemorySize(), 3U);
+  EXPECT_DOUBLE_EQ(storage.load(0), 0.0);
+  EXPECT_NEAR(storage.load(1), 128.0 / 255.0, 1e-12);
+  EXPECT_DOUBLE_EQ(storage.load(2), 1.0);
+  EXPECT_EQ(storage.data<double>(), nullptr);
+  ASSERT_NE(storage.data<std::uint8_t>(), nullptr);
+}
+
+TEST(TextureStorageTest, ConvertKeepsValues) {
+  TextureStorage storage;
+  storage.setFloat64({0.25, 2.0, 0.5, 1.0});
+
+  storage.convertTo(TexelFormat::HALF);
+  EXPECT_EQ(storage.getFormat(), TexelFormat::HALF);
+  EXPECT_EQ(storage.getMemorySize(), 4U * sizeof(Half));
+  EXPECT_DOUBLE_EQ(storage.load(1), 2.0);
+
+  storage.convertTo(TexelFormat::UNORM8);
+  EXPECT_DOUBLE_EQ(storage.load(0), 64.0 / 255.0);
+  EXPECT_DOUBLE_EQ(storage.load(1), 1.0);
+}
+
+TEST(TextureStorageTest, FlipRows) {
+  TextureStorage storage;
+  storage.setFloat32({1.0F, 2.0F, 3.0F, 4.0F, 5.0F, 6.0F});
+  storage.flipRows(1, 3, 2);
+
+  EXPECT_DOUBLE_EQ(storage.load(0), 5.0);
+  EXPECT_DOUBLE_EQ(storage.load(1), 6.0);
+  EXPECT_DOUBLE_EQ(storage.load(2), 3.0);
+  EXPECT_DOUBLE_EQ(storage.load(4), 1.0);
+}
+
+TEST(TextureStorageTest, SRGBLutMatchesConversion) {
+  for(int i = 0; i <= COLOR8_MAX_VALUE; ++i) {
+    double expected = i * COLOR8_TO_NORMALIZED;
+    convertToLinearSpace(expected);
+    EXPECT_DOUBLE_EQ(decodeSRGBTexel(static_cast<std::uint8_t>(i)), expected);
+  }
+}
+
+TEST(TextureStorageTest, ToLinearSpaceKeepsAlpha) {
+  TextureStorage storage;
+  storage.setFloat64({0.5, 0.5, 0.5, 0.5});
+
+  const TextureStorage linear = storage.toLinearSpace(4);
+  double               color  = 0.5;
+  convertToLinearSpace(color);
+  EXPECT_EQ(linear.getFormat(), TexelFormat::FLOAT64);
+  EXPECT_DOUBLE_EQ(linear.load(0), color);
+  EXPECT_DOUBLE_EQ(linear.load(2), color);
+  EXPECT_DOUBLE_EQ(linear.load(3), 0.5);
+  EXPECT_DOUBLE_EQ(storage.load(0), 0.5);
+
+  storage.convertTo(TexelFormat::UNORM8);
+  EXPECT_EQ(storage.toLinearSpace(4).getFormat(), TexelFormat::HALF);
+}
+
+TEST(TextureStorageTest, DownsampleAveragesTexels) {
+  TextureStorage storage;
+  storage.setFloat32({0.0F, 1.0F, 2.0F, 3.0F, 4.0F, 5.0F, 6.0F, 7.0F, 8.0F});
+  storage.setImageLayout({3, 3}, 1);
+
+  const TextureStorage level = storage.downsample(false);
+  EXPECT_EQ(level.getFormat(), TexelFormat::FLOAT32);
+  ASSERT_EQ(level.size(), 1U);
+  EXPECT_DOUBLE_EQ(level.load(0), 2.0);
+}
+
+TEST(TextureStorageTest, DownsampleSRGBAveragesInLinearSpace) {
+  TextureStorage storage;
+  storage.setUnorm8({0, 255, 0, 255});
+  storage.setImageLayout({2, 2}, 1);
+
+  const TextureStorage level = storage.downsample(true);
+  double               mean  = 0.5;
+  convertToSRGBSpace(mean);
+  EXPECT_NEAR(level.load(0), mean, 1.0 / 255.0);
+
+  const TextureStorage raw_level = storage.downsample(false);
+  EXPECT_NEAR(raw_level.load(0), 0.5, 1.0 / 255.0);
+}
+
+TEST(TextureStorageTest, LargeImagesAreStoredInTiles) {
+  const Resolution    resolution{20, 10};
+  std::vector<double> values(static_cast<std::size_t>(resolution.width) * resolution.height * 2);
+  for(std::size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<double>(i);
+  }
+
+  TextureStorage storage;
+  storage.setFloat64(values);
+  storage.setImageLayout(resolution, 2);
+  EXPECT_TRUE(storage.getLayout().tiled);
+  EXPECT_EQ(storage.size(), 3U * 2U * TEXTURE_TILE_SIZE * TEXTURE_TILE_SIZE * 2U);
+
+  for(int y = 0; y < resolution.height; ++y) {
+    for(int x = 0; x < resolution.width; ++x) {
+      const std::size_t scanline_index = ((static_cast<std::size_t>(y) * resolution.width) + x) * 2;
+      EXPECT_DOUBLE_EQ(storage.load(storage.getTexelIndex(x, y)), values[scanline_index]);
+      EXPECT_DOUBLE_EQ(storage.load(storage.getTexelIndex(x, y) + 1), values[scanline_index + 1]);
+    }
+  }
+  EXPECT_EQ(storage.getTexelIndex(1, 1) - storage.getTexelIndex(0, 0), (TEXTURE_TILE_SIZE + 1U) * 2U);
+
+  const TextureStorage scanline = storage.toScanlineLayout();
+  EXPECT_FALSE(scanline.getLayout().tiled);
+  ASSERT_EQ(scanline.size(), values.size());
+  for(std::size_t i = 0; i < values.size(); ++i) {
+    EXPECT_DOUBLE_EQ(scanline.load(i), values[i]);
+  }
+}
+
+TEST(TextureStorageTest, SmallImagesStayInScanlineOrder) {
+  TextureStorage storage;
+  storage.setFloat64(std::vector<double>(4 * 16, 0.0));
+  storage.setImageLayout({4, 16}, 1);
+  EXPECT_FALSE(storage.getLayout().tiled);
+  EXPECT_EQ(storage.getTexelIndex(1, 2), 9U);
+}
+
+TEST(TextureStorageTest, FlipRowsOfTiledImage) {
+  const Resolution    resolution{9, 12};
+  std::vector<double> values(static_cast<std::size_t>(resolution.width) * resolution.height);
+  for(std::size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<double>(i / resolution.width);
+  }
+
+  TextureStorage storage;
+  storage.setFloat64(values);
+  storage.setImageLayout(resolution, 1);
+  storage.flipRows(resolution.width, resolution.height, 1);
+
+  EXPECT_TRUE(storage.getLayout().tiled);
+  EXPECT_DOUBLE_EQ(storage.load(storage.getTexelIndex(3, 0)), 11.0);
+  EXPECT_DOUBLE_EQ(storage.load(storage.getTexelIndex(8, 11)), 0.0);
+}
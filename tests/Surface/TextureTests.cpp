@@ -1,7 +1,11 @@
 #include <gtest/gtest.h>
 
+#include <filesystem>
+#include <string>
+
 #include "Core/Color.hpp"
 #include "Surface/Texture.hpp"
+#include "Surface/TiledTextureFile.hpp"
 
 TEST(TextureTest, ConstructFromDouble) {
   Texture texture;
@@ -380,4 +384,159 @@ TEST(TextureTest, TextureParametersObserver) {
   notified = false;
   texture.setColorSpace(ColorSpace::LINEAR);
   EXPECT_TRUE(notified);
-}
\ No newline at end of file
+}
+TEST(TextureTest, SetStorageFormatKeepsSampledValues) {
+  ImageProperties     properties{2, 1, 3};
+  std::vector<double> image_data = {0.2, 0.4, 0.6, 1.5, 3.0, 0.0};
+
+  Texture texture;
+  texture.generateTexture(properties, image_data);
+  texture.setFilteringMode(TextureSampling::TextureFiltering::NEAREST);
+  texture.setColorSpace(ColorSpace::S_RGB);
+  EXPECT_EQ(texture.getStorageFormat(), TexelFormat::FLOAT64);
+
+  texture.setStorageFormat(TexelFormat::HALF);
+  EXPECT_EQ(texture.getStorageFormat(), TexelFormat::HALF);
+  EXPECT_EQ(texture.getImageData(), nullptr);
+
+  const ColorRGB value = texture.getValue3d({0.75, 0.5});
+  EXPECT_NEAR(value.r, 1.5, 1e-3);
+  EXPECT_NEAR(value.g, 3.0, 1e-3);
+  EXPECT_NEAR(value.b, 0.0, 1e-3);
+}
+
+TEST(TextureTest, LinearColorSpaceOnUnorm8UsesLut) {
+  ImageProperties     properties{1, 1, 4};
+  std::vector<double> image_data = {0.0, 128.0 / 255.0, 1.0, 128.0 / 255.0};
+
+  Texture texture;
+  texture.generateTexture(properties, image_data);
+  texture.setStorageFormat(TexelFormat::UNORM8);
+  texture.setColorSpace(ColorSpace::LINEAR);
+
+  double expected = 128.0 / 255.0;
+  convertToLinearSpace(expected);
+  const ColorRGBA value = texture.getValue4d({0.5, 0.5});
+  EXPECT_DOUBLE_EQ(value.r, 0.0);
+  EXPECT_DOUBLE_EQ(value.g, expected);
+  EXPECT_DOUBLE_EQ(value.b, 1.0);
+  EXPECT_DOUBLE_EQ(value.a, 128.0 / 255.0);
+
+  texture.setColorSpace(ColorSpace::S_RGB);
+  EXPECT_DOUBLE_EQ(texture.getValue4d({0.5, 0.5}).g, 128.0 / 255.0);
+}
+
+TEST(TextureTest, LinearDataFollowsDataChanges) {
+  Texture texture;
+  texture.setColorSpace(ColorSpace::LINEAR);
+  texture.setValue(ColorRGB(0.5, 0.5, 0.5));
+
+  double expected = 0.5;
+  convertToLinearSpace(expected);
+  EXPECT_NEAR(texture.getValue3d({0.0, 0.0}).r, expected, 1e-9);
+
+  texture.setStorageFormat(TexelFormat::FLOAT32);
+  EXPECT_NEAR(texture.getValue3d({0.0, 0.0}).r, expected, 1e-6);
+}
+
+TEST(TextureTest, TrilinearFilteringUsesMipLevels) {
+  ImageProperties     properties{4, 4, 1};
+  std::vector<double> image_data(16);
+  for(int i = 0; i < 16; ++i) {
+    image_data[i] = ((i % 4) + (i / 4)) % 2 == 0 ? 1.0 : 0.0;
+  }
+
+  Texture texture;
+  texture.generateTexture(properties, image_data);
+  texture.setColorSpace(ColorSpace::S_RGB);
+  EXPECT_EQ(texture.getMipLevelCount(), 1);
+
+  texture.setFilteringMode(TextureSampling::TextureFiltering::TRILINEAR);
+  EXPECT_EQ(texture.getMipLevelCount(), 3);
+
+  EXPECT_NEAR(texture.getValue1d({0.125, 0.125}), 1.0, 1e-9);
+  EXPECT_NEAR(texture.getValue1d({0.125, 0.125}, 1.0), 0.5, 1e-9);
+  EXPECT_NEAR(texture.getValue1d({0.125, 0.125}, 0.5), 0.5, 1e-9);
+
+  texture.setFilteringMode(TextureSampling::TextureFiltering::BILINEAR);
+  EXPECT_EQ(texture.getMipLevelCount(), 1);
+  EXPECT_NEAR(texture.getValue1d({0.125, 0.125}, 1.0), 1.0, 1e-9);
+}
+
+TEST(TextureTest, TiledTextureSamplesLikeScanline) {
+  ImageProperties     properties{32, 24, 3};
+  std::vector<double> image_data(properties.bufferSize());
+  for(std::size_t i = 0; i < image_data.size(); ++i) {
+    image_data[i] = static_cast<double>(i % 97) / 97.0;
+  }
+
+  Texture texture;
+  texture.generateTexture(properties, image_data);
+  texture.setColorSpace(ColorSpace::S_RGB);
+  texture.setFilteringMode(TextureSampling::TextureFiltering::NEAREST);
+  EXPECT_TRUE(texture.getStorage().getLayout().tiled);
+
+  for(int y = 0; y < properties.height; ++y) {
+    for(int x = 0; x < properties.width; ++x) {
+      const TextureUV   uv{(x + 0.5) / properties.width, (y + 0.5) / properties.height};
+      const std::size_t index = ((static_cast<std::size_t>(y) * properties.width) + x) * 3;
+      const ColorRGB    value = texture.getValue3d(uv);
+      EXPECT_DOUBLE_EQ(value.r, image_data[index]);
+      EXPECT_DOUBLE_EQ(value.b, image_data[index + 2]);
+    }
+  }
+}
+
+TEST(TextureTest, StreamedTextureSamplesLikeResident) {
+  ImageProperties     properties{37, 21, 3};
+  std::vector<double> image_data(properties.bufferSize());
+  for(std::size_t i = 0; i < image_data.size(); ++i) {
+    image_data[i] = static_cast<double>(i % 89) / 89.0;
+  }
+
+  Texture resident;
+  resident.generateTexture(properties, image_data);
+  const std::string path = (std::filesystem::temp_directory_path() / "lumen_streamed.ltex").string();
+  ASSERT_TRUE(TiledTextureFile::Write(path, resident.getStorage(), false, 16));
+
+  Texture streamed;
+  streamed.loadFromFile(path.c_str());
+  ASSERT_TRUE(streamed.isStreamed());
+  EXPECT_EQ(streamed.getStorage().size(), 0U);
+  EXPECT_EQ(streamed.getProperties().width, properties.width);
+  EXPECT_EQ(streamed.getMipLevelCount(), 6);
+  EXPECT_EQ(streamed.getPreviewProperties().width, properties.width);
+
+  const auto expect_same_samples = [&](double uv_footprint) {
+    for(int i = 0; i < 50; ++i) {
+      const TextureUV uv{0.013 + (0.021 * i), 0.97 - (0.017 * i)};
+      const ColorRGB  expected = resident.getValue3d(uv, uv_footprint);
+      const ColorRGB  value    = streamed.getValue3d(uv, uv_footprint);
+      EXPECT_NEAR(value.r, expected.r, 1e-12);
+      EXPECT_NEAR(value.g, expected.g, 1e-12);
+      EXPECT_NEAR(value.b, expected.b, 1e-12);
+    }
+  };
+
+  for(Texture* texture : {&resident, &streamed}) {
+    texture->setColorSpace(ColorSpace::S_RGB);
+  }
+  expect_same_samples(0.0);
+
+  for(Texture* texture : {&resident, &streamed}) {
+    texture->setFlippedVertically(true);
+    texture->setColorSpace(ColorSpace::LINEAR);
+  }
+  expect_same_samples(0.0);
+
+  for(Texture* texture : {&resident, &streamed}) {
+    texture->setFlippedVertically(false);
+    texture->setColorSpace(ColorSpace::S_RGB);
+    texture->setFilteringMode(TextureSampling::TextureFiltering::TRILINEAR);
+  }
+  expect_same_samples(0.1);
+
+  streamed.setValue(0.5);
+  EXPECT_FALSE(streamed.isStreamed());
+  std::filesystem::remove(path);
+}
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Surface/TextureStorage.hpp"
+#include "Surface/TextureTileCache.hpp"
+#include "Surface/TiledTextureFile.hpp"
+
+namespace {
+
+constexpr int TILE_SIZE = 8;
+
+class TextureTileCacheTest : public ::testing::Test {
+protected:
+  std::string m_path = (std::filesystem::temp_directory_path() / "lumen_cache.ltex").string();
+  std::shared_ptr<const TiledTextureFile> m_file;
+
+  void SetUp() override {
+    std::vector<double> values;
+    for(int i = 0; i < 32 * 32; ++i) {
+      values.push_back(static_cast<double>(i));
+    }
+    TextureStorage image;
+    image.setFloat64(values);
+    image.setImageLayout({32, 32}, 1);
+    ASSERT_TRUE(TiledTextureFile::Write(m_path, image, false, TILE_SIZE));
+    m_file = TiledTextureFile::Open(m_path);
+    ASSERT_NE(m_file, nullptr);
+  }
+
+  void TearDown() override { std::filesystem::remove(m_path); }
+
+  static std::size_t tileMemory() { return TILE_SIZE * TILE_SIZE * sizeof(double); }
+};
+
+} // namespace
+
+TEST_F(TextureTileCacheTest, SecondRequestIsAHit) {
+  TextureTileCache cache(tileMemory() * 4, 1);
+
+  const auto first  = cache.getTile(*m_file, 0, 1, 2);
+  const auto second = cache.getTile(*m_file, 0, 1, 2);
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(cache.getMissCount(), 1U);
+  EXPECT_EQ(cache.getHitCount(), 1U);
+  EXPECT_DOUBLE_EQ(first->load(first->getTexelIndex(3, 4)), (2 * TILE_SIZE + 4) * 32 + (TILE_SIZE + 3));
+}
+
+TEST_F(TextureTileCacheTest, EvictsLeastRecentlyUsedTile) {
+  TextureTileCache cache(tileMemory() * 2, 1);
+
+  cache.getTile(*m_file, 0, 0, 0);
+  cache.getTile(*m_file, 0, 1, 0);
+  cache.getTile(*m_file, 0, 0, 0); // Tile (1, 0) becomes the least recently used.
+  cache.getTile(*m_file, 0, 2, 0);
+  EXPECT_EQ(cache.getTileCount(), 2U);
+  EXPECT_LE(cache.getMemoryUsage(), cache.getMemoryBudget());
+
+  cache.getTile(*m_file, 0, 0, 0);
+  EXPECT_EQ(cache.getMissCount(), 3U);
+  cache.getTile(*m_file, 0, 1, 0);
+  EXPECT_EQ(cache.getMissCount(), 4U);
+}
+
+TEST_F(TextureTileCacheTest, StaysWithinBudget) {
+  TextureTileCache cache(tileMemory() * 8, 4);
+  for(int level = 0; level < m_file->getLevelCount(); ++level) {
+    const Resolution resolution = m_file->getLevelResolution(level);
+    for(int y = 0; y < (resolution.height + TILE_SIZE - 1) / TILE_SIZE; ++y) {
+      for(int x = 0; x < (resolution.width + TILE_SIZE - 1) / TILE_SIZE; ++x) {
+        cache.getTile(*m_file, level, x, y);
+        EXPECT_LE(cache.getMemoryUsage(), cache.getMemoryBudget());
+      }
+    }
+  }
+
+  cache.setMemoryBudget(0);
+  EXPECT_LE(cache.getTileCount(), 4U); // Each shard keeps its most recent tile.
+  cache.clear();
+  EXPECT_EQ(cache.getTileCount(), 0U);
+  EXPECT_EQ(cache.getMemoryUsage(), 0U);
+}
+
+TEST_F(TextureTileCacheTest, ConcurrentRequestsReturnConsistentTiles) {
+  TextureTileCache         cache(tileMemory() * 6, 2);
+  std::atomic<int>         errors{0};
+  std::vector<std::thread> workers;
+  for(int t = 0; t < 8; ++t) {
+    workers.emplace_back([&, t]() {
+      for(int i = 0; i < 500; ++i) {
+        const int  tile_x = (i + t) % 4;
+        const int  tile_y = (i / 4 + t) % 4;
+        const auto tile   = cache.getTile(*m_file, 0, tile_x, tile_y);
+        const double expected = static_cast<double>((tile_y * TILE_SIZE * 32) + (tile_x * TILE_SIZE));
+        if(tile->load(tile->getTexelIndex(0, 0)) != expected) {
+          ++errors;
+        }
+      }
+    });
+  }
+  for(auto& worker : workers) {
+    worker.join();
+  }
+
+  EXPECT_EQ(errors, 0);
+  EXPECT_EQ(cache.getHitCount() + cache.getMissCount(), 8U * 500U);
+  EXPECT_LE(cache.getMemoryUsage(), cache.getMemoryBudget());
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "Surface/TextureStorage.hpp"
+#include "Surface/TiledTextureFile.hpp"
+
+namespace {
+
+std::string tempPath(const char* name) { return (std::filesystem::temp_directory_path() / name).string(); }
+
+TextureStorage makeGradient(int width, int height, int channels) {
+  std::vector<float> values;
+  for(int y = 0; y < height; ++y) {
+    for(int x = 0; x < width; ++x) {
+      for(int c = 0; c < channels; ++c) {
+        values.push_back(static_cast<float>(x + (y * width) + c) / static_cast<float>(width * height));
+      }
+    }
+  }
+  TextureStorage storage;
+  storage.setFloat32(values);
+  storage.setImageLayout({width, height}, channels);
+  return storage;
+}
+
+} // namespace
+
+TEST(TiledTextureFileTest, HasTiledExtension) {
+  EXPECT_TRUE(TiledTextureFile::HasTiledExtension("textures/wood.ltex"));
+  EXPECT_TRUE(TiledTextureFile::HasTiledExtension("WOOD.LTEX"));
+  EXPECT_FALSE(TiledTextureFile::HasTiledExtension("wood.png"));
+  EXPECT_FALSE(TiledTextureFile::HasTiledExtension("ltex"));
+}
+
+TEST(TiledTextureFileTest, WriteAndReadTilesRoundTrip) {
+  const std::string    path  = tempPath("lumen_round_trip.ltex");
+  const TextureStorage image = makeGradient(40, 20, 3);
+  ASSERT_TRUE(TiledTextureFile::Write(path, image, false, 16));
+
+  const auto file = TiledTextureFile::Open(path);
+  ASSERT_NE(file, nullptr);
+  EXPECT_EQ(file->getFormat(), TexelFormat::FLOAT32);
+  EXPECT_EQ(file->getProperties().width, 40);
+  EXPECT_EQ(file->getProperties().height, 20);
+  EXPECT_EQ(file->getProperties().channels, 3);
+  EXPECT_EQ(file->getTileSize(), 16);
+  EXPECT_EQ(file->getLevelCount(), 6); // 40x20 down to 1x1
+
+  // Last tile of the base level, padded past the right and bottom edges.
+  const TextureStorage tile = file->readTile(0, 2, 1);
+  ASSERT_EQ(tile.size(), 16U * 16U * 3U);
+  for(int y = 0; y < 16; ++y) {
+    for(int x = 0; x < 16; ++x) {
+      const int source_x = std::min(32 + x, 39);
+      const int source_y = std::min(16 + y, 19);
+      EXPECT_EQ(tile.load(tile.getTexelIndex(x, y) + 1), image.load(image.getTexelIndex(source_x, source_y) + 1));
+    }
+  }
+
+  const TextureStorage last_level = file->readTile(file->getLevelCount() - 1, 0, 0);
+  EXPECT_GT(last_level.load(0), 0.0);
+  EXPECT_LT(last_level.load(0), 1.0);
+
+  std::filesystem::remove(path);
+}
+
+TEST(TiledTextureFileTest, LevelsMatchDownsampledImage) {
+  const std::string path = tempPath("lumen_levels.ltex");
+  TextureStorage    image;
+  image.setUnorm8({0, 64, 128, 255, 32, 96, 160, 224, 16, 48, 80, 112, 0, 255, 0, 255});
+  image.setImageLayout({4, 4}, 1);
+  ASSERT_TRUE(TiledTextureFile::Write(path, image, true, 8));
+
+  const auto file = TiledTextureFile::Open(path);
+  ASSERT_NE(file, nullptr);
+  ASSERT_EQ(file->getLevelCount(), 3);
+
+  const TextureStorage expected = image.downsample(true);
+  const TextureStorage tile     = file->readTile(1, 0, 0);
+  for(int y = 0; y < 2; ++y) {
+    for(int x = 0; x < 2; ++x) {
+      EXPECT_EQ(tile.load(tile.getTexelIndex(x, y)), expected.load(expected.getTexelIndex(x, y)));
+    }
+  }
+
+  std::filesystem::remove(path);
+}
+
+TEST(TiledTextureFileTest, OpenRejectsInvalidFiles) {
+  EXPECT_EQ(TiledTextureFile::Open(tempPath("lumen_missing.ltex")), nullptr);
+
+  const std::string path = tempPath("lumen_invalid.ltex");
+  {
+    std::ofstream file(path, std::ios::binary);
+    file << "not a tiled texture file";
+  }
+  EXPECT_EQ(TiledTextureFile::Open(path), nullptr);
+  std::filesystem::remove(path);
+}
+
+TEST(TiledTextureFileTest, OpenedFilesHaveUniqueIds) {
+  const std::string path = tempPath("lumen_ids.ltex");
+  ASSERT_TRUE(TiledTextureFile::Write(path, makeGradient(2, 2, 1), false));
+
+  const auto first  = TiledTextureFile::Open(path);
+  const auto second = TiledTextureFile::Open(path);
+  ASSERT_NE(first, nullptr);
+  ASSERT_NE(second, nullptr);
+  EXPECT_NE(first->getId(), second->getId());
+
+  std::filesystem::remove(path);
+}